@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+namespace soundarch::audio {
+
+    class BluetoothRouter;
+
+// ==============================================================================
+// 🔌 AUDIO BACKEND - What OboeEngine needs from a device, and nothing more
+// ==============================================================================
+//
+// OboeEngine owns the engine logic (ring buffer, XRun accounting, metering,
+// latency statistics, Safe Mode). A backend owns the device: it opens a
+// mono float input + output pair and calls onAudioReady() from its audio
+// thread whenever the output wants numFrames.
+//
+// Implementations:
+//   - OboeBackend      (Android): AAudio/OpenSL ES via Oboe, real RT thread
+//   - SimulatedBackend (host):    virtual clock, bursts, jitter, drift,
+//                                 stalls; callbacks driven by advance()
+//
+// Threading:
+//   - open()/start()/stop(): control thread
+//   - readInput(), timing(), nowNanos(): from inside onAudioReady() only
+//
+// ==============================================================================
+
+    class AudioBackendCallback {
+    public:
+        virtual ~AudioBackendCallback() = default;
+
+        /**
+         * Output wants numFrames (interleaved, channelCount() channels).
+         * @return false to stop the stream
+         */
+        virtual bool onAudioReady(float* output, int32_t numFrames) noexcept = 0;
+    };
+
+    // Stream geometry + frame counters, sampled at 10Hz for latency statistics
+    struct StreamTiming {
+        int32_t inputFramesPerBurst = 0;
+        int32_t outputFramesPerBurst = 0;
+        int32_t inputBufferSizeFrames = 0;
+        int32_t outputBufferSizeFrames = 0;
+        int64_t inputFramesWritten = 0;
+        int64_t inputFramesRead = 0;
+        int64_t outputFramesWritten = 0;
+        int64_t outputFramesRead = 0;
+    };
+
+    class AudioBackend {
+    public:
+        virtual ~AudioBackend() = default;
+
+        virtual const char* name() const noexcept = 0;
+
+        // Opens input + output streams; callback receives the output callbacks
+        virtual bool open(AudioBackendCallback* callback) = 0;
+        virtual bool start() = 0;
+        // Stops and closes both streams (no-op if not open)
+        virtual void stop() = 0;
+
+        /**
+         * Non-blocking capture read (RT-safe).
+         * @return Frames actually read (may be fewer than requested)
+         */
+        virtual int32_t readInput(float* dst, int32_t numFrames) noexcept = 0;
+
+        virtual int32_t sampleRate() const noexcept = 0;
+        virtual int32_t channelCount() const noexcept = 0;
+        virtual int32_t framesPerBurst() const noexcept = 0;
+        virtual int32_t bufferSizeFrames() const noexcept = 0;
+        virtual bool isOpen() const noexcept = 0;
+
+        virtual StreamTiming timing() const noexcept = 0;
+
+        // Stream clock (monotonic ns): steady_clock on device, virtual in simulation
+        virtual int64_t nowNanos() const noexcept = 0;
+
+        // Bluetooth profile detection needs the native output stream
+        virtual void detectRoute(BluetoothRouter& /*router*/) noexcept {}
+    };
+
+} // namespace soundarch::audio
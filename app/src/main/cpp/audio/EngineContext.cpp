@@ -0,0 +1,110 @@
+#include "EngineContext.h"
+#include <cstring>
+
+namespace soundarch {
+
+    EngineContext::EngineContext(float sampleRate)
+            : chain_(sampleRate) {}
+
+    EngineContext::EngineContext(float sampleRate, std::unique_ptr<OboeEngine> engine)
+            : chain_(sampleRate), engine_(std::move(engine)) {
+        if (engine_) {
+            // One pointer captured: fits std::function's inline storage
+            engine_->setAudioCallback([this](float* input, float* output, int32_t numFrames) {
+                onDeviceAudio(input, output, numFrames);
+            });
+        }
+    }
+
+    EngineContext::~EngineContext() {
+        stop();
+    }
+
+    bool EngineContext::start() {
+        if (!engine_) return false;
+        processedFrames_.store(0, std::memory_order_relaxed);
+        if (!engine_->start()) return false;
+
+        // 🔁 The device picked another rate: rebuild the modules for it while the
+        // stream runs (hot swap, the first blocks use the old set)
+        const float streamRate = engine_->getSampleRate();
+        if (streamRate != chain_.getSampleRate()) chain_.setSampleRate(streamRate);
+        return true;
+    }
+
+    void EngineContext::stop() {
+        if (engine_) engine_->stop();
+        chain_.reclaimRetired();   // No block in flight any more
+    }
+
+    void EngineContext::setParameter(dsp::Param id, float value) noexcept {
+        if (id == dsp::Param::VoiceGain) {
+            chain_.setVoiceGainDb(value);   // Also remembered for getVoiceGainDb()
+        } else {
+            chain_.setParameter(id, value);
+        }
+    }
+
+    void EngineContext::setModuleEnabled(dsp::ModuleSwitch module, bool enabled) noexcept {
+        switch (module) {
+            case dsp::ModuleSwitch::AGC: chain_.setAGCEnabled(enabled); break;
+            case dsp::ModuleSwitch::NoiseCanceller: chain_.setNoiseCancellerEnabled(enabled); break;
+            case dsp::ModuleSwitch::Compressor: chain_.setCompressorEnabled(enabled); break;
+            case dsp::ModuleSwitch::Limiter: chain_.setLimiterEnabled(enabled); break;
+            case dsp::ModuleSwitch::Count: break;
+        }
+    }
+
+    void EngineContext::process(float* buffer, int32_t numFrames) noexcept {
+        if (!buffer || numFrames <= 0) return;
+        dsp::BlockContext ctx;
+        ctx.sampleRate = static_cast<int>(chain_.getSampleRate());
+        dsp::EngineMeters meters;
+        runBlock(buffer, numFrames, ctx, meters);
+    }
+
+    // ✅ CRITICAL: real-time audio thread. NO malloc, NO locks, NO system calls.
+    void EngineContext::onDeviceAudio(float* input, float* output, int32_t numFrames) noexcept {
+        if (!input || !output) return;
+
+        // In-place processing: OboeEngine passes the same buffer for input and output
+        if (input != output) {
+            std::memcpy(output, input, static_cast<size_t>(numFrames) * sizeof(float));
+        }
+
+        // 🛡️ Safe Mode (Bluetooth underruns) reduces the chain to the limiter only
+        dsp::BlockContext ctx;
+        ctx.safeMode = engine_->isSafeModeActive();
+        ctx.sampleRate = static_cast<int>(engine_->getSampleRate());   // Actual stream rate
+        ctx.profiler = &engine_->profiler();                           // ⏱️ Per-stage timing
+        dsp::BlockLevels levels;
+        ctx.levels = &levels;                                          // 📊 Metered by the chain
+
+        dsp::EngineMeters meters;
+        meters.peakDb = engine_->getPeakDb();
+        meters.rmsDb = engine_->getRmsDb();
+        meters.xRunCount = engine_->getXRunCount();
+        meters.safeModeActive = ctx.safeMode;
+        runBlock(output, numFrames, ctx, meters);
+        engine_->reportBlockLevels(levels.peak, levels.sumSquares, levels.samples);
+    }
+
+    void EngineContext::runBlock(float* buffer, int32_t numFrames, const dsp::BlockContext& ctx,
+                                 dsp::EngineMeters& meters) noexcept {
+        // 🧩 Values written by Kotlin, then 📨 queued updates applied by processBlock()
+        sharedControl_.pump(chain_);
+        chain_.processBlock(buffer, numFrames, ctx);
+
+        // 🧩 Meters for the display-rate UI loop (copied by processBlock(): swap-safe)
+        const dsp::ModuleMeters modules = chain_.moduleMeters();
+        meters.agcGainDb = modules.agcGainDb;
+        meters.agcLevelDb = modules.agcLevelDb;
+        meters.compressorReductionDb = -modules.compressorGainReductionDb;
+        meters.limiterReductionDb = -modules.limiterGainReductionDb;
+        meters.callbackFrames = static_cast<uint32_t>(numFrames);
+        sharedControl_.publish(meters);
+
+        processedFrames_.fetch_add(static_cast<uint64_t>(numFrames), std::memory_order_relaxed);
+    }
+
+} // namespace soundarch
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "OboeEngine.h"
+#include "../dsp/DSPChain.h"
+#include "../dsp/SharedControlBlock.h"
+
+namespace soundarch {
+
+// ==============================================================================
+// 🧳 ENGINE CONTEXT - One complete, independent engine instance
+// ==============================================================================
+//
+// Everything an audio session used to keep in native-lib.cpp file-scope
+// globals, owned by one object:
+//   - DSPChain            (AGC → EQ → Voice Gain → NC → Compressor → Limiter)
+//   - SharedControlBlock  (Kotlin parameter/meter region)
+//   - OboeEngine          (live contexts only: device I/O, telemetry, trace)
+//   - processed frame counter
+//
+// Contexts share no mutable state, so several run side by side: the live
+// session plus offline renders on other cores, or many renders at once.
+// Process-wide pieces that remain are thread-safe by design: the RtLog
+// drain thread, the cycle-counter calibration and the RtGuard tables of
+// host test builds.
+//
+// Kinds:
+//   - Live     EngineContext(sampleRate, std::move(oboeEngine))
+//              start()/stop() drive the device callback
+//   - Offline  EngineContext(sampleRate)
+//              process() on the caller's thread, no device, no threads
+//
+// Both run the same block path: shared block pump → DSPChain → meters.
+//
+// Interfaces:
+//   - C ABI: audio/SoundArchEngine.h (opaque handle)
+//   - JNI:   engine/NativeAudioEngine.kt (one context per Kotlin object) and
+//            MainActivity (the app's session context, native-lib.cpp)
+//
+// Thread Safety:
+//   - process() / the device callback: one thread at a time per context
+//   - setParameter() / setModuleEnabled(): any thread (lock-free)
+//   - start() / stop() / destruction: control thread
+//
+// ==============================================================================
+
+    class EngineContext {
+    public:
+        // Offline: no device
+        explicit EngineContext(float sampleRate);
+
+        // Live: the context installs itself as the engine's audio callback
+        EngineContext(float sampleRate, std::unique_ptr<OboeEngine> engine);
+
+        ~EngineContext();   // Stops the device first
+
+        EngineContext(const EngineContext&) = delete;
+        EngineContext& operator=(const EngineContext&) = delete;
+
+        [[nodiscard]] bool isLive() const noexcept { return engine_ != nullptr; }
+
+        // Live contexts only (false/no-op offline)
+        bool start();
+        void stop();
+
+        // ⚡ Offline block: in-place, same path as the device callback (RT-safe)
+        void process(float* buffer, int32_t numFrames) noexcept;
+
+        // 📨 Any thread: queued, applied at the next block
+        void setParameter(dsp::Param id, float value) noexcept;
+        void setModuleEnabled(dsp::ModuleSwitch module, bool enabled) noexcept;
+
+        dsp::DSPChain& chain() noexcept { return chain_; }
+        const dsp::DSPChain& chain() const noexcept { return chain_; }
+        dsp::SharedControlBlock& sharedControl() noexcept { return sharedControl_; }
+        OboeEngine* engine() noexcept { return engine_.get(); }        // Null offline
+        const OboeEngine* engine() const noexcept { return engine_.get(); }
+
+        [[nodiscard]] uint64_t processedFrames() const noexcept {
+            return processedFrames_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        void onDeviceAudio(float* input, float* output, int32_t numFrames) noexcept;
+        void runBlock(float* buffer, int32_t numFrames, const dsp::BlockContext& ctx,
+                      dsp::EngineMeters& meters) noexcept;
+
+        dsp::DSPChain chain_;
+        dsp::SharedControlBlock sharedControl_;
+        std::unique_ptr<OboeEngine> engine_;       // Last: its callback uses the members above
+        std::atomic<uint64_t> processedFrames_{0};
+    };
+
+} // namespace soundarch
@@ -1,59 +1,174 @@
-#include <jni.h>
+#include "NativeAudioEngine.h"
 #include <android/log.h>
-#include "Equalizer.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include "EngineContext.h"
+
+// ==============================================================================
+// 🧳 NATIVE AUDIO ENGINE - JNI for com.soundarch.engine.NativeAudioEngine
+// ==============================================================================
+// One EngineContext per Kotlin object, passed back and forth as a jlong
+// handle: no file-scope state, so live and offline instances run side by
+// side (each offline render on its own thread). The app session used by
+// MainActivity lives in native-lib.cpp; the C ABI in SoundArchEngine.h.
+// ==============================================================================
 
 #define LOG_TAG "NativeAudioEngine"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
 
-static soundarch::dsp::Equalizer* equalizer = nullptr;
+using soundarch::EngineContext;
+namespace dsp = soundarch::dsp;
 
-extern "C"
-JNIEXPORT jboolean JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_initialize(JNIEnv* env, jobject /* this */, jint sampleRate) {
-    equalizer = new soundarch::dsp::Equalizer(static_cast<float>(sampleRate));
-    LOGI("Equalizer initialized with sampleRate: %d", sampleRate);
-    return equalizer != nullptr;
+namespace {
+    EngineContext* fromHandle(jlong handle) noexcept {
+        return reinterpret_cast<EngineContext*>(static_cast<intptr_t>(handle));
+    }
+} // anonymous namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeCreate(JNIEnv* /*env*/, jobject /*thiz*/, jint sampleRate, jboolean live) {
+    if (sampleRate <= 0) return 0;
+    const auto rate = static_cast<float>(sampleRate);
+    auto* context = live ? new EngineContext(rate, std::make_unique<OboeEngine>())
+                         : new EngineContext(rate);
+    LOGI("🧳 Engine context created (%s, SR=%d)", live ? "live" : "offline", sampleRate);
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(context));
+}
+
+JNIEXPORT void JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeDestroy(JNIEnv* /*env*/, jobject /*thiz*/, jlong handle) {
+    delete fromHandle(handle);   // Stops a live stream first
+    LOGI("🧳 Engine context released");
 }
 
-extern "C"
 JNIEXPORT jboolean JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_start(JNIEnv* env, jobject /* this */) {
-    LOGI("Audio started (stub)");
-    return true; // Implémente ton démarrage audio ici
+Java_com_soundarch_engine_NativeAudioEngine_nativeStart(JNIEnv* /*env*/, jobject /*thiz*/, jlong handle) {
+    EngineContext* context = fromHandle(handle);
+    return context && context->start() ? JNI_TRUE : JNI_FALSE;
 }
 
-extern "C"
 JNIEXPORT void JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_stop(JNIEnv* env, jobject /* this */) {
-    LOGI("Audio stopped (stub)");
+Java_com_soundarch_engine_NativeAudioEngine_nativeStop(JNIEnv* /*env*/, jobject /*thiz*/, jlong handle) {
+    if (EngineContext* context = fromHandle(handle)) context->stop();
+}
+
+JNIEXPORT jdouble JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeGetCurrentLatency(JNIEnv* /*env*/, jobject /*thiz*/, jlong handle) {
+    EngineContext* context = fromHandle(handle);
+    return context && context->engine() ? context->engine()->getLatencyStats().emaMs : 0.0;
 }
 
-extern "C"
 JNIEXPORT void JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_release(JNIEnv* env, jobject /* this */) {
-    delete equalizer;
-    equalizer = nullptr;
-    LOGI("Equalizer released");
+Java_com_soundarch_engine_NativeAudioEngine_nativeSetEqBands(JNIEnv* env, jobject /*thiz*/, jlong handle, jfloatArray gains) {
+    EngineContext* context = fromHandle(handle);
+    if (!context || !gains) return;
+
+    jfloat* values = env->GetFloatArrayElements(gains, nullptr);
+    if (!values) return;
+    const jsize bands = std::min(env->GetArrayLength(gains), static_cast<jsize>(dsp::Equalizer::kNumBands));
+    for (jsize i = 0; i < bands; ++i) {
+        context->setParameter(dsp::eqBandParam(i), values[i]);
+    }
+    env->ReleaseFloatArrayElements(gains, values, JNI_ABORT);
 }
 
-extern "C"
-JNIEXPORT jdouble JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_getCurrentLatency(JNIEnv* env, jobject /* this */) {
-    return 0.0; // Retourne la latence réelle si tu peux
+JNIEXPORT jboolean JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeSetParameter(JNIEnv* /*env*/, jobject /*thiz*/, jlong handle, jint param, jfloat value) {
+    EngineContext* context = fromHandle(handle);
+    if (!context || param < 0 || static_cast<size_t>(param) >= dsp::kParamCount) return JNI_FALSE;
+    context->setParameter(static_cast<dsp::Param>(param), value);
+    return JNI_TRUE;
 }
 
-extern "C"
 JNIEXPORT void JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_setEqBands(JNIEnv* env, jobject /* this */, jfloatArray gains) {
-    if (!equalizer) return;
+Java_com_soundarch_engine_NativeAudioEngine_nativeSetModuleEnabled(JNIEnv* /*env*/, jobject /*thiz*/, jlong handle, jint module, jboolean enabled) {
+    EngineContext* context = fromHandle(handle);
+    if (!context || module < 0 || static_cast<size_t>(module) >= dsp::kModuleSwitchCount) return;
+    context->setModuleEnabled(static_cast<dsp::ModuleSwitch>(module), enabled);
+}
 
-    jsize length = env->GetArrayLength(gains);
-    jfloat* nativeGains = env->GetFloatArrayElements(gains, nullptr);
+// Offline contexts: in-place render of the first numFrames samples
+JNIEXPORT jboolean JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeProcess(JNIEnv* env, jobject /*thiz*/, jlong handle, jfloatArray buffer, jint numFrames) {
+    EngineContext* context = fromHandle(handle);
+    if (!context || context->isLive() || !buffer) return JNI_FALSE;
+    if (numFrames <= 0 || numFrames > env->GetArrayLength(buffer)) return JNI_FALSE;
 
-    for (int i = 0; i < length; ++i) {
-        equalizer->setBandGain(i, nativeGains[i]);
+    jfloat* samples = env->GetFloatArrayElements(buffer, nullptr);
+    if (!samples) return JNI_FALSE;
+    context->process(samples, numFrames);
+    env->ReleaseFloatArrayElements(buffer, samples, 0);   // Copy back
+    return JNI_TRUE;
+}
+
+JNIEXPORT jobject JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeGetSharedControlBlock(JNIEnv* env, jobject /*thiz*/, jlong handle) {
+    EngineContext* context = fromHandle(handle);
+    if (!context) return nullptr;
+    return env->NewDirectByteBuffer(context->sharedControl().data(),
+                                    static_cast<jlong>(dsp::SharedControlBlock::sizeBytes()));
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// 🔇 NOISE CANCELLER
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+JNIEXPORT void JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeApplyNoiseCancellerPreset(JNIEnv* /*env*/, jobject /*thiz*/, jlong handle, jint presetIndex) {
+    using Preset = dsp::noisecancel::NoiseCancellerParams::Preset;
+    EngineContext* context = fromHandle(handle);
+    if (!context) return;
+
+    // Same order as NativeAudioEngine.NoisePreset
+    static constexpr Preset kPresets[] = { Preset::Default, Preset::Voice, Preset::Outdoor, Preset::Office };
+    if (presetIndex < 0 || presetIndex >= static_cast<jint>(std::size(kPresets))) {
+        LOGE("❌ Invalid preset index: %d", presetIndex);
+        return;
     }
+    context->chain().applyNoiseCancellerPreset(kPresets[presetIndex]);
+}
+
+JNIEXPORT void JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeSetNoiseCancellerParams(
+        JNIEnv* /*env*/, jobject /*thiz*/, jlong handle,
+        jfloat strength, jfloat spectralFloor, jfloat smoothing, jfloat noiseAttackMs,
+        jfloat noiseReleaseMs, jfloat residualBoostDb, jfloat artifactSuppress) {
+    EngineContext* context = fromHandle(handle);
+    if (!context) return;
 
-    env->ReleaseFloatArrayElements(gains, nativeGains, 0);
-    LOGI("EQ bands updated");
+    dsp::noisecancel::NoiseCancellerParams params;
+    params.setEnabled(context->chain().isNoiseCancellerEnabled());
+    params.setStrength(strength);
+    params.setSpectralFloor(spectralFloor);
+    params.setSmoothing(smoothing);
+    params.setNoiseAttack(noiseAttackMs);
+    params.setNoiseRelease(noiseReleaseMs);
+    params.setResidualBoost(residualBoostDb);
+    params.setArtifactSuppression(artifactSuppress);
+    context->chain().setNoiseCancellerParams(params);
 }
+
+JNIEXPORT jfloat JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeGetNoiseCancellerNoiseFloor(JNIEnv* /*env*/, jobject /*thiz*/, jlong handle) {
+    EngineContext* context = fromHandle(handle);
+    return context ? context->chain().noiseCancellerNoiseFloorDb() : -100.0f;
+}
+
+#ifdef NC_BENCHMARK
+JNIEXPORT jfloat JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeGetNoiseCancellerCpuMs(JNIEnv* /*env*/, jobject /*thiz*/, jlong handle) {
+    EngineContext* context = fromHandle(handle);
+    return context ? context->chain().noiseCancellerCpuMs() : 0.0f;
+}
+
+JNIEXPORT void JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeResetNoiseCancellerCpuStats(JNIEnv* /*env*/, jobject /*thiz*/, jlong handle) {
+    if (EngineContext* context = fromHandle(handle)) context->chain().resetNoiseCancellerCpuStats();
+}
+#endif
+
+} // extern "C"
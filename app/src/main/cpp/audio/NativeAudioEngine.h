@@ -3,27 +3,54 @@
 
 #include <jni.h>
 
+// JNI for com.soundarch.engine.NativeAudioEngine: the jlong handle is an
+// EngineContext* (audio/EngineContext.h), 0 once released.
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-JNIEXPORT jboolean JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_initialize(JNIEnv* env, jobject obj, jint sampleRate);
+JNIEXPORT jlong JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeCreate(JNIEnv* env, jobject obj, jint sampleRate, jboolean live);
+
+JNIEXPORT void JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeDestroy(JNIEnv* env, jobject obj, jlong handle);
 
 JNIEXPORT jboolean JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_start(JNIEnv* env, jobject obj);
+Java_com_soundarch_engine_NativeAudioEngine_nativeStart(JNIEnv* env, jobject obj, jlong handle);
 
 JNIEXPORT void JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_stop(JNIEnv* env, jobject obj);
+Java_com_soundarch_engine_NativeAudioEngine_nativeStop(JNIEnv* env, jobject obj, jlong handle);
+
+JNIEXPORT jdouble JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeGetCurrentLatency(JNIEnv* env, jobject obj, jlong handle);
 
 JNIEXPORT void JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_release(JNIEnv* env, jobject obj);
+Java_com_soundarch_engine_NativeAudioEngine_nativeSetEqBands(JNIEnv* env, jobject obj, jlong handle, jfloatArray gains);
 
-JNIEXPORT jdouble JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_getCurrentLatency(JNIEnv* env, jobject obj);
+JNIEXPORT jboolean JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeSetParameter(JNIEnv* env, jobject obj, jlong handle, jint param, jfloat value);
 
 JNIEXPORT void JNICALL
-Java_com_soundarch_engine_NativeAudioEngine_setEqBands(JNIEnv* env, jobject obj, jfloatArray gains);
+Java_com_soundarch_engine_NativeAudioEngine_nativeSetModuleEnabled(JNIEnv* env, jobject obj, jlong handle, jint module, jboolean enabled);
+
+JNIEXPORT jboolean JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeProcess(JNIEnv* env, jobject obj, jlong handle, jfloatArray buffer, jint numFrames);
+
+JNIEXPORT jobject JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeGetSharedControlBlock(JNIEnv* env, jobject obj, jlong handle);
+
+JNIEXPORT void JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeApplyNoiseCancellerPreset(JNIEnv* env, jobject obj, jlong handle, jint presetIndex);
+
+JNIEXPORT void JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeSetNoiseCancellerParams(
+        JNIEnv* env, jobject obj, jlong handle,
+        jfloat strength, jfloat spectralFloor, jfloat smoothing, jfloat noiseAttackMs,
+        jfloat noiseReleaseMs, jfloat residualBoostDb, jfloat artifactSuppress);
+
+JNIEXPORT jfloat JNICALL
+Java_com_soundarch_engine_NativeAudioEngine_nativeGetNoiseCancellerNoiseFloor(JNIEnv* env, jobject obj, jlong handle);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,143 @@
+#include "OboeBackend.h"
+#include <chrono>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <cerrno>
+#include "BluetoothRouter.h"
+#include "../utils/Log.h"
+#include "../utils/RtLog.h"
+
+#define TAG "OboeBackend"
+#define LOGE(...) SA_LOGE(TAG, __VA_ARGS__)
+#define LOGI(...) SA_LOGI(TAG, __VA_ARGS__)
+#define RT_LOGE(...) SA_RT_LOGE(TAG, __VA_ARGS__)   // Audio callback only
+#define RT_LOGI(...) SA_RT_LOGI(TAG, __VA_ARGS__)
+
+namespace soundarch::audio {
+
+    OboeBackend::~OboeBackend() {
+        stop();
+    }
+
+    bool OboeBackend::open(AudioBackendCallback* callback) {
+        callback_ = callback;
+        threadConfigured_ = false;
+
+        auto inputBuilder = std::make_shared<oboe::AudioStreamBuilder>();
+        auto outputBuilder = std::make_shared<oboe::AudioStreamBuilder>();
+
+        inputBuilder->setDirection(oboe::Direction::Input)
+                ->setFormat(oboe::AudioFormat::Float)
+                ->setPerformanceMode(oboe::PerformanceMode::LowLatency)
+                ->setSharingMode(oboe::SharingMode::Exclusive)
+                ->setChannelCount(oboe::ChannelCount::Mono)
+                ->setCallback(nullptr);
+
+        outputBuilder->setDirection(oboe::Direction::Output)
+                ->setFormat(oboe::AudioFormat::Float)
+                ->setPerformanceMode(oboe::PerformanceMode::LowLatency)
+                ->setSharingMode(oboe::SharingMode::Exclusive)
+                ->setChannelCount(oboe::ChannelCount::Mono)
+                ->setCallback(this);
+
+        oboe::Result result = inputBuilder->openStream(inputStream_);
+        if (result != oboe::Result::OK || !inputStream_) {
+            LOGE("❌ Input stream error: %s", oboe::convertToText(result));
+            inputStream_.reset();
+            return false;
+        }
+
+        result = outputBuilder->openStream(outputStream_);
+        if (result != oboe::Result::OK || !outputStream_) {
+            LOGE("❌ Output stream error: %s", oboe::convertToText(result));
+            outputStream_.reset();
+            inputStream_->close();
+            inputStream_.reset();
+            return false;
+        }
+
+        int32_t burst = outputStream_->getFramesPerBurst();
+        oboe::Result bufferResult = outputStream_->setBufferSizeInFrames(burst * 2);  // ✅ 2x burst pour Bluetooth
+        if (bufferResult != oboe::Result::OK) {
+            LOGE("⚠️ setBufferSizeInFrames failed: %s", oboe::convertToText(bufferResult));
+        }
+        return true;
+    }
+
+    bool OboeBackend::start() {
+        if (!inputStream_ || !outputStream_) return false;
+        inputStream_->requestStart();
+        outputStream_->requestStart();
+        return true;
+    }
+
+    void OboeBackend::stop() {
+        if (inputStream_) {
+            inputStream_->requestStop();
+            inputStream_->close();
+            inputStream_.reset();
+        }
+
+        if (outputStream_) {
+            outputStream_->requestStop();
+            usleep(20000);
+            outputStream_->close();
+            outputStream_.reset();
+        }
+    }
+
+    int32_t OboeBackend::readInput(float* dst, int32_t numFrames) noexcept {
+        if (!inputStream_) return 0;
+        auto result = inputStream_->read(dst, numFrames, 0);  // Non-blocking
+        return result ? result.value() : 0;
+    }
+
+    StreamTiming OboeBackend::timing() const noexcept {
+        StreamTiming t;
+        if (!inputStream_ || !outputStream_) return t;
+
+        t.inputFramesPerBurst = inputStream_->getFramesPerBurst();
+        t.outputFramesPerBurst = outputStream_->getFramesPerBurst();
+        t.inputBufferSizeFrames = inputStream_->getBufferSizeInFrames();
+        t.outputBufferSizeFrames = outputStream_->getBufferSizeInFrames();
+        t.inputFramesWritten = inputStream_->getFramesWritten();
+        t.inputFramesRead = inputStream_->getFramesRead();
+        t.outputFramesWritten = outputStream_->getFramesWritten();
+        t.outputFramesRead = outputStream_->getFramesRead();
+        return t;
+    }
+
+    int64_t OboeBackend::nowNanos() const noexcept {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    void OboeBackend::detectRoute(BluetoothRouter& router) noexcept {
+        router.detectProfile(outputStream_.get());
+    }
+
+    oboe::DataCallbackResult OboeBackend::onAudioReady(oboe::AudioStream* /*stream*/, void* audioData, int32_t numFrames) {
+        if (!threadConfigured_) {
+            threadConfigured_ = true;
+
+            // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+            // 🔧 AUDIO THREAD OPTIMIZATION: SCHED_FIFO real-time priority
+            // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+            struct sched_param schParams = {};
+            schParams.sched_priority = 18;
+            pid_t tid = gettid();
+            if (sched_setscheduler(tid, SCHED_FIFO, &schParams) == 0) {
+                RT_LOGI("✅ Audio thread: SCHED_FIFO priority %d", schParams.sched_priority);
+            } else {
+                RT_LOGE("⚠️ Audio thread: Failed to set SCHED_FIFO (errno=%d)", errno);
+            }
+        }
+
+        if (!callback_) return oboe::DataCallbackResult::Stop;
+        return callback_->onAudioReady(static_cast<float*>(audioData), numFrames)
+               ? oboe::DataCallbackResult::Continue
+               : oboe::DataCallbackResult::Stop;
+    }
+
+} // namespace soundarch::audio
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <oboe/Oboe.h>
+#include <memory>
+#include "AudioBackend.h"
+
+namespace soundarch::audio {
+
+// ==============================================================================
+// 📱 OBOE BACKEND - Low-latency exclusive mono float streams (Android)
+// ==============================================================================
+//
+// Input is opened without callback and read non-blocking from the output
+// callback thread; output drives everything. The output buffer is set to
+// 2x burst for Bluetooth headroom.
+//
+// ==============================================================================
+
+    class OboeBackend final : public AudioBackend, public oboe::AudioStreamCallback {
+    public:
+        OboeBackend() noexcept = default;
+        ~OboeBackend() override;
+
+        const char* name() const noexcept override { return "Oboe"; }
+
+        bool open(AudioBackendCallback* callback) override;
+        bool start() override;
+        void stop() override;
+
+        int32_t readInput(float* dst, int32_t numFrames) noexcept override;
+
+        int32_t sampleRate() const noexcept override {
+            return outputStream_ ? outputStream_->getSampleRate() : 48000;
+        }
+        int32_t channelCount() const noexcept override {
+            return outputStream_ ? outputStream_->getChannelCount() : 1;
+        }
+        int32_t framesPerBurst() const noexcept override {
+            return outputStream_ ? outputStream_->getFramesPerBurst() : 0;
+        }
+        int32_t bufferSizeFrames() const noexcept override {
+            return outputStream_ ? outputStream_->getBufferSizeInFrames() : 128;
+        }
+        bool isOpen() const noexcept override { return outputStream_ != nullptr; }
+
+        StreamTiming timing() const noexcept override;
+        int64_t nowNanos() const noexcept override;
+        void detectRoute(BluetoothRouter& router) noexcept override;
+
+        // 🔁 Oboe real-time callback (output)
+        oboe::DataCallbackResult onAudioReady(
+                oboe::AudioStream* stream,
+                void* audioData,
+                int32_t numFrames) override;
+
+    private:
+        std::shared_ptr<oboe::AudioStream> inputStream_;
+        std::shared_ptr<oboe::AudioStream> outputStream_;
+        AudioBackendCallback* callback_ = nullptr;
+        bool threadConfigured_ = false;
+    };
+
+} // namespace soundarch::audio
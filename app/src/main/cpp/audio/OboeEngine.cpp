@@ -1,108 +1,97 @@
 #include "OboeEngine.h"
-#include <android/log.h>
-#include <chrono>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
-#include <unistd.h>
-#include <pthread.h>
-#include <sched.h>
-#include <cerrno>
-#include <mutex>
-#include "../utils/RingBuffer.h"
-
-// FTZ/DAZ support for denormal handling
-#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
-    #include <xmmintrin.h>  // SSE intrinsics for FTZ
-    #include <pmmintrin.h>  // SSE3 intrinsics for DAZ
-    #define HAS_FTZ_DAZ 1
-#elif defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(__aarch64__)
-    // ARM NEON: Flush-to-zero is controlled by FPCR register
-    // On Android ARM64, FTZ is typically enabled by default
-    #define HAS_FTZ_DAZ 1
-    #define HAS_ARM_NEON 1
-#else
-    #define HAS_FTZ_DAZ 0
+#include "../utils/Denormals.h"
+#include "../utils/Log.h"
+#include "../utils/RtGuard.h"
+#include "../utils/RtLog.h"
+
+#if defined(__ANDROID__)
+#include "OboeBackend.h"
 #endif
 
 #define TAG "OboeEngine"
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, TAG, __VA_ARGS__)
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, TAG, __VA_ARGS__)
-
-extern "C" void sendLatencyToJava(double latency);
-
-static std::once_flag pinThreadFlag;
-static RingBuffer<float, 16384> ringBuffer;  // ✅ FIX: 4x plus grand pour Bluetooth
-
-// ✅ FIX: Compteurs de debug
-static std::atomic<int> overflowCount{0};
-static std::atomic<int> underflowCount{0};
+#define LOGE(...) SA_LOGE(TAG, __VA_ARGS__)
+#define LOGI(...) SA_LOGI(TAG, __VA_ARGS__)
+#define RT_LOGE(...) SA_RT_LOGE(TAG, __VA_ARGS__)   // Audio callback only
+#define RT_LOGI(...) SA_RT_LOGI(TAG, __VA_ARGS__)
+
+#if defined(__ANDROID__)
+OboeEngine::OboeEngine() noexcept
+        : OboeEngine(std::make_unique<soundarch::audio::OboeBackend>()) {}
+#endif
 
-OboeEngine::OboeEngine() noexcept : isRecording(false) {}
+OboeEngine::OboeEngine(std::unique_ptr<soundarch::audio::AudioBackend> backend) noexcept
+        : backend_(std::move(backend)), isRecording(false) {
+    audioTrace_ = trace_.addTrack("audio");
+    telemetryTrace_ = trace_.addTrack("telemetry");
+    profiler_.setTrace(audioTrace_);
+}
 
 OboeEngine::~OboeEngine() {
     stop();
 }
 
-void OboeEngine::start() {
-    if (isRecording) return;
-    isRecording = true;
-
-    auto inputBuilder = std::make_shared<oboe::AudioStreamBuilder>();
-    auto outputBuilder = std::make_shared<oboe::AudioStreamBuilder>();
-
-    inputBuilder->setDirection(oboe::Direction::Input)
-            ->setFormat(oboe::AudioFormat::Float)
-            ->setPerformanceMode(oboe::PerformanceMode::LowLatency)
-            ->setSharingMode(oboe::SharingMode::Exclusive)
-            ->setChannelCount(oboe::ChannelCount::Mono)
-            ->setCallback(nullptr);
-
-    outputBuilder->setDirection(oboe::Direction::Output)
-            ->setFormat(oboe::AudioFormat::Float)
-            ->setPerformanceMode(oboe::PerformanceMode::LowLatency)
-            ->setSharingMode(oboe::SharingMode::Exclusive)
-            ->setChannelCount(oboe::ChannelCount::Mono)
-            ->setCallback(this);
-
-    oboe::Result result = inputBuilder->openStream(inputStream);
-    if (result != oboe::Result::OK || !inputStream) {
-        LOGE("❌ Input stream error: %s", oboe::convertToText(result));
-        return;
-    }
-
-    result = outputBuilder->openStream(outputStream);
-    if (result != oboe::Result::OK || !outputStream) {
-        LOGE("❌ Output stream error: %s", oboe::convertToText(result));
-        inputStream->close();
-        inputStream.reset();
-        return;
-    }
-
-    int32_t burst = outputStream->getFramesPerBurst();
-    oboe::Result bufferResult = outputStream->setBufferSizeInFrames(burst * 2);  // ✅ 2x burst pour Bluetooth
-    if (bufferResult != oboe::Result::OK) {
-        LOGE("⚠️ setBufferSizeInFrames failed: %s", oboe::convertToText(bufferResult));
-    }
+bool OboeEngine::start() {
+    if (isRecording) return true;
 
-    inputStream->requestStart();
-    outputStream->requestStart();
-
-    // ✅ Reset des compteurs
-    overflowCount.store(0);
-    underflowCount.store(0);
+    // ✅ Reset des compteurs (before the first callback can run)
+    ringBuffer_.reset();
+    overflowCount_.store(0);
+    underflowCount_.store(0);
     xRunCount_.store(0);
     lastCallbackSize_.store(0);
+    profiler_.reset();   // Also calibrates the cycle counter (off the audio thread)
+    lastSafeMode_ = false;
+    frameCounter_ = 0;
+    telemetryCounters_.reset();
+    lastDebugLogNs_ = 0;
+    lastSystemSampleNs_ = 0;
+    systemSampled_ = false;
+    audioThreadConfigured_ = false;
 
     // Reset latency statistics
     latencyStats_ = LatencyStats{};
+    performanceMetrics_ = PerformanceMetrics{};
+    publishedMetrics_.write({ latencyStats_, performanceMetrics_ });
+
+    if (!backend_->open(this)) {
+        LOGE("❌ %s backend: failed to open streams", backend_->name());
+        return false;
+    }
 
+    isRecording = true;
+
+#if SOUNDARCH_HAS_BLUETOOTH_ROUTER
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // 📻 BLUETOOTH PROFILE DETECTION
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    bluetoothRouter_.detectProfile(outputStream.get());
+    backend_->detectRoute(bluetoothRouter_);
     bluetoothRouter_.resetStats();
+#endif
 
-    LOGI("🎧 Audio STARTED | SR=%d | Burst=%d | Buffer=%d frames | RingBuffer=%zu",
-         outputStream->getSampleRate(), burst, outputStream->getBufferSizeInFrames(), ringBuffer.capacity());
+    // 📝 Drains RT_LOG* records from the callback
+    soundarch::log::rt::logger().startThread();
+
+    if (!backend_->start()) {
+        LOGE("❌ %s backend: failed to start streams", backend_->name());
+        isRecording = false;
+        backend_->stop();
+        soundarch::log::rt::logger().stopThread();
+        return false;
+    }
+
+    // 📡 Telemetry thread: everything the callback must not do (/proc, JNI, logs)
+    if (telemetryThreadEnabled_) {
+        telemetryStop_ = false;
+        telemetryThread_ = std::thread(&OboeEngine::telemetryLoop, this);
+    }
+
+    LOGI("🎧 Audio STARTED (%s) | SR=%d | Burst=%d | Buffer=%d frames | RingBuffer=%zu",
+         backend_->name(), backend_->sampleRate(), backend_->framesPerBurst(),
+         backend_->bufferSizeFrames(), ringBuffer_.capacity());
+    return true;
 }
 
 void OboeEngine::stop() {
@@ -111,105 +100,94 @@ void OboeEngine::stop() {
 
     LOGI("🛑 Stopping audio...");
 
-    if (inputStream) {
-        inputStream->requestStop();
-        inputStream->close();
-        inputStream.reset();
-    }
+    backend_->stop();
 
-    if (outputStream) {
-        outputStream->requestStop();
-        usleep(20000);
-        outputStream->close();
-        outputStream.reset();
+    if (telemetryThread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(telemetryMutex_);
+            telemetryStop_ = true;
+        }
+        telemetryWake_.notify_one();
+        telemetryThread_.join();
     }
 
+    soundarch::log::rt::logger().stopThread();   // Flushes the callback's last records
+
     // ✅ FIX: Affiche stats finales
-    LOGI("📊 Final stats: Overflows=%d Underflows=%d",
-         overflowCount.load(), underflowCount.load());
+    LOGI("📊 Final stats: Overflows=%u Underflows=%u",
+         overflowCount_.load(), underflowCount_.load());
 }
 
-oboe::DataCallbackResult OboeEngine::onAudioReady(oboe::AudioStream *stream, void *audioData, int32_t numFrames) {
-    if (!isRecording) return oboe::DataCallbackResult::Stop;
+bool OboeEngine::onAudioReady(float* output, int32_t numFrames) noexcept {
+    SOUNDARCH_RT_SCOPE();   // 🚨 Test builds: no malloc / lock / syscall below
+    if (!isRecording) return false;
+
+    using soundarch::utils::Stage;
+    const uint64_t callbackStart = soundarch::utils::StageProfiler::now();
 
     // Track callback buffer size for XRun correlation
     lastCallbackSize_.store(numFrames, std::memory_order_relaxed);
 
-    std::call_once(pinThreadFlag, []() {
+    if (!audioThreadConfigured_) {
+        audioThreadConfigured_ = true;
+
         // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-        // 🔧 AUDIO THREAD OPTIMIZATION
+        // 🔧 AUDIO THREAD OPTIMIZATION (SCHED_FIFO is set by the backend)
         // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 
-        // 1. Set SCHED_FIFO real-time priority
-        struct sched_param schParams = {};
-        schParams.sched_priority = 18;
-        pid_t tid = gettid();
-        if (sched_setscheduler(tid, SCHED_FIFO, &schParams) == 0) {
-            LOGI("✅ Audio thread: SCHED_FIFO priority %d", schParams.sched_priority);
-        } else {
-            LOGE("⚠️ Audio thread: Failed to set SCHED_FIFO (errno=%d)", errno);
-        }
-
-        // 2. Enable FTZ (Flush-To-Zero) and DAZ (Denormals-Are-Zero) for denormal handling
+        // Enable FTZ (Flush-To-Zero) and DAZ (Denormals-Are-Zero) for denormal handling
         // Prevents CPU slowdown when processing very small floating-point values (<10^-38)
-#if HAS_FTZ_DAZ
-    #ifdef HAS_ARM_NEON
-        // ARM NEON: Enable FTZ via FPCR register
-        // NOTE: FPCR register only available on ARM64 (aarch64), not on 32-bit ARM
-        #ifdef __aarch64__
-            uint64_t fpcr;
-            __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
-            fpcr |= (1 << 24);  // Set FZ bit (Flush-to-Zero)
-            __asm__ __volatile__("msr fpcr, %0" :: "r"(fpcr));
-            LOGI("✅ Audio thread: FTZ enabled (ARM64 NEON)");
-        #else
-            // 32-bit ARM: FTZ controlled by FPSCR register, but typically enabled by default
-            // We don't set it manually to avoid platform-specific assembly issues
-            LOGI("⚠️ Audio thread: FTZ (ARM32 NEON, using default)");
-        #endif
-    #else
-        // x86/x64: Enable FTZ and DAZ via SSE control registers
-        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);   // FTZ: Underflows flushed to zero
-        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);  // DAZ: Denormals treated as zero
-        LOGI("✅ Audio thread: FTZ/DAZ enabled (x86/SSE)");
-    #endif
-#else
-        LOGI("⚠️ Audio thread: FTZ/DAZ not supported on this architecture");
-#endif
-    });
-
-    float *output = static_cast<float *>(audioData);
-    int32_t numSamples = numFrames * stream->getChannelCount();
-
-    // Lecture micro → buffer
-    if (inputStream) {
-        static float inputTemp[4096];
-        inputStream->read(inputTemp, numFrames, 0);
+        RT_LOGI("Audio thread: %s", soundarch::utils::enableFlushToZero());
+    }
 
-        // ✅ FIX: Log overflow avec limite + Track XRun
-        if (!ringBuffer.push(inputTemp, numSamples)) {
-            int count = overflowCount.fetch_add(1) + 1;
+    const int32_t numSamples = numFrames * backend_->channelCount();
+
+    // Lecture micro → directly into ring storage (no intermediate copy)
+    // Only what the device actually delivered is queued (non-blocking read may be short)
+    const auto reservation = ringBuffer_.prepareWrite(static_cast<size_t>(numSamples));
+    size_t queued = 0;
+    for (const auto& span : {reservation.first, reservation.second}) {
+        if (span.size == 0) break;
+        const int32_t got = backend_->readInput(span.data, static_cast<int32_t>(span.size));
+        if (got <= 0) break;
+        queued += static_cast<size_t>(got);
+        if (static_cast<size_t>(got) < span.size) break;
+    }
+    ringBuffer_.commitWrite(queued);
+
+    // ✅ FIX: Log overflow avec limite + Track XRun
+    // Ring full: what the device still holds for this callback is read into
+    // output (scratch, overwritten below) and dropped, so capture latency cannot build up
+    if (queued == reservation.size() && queued < static_cast<size_t>(numSamples)) {
+        const int32_t dropped = backend_->readInput(output, numSamples - static_cast<int32_t>(queued));
+        if (dropped > 0) {
+            uint32_t count = overflowCount_.fetch_add(1) + 1;
             xRunCount_.fetch_add(1, std::memory_order_relaxed);  // Track total XRuns
+            audioTrace_->instant("xrun_overflow", "count", count);
             if (count % 100 == 0) {
-                LOGE("⚠️ RingBuffer OVERFLOW x%d (capacity=%zu, available=%zu, callback=%d frames)",
-                     count, ringBuffer.capacity(), ringBuffer.availableToWrite(), numFrames);
+                RT_LOGE("⚠️ RingBuffer OVERFLOW x%u (capacity=%zu, dropped=%d, callback=%d frames)",
+                     count, ringBuffer_.capacity(), dropped, numFrames);
             }
         }
     }
+    uint64_t t = profiler_.lap(Stage::Input, callbackStart);
 
     // Traitement DSP
+    reportedSamples_ = 0;   // Set again by the callback if it meters the block
     // ✅ FIX: Log underflow avec limite + Track XRun
-    if (!ringBuffer.pop(output, numSamples)) {
-        int count = underflowCount.fetch_add(1) + 1;
+    if (!ringBuffer_.pop(output, static_cast<size_t>(numSamples))) {
+        uint32_t count = underflowCount_.fetch_add(1) + 1;
         xRunCount_.fetch_add(1, std::memory_order_relaxed);  // Track total XRuns
+        audioTrace_->instant("xrun_underflow", "count", count);
         if (count % 100 == 0) {
-            LOGE("⚠️ RingBuffer UNDERFLOW x%d (capacity=%zu, available=%zu, callback=%d frames)",
-                 count, ringBuffer.capacity(), ringBuffer.availableToRead(), numFrames);
+            RT_LOGE("⚠️ RingBuffer UNDERFLOW x%u (capacity=%zu, available=%zu, callback=%d frames)",
+                 count, ringBuffer_.capacity(), ringBuffer_.availableToRead(), numFrames);
         }
         memset(output, 0, numSamples * sizeof(float));
     } else if (audioCallback_) {
         audioCallback_(output, output, numFrames);
     }
+    t = profiler_.lap(Stage::Dsp, t);
 
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // 📊 PEAK/RMS METER - Real-time audio level tracking with EMA smoothing
@@ -218,10 +196,16 @@ oboe::DataCallbackResult OboeEngine::onAudioReady(oboe::AudioStream *stream, voi
     float peak = 0.0f;
     float sumSquares = 0.0f;
 
-    for (int32_t i = 0; i < numSamples; ++i) {
-        float sample = std::abs(output[i]);
-        peak = std::max(peak, sample);
-        sumSquares += output[i] * output[i];
+    if (reportedSamples_ == numSamples) {
+        // ⚡ Already measured by the DSP callback in its fused pass
+        peak = reportedPeak_;
+        sumSquares = reportedSumSquares_;
+    } else {
+        for (int32_t i = 0; i < numSamples; ++i) {
+            float sample = std::abs(output[i]);
+            peak = std::max(peak, sample);
+            sumSquares += output[i] * output[i];
+        }
     }
 
     float rms = std::sqrt(sumSquares / static_cast<float>(numSamples));
@@ -250,206 +234,225 @@ oboe::DataCallbackResult OboeEngine::onAudioReady(oboe::AudioStream *stream, voi
     peakDb_.store(newPeak, std::memory_order_relaxed);
     rmsDb_.store(newRms, std::memory_order_relaxed);
 
+    t = profiler_.lap(Stage::Metering, t);
+    profiler_.recordCallback(t - callbackStart, numFrames, backend_->sampleRate());
+
+    // 🎞️ Timeline: whole callback + ring buffer fill (no-op unless recording)
+    if (audioTrace_->enabled()) {
+        const auto fill = static_cast<int64_t>(ringBuffer_.availableToRead());
+        audioTrace_->complete("callback", callbackStart, t, "frames", numFrames, "ring_fill", fill);
+        audioTrace_->counter("ring_fill", "samples", fill);
+    }
+
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    // 📊 LATENCY MEASUREMENT & STATISTICS (10Hz update rate)
+    // 📡 TELEMETRY PUBLICATION (10Hz) - raw counters only, wait-free
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    static int64_t frameCounter = 0;
-    frameCounter += numFrames;
+    // Stream positions are sampled here so they stay consistent with the
+    // ring buffer fill; the math, /proc, logs and JNI run in pollTelemetry().
+    frameCounter_ += numFrames;
+
+    if (frameCounter_ >= backend_->sampleRate() / 10) {
+        frameCounter_ = 0;
+
+        TelemetryCounters counters;
+        counters.timestampNs = backend_->nowNanos();
+        counters.sampleRate = backend_->sampleRate();
+        counters.callbackSize = numFrames;
+        counters.xRunCount = xRunCount_.load(std::memory_order_relaxed);
+        counters.ringBufferSamples = ringBuffer_.availableToRead();
+        counters.timing = backend_->timing();
+        telemetryCounters_.write(counters);
+    }
 
-    if (frameCounter >= stream->getSampleRate() / 10) {
-        frameCounter = 0;
+    return true;
+}
 
-        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-        // 📻 LATENCY MEASUREMENT - Multiple methods for verification
-        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// ==============================================================================
+// 📡 TELEMETRY - Runs on the telemetry thread (or the owner, if disabled)
+// ==============================================================================
 
-        int32_t sampleRate = outputStream->getSampleRate();
-
-        // METHOD 1: Hardware burst latency
-        int32_t inBurst = inputStream->getFramesPerBurst();
-        int32_t outBurst = outputStream->getFramesPerBurst();
-        double burstLatencyMs = ((double)(inBurst + outBurst) / sampleRate) * 1000.0;
-
-        // METHOD 2: Buffer size latency
-        int32_t inBufferSize = inputStream->getBufferSizeInFrames();
-        int32_t outBufferSize = outputStream->getBufferSizeInFrames();
-        double bufferLatencyMs = ((double)(inBufferSize + outBufferSize) / sampleRate) * 1000.0;
-
-        // METHOD 3: Frame position based (most accurate for callback mode)
-        int64_t inFramesWritten = inputStream->getFramesWritten();
-        int64_t inFramesRead = inputStream->getFramesRead();
-        int64_t outFramesWritten = outputStream->getFramesWritten();
-        int64_t outFramesRead = outputStream->getFramesRead();
-
-        int64_t inFramesPending = inFramesWritten - inFramesRead;
-        int64_t outFramesPending = outFramesWritten - outFramesRead;
-
-        double frameBasedInMs = ((double)inFramesPending / sampleRate) * 1000.0;
-        double frameBasedOutMs = ((double)outFramesPending / sampleRate) * 1000.0;
-        double frameBasedLatencyMs = frameBasedInMs + frameBasedOutMs;
-
-        // Ring buffer latency (data waiting to be processed)
-        size_t samplesInRingBuffer = ringBuffer.availableToRead();
-        double ringBufferLatencyMs = ((double)samplesInRingBuffer / sampleRate) * 1000.0;
-
-        // DEBUG: Log all methods every 10 seconds
-        static int debugCounter = 0;
-        if (++debugCounter >= 100) {  // 10 seconds at 10Hz
-            debugCounter = 0;
-            LOGI("🔍 LATENCY DEBUG:");
-            LOGI("  SR=%d | InBurst=%d OutBurst=%d | InBuf=%d OutBuf=%d",
-                 sampleRate, inBurst, outBurst, inBufferSize, outBufferSize);
-            LOGI("  Method1(Burst): %.2fms | Method2(Buffer): %.2fms | Method3(FramePos): %.2fms",
-                 burstLatencyMs, bufferLatencyMs, frameBasedLatencyMs);
-            LOGI("  FramePos Detail: In=%lld/%lld (%.2fms) Out=%lld/%lld (%.2fms)",
-                 (long long)inFramesRead, (long long)inFramesWritten, frameBasedInMs,
-                 (long long)outFramesRead, (long long)outFramesWritten, frameBasedOutMs);
-            LOGI("  RingBuffer: %zu samples = %.2fms", samplesInRingBuffer, ringBufferLatencyMs);
-        }
+bool OboeEngine::pollTelemetry() {
+    TelemetryCounters counters;
+    if (!telemetryCounters_.read(counters) || counters.sampleRate <= 0) return false;
+    const uint64_t pollStart = soundarch::utils::readCycles();
 
-        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-        // 🎯 REAL-TIME LATENCY (what you actually perceive)
-        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-        // Use OUTPUT burst + ring buffer for perceived latency
-        // This represents the actual delay between speaking and hearing processed audio
-        //
-        // Why not input buffer? The input buffer is being filled continuously by the mic,
-        // but we only process what's in the ring buffer. The OUTPUT latency is what you feel.
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 📻 LATENCY MEASUREMENT - Multiple methods for verification
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 
-        double perceivedLatencyMs = burstLatencyMs + ringBufferLatencyMs;
+    const int32_t sampleRate = counters.sampleRate;
+    const soundarch::audio::StreamTiming& timing = counters.timing;
+
+    // METHOD 1: Hardware burst latency
+    int32_t inBurst = timing.inputFramesPerBurst;
+    int32_t outBurst = timing.outputFramesPerBurst;
+    double burstLatencyMs = ((double)(inBurst + outBurst) / sampleRate) * 1000.0;
+
+    // METHOD 2: Buffer size latency
+    int32_t inBufferSize = timing.inputBufferSizeFrames;
+    int32_t outBufferSize = timing.outputBufferSizeFrames;
+    double bufferLatencyMs = ((double)(inBufferSize + outBufferSize) / sampleRate) * 1000.0;
+
+    // METHOD 3: Frame position based (most accurate for callback mode)
+    int64_t inFramesWritten = timing.inputFramesWritten;
+    int64_t inFramesRead = timing.inputFramesRead;
+    int64_t outFramesWritten = timing.outputFramesWritten;
+    int64_t outFramesRead = timing.outputFramesRead;
+
+    int64_t inFramesPending = inFramesWritten - inFramesRead;
+    int64_t outFramesPending = outFramesWritten - outFramesRead;
+
+    double frameBasedInMs = ((double)inFramesPending / sampleRate) * 1000.0;
+    double frameBasedOutMs = ((double)outFramesPending / sampleRate) * 1000.0;
+    double frameBasedLatencyMs = frameBasedInMs + frameBasedOutMs;
+
+    // Ring buffer latency (data waiting to be processed)
+    size_t samplesInRingBuffer = counters.ringBufferSamples;
+    double ringBufferLatencyMs = ((double)samplesInRingBuffer / sampleRate) * 1000.0;
+
+    // DEBUG: Log all methods every 10 seconds
+    if (counters.timestampNs - lastDebugLogNs_ >= 10000000000LL) {
+        lastDebugLogNs_ = counters.timestampNs;
+        LOGI("🔍 LATENCY DEBUG:");
+        LOGI("  SR=%d | InBurst=%d OutBurst=%d | InBuf=%d OutBuf=%d",
+             sampleRate, inBurst, outBurst, inBufferSize, outBufferSize);
+        LOGI("  Method1(Burst): %.2fms | Method2(Buffer): %.2fms | Method3(FramePos): %.2fms",
+             burstLatencyMs, bufferLatencyMs, frameBasedLatencyMs);
+        LOGI("  FramePos Detail: In=%lld/%lld (%.2fms) Out=%lld/%lld (%.2fms)",
+             (long long)inFramesRead, (long long)inFramesWritten, frameBasedInMs,
+             (long long)outFramesRead, (long long)outFramesWritten, frameBasedOutMs);
+        LOGI("  RingBuffer: %zu samples = %.2fms", samplesInRingBuffer, ringBufferLatencyMs);
+
+        const soundarch::utils::StageSummary callback = profiler_.summary(soundarch::utils::Stage::Callback);
+        const soundarch::utils::BudgetSummary budget = profiler_.budget();
+        LOGI("  Callback: p50=%.1fus p99=%.1fus max=%.1fus | Budget p99=%.1f%% | Deadline misses=%llu",
+             callback.p50Ns * 1e-3, callback.p99Ns * 1e-3, callback.maxNs * 1e-3,
+             budget.p99 * 100.0, static_cast<unsigned long long>(budget.deadlineMisses));
+    }
 
-        latencyStats_.inputMs = burstLatencyMs / 2.0;
-        latencyStats_.outputMs = (burstLatencyMs / 2.0) + ringBufferLatencyMs;
-        latencyStats_.totalMs = perceivedLatencyMs;
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🎯 REAL-TIME LATENCY (what you actually perceive)
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // Use OUTPUT burst + ring buffer for perceived latency
+    // This represents the actual delay between speaking and hearing processed audio
+    //
+    // Why not input buffer? The input buffer is being filled continuously by the mic,
+    // but we only process what's in the ring buffer. The OUTPUT latency is what you feel.
 
-        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-        // 📊 PERFORMANCE METRICS - Comprehensive breakdown
-        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-        performanceMetrics_.burstLatencyMs = burstLatencyMs;
-        performanceMetrics_.bufferLatencyMs = bufferLatencyMs;
-        performanceMetrics_.ringBufferLatencyMs = ringBufferLatencyMs;
-        performanceMetrics_.perceivedLatencyMs = perceivedLatencyMs;
-        performanceMetrics_.bluetoothCodecMs = 0.0;  // TODO: Add getter to BluetoothRouter
+    double perceivedLatencyMs = burstLatencyMs + ringBufferLatencyMs;
 
-        performanceMetrics_.inputFramesPending = inFramesPending;
-        performanceMetrics_.outputFramesPending = outFramesPending;
+    latencyStats_.inputMs = burstLatencyMs / 2.0;
+    latencyStats_.outputMs = (burstLatencyMs / 2.0) + ringBufferLatencyMs;
+    latencyStats_.totalMs = perceivedLatencyMs;
 
-        performanceMetrics_.xRunCount = xRunCount_.load(std::memory_order_relaxed);
-        performanceMetrics_.lastCallbackSize = numFrames;
-        performanceMetrics_.bufferFillRatio = (float)ringBuffer.availableToRead() / ringBuffer.capacity();
-        performanceMetrics_.safeModeActive = bluetoothRouter_.isSafeModeActive();
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 📊 PERFORMANCE METRICS - Comprehensive breakdown
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    performanceMetrics_.burstLatencyMs = burstLatencyMs;
+    performanceMetrics_.bufferLatencyMs = bufferLatencyMs;
+    performanceMetrics_.ringBufferLatencyMs = ringBufferLatencyMs;
+    performanceMetrics_.perceivedLatencyMs = perceivedLatencyMs;
+    performanceMetrics_.bluetoothCodecMs = 0.0;  // TODO: Add getter to BluetoothRouter
 
-        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-        // 💻 CPU & RAM MONITORING (1Hz update rate - every second)
-        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-        static int cpuRamCounter = 0;
-        if (++cpuRamCounter >= 10) {  // Every 10 * 100ms = 1 second
-            cpuRamCounter = 0;
-
-            // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-            // 📊 CPU USAGE - Read from /proc/stat
-            // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-            static uint64_t prevTotalCpuTime = 0;
-            static uint64_t prevIdleCpuTime = 0;
-
-            FILE* statFile = fopen("/proc/stat", "r");
-            if (statFile) {
-                char cpuLabel[16];
-                uint64_t user, nice, system, idle, iowait, irq, softirq, steal;
-
-                if (fscanf(statFile, "%s %llu %llu %llu %llu %llu %llu %llu %llu",
-                           cpuLabel, &user, &nice, &system, &idle, &iowait, &irq, &softirq, &steal) == 9) {
-
-                    uint64_t totalCpuTime = user + nice + system + idle + iowait + irq + softirq + steal;
-                    uint64_t idleCpuTime = idle + iowait;
-
-                    if (prevTotalCpuTime > 0) {
-                        uint64_t totalDelta = totalCpuTime - prevTotalCpuTime;
-                        uint64_t idleDelta = idleCpuTime - prevIdleCpuTime;
-
-                        if (totalDelta > 0) {
-                            float cpuUsage = 100.0f * (1.0f - (float)idleDelta / (float)totalDelta);
-                            performanceMetrics_.cpuUsagePercent = cpuUsage;
-                        }
-                    }
-
-                    prevTotalCpuTime = totalCpuTime;
-                    prevIdleCpuTime = idleCpuTime;
-                }
-                fclose(statFile);
-            }
+    performanceMetrics_.inputFramesPending = inFramesPending;
+    performanceMetrics_.outputFramesPending = outFramesPending;
 
-            // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-            // 📊 RAM USAGE - Read from /proc/meminfo
-            // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-            FILE* meminfoFile = fopen("/proc/meminfo", "r");
-            if (meminfoFile) {
-                uint64_t memTotal = 0;
-                uint64_t memAvailable = 0;
-                char line[256];
-
-                while (fgets(line, sizeof(line), meminfoFile)) {
-                    if (sscanf(line, "MemTotal: %llu kB", &memTotal) == 1) {
-                        memTotal *= 1024;  // Convert to bytes
-                    } else if (sscanf(line, "MemAvailable: %llu kB", &memAvailable) == 1) {
-                        memAvailable *= 1024;  // Convert to bytes
-                        break;  // Got both values
-                    }
-                }
-                fclose(meminfoFile);
-
-                if (memTotal > 0 && memAvailable > 0) {
-                    uint64_t memUsed = memTotal - memAvailable;
-                    performanceMetrics_.ramUsedBytes = memUsed;
-                    performanceMetrics_.ramAvailableBytes = memAvailable;
-                    performanceMetrics_.ramUsagePercent = 100.0f * (float)memUsed / (float)memTotal;
-                }
-            }
-        }
+    performanceMetrics_.xRunCount = counters.xRunCount;
+    performanceMetrics_.lastCallbackSize = counters.callbackSize;
+    performanceMetrics_.bufferFillRatio = (float)samplesInRingBuffer / ringBuffer_.capacity();
+    performanceMetrics_.safeModeActive = isSafeModeActive();
 
-        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-        // 🛡️ SAFE MODE: Monitor buffer fill level for underrun prediction
-        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-        float bufferFillRatio = static_cast<float>(ringBuffer.availableToRead()) / ringBuffer.capacity();
-        bluetoothRouter_.updateSafeModeStatus(bufferFillRatio);
-
-        // ✅ EMA SMOOTHING (α = 0.3 for ~5-second window at 10Hz)
-        constexpr double EMA_ALPHA = 0.3;
-        if (latencyStats_.emaMs == 0.0) {
-            latencyStats_.emaMs = latencyStats_.totalMs;  // Initialize on first sample
-        } else {
-            latencyStats_.emaMs = EMA_ALPHA * latencyStats_.totalMs + (1.0 - EMA_ALPHA) * latencyStats_.emaMs;
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 💻 CPU & RAM MONITORING (1Hz, /proc - this is why it is off the audio thread)
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    if (!systemSampled_ || counters.timestampNs - lastSystemSampleNs_ >= 1000000000LL) {
+        systemSampled_ = true;
+        lastSystemSampleNs_ = counters.timestampNs;
+
+        // 📊 CPU USAGE - /proc/stat delta since the previous sample
+        float cpuUsage = 0.0f;
+        if (cpuSampler_.sample(cpuUsage)) {
+            performanceMetrics_.cpuUsagePercent = cpuUsage;
         }
 
-        // ✅ 5-SECOND ROLLING MIN/MAX
-        using namespace std::chrono;
-        int64_t now = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
-
-        // Reset min/max every 5 seconds
-        if (now - latencyStats_.minMaxResetTime > 5000) {
-            latencyStats_.minMs = latencyStats_.totalMs;
-            latencyStats_.maxMs = latencyStats_.totalMs;
-            latencyStats_.minMaxResetTime = now;
-        } else {
-            latencyStats_.minMs = std::min(latencyStats_.minMs, latencyStats_.totalMs);
-            latencyStats_.maxMs = std::max(latencyStats_.maxMs, latencyStats_.totalMs);
+        // 📊 RAM USAGE - /proc/meminfo
+        soundarch::utils::MemoryInfo memory;
+        if (soundarch::utils::readMemoryInfo(memory)) {
+            performanceMetrics_.ramUsedBytes = memory.usedBytes;
+            performanceMetrics_.ramAvailableBytes = memory.availableBytes;
+            performanceMetrics_.ramUsagePercent = memory.usagePercent;
         }
+    }
 
-        // Log breakdown + Bluetooth + Safe Mode for regression detection
-        uint32_t xruns = xRunCount_.load(std::memory_order_relaxed);
-        const char* profile = bluetoothRouter_.isBluetoothActive() ? bluetoothRouter_.getProfileName() : "Wired";
-        const char* safeMode = bluetoothRouter_.isSafeModeActive() ? " [SAFE MODE]" : "";
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🛡️ SAFE MODE: Monitor buffer fill level for underrun prediction
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+#if SOUNDARCH_HAS_BLUETOOTH_ROUTER
+    bluetoothRouter_.updateSafeModeStatus(performanceMetrics_.bufferFillRatio);
+#endif
+    const bool safeModeNow = isSafeModeActive();
+    if (safeModeNow != lastSafeMode_) {
+        lastSafeMode_ = safeModeNow;
+        telemetryTrace_->instant(safeModeNow ? "safe_mode_on" : "safe_mode_off", "fill_permille",
+                                 static_cast<int64_t>(performanceMetrics_.bufferFillRatio * 1000.0f));
+    }
 
-        LOGI("📊 Latency: IN=%.2f | OUT=%.2f | Total=%.2f | EMA=%.2f | Min=%.2f | Max=%.2f | XRuns=%u | CB=%d | %s%s",
-             latencyStats_.inputMs, latencyStats_.outputMs, latencyStats_.totalMs,
-             latencyStats_.emaMs, latencyStats_.minMs, latencyStats_.maxMs, xruns, numFrames,
-             profile, safeMode);
+    // ✅ EMA SMOOTHING (α = 0.3 for ~5-second window at 10Hz)
+    constexpr double EMA_ALPHA = 0.3;
+    if (latencyStats_.emaMs == 0.0) {
+        latencyStats_.emaMs = latencyStats_.totalMs;  // Initialize on first sample
+    } else {
+        latencyStats_.emaMs = EMA_ALPHA * latencyStats_.totalMs + (1.0 - EMA_ALPHA) * latencyStats_.emaMs;
+    }
 
-        // Send smoothed EMA to Java UI
-        sendLatencyToJava(latencyStats_.emaMs);
+    // ✅ 5-SECOND ROLLING MIN/MAX (stream clock: virtual time under simulation)
+    int64_t now = counters.timestampNs / 1000000;
+
+    // Reset min/max every 5 seconds
+    if (now - latencyStats_.minMaxResetTime > 5000) {
+        latencyStats_.minMs = latencyStats_.totalMs;
+        latencyStats_.maxMs = latencyStats_.totalMs;
+        latencyStats_.minMaxResetTime = now;
+    } else {
+        latencyStats_.minMs = std::min(latencyStats_.minMs, latencyStats_.totalMs);
+        latencyStats_.maxMs = std::max(latencyStats_.maxMs, latencyStats_.totalMs);
     }
 
-    return oboe::DataCallbackResult::Continue;
+    // Log breakdown + Bluetooth + Safe Mode for regression detection
+    uint32_t xruns = counters.xRunCount;
+#if SOUNDARCH_HAS_BLUETOOTH_ROUTER
+    const char* profile = bluetoothRouter_.isBluetoothActive() ? bluetoothRouter_.getProfileName() : "Wired";
+#else
+    const char* profile = "Wired";
+#endif
+    const char* safeMode = isSafeModeActive() ? " [SAFE MODE]" : "";
+
+    LOGI("📊 Latency: IN=%.2f | OUT=%.2f | Total=%.2f | EMA=%.2f | Min=%.2f | Max=%.2f | XRuns=%u | CB=%d | %s%s",
+         latencyStats_.inputMs, latencyStats_.outputMs, latencyStats_.totalMs,
+         latencyStats_.emaMs, latencyStats_.minMs, latencyStats_.maxMs, xruns, counters.callbackSize,
+         profile, safeMode);
+
+    // 📸 Publish for JNI / UI readers (single writer: this thread)
+    publishedMetrics_.write({ latencyStats_, performanceMetrics_ });
+
+    // Send smoothed EMA to Java UI
+    if (latencyListener_) latencyListener_(latencyStats_.emaMs);
+
+    telemetryTrace_->complete("telemetry_poll", pollStart, soundarch::utils::readCycles(),
+                              "xruns", static_cast<int64_t>(counters.xRunCount));
+    return true;
+}
+
+void OboeEngine::telemetryLoop() {
+    std::unique_lock<std::mutex> lock(telemetryMutex_);
+    while (!telemetryStop_) {
+        telemetryWake_.wait_for(lock, kTelemetryPollInterval, [this] { return telemetryStop_; });
+        if (telemetryStop_) break;
+
+        lock.unlock();
+        pollTelemetry();
+        lock.lock();
+    }
 }
 
 void OboeEngine::setAudioCallback(std::function<void(float*, float*, int32_t)> cb) noexcept {
@@ -457,9 +460,23 @@ void OboeEngine::setAudioCallback(std::function<void(float*, float*, int32_t)> c
 }
 
 LatencyStats OboeEngine::getLatencyStats() const noexcept {
-    return latencyStats_;  // POD struct, safe to copy
+    return publishedMetrics_.read().latency;
 }
 
 PerformanceMetrics OboeEngine::getPerformanceMetrics() const noexcept {
-    return performanceMetrics_;  // POD struct, safe to copy
+    return publishedMetrics_.read().performance;
+}
+
+EngineMetricsSnapshot OboeEngine::getMetricsSnapshot() const noexcept {
+    const PublishedMetrics published = publishedMetrics_.read();
+
+    EngineMetricsSnapshot snapshot;
+    snapshot.latency = published.latency;
+    snapshot.performance = published.performance;
+    snapshot.xRunCount = xRunCount_.load(std::memory_order_relaxed);
+    snapshot.lastCallbackSize = lastCallbackSize_.load(std::memory_order_relaxed);
+    snapshot.peakDb = peakDb_.load(std::memory_order_relaxed);
+    snapshot.rmsDb = rmsDb_.load(std::memory_order_relaxed);
+    snapshot.telemetryVersion = publishedMetrics_.version();
+    return snapshot;
 }
\ No newline at end of file
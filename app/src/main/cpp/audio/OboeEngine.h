@@ -1,11 +1,29 @@
 #pragma once
 
-#include <oboe/Oboe.h>
 #include <memory>
 #include <cstdint>
 #include <functional>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "AudioBackend.h"
+#include "../utils/RingBuffer.h"
+#include "../utils/SeqLock.h"
+#include "../utils/StageProfiler.h"
+#include "../utils/TraceRecorder.h"
+#include "../utils/SystemStats.h"
+#include "../utils/TripleBuffer.h"
+
+// Set by CMake for the Android build (BluetoothRouter needs Oboe streams)
+#ifndef SOUNDARCH_HAS_BLUETOOTH_ROUTER
+#define SOUNDARCH_HAS_BLUETOOTH_ROUTER 0
+#endif
+
+#if SOUNDARCH_HAS_BLUETOOTH_ROUTER
 #include "BluetoothRouter.h"
+#endif
 
 // ==============================================================================
 // 📊 LATENCY STATISTICS - EMA Smoothing + 5s Min/Max
@@ -51,41 +69,119 @@ struct PerformanceMetrics {
     bool safeModeActive = false;
 };
 
-class OboeEngine : public oboe::AudioStreamCallback {
+// ==============================================================================
+// 📸 METRICS SNAPSHOT - Everything the UI polls, from one consistent instant
+// ==============================================================================
+// latency + performance come from the same telemetry update (seqlock, never
+// torn); the counters and levels below are the live values at read time.
+struct EngineMetricsSnapshot {
+    LatencyStats latency;
+    PerformanceMetrics performance;
+    uint32_t xRunCount = 0;
+    int32_t lastCallbackSize = 0;
+    float peakDb = -60.0f;
+    float rmsDb = -60.0f;
+    uint32_t telemetryVersion = 0;      // Telemetry updates published so far
+};
+
+// ==============================================================================
+// 📡 TELEMETRY COUNTERS - Raw values published by the audio callback (10Hz)
+// ==============================================================================
+// Plain copies of what the callback already has at hand: no math, no syscalls.
+// Everything derived from them (latency breakdown, EMA, min/max, CPU/RAM, logs,
+// Java notification) is computed by the telemetry thread.
+struct TelemetryCounters {
+    int64_t timestampNs = 0;            // Backend clock (virtual under simulation)
+    int32_t sampleRate = 0;
+    int32_t callbackSize = 0;
+    uint32_t xRunCount = 0;
+    size_t ringBufferSamples = 0;       // Input queued in the ring buffer
+    soundarch::audio::StreamTiming timing{};
+};
+
+// ==============================================================================
+// 🎧 OBOE ENGINE - Duplex engine logic on top of a pluggable AudioBackend
+// ==============================================================================
+//
+// The engine (input → ring buffer → DSP callback → output, XRun accounting,
+// metering, latency statistics, Safe Mode) only talks to the device through
+// soundarch::audio::AudioBackend:
+//   - OboeEngine()                 → OboeBackend (Android, real device)
+//   - OboeEngine(std::move(sim))   → SimulatedBackend (host tests, CI)
+//
+// Threads:
+//   - Audio callback: DSP, metering, XRun counters, then publishes
+//     TelemetryCounters into a wait-free triple buffer every 100ms
+//   - Telemetry thread: pollTelemetry() → latency stats, /proc CPU/RAM,
+//     logging, Safe Mode update and the latency listener (JNI upcall)
+//
+// ==============================================================================
+
+class OboeEngine : public soundarch::audio::AudioBackendCallback {
 public:
+    static constexpr size_t kRingBufferSize = 16384;     // ✅ FIX: 4x plus grand pour Bluetooth
+
+#if defined(__ANDROID__)
     OboeEngine() noexcept;
-    ~OboeEngine();
+#endif
+    explicit OboeEngine(std::unique_ptr<soundarch::audio::AudioBackend> backend) noexcept;
+    ~OboeEngine() override;
 
-    void start();
+    bool start();
     void stop();
 
     // 🔧 Injection du traitement DSP temps réel
     void setAudioCallback(std::function<void(float*, float*, int32_t)> cb) noexcept;
 
-    // 🔁 Callback Oboe temps réel (output)
-    oboe::DataCallbackResult onAudioReady(
-            oboe::AudioStream* stream,
-            void* audioData,
-            int32_t numFrames) override;
+    // 📤 Smoothed latency (EMA, ms) published at 10Hz (JNI: sendLatencyToJava)
+    // Called on the telemetry thread, never on the audio thread.
+    void setLatencyListener(void (*listener)(double latencyMs)) noexcept { latencyListener_ = listener; }
 
-    // 📊 Latency monitoring getters (thread-safe)
+    // 📡 Telemetry thread (default on). When disabled before start(), the owner
+    // pumps pollTelemetry() itself - simulated devices do this to stay on the
+    // virtual clock. Never call pollTelemetry() while the thread is running.
+    void setTelemetryThreadEnabled(bool enabled) noexcept { telemetryThreadEnabled_ = enabled; }
+    bool pollTelemetry();
+
+    // 🔁 Backend real-time callback (output)
+    bool onAudioReady(float* output, int32_t numFrames) noexcept override;
+
+    // 📊 Latency monitoring getters (thread-safe, consistent snapshots)
     LatencyStats getLatencyStats() const noexcept;
     PerformanceMetrics getPerformanceMetrics() const noexcept;
+    EngineMetricsSnapshot getMetricsSnapshot() const noexcept;   // Bulk: one call per UI frame
     uint32_t getXRunCount() const noexcept { return xRunCount_.load(std::memory_order_relaxed); }
     int32_t getLastCallbackSize() const noexcept { return lastCallbackSize_.load(std::memory_order_relaxed); }
+    uint32_t getOverflowCount() const noexcept { return overflowCount_.load(std::memory_order_relaxed); }
+    uint32_t getUnderflowCount() const noexcept { return underflowCount_.load(std::memory_order_relaxed); }
 
     // 🎵 Audio stream properties
     float getSampleRate() const noexcept {
-        return outputStream ? static_cast<float>(outputStream->getSampleRate()) : 48000.0f;
+        return backend_->isOpen() ? static_cast<float>(backend_->sampleRate()) : 48000.0f;
     }
     int32_t getBufferSize() const noexcept {
-        return outputStream ? outputStream->getBufferSizeInFrames() : 128;
+        return backend_->isOpen() ? backend_->bufferSizeFrames() : 128;
     }
 
+    soundarch::audio::AudioBackend& backend() noexcept { return *backend_; }
+
+    // ⏱️ Per-stage callback timing (always on, reset by start()). The audio
+    // callback passes it to DSPChain through BlockContext::profiler.
+    soundarch::utils::StageProfiler& profiler() noexcept { return profiler_; }
+    const soundarch::utils::StageProfiler& profiler() const noexcept { return profiler_; }
+
+    // 🎞️ Callback timeline recorder (off until trace().start(); JNI: startTrace/dumpTrace)
+    soundarch::utils::TraceRecorder& trace() noexcept { return trace_; }
+
     // 📻 Bluetooth monitoring getters
+#if SOUNDARCH_HAS_BLUETOOTH_ROUTER
     const soundarch::audio::BluetoothRouter& getBluetoothRouter() const noexcept { return bluetoothRouter_; }
     bool isBluetoothActive() const noexcept { return bluetoothRouter_.isBluetoothActive(); }
     bool isSafeModeActive() const noexcept { return bluetoothRouter_.isSafeModeActive(); }
+#else
+    bool isBluetoothActive() const noexcept { return false; }
+    bool isSafeModeActive() const noexcept { return false; }
+#endif
 
     // 📻 Bluetooth profile update (called from JNI when BluetoothBridge notifies change)
     void updateBluetoothProfile(
@@ -94,7 +190,11 @@ public:
         int sampleRate,
         float estimatedLatencyMs
     ) noexcept {
+#if SOUNDARCH_HAS_BLUETOOTH_ROUTER
         bluetoothRouter_.setActiveProfile(profileName, codecName, sampleRate, estimatedLatencyMs);
+#else
+        (void)profileName; (void)codecName; (void)sampleRate; (void)estimatedLatencyMs;
+#endif
     }
 
     // 📊 Audio levels monitoring (Peak/RMS Meter)
@@ -105,30 +205,88 @@ public:
     float getPeakDb() const noexcept { return peakDb_.load(std::memory_order_relaxed); }
     float getRmsDb() const noexcept { return rmsDb_.load(std::memory_order_relaxed); }
 
+    // 📊 Output levels the audio callback already measured (DSPChain fused
+    // meter): the meter then skips its own pass over the block. Audio
+    // callback only; ignored unless samples covers the whole block.
+    void reportBlockLevels(float peak, float sumSquares, int32_t samples) noexcept {
+        reportedPeak_ = peak;
+        reportedSumSquares_ = sumSquares;
+        reportedSamples_ = samples;
+    }
+
 private:
-    std::shared_ptr<oboe::AudioStream> inputStream;
-    std::shared_ptr<oboe::AudioStream> outputStream;
+    // 🔌 Device (Oboe or simulated)
+    std::unique_ptr<soundarch::audio::AudioBackend> backend_;
 
     // 🧠 Callback DSP passé depuis le code externe
     std::function<void(float*, float*, int32_t)> audioCallback_;
 
+    // 📊 Levels reported by the callback for the current block (audio thread)
+    float reportedPeak_ = 0.0f;
+    float reportedSumSquares_ = 0.0f;
+    int32_t reportedSamples_ = 0;
+    void (*latencyListener_)(double) = nullptr;
+
+    void telemetryLoop();
+
     bool isRecording = false;
-    int64_t lastLogTime = 0;
+    bool audioThreadConfigured_ = false;
 
-    // 📊 Latency statistics (updated at 10Hz)
-    LatencyStats latencyStats_{};
+    // 🔁 Input → output FIFO (SPSC, both ends on the callback thread)
+    RingBuffer<float, kRingBufferSize> ringBuffer_;   // Input is read straight into its storage
+
+    // ✅ FIX: Compteurs de debug
+    std::atomic<uint32_t> overflowCount_{0};
+    std::atomic<uint32_t> underflowCount_{0};
+
+    // ⏱️ 10Hz telemetry publication (callback thread only)
+    int64_t frameCounter_ = 0;
+    soundarch::utils::TripleBuffer<TelemetryCounters> telemetryCounters_;
+
+    // 📡 Telemetry thread
+    static constexpr std::chrono::milliseconds kTelemetryPollInterval{50};  // 2x publication rate
+    bool telemetryThreadEnabled_ = true;
+    std::thread telemetryThread_;
+    std::mutex telemetryMutex_;
+    std::condition_variable telemetryWake_;
+    bool telemetryStop_ = false;
+
+    // Telemetry state (telemetry thread only)
+    int64_t lastDebugLogNs_ = 0;
+    int64_t lastSystemSampleNs_ = 0;
+    bool systemSampled_ = false;
+    soundarch::utils::CpuUsageSampler cpuSampler_;
 
-    // 📊 Performance metrics (updated at 10Hz)
+    // 📊 Latency statistics + performance metrics (telemetry thread working copies, 10Hz)
+    LatencyStats latencyStats_{};
     PerformanceMetrics performanceMetrics_{};
 
+    // 📸 Published copy for every other thread (written once per telemetry update)
+    struct PublishedMetrics {
+        LatencyStats latency;
+        PerformanceMetrics performance;
+    };
+    soundarch::utils::SeqLock<PublishedMetrics> publishedMetrics_;
+
+    // 🎞️ Trace tracks (declared before profiler_, which emits into audioTrace_)
+    soundarch::utils::TraceRecorder trace_;
+    soundarch::utils::TraceTrack* audioTrace_ = nullptr;
+    soundarch::utils::TraceTrack* telemetryTrace_ = nullptr;
+    bool lastSafeMode_ = false;   // Telemetry thread: Safe Mode transition detection
+
+    // ⏱️ Stage histograms (written by the audio callback only)
+    soundarch::utils::StageProfiler profiler_;
+
     // ⚠️ XRun tracking (overflow + underflow)
     std::atomic<uint32_t> xRunCount_{0};
 
     // 📏 Callback size tracking (for correlation with XRuns)
     std::atomic<int32_t> lastCallbackSize_{0};
 
+#if SOUNDARCH_HAS_BLUETOOTH_ROUTER
     // 📻 Bluetooth profile router (profile detection + Safe Mode)
     soundarch::audio::BluetoothRouter bluetoothRouter_{48000.0f};  // Default SR, updated in start()
+#endif
 
     // 📊 Audio levels (Peak/RMS) - Lock-free atomics
     // ✅ IMPLEMENTED: Updated in onAudioReady() every audio block with EMA smoothing
@@ -0,0 +1,202 @@
+#include "SimulatedBackend.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace soundarch::audio {
+
+    namespace {
+
+        // Copies n frames to/from a circular buffer at absolute position pos (two spans max)
+        void copyCircular(float* ring, int64_t capacity, int64_t pos, float* linear, int32_t n, bool toRing) noexcept {
+            const auto start = static_cast<size_t>(pos % capacity);
+            const size_t first = std::min(static_cast<size_t>(n), static_cast<size_t>(capacity) - start);
+            const size_t second = static_cast<size_t>(n) - first;
+            if (toRing) {
+                std::memcpy(ring + start, linear, first * sizeof(float));
+                std::memcpy(ring, linear + first, second * sizeof(float));
+            } else {
+                std::memcpy(linear, ring + start, first * sizeof(float));
+                std::memcpy(linear + first, ring, second * sizeof(float));
+            }
+        }
+
+    } // namespace
+
+    SimulatedBackend::SimulatedBackend(const SimulatedDeviceConfig& config)
+            : config_(config) {
+        config_.framesPerBurst = std::max(1, config_.framesPerBurst);
+        config_.bufferSizeBursts = std::max(1, config_.bufferSizeBursts);
+        if (config_.callbackFrames <= 0) config_.callbackFrames = config_.framesPerBurst;
+        if (config_.inputCapacityFrames <= 0) config_.inputCapacityFrames = 8 * config_.framesPerBurst;
+
+        bufferCapacity_ = config_.framesPerBurst * config_.bufferSizeBursts;
+        config_.callbackFrames = std::min(config_.callbackFrames, bufferCapacity_);
+
+        captureFifo_.assign(static_cast<size_t>(config_.inputCapacityFrames), 0.0f);
+        scratch_.assign(static_cast<size_t>(std::max(bufferCapacity_, config_.inputCapacityFrames)), 0.0f);
+
+        // Default capture signal: 1 kHz sine at -20 dBFS (one exact period, tabulated)
+        const int32_t period = config_.sampleRate / std::gcd(config_.sampleRate, 1000);
+        std::vector<float> sine(static_cast<size_t>(period));
+        for (int32_t i = 0; i < period; ++i) {
+            sine[static_cast<size_t>(i)] = static_cast<float>(
+                    0.1 * std::sin(6.283185307179586 * 1000.0 * i / config_.sampleRate));
+        }
+        inputSource_ = [sine = std::move(sine)](float* dst, int32_t frames, int64_t firstFrame) {
+            const size_t n = sine.size();
+            size_t index = static_cast<size_t>(firstFrame % static_cast<int64_t>(n));
+            for (int32_t i = 0; i < frames; ++i) {
+                dst[i] = sine[index];
+                if (++index == n) index = 0;
+            }
+        };
+    }
+
+    bool SimulatedBackend::open(AudioBackendCallback* callback) {
+        callback_ = callback;
+        running_ = false;
+
+        const double outputRate = config_.sampleRate * (1.0 + config_.outputDriftPpm * 1e-6);
+        const double inputRate = config_.sampleRate * (1.0 + config_.inputDriftPpm * 1e-6);
+        outputPeriodNs_ = config_.framesPerBurst * 1e9 / outputRate;
+        inputFramesPerNs_ = inputRate / 1e9;
+
+        queuedFrames_ = 0;
+        period_ = 0;
+        nowNs_ = 0;
+        captureHead_ = captureTail_ = 0;
+        rng_ = config_.seed ? config_.seed : 1u;
+        stats_ = SimulatedDeviceStats{};
+        pendingRequest_ = nextRequestSize();
+        return callback_ != nullptr;
+    }
+
+    bool SimulatedBackend::start() {
+        running_ = callback_ != nullptr;
+        return running_;
+    }
+
+    void SimulatedBackend::stop() {
+        running_ = false;
+        callback_ = nullptr;
+    }
+
+    bool SimulatedBackend::advance(double seconds) {
+        const int64_t endNs = nowNs_ + static_cast<int64_t>(seconds * 1e9);
+        while (running_) {
+            // Absolute period times: no accumulated rounding error over hours
+            const auto periodNs = static_cast<int64_t>(static_cast<double>(period_) * outputPeriodNs_);
+            if (periodNs > endNs) break;
+            nowNs_ = periodNs;
+            runPeriod();
+            ++period_;
+        }
+        nowNs_ = std::max(nowNs_, endNs);
+        stats_.virtualSeconds = static_cast<double>(nowNs_) * 1e-9;
+        return running_;
+    }
+
+    void SimulatedBackend::runPeriod() {
+        const int32_t burst = config_.framesPerBurst;
+
+        // 1️⃣ Playback consumes one burst (period 0 = stream start, nothing to play yet)
+        if (period_ > 0) {
+            if (queuedFrames_ >= burst) {
+                queuedFrames_ -= burst;
+            } else {
+                queuedFrames_ = 0;
+                ++stats_.outputUnderruns;
+            }
+            stats_.outputFramesRead += burst;
+        }
+
+        // 2️⃣ Capture catches up with its own clock
+        produceInput(static_cast<int64_t>(static_cast<double>(nowNs_) * inputFramesPerNs_));
+
+        // 3️⃣ Callback thread refills the output buffer (unless stalled)
+        if (isStalled(static_cast<double>(nowNs_) * 1e-9)) {
+            ++stats_.stalledPeriods;
+            return;
+        }
+
+        while (running_ && queuedFrames_ + pendingRequest_ <= bufferCapacity_) {
+            const int32_t frames = pendingRequest_;
+            float* out = scratch_.data();
+
+            running_ = callback_->onAudioReady(out, frames);
+            if (outputSink_) outputSink_(out, frames);
+
+            queuedFrames_ += frames;
+            stats_.outputFramesWritten += frames;
+            if (stats_.callbacks == 0 || frames < stats_.minCallbackFrames) stats_.minCallbackFrames = frames;
+            if (frames > stats_.maxCallbackFrames) stats_.maxCallbackFrames = frames;
+            ++stats_.callbacks;
+
+            pendingRequest_ = nextRequestSize();
+        }
+    }
+
+    void SimulatedBackend::produceInput(int64_t targetFrames) {
+        const int64_t capacity = config_.inputCapacityFrames;
+        float* generated = scratch_.data();
+
+        while (captureHead_ < targetFrames) {
+            const auto n = static_cast<int32_t>(std::min<int64_t>(targetFrames - captureHead_, capacity));
+            inputSource_(generated, n, captureHead_);
+
+            copyCircular(captureFifo_.data(), capacity, captureHead_, generated, n, true);
+            captureHead_ += n;
+
+            // Reader too slow: oldest frames are overwritten
+            if (captureHead_ - captureTail_ > capacity) {
+                captureTail_ = captureHead_ - capacity;
+                ++stats_.inputOverruns;
+            }
+        }
+        stats_.inputFramesWritten = captureHead_;
+    }
+
+    int32_t SimulatedBackend::readInput(float* dst, int32_t numFrames) noexcept {
+        const int64_t capacity = config_.inputCapacityFrames;
+        const auto n = static_cast<int32_t>(std::min<int64_t>(numFrames, captureHead_ - captureTail_));
+        copyCircular(captureFifo_.data(), capacity, captureTail_, dst, n, false);
+        captureTail_ += n;
+        stats_.inputFramesRead += n;
+        return n;
+    }
+
+    StreamTiming SimulatedBackend::timing() const noexcept {
+        StreamTiming t;
+        t.inputFramesPerBurst = config_.framesPerBurst;
+        t.outputFramesPerBurst = config_.framesPerBurst;
+        t.inputBufferSizeFrames = config_.inputCapacityFrames;
+        t.outputBufferSizeFrames = bufferCapacity_;
+        t.inputFramesWritten = stats_.inputFramesWritten;
+        t.inputFramesRead = stats_.inputFramesRead;
+        t.outputFramesWritten = stats_.outputFramesWritten;
+        t.outputFramesRead = stats_.outputFramesRead;
+        return t;
+    }
+
+    int32_t SimulatedBackend::nextRequestSize() noexcept {
+        const int32_t jitter = config_.callbackJitterFrames;
+        if (jitter <= 0) return config_.callbackFrames;
+
+        // xorshift32: deterministic for a given seed
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 17;
+        rng_ ^= rng_ << 5;
+        const int32_t offset = static_cast<int32_t>(rng_ % static_cast<uint32_t>(2 * jitter + 1)) - jitter;
+        return std::clamp(config_.callbackFrames + offset, 1, bufferCapacity_);
+    }
+
+    bool SimulatedBackend::isStalled(double seconds) const noexcept {
+        for (const auto& stall : config_.stalls) {
+            if (seconds >= stall.atSeconds && seconds < stall.atSeconds + stall.durationMs * 1e-3) return true;
+        }
+        return false;
+    }
+
+} // namespace soundarch::audio
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "AudioBackend.h"
+
+namespace soundarch::audio {
+
+// ==============================================================================
+// 🧪 SIMULATED BACKEND - Deterministic virtual audio device (host / CI)
+// ==============================================================================
+//
+// Drives OboeEngine callbacks from a virtual clock instead of hardware, so
+// scheduling, XRun and buffering behaviour can be reproduced on Linux at
+// thousands of times real time, bit-for-bit identical from run to run.
+//
+// Model (one step per output hardware period = framesPerBurst frames):
+//   1. Playback consumes one burst from the output buffer
+//      → fewer than a burst queued = output underrun (audible glitch)
+//   2. Capture produces frames up to "now" on its own (drifting) clock
+//      → capture FIFO full = input overrun (oldest frames lost)
+//   3. Unless a stall is in progress, the callback runs while a whole
+//      request (callbackFrames ± jitter) still fits in the output buffer
+//      → after a stall it runs back-to-back to catch up, like a real
+//        audio thread that got preempted
+//
+// Nothing runs on its own: start() arms the device, advance() moves the
+// virtual clock forward and invokes callbacks on the calling thread.
+//
+// ==============================================================================
+
+    struct SimulatedStall {
+        double atSeconds = 0.0;     // Virtual time the callback thread stops running
+        double durationMs = 0.0;    // How long it stays blocked
+    };
+
+    struct SimulatedDeviceConfig {
+        int32_t sampleRate = 48000;
+        int32_t framesPerBurst = 192;        // Hardware period
+        int32_t bufferSizeBursts = 2;        // Output buffer (OboeBackend uses 2x burst)
+        int32_t callbackFrames = 0;          // Nominal callback size, 0 = framesPerBurst
+        int32_t callbackJitterFrames = 0;    // Each request = callbackFrames ± U[0, jitter]
+        int32_t inputCapacityFrames = 0;     // Capture FIFO, 0 = 8 x framesPerBurst
+        double inputDriftPpm = 0.0;          // Capture clock error (+ = faster than nominal)
+        double outputDriftPpm = 0.0;         // Playback clock error
+        std::vector<SimulatedStall> stalls;
+        uint32_t seed = 0x5EED1234u;         // Jitter PRNG
+    };
+
+    struct SimulatedDeviceStats {
+        uint64_t callbacks = 0;
+        int32_t minCallbackFrames = 0;
+        int32_t maxCallbackFrames = 0;
+        uint64_t outputUnderruns = 0;        // Hardware periods that played silence
+        uint64_t inputOverruns = 0;          // Capture FIFO overflows
+        uint64_t stalledPeriods = 0;         // Hardware periods with the callback blocked
+        int64_t inputFramesWritten = 0;
+        int64_t inputFramesRead = 0;
+        int64_t outputFramesWritten = 0;
+        int64_t outputFramesRead = 0;
+        double virtualSeconds = 0.0;
+    };
+
+    class SimulatedBackend final : public AudioBackend {
+    public:
+        // dst[frames] ← capture signal starting at absolute frame firstFrame
+        using InputSource = std::function<void(float* dst, int32_t frames, int64_t firstFrame)>;
+        // Every frame the callback produced, in order
+        using OutputSink = std::function<void(const float* src, int32_t frames)>;
+
+        explicit SimulatedBackend(const SimulatedDeviceConfig& config = {});
+
+        void setInputSource(InputSource source) { inputSource_ = std::move(source); }
+        void setOutputSink(OutputSink sink) { outputSink_ = std::move(sink); }
+
+        /**
+         * Advances the virtual clock, running every hardware period and
+         * callback that falls inside the interval.
+         * @return false once the stream is stopped (callback returned false)
+         */
+        bool advance(double seconds);
+
+        const SimulatedDeviceStats& stats() const noexcept { return stats_; }
+        const SimulatedDeviceConfig& config() const noexcept { return config_; }
+
+        // AudioBackend
+        const char* name() const noexcept override { return "Simulated"; }
+        bool open(AudioBackendCallback* callback) override;
+        bool start() override;
+        void stop() override;
+        int32_t readInput(float* dst, int32_t numFrames) noexcept override;
+        int32_t sampleRate() const noexcept override { return config_.sampleRate; }
+        int32_t channelCount() const noexcept override { return 1; }
+        int32_t framesPerBurst() const noexcept override { return config_.framesPerBurst; }
+        int32_t bufferSizeFrames() const noexcept override { return bufferCapacity_; }
+        bool isOpen() const noexcept override { return callback_ != nullptr; }
+        StreamTiming timing() const noexcept override;
+        int64_t nowNanos() const noexcept override { return nowNs_; }
+
+    private:
+        void runPeriod();
+        void produceInput(int64_t targetFrames);
+        int32_t nextRequestSize() noexcept;
+        bool isStalled(double seconds) const noexcept;
+
+        SimulatedDeviceConfig config_;
+        AudioBackendCallback* callback_ = nullptr;
+        InputSource inputSource_;
+        OutputSink outputSink_;
+        bool running_ = false;
+
+        int32_t bufferCapacity_ = 0;         // Output buffer, frames
+        int32_t queuedFrames_ = 0;           // Output frames waiting to be played
+        int32_t pendingRequest_ = 0;         // Size of the next callback
+        double outputPeriodNs_ = 0.0;
+        double inputFramesPerNs_ = 0.0;
+        int64_t period_ = 0;                 // Hardware periods elapsed
+        int64_t nowNs_ = 0;
+        uint32_t rng_ = 0;
+
+        // Capture FIFO (preallocated; readInput() never allocates)
+        std::vector<float> captureFifo_;
+        int64_t captureHead_ = 0;            // Total frames written
+        int64_t captureTail_ = 0;            // Total frames read or dropped
+        std::vector<float> scratch_;         // Callback output / generated input
+
+        SimulatedDeviceStats stats_;
+    };
+
+} // namespace soundarch::audio
@@ -0,0 +1,69 @@
+#include "SoundArchEngine.h"
+#include "EngineContext.h"
+
+// Opaque handle = the context itself, nothing else shared
+struct SoundArchEngine {
+    explicit SoundArchEngine(float sampleRate) : context(sampleRate) {}
+    SoundArchEngine(float sampleRate, std::unique_ptr<OboeEngine> engine)
+            : context(sampleRate, std::move(engine)) {}
+
+    soundarch::EngineContext context;
+};
+
+using soundarch::EngineContext;
+
+extern "C" {
+
+SoundArchEngine* soundarch_engine_create(float sampleRate, uint32_t flags) {
+    if (!(sampleRate > 0.0f)) return nullptr;
+    if (flags & SOUNDARCH_ENGINE_LIVE) {
+#if defined(__ANDROID__)
+        return new SoundArchEngine(sampleRate, std::make_unique<OboeEngine>());
+#else
+        return nullptr;   // Host: build a live EngineContext on a SimulatedBackend instead
+#endif
+    }
+    return new SoundArchEngine(sampleRate);
+}
+
+void soundarch_engine_destroy(SoundArchEngine* engine) {
+    delete engine;
+}
+
+int soundarch_engine_start(SoundArchEngine* engine) {
+    return engine && engine->context.start() ? 1 : 0;
+}
+
+void soundarch_engine_stop(SoundArchEngine* engine) {
+    if (engine) engine->context.stop();
+}
+
+int soundarch_engine_process(SoundArchEngine* engine, float* buffer, int32_t numFrames) {
+    // A live handle's chain belongs to its device callback
+    if (!engine || engine->context.isLive() || !buffer || numFrames <= 0) return 0;
+    engine->context.process(buffer, numFrames);
+    return 1;
+}
+
+int soundarch_engine_set_param(SoundArchEngine* engine, uint32_t param, float value) {
+    if (!engine || param >= soundarch::dsp::kParamCount) return 0;
+    engine->context.setParameter(static_cast<soundarch::dsp::Param>(param), value);
+    return 1;
+}
+
+int soundarch_engine_set_module_enabled(SoundArchEngine* engine, uint32_t module, int enabled) {
+    if (!engine || module >= soundarch::dsp::kModuleSwitchCount) return 0;
+    engine->context.setModuleEnabled(static_cast<soundarch::dsp::ModuleSwitch>(module), enabled != 0);
+    return 1;
+}
+
+void* soundarch_engine_shared_block(SoundArchEngine* engine, size_t* sizeBytes) {
+    if (sizeBytes) *sizeBytes = engine ? soundarch::dsp::SharedControlBlock::sizeBytes() : 0;
+    return engine ? engine->context.sharedControl().data() : nullptr;
+}
+
+uint64_t soundarch_engine_processed_frames(const SoundArchEngine* engine) {
+    return engine ? engine->context.processedFrames() : 0;
+}
+
+} // extern "C"
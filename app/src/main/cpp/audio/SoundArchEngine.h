@@ -0,0 +1,63 @@
+#ifndef SOUNDARCH_ENGINE_H
+#define SOUNDARCH_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ==============================================================================
+// 🧳 SOUNDARCH ENGINE - C ABI over soundarch::EngineContext
+// ==============================================================================
+//
+// Opaque handle, one complete engine per handle (see audio/EngineContext.h).
+// Handles share no mutable state: create as many as needed and drive each
+// from its own thread (live session + offline renders on other cores).
+//
+//   SoundArchEngine* e = soundarch_engine_create(48000.0f, 0);
+//   soundarch_engine_set_param(e, 7, -30.0f);        // CompressorThreshold
+//   soundarch_engine_process(e, buffer, 192);       // In-place, mono float
+//   soundarch_engine_destroy(e);
+//
+// Parameter ids: dsp::Param ordinals (dsp/ParameterQueue.h).
+// Module ids:    dsp::ModuleSwitch ordinals (dsp/SharedControlBlock.h).
+//
+// Every call accepts a null handle (no-op, returns 0 / failure).
+// Thread Safety: per handle, process() from one thread at a time;
+// set_param()/set_module_enabled() from any thread.
+//
+// ==============================================================================
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SoundArchEngine SoundArchEngine;
+
+enum {
+    SOUNDARCH_ENGINE_LIVE = 1u << 0    // Opens the audio device (Android builds only)
+};
+
+// Null on failure (live requested where no device backend exists)
+SoundArchEngine* soundarch_engine_create(float sampleRate, uint32_t flags);
+void soundarch_engine_destroy(SoundArchEngine* engine);
+
+// Live handles: 1 on success
+int soundarch_engine_start(SoundArchEngine* engine);
+void soundarch_engine_stop(SoundArchEngine* engine);
+
+// Offline handles: processes numFrames mono samples in place. 1 on success
+int soundarch_engine_process(SoundArchEngine* engine, float* buffer, int32_t numFrames);
+
+// 1 if the id is valid (the value is applied at the next block)
+int soundarch_engine_set_param(SoundArchEngine* engine, uint32_t param, float value);
+int soundarch_engine_set_module_enabled(SoundArchEngine* engine, uint32_t module, int enabled);
+
+// Shared control block (parameters in, meters out); size written to *sizeBytes
+void* soundarch_engine_shared_block(SoundArchEngine* engine, size_t* sizeBytes);
+
+uint64_t soundarch_engine_processed_frames(const SoundArchEngine* engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SOUNDARCH_ENGINE_H
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// ==============================================================================
+// ⏱️ HOST BENCHMARK HARNESS - Timing, test signals and JSON output
+// ==============================================================================
+//
+// Shared by the host benchmark executables in bench/. Everything here runs on
+// the host only (never linked into libsoundarch.so), so it is free to allocate.
+//
+// Measurement model:
+//   - A "kernel" processes one block of blockSize samples
+//   - Each repetition runs the kernel until at least minSeconds of wall time
+//   - The reported figure is the MEDIAN repetition (robust to scheduler noise)
+//
+// Output: one JSON document per run. Keys are stable so CI can diff results
+// between commits and flag throughput regressions.
+//
+// ==============================================================================
+
+namespace soundarch::bench {
+
+    struct Measurement {
+        double nsPerSample = 0.0;
+        double samplesPerSec = 0.0;
+        double realtimeFactor = 0.0;   // Audio seconds processed per wall second
+        uint64_t samples = 0;          // Samples processed in the median repetition
+    };
+
+    struct TimingConfig {
+        double minSeconds = 0.02;      // Wall time per repetition
+        int repetitions = 5;
+        int warmupBlocks = 64;
+    };
+
+    /**
+     * Prevents the optimizer from discarding benchmark results.
+     */
+    inline void doNotOptimize(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __asm__ __volatile__("" : : "g"(p) : "memory");
+#else
+        static const void* volatile sink;
+        sink = p;
+#endif
+    }
+
+    /**
+     * Times kernel(offset) repeatedly. The kernel processes blockSize samples per
+     * call; offset lets it walk through a longer test signal.
+     */
+    template<typename Kernel>
+    Measurement measure(Kernel&& kernel, int blockSize, float sampleRate, const TimingConfig& cfg) {
+        using Clock = std::chrono::steady_clock;
+
+        for (int i = 0; i < cfg.warmupBlocks; ++i) {
+            kernel(i);
+        }
+
+        std::vector<Measurement> reps;
+        reps.reserve(static_cast<size_t>(cfg.repetitions));
+
+        int call = cfg.warmupBlocks;
+        for (int r = 0; r < cfg.repetitions; ++r) {
+            uint64_t blocks = 0;
+            const auto start = Clock::now();
+            double elapsed = 0.0;
+
+            // Check the clock every 16 blocks to keep timer overhead off tiny blocks
+            do {
+                for (int i = 0; i < 16; ++i) {
+                    kernel(call++);
+                }
+                blocks += 16;
+                elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            } while (elapsed < cfg.minSeconds);
+
+            Measurement m;
+            m.samples = blocks * static_cast<uint64_t>(blockSize);
+            m.nsPerSample = elapsed * 1e9 / static_cast<double>(m.samples);
+            m.samplesPerSec = static_cast<double>(m.samples) / elapsed;
+            m.realtimeFactor = m.samplesPerSec / sampleRate;
+            reps.push_back(m);
+        }
+
+        std::sort(reps.begin(), reps.end(), [](const Measurement& a, const Measurement& b) {
+            return a.nsPerSample < b.nsPerSample;
+        });
+        return reps[reps.size() / 2];
+    }
+
+    /**
+     * Deterministic speech-like test signal: band-limited noise + two partials,
+     * amplitude-modulated at a syllable rate (~4 Hz), normalized to rmsDb.
+     */
+    inline std::vector<float> makeTestSignal(size_t numSamples, float sampleRate, float rmsDb,
+                                             uint32_t seed = 0x5EED1234u) {
+        std::vector<float> signal(numSamples);
+        uint32_t state = seed;
+        float lowpass = 0.0f;
+
+        constexpr double kTwoPi = 6.283185307179586;
+        for (size_t i = 0; i < numSamples; ++i) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            const float noise = static_cast<float>(state) / 4294967295.0f * 2.0f - 1.0f;
+            lowpass += 0.25f * (noise - lowpass);
+
+            const double t = static_cast<double>(i) / sampleRate;
+            const float tone = 0.6f * static_cast<float>(std::sin(kTwoPi * 220.0 * t))
+                               + 0.3f * static_cast<float>(std::sin(kTwoPi * 1330.0 * t));
+            const float envelope = 0.55f + 0.45f * static_cast<float>(std::sin(kTwoPi * 4.0 * t));
+            signal[i] = envelope * (tone + 0.5f * lowpass);
+        }
+
+        double sumSquares = 0.0;
+        for (float s : signal) sumSquares += static_cast<double>(s) * s;
+        const double rms = std::sqrt(sumSquares / static_cast<double>(std::max<size_t>(numSamples, 1)));
+        const double scale = (rms > 0.0) ? std::pow(10.0, rmsDb / 20.0) / rms : 0.0;
+        for (float& s : signal) s = static_cast<float>(s * scale);
+
+        return signal;
+    }
+
+    inline std::vector<int> blockSizes(int minBlock, int maxBlock) {
+        std::vector<int> sizes;
+        for (int b = minBlock; b <= maxBlock; b *= 2) {
+            sizes.push_back(b);
+        }
+        return sizes;
+    }
+
+    inline const char* hostArchitecture() noexcept {
+#if defined(__aarch64__)
+        return "aarch64";
+#elif defined(__x86_64__)
+        return "x86_64";
+#elif defined(__arm__)
+        return "arm";
+#elif defined(__i386__)
+        return "x86";
+#else
+        return "unknown";
+#endif
+    }
+
+    inline std::string compilerId() {
+        char buf[64];
+#if defined(__clang__)
+        std::snprintf(buf, sizeof(buf), "clang %d.%d.%d", __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+        std::snprintf(buf, sizeof(buf), "gcc %d.%d.%d", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#else
+        std::snprintf(buf, sizeof(buf), "unknown");
+#endif
+        return buf;
+    }
+
+    /**
+     * Minimal streaming JSON writer (objects, arrays, scalars). No escaping
+     * beyond quotes/backslashes: benchmark keys and labels are ASCII identifiers.
+     */
+    class JsonWriter {
+    public:
+        explicit JsonWriter(FILE* out) : out_(out) {}
+
+        void beginObject(const char* key = nullptr) { open(key, '{'); }
+        void endObject() { close('}'); }
+        void beginArray(const char* key = nullptr) { open(key, '['); }
+        void endArray() { close(']'); }
+
+        void field(const char* key, const std::string& value) {
+            prefix(key);
+            std::fputc('"', out_);
+            for (char c : value) {
+                if (c == '"' || c == '\\') std::fputc('\\', out_);
+                std::fputc(c, out_);
+            }
+            std::fputc('"', out_);
+        }
+        void field(const char* key, const char* value) { field(key, std::string(value)); }
+        void field(const char* key, double value) {
+            prefix(key);
+            if (std::isfinite(value)) {
+                std::fprintf(out_, "%.6g", value);
+            } else {
+                std::fputs("null", out_);
+            }
+        }
+        void field(const char* key, int value) { prefix(key); std::fprintf(out_, "%d", value); }
+        void field(const char* key, uint64_t value) {
+            prefix(key);
+            std::fprintf(out_, "%llu", static_cast<unsigned long long>(value));
+        }
+        void field(const char* key, bool value) { prefix(key); std::fputs(value ? "true" : "false", out_); }
+
+        void finish() { std::fputc('\n', out_); std::fflush(out_); }
+
+    private:
+        void prefix(const char* key) {
+            if (!first_.empty()) {
+                if (!first_.back()) std::fputc(',', out_);
+                first_.back() = false;
+                std::fputc('\n', out_);
+                for (size_t i = 0; i < first_.size(); ++i) std::fputs("  ", out_);
+            }
+            if (key) std::fprintf(out_, "\"%s\": ", key);
+        }
+        void open(const char* key, char bracket) {
+            prefix(key);
+            std::fputc(bracket, out_);
+            first_.push_back(true);
+        }
+        void close(char bracket) {
+            const bool empty = first_.back();
+            first_.pop_back();
+            if (!empty) {
+                std::fputc('\n', out_);
+                for (size_t i = 0; i < first_.size(); ++i) std::fputs("  ", out_);
+            }
+            std::fputc(bracket, out_);
+        }
+
+        FILE* out_;
+        std::vector<bool> first_;
+    };
+
+    inline void writeMeasurement(JsonWriter& json, const Measurement& m) {
+        json.field("ns_per_sample", m.nsPerSample);
+        json.field("samples_per_sec", m.samplesPerSec);
+        json.field("realtime_factor", m.realtimeFactor);
+        json.field("samples", m.samples);
+    }
+
+} // namespace soundarch::bench
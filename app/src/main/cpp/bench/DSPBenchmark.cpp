@@ -0,0 +1,387 @@
+// ==============================================================================
+// SoundArch DSP Microbenchmark - per-module throughput on the host
+// ==============================================================================
+//
+// Runs AGC / Equalizer / Compressor / Limiter processBlock() for every
+// parameter regime across block sizes 16..4096 (plus the whole DSPChain,
+// multi-pass vs fused, module "Chain", and the fast-math kernels against
+// libm, module "FastMath") and prints one JSON document:
+//
+//   {
+//     "schema": "soundarch-dsp-bench/1",
+//     "host": { "arch": "aarch64", "compiler": "...", "build_type": "Release" },
+//     "sample_rate": 48000,
+//     "results": [
+//       { "module": "Compressor", "regime": "rms_compressing", "block_size": 256,
+//         "ns_per_sample": 4.1, "samples_per_sec": 2.4e8, "realtime_factor": 5080, ... }
+//     ]
+//   }
+//
+// --counters (Linux) adds hardware counters to every result, measured in a
+// separate run so the timing figures are unaffected:
+//
+//   "counters": { "blocks": 1365,
+//                 "per_block":  { "cycles": 2.1e4, "instructions": 5.3e4, "l1d_misses": 12, ... },
+//                 "per_sample": { "cycles": 109, ... }, "ipc": 2.5, "multiplex_ratio": 1 }
+//
+// Usage:
+//   soundarch_dsp_bench [--module NAME] [--regime NAME] [--min-block N]
+//                       [--max-block N] [--sample-rate HZ] [--min-time SEC]
+//                       [--reps N] [--counters] [--counter-samples N]
+//                       [--quick] [--list] [--output FILE]
+//
+// ==============================================================================
+
+#include "BenchmarkHarness.h"
+#include "PerfCounters.h"
+
+#include "dsp/AGC.h"
+#include "dsp/Compressor.h"
+#include "dsp/DSPChain.h"
+#include "dsp/Equalizer.h"
+#include "dsp/FastMath.h"
+#include "dsp/Limiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+#ifndef SOUNDARCH_BUILD_TYPE
+#define SOUNDARCH_BUILD_TYPE "unknown"
+#endif
+
+using namespace soundarch;
+
+namespace {
+
+    using BlockProcessor = std::function<void(const float*, float*, int)>;
+
+    struct BenchCase {
+        const char* module;
+        const char* regime;
+        float inputRmsDb;                                   // Test signal level
+        std::function<BlockProcessor(float sampleRate)> create;
+    };
+
+    template<typename Module>
+    BlockProcessor wrap(std::shared_ptr<Module> m) {
+        return [m](const float* in, float* out, int n) { m->processBlock(in, out, n); };
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🎛️ PARAMETER REGIMES - each one exercises a different code path
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    std::vector<BenchCase> makeCases() {
+        std::vector<BenchCase> cases;
+
+        // AGC: production config from startAudio(), gate vs tracking, short vs long window
+        auto agc = [](float sr, float windowSeconds, int controlInterval = 1) {
+            auto m = std::make_shared<dsp::AGC>(sr);
+            m->setTargetLevel(-20.0f);
+            m->setMaxGain(25.0f);
+            m->setMinGain(-10.0f);
+            m->setAttackTime(0.1f);
+            m->setReleaseTime(0.5f);
+            m->setNoiseThreshold(-55.0f);
+            m->setWindowSize(windowSeconds);
+            m->setControlInterval(controlInterval);
+            return m;
+        };
+        cases.push_back({"AGC", "gated", -70.0f, [agc](float sr) { return wrap(agc(sr, 0.1f)); }});
+        cases.push_back({"AGC", "tracking", -30.0f, [agc](float sr) { return wrap(agc(sr, 0.1f)); }});
+        cases.push_back({"AGC", "tracking_window_2s", -30.0f, [agc](float sr) { return wrap(agc(sr, 2.0f)); }});
+        cases.push_back({"AGC", "tracking_control_32", -30.0f, [agc](float sr) { return wrap(agc(sr, 0.1f, 32)); }});
+
+        // Equalizer: flat vs shaped vs all bands boosted (best cascade kernel),
+        // then the voice curve on every kernel this CPU runs
+        auto eq = [](float sr, const float* gains, dsp::CascadeKernel kernel = dsp::BiquadCascade::bestKernel()) {
+            auto m = std::make_shared<dsp::Equalizer>(sr);
+            m->setCascadeKernel(kernel);
+            for (int b = 0; b < dsp::Equalizer::kNumBands; ++b) m->setBandGain(b, gains[b]);
+            return m;
+        };
+        static const float kFlat[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+        static const float kVoice[10] = {-6, -4, -2, 0, 2, 4, 5, 3, 0, -3};
+        static const float kBoost[10] = {12, 12, 12, 12, 12, 12, 12, 12, 12, 12};
+        cases.push_back({"Equalizer", "flat", -20.0f, [eq](float sr) { return wrap(eq(sr, kFlat)); }});
+        cases.push_back({"Equalizer", "voice_curve", -20.0f, [eq](float sr) { return wrap(eq(sr, kVoice)); }});
+        cases.push_back({"Equalizer", "max_boost", -30.0f, [eq](float sr) { return wrap(eq(sr, kBoost)); }});
+        static const char* const kKernelRegimes[] = {"voice_curve_scalar", "voice_curve_sse",
+                                                     "voice_curve_avx2", "voice_curve_neon"};
+        for (dsp::CascadeKernel k : {dsp::CascadeKernel::Scalar, dsp::CascadeKernel::SSE,
+                                     dsp::CascadeKernel::AVX2, dsp::CascadeKernel::NEON}) {
+            if (!dsp::BiquadCascade::isSupported(k)) continue;
+            cases.push_back({"Equalizer", kKernelRegimes[static_cast<int>(k)], -20.0f,
+                             [eq, k](float sr) { return wrap(eq(sr, kVoice, k)); }});
+        }
+
+        // Compressor: below threshold, hard compression, inside the knee, RMS detection
+        auto comp = [](float sr, dsp::DetectionMode mode, float kneeDb, float rmsMs, int controlInterval = 1) {
+            auto m = std::make_shared<dsp::Compressor>(sr);
+            m->setThreshold(-20.0f);
+            m->setRatio(4.0f);
+            m->setAttack(5.0f);
+            m->setRelease(50.0f);
+            m->setKnee(kneeDb);
+            m->setDetectionMode(mode);
+            if (mode == dsp::DetectionMode::RMS) m->setRMSWindowSize(rmsMs);
+            m->setControlInterval(controlInterval);
+            return m;
+        };
+        using DM = dsp::DetectionMode;
+        cases.push_back({"Compressor", "peak_below_threshold", -40.0f,
+                         [comp](float sr) { return wrap(comp(sr, DM::PEAK, 6.0f, 10.0f)); }});
+        cases.push_back({"Compressor", "peak_compressing", -6.0f,
+                         [comp](float sr) { return wrap(comp(sr, DM::PEAK, 6.0f, 10.0f)); }});
+        cases.push_back({"Compressor", "peak_soft_knee", -22.0f,
+                         [comp](float sr) { return wrap(comp(sr, DM::PEAK, 12.0f, 10.0f)); }});
+        cases.push_back({"Compressor", "rms_compressing", -6.0f,
+                         [comp](float sr) { return wrap(comp(sr, DM::RMS, 6.0f, 10.0f)); }});
+        cases.push_back({"Compressor", "rms_window_100ms", -6.0f,
+                         [comp](float sr) { return wrap(comp(sr, DM::RMS, 6.0f, 100.0f)); }});
+        cases.push_back({"Compressor", "peak_compressing_control_32", -6.0f,
+                         [comp](float sr) { return wrap(comp(sr, DM::PEAK, 6.0f, 10.0f, 32)); }});
+        cases.push_back({"Compressor", "rms_compressing_control_32", -6.0f,
+                         [comp](float sr) { return wrap(comp(sr, DM::RMS, 6.0f, 10.0f, 32)); }});
+
+        // Limiter: idle, limiting hot input, with lookahead
+        auto lim = [](float sr, float lookaheadMs, int controlInterval = 1) {
+            auto m = std::make_shared<dsp::Limiter>(sr);
+            m->setThreshold(-1.0f);
+            m->setRelease(50.0f);
+            m->setLookahead(lookaheadMs);
+            m->setControlInterval(controlInterval);
+            return m;
+        };
+        cases.push_back({"Limiter", "below_threshold", -20.0f, [lim](float sr) { return wrap(lim(sr, 0.0f)); }});
+        cases.push_back({"Limiter", "limiting", 0.0f, [lim](float sr) { return wrap(lim(sr, 0.0f)); }});
+        cases.push_back({"Limiter", "lookahead_5ms", 0.0f, [lim](float sr) { return wrap(lim(sr, 5.0f)); }});
+        cases.push_back({"Limiter", "limiting_control_32", 0.0f, [lim](float sr) { return wrap(lim(sr, 0.0f, 32)); }});
+        cases.push_back({"Limiter", "lookahead_5ms_control_32", 0.0f, [lim](float sr) { return wrap(lim(sr, 5.0f, 32)); }});
+
+        // Fast math (FastMath.h): libm loop vs every batch kernel this CPU runs
+        using FM = dsp::fastmath::MathKernel;
+        static const char* const kMathKernelRegimes[][4] = {
+                {"tanh_scalar", "tanh_sse", "tanh_avx2", "tanh_neon"},
+                {"db_to_linear_scalar", "db_to_linear_sse", "db_to_linear_avx2", "db_to_linear_neon"},
+                {"linear_to_db_scalar", "linear_to_db_sse", "linear_to_db_avx2", "linear_to_db_neon"}};
+        cases.push_back({"FastMath", "tanh_libm", -6.0f, [](float) -> BlockProcessor {
+            return [](const float* in, float* out, int n) {
+                for (int i = 0; i < n; ++i) out[i] = std::tanh(in[i]);
+            };
+        }});
+        cases.push_back({"FastMath", "db_to_linear_libm", -6.0f, [](float) -> BlockProcessor {
+            return [](const float* in, float* out, int n) {
+                for (int i = 0; i < n; ++i) out[i] = std::pow(10.0f, in[i] / 20.0f);
+            };
+        }});
+        cases.push_back({"FastMath", "linear_to_db_libm", -6.0f, [](float) -> BlockProcessor {
+            return [](const float* in, float* out, int n) {
+                for (int i = 0; i < n; ++i) out[i] = 20.0f * std::log10(std::max(std::abs(in[i]), 1e-10f));
+            };
+        }});
+        for (FM k : {FM::Scalar, FM::SSE, FM::AVX2, FM::NEON}) {
+            if (!dsp::fastmath::isSupported(k)) continue;
+            const dsp::fastmath::MathKernels& fm = dsp::fastmath::kernels(k);
+            const dsp::fastmath::BatchFunction functions[] = {fm.tanh, fm.dbToLinear, fm.linearToDb};
+            for (int f = 0; f < 3; ++f) {
+                const dsp::fastmath::BatchFunction fn = functions[f];
+                cases.push_back({"FastMath", kMathKernelRegimes[f][static_cast<int>(k)], -6.0f,
+                                 [fn](float) -> BlockProcessor { return fn; }});
+            }
+        }
+
+        // Whole chain + output meter (voice curve): one pass per stage vs one fused pass
+        auto chain = [](float sr, bool fused) -> BlockProcessor {
+            auto m = std::make_shared<dsp::DSPChain>(sr);
+            for (int b = 0; b < dsp::Equalizer::kNumBands; ++b) m->equalizer().setBandGain(b, kVoice[b]);
+            m->setVoiceGainDb(6.0f);
+            m->setFusedProcessing(fused);
+            auto levels = std::make_shared<dsp::BlockLevels>();
+            return [m, levels, fused](const float* in, float* out, int n) {
+                std::copy(in, in + n, out);
+                dsp::BlockContext ctx;
+                if (fused) ctx.levels = levels.get();
+                m->processBlock(out, n, ctx);
+                if (!fused) {
+                    // OboeEngine's meter loop
+                    float peak = 0.0f, sumSquares = 0.0f;
+                    for (int i = 0; i < n; ++i) {
+                        peak = std::max(peak, std::abs(out[i]));
+                        sumSquares += out[i] * out[i];
+                    }
+                    levels->peak = peak;
+                    levels->sumSquares = sumSquares;
+                }
+            };
+        };
+        cases.push_back({"Chain", "multi_pass", -30.0f, [chain](float sr) { return chain(sr, false); }});
+        cases.push_back({"Chain", "fused", -30.0f, [chain](float sr) { return chain(sr, true); }});
+
+        return cases;
+    }
+
+    struct Options {
+        const char* module = nullptr;
+        const char* regime = nullptr;
+        const char* output = nullptr;
+        int minBlock = 16;
+        int maxBlock = 4096;
+        float sampleRate = 48000.0f;
+        bench::TimingConfig timing;
+        bool counters = false;
+        uint64_t counterSamples = 1u << 18;   // Samples per counter run (~5 s at 48 kHz)
+        bool list = false;
+    };
+
+    void printUsage(const char* argv0) {
+        std::fprintf(stderr,
+                     "Usage: %s [--module NAME] [--regime NAME] [--min-block N] [--max-block N]\n"
+                     "          [--sample-rate HZ] [--min-time SEC] [--reps N] [--counters]\n"
+                     "          [--counter-samples N] [--quick] [--list] [--output FILE]\n", argv0);
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            const char* a = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (!std::strcmp(a, "--module") && hasValue) opt.module = argv[++i];
+            else if (!std::strcmp(a, "--regime") && hasValue) opt.regime = argv[++i];
+            else if (!std::strcmp(a, "--output") && hasValue) opt.output = argv[++i];
+            else if (!std::strcmp(a, "--min-block") && hasValue) opt.minBlock = std::atoi(argv[++i]);
+            else if (!std::strcmp(a, "--max-block") && hasValue) opt.maxBlock = std::atoi(argv[++i]);
+            else if (!std::strcmp(a, "--sample-rate") && hasValue) opt.sampleRate = static_cast<float>(std::atof(argv[++i]));
+            else if (!std::strcmp(a, "--min-time") && hasValue) opt.timing.minSeconds = std::atof(argv[++i]);
+            else if (!std::strcmp(a, "--reps") && hasValue) opt.timing.repetitions = std::atoi(argv[++i]);
+            else if (!std::strcmp(a, "--counter-samples") && hasValue) opt.counterSamples = std::strtoull(argv[++i], nullptr, 10);
+            else if (!std::strcmp(a, "--counters")) opt.counters = true;
+            else if (!std::strcmp(a, "--list")) opt.list = true;
+            else if (!std::strcmp(a, "--quick")) {
+                // Smoke-test mode: every case runs, but only briefly
+                opt.timing.minSeconds = 0.001;
+                opt.timing.repetitions = 1;
+                opt.timing.warmupBlocks = 4;
+                opt.counterSamples = 4096;
+            } else {
+                return false;
+            }
+        }
+        return opt.minBlock > 0 && opt.maxBlock >= opt.minBlock && opt.sampleRate > 0.0f
+               && opt.timing.repetitions > 0 && opt.counterSamples > 0;
+    }
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    const std::vector<BenchCase> cases = makeCases();
+
+    if (opt.list) {
+        for (const auto& c : cases) std::printf("%s/%s\n", c.module, c.regime);
+        return 0;
+    }
+
+    FILE* out = opt.output ? std::fopen(opt.output, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "Cannot open %s\n", opt.output);
+        return 1;
+    }
+
+    // One second of signal per level; kernels walk through it block by block
+    const size_t signalLength = static_cast<size_t>(opt.sampleRate);
+    const std::vector<int> sizes = bench::blockSizes(opt.minBlock, opt.maxBlock);
+    std::vector<float> output(static_cast<size_t>(opt.maxBlock));
+
+    // Counters follow the calling thread: open once, reuse for every case
+    bench::PerfCounterGroup counters;
+    const bool countersAvailable = opt.counters && counters.open();
+    if (opt.counters && !countersAvailable) {
+        std::fprintf(stderr, "Hardware counters unavailable: %s\n", counters.error().c_str());
+    }
+
+    bench::JsonWriter json(out);
+    json.beginObject();
+    json.field("schema", "soundarch-dsp-bench/1");
+    json.beginObject("host");
+    json.field("arch", bench::hostArchitecture());
+    json.field("compiler", bench::compilerId());
+    json.field("build_type", SOUNDARCH_BUILD_TYPE);
+    json.endObject();
+    json.field("sample_rate", static_cast<double>(opt.sampleRate));
+    if (opt.counters) {
+        json.beginObject("perf_counters");
+        json.field("available", countersAvailable);
+        if (countersAvailable) {
+            json.beginArray("events");
+            for (int e = 0; e < bench::kPerfEventCount; ++e) {
+                const auto event = static_cast<bench::PerfEvent>(e);
+                if (counters.hasEvent(event)) json.field(nullptr, bench::perfEventName(event));
+            }
+            json.endArray();
+        } else {
+            json.field("error", counters.error());
+        }
+        json.endObject();
+    }
+    json.beginArray("results");
+
+    int matched = 0;
+    for (const auto& c : cases) {
+        if (opt.module && std::strcmp(opt.module, c.module) != 0) continue;
+        if (opt.regime && std::strcmp(opt.regime, c.regime) != 0) continue;
+        ++matched;
+
+        const std::vector<float> signal = bench::makeTestSignal(signalLength, opt.sampleRate, c.inputRmsDb);
+
+        for (int blockSize : sizes) {
+            // Fresh instance per block size: no state carried between measurements
+            BlockProcessor process = c.create(opt.sampleRate);
+            const size_t blocksInSignal = signalLength / static_cast<size_t>(blockSize);
+
+            auto kernel = [&](int call) {
+                const size_t offset = (static_cast<size_t>(call) % blocksInSignal) * static_cast<size_t>(blockSize);
+                process(signal.data() + offset, output.data(), blockSize);
+                bench::doNotOptimize(output.data());
+            };
+
+            const bench::Measurement m = bench::measure(kernel, blockSize, opt.sampleRate, opt.timing);
+
+            json.beginObject();
+            json.field("module", c.module);
+            json.field("regime", c.regime);
+            json.field("block_size", blockSize);
+            json.field("input_rms_db", static_cast<double>(c.inputRmsDb));
+            bench::writeMeasurement(json, m);
+
+            if (countersAvailable) {
+                // Fresh instance again: same starting state as the timed run
+                process = c.create(opt.sampleRate);
+                const uint64_t blocks = std::max<uint64_t>(16, opt.counterSamples / static_cast<uint64_t>(blockSize));
+                const bench::PerfMeasurement pm =
+                        bench::measureCounters(kernel, blockSize, counters, blocks, opt.timing.warmupBlocks);
+                bench::writePerfCounters(json, pm);
+            }
+            json.endObject();
+        }
+    }
+
+    json.endArray();
+    json.endObject();
+    json.finish();
+
+    if (out != stdout) std::fclose(out);
+
+    if (matched == 0) {
+        std::fprintf(stderr, "No benchmark case matches the given --module/--regime filter\n");
+        return 1;
+    }
+    return 0;
+}
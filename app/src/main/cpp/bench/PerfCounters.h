@@ -0,0 +1,257 @@
+#pragma once
+
+#include "BenchmarkHarness.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ==============================================================================
+// 🔬 HARDWARE PERFORMANCE COUNTERS - perf_event_open around a benchmark kernel
+// ==============================================================================
+//
+// One counter group per process (measured thread only, user space only):
+//   - cycles          CPU cycles (leader: the group is scheduled as a unit)
+//   - instructions    retired instructions → IPC
+//   - l1d_misses      L1 data cache read misses (LUTs, RMS/lookahead rings)
+//   - branch_misses   mispredicted branches (gates, knees, per-sample modes)
+//
+// Requires Linux with perf_event_paranoid ≤ 2 (default) and a PMU visible to
+// the process: VMs and containers often expose none, in which case open()
+// fails with the reason and the benchmark reports counters as unavailable.
+// Events the PMU lacks (e.g. L1D on some cores) are reported as null.
+//
+// When the kernel multiplexes the group, counts are scaled by
+// time_enabled / time_running.
+//
+// ==============================================================================
+
+namespace soundarch::bench {
+
+    enum class PerfEvent : int {
+        Cycles = 0,
+        Instructions,
+        L1dMisses,
+        BranchMisses,
+        Count
+    };
+
+    constexpr int kPerfEventCount = static_cast<int>(PerfEvent::Count);
+
+    inline const char* perfEventName(PerfEvent event) noexcept {
+        switch (event) {
+            case PerfEvent::Cycles: return "cycles";
+            case PerfEvent::Instructions: return "instructions";
+            case PerfEvent::L1dMisses: return "l1d_misses";
+            case PerfEvent::BranchMisses: return "branch_misses";
+            default: return "?";
+        }
+    }
+
+    // Counts over one measured run; NaN = event not available
+    struct PerfCounts {
+        double values[kPerfEventCount];
+        double multiplexRatio = 1.0;   // time_running / time_enabled
+
+        PerfCounts() {
+            for (double& v : values) v = std::numeric_limits<double>::quiet_NaN();
+        }
+        double operator[](PerfEvent e) const noexcept { return values[static_cast<int>(e)]; }
+    };
+
+    class PerfCounterGroup {
+    public:
+        PerfCounterGroup() = default;
+        ~PerfCounterGroup() { close(); }
+
+        PerfCounterGroup(const PerfCounterGroup&) = delete;
+        PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+        /**
+         * Opens the group for the calling thread.
+         * @return false if no hardware counter is available (see error())
+         */
+        bool open() {
+            close();
+#if defined(__linux__)
+            for (int i = 0; i < kPerfEventCount; ++i) {
+                const int fd = openEvent(static_cast<PerfEvent>(i), leader_);
+                if (fd < 0) {
+                    if (i == 0) {
+                        error_ = std::string("perf_event_open(cycles): ") + std::strerror(errno);
+                        return false;
+                    }
+                    continue;   // Member missing on this PMU: reported as null
+                }
+                if (i == 0) leader_ = fd;
+                fds_[i] = fd;
+                slot_[i] = members_++;
+            }
+            return true;
+#else
+            error_ = "perf_event_open is Linux-only";
+            return false;
+#endif
+        }
+
+        bool isOpen() const noexcept { return leader_ >= 0; }
+        const std::string& error() const noexcept { return error_; }
+        bool hasEvent(PerfEvent e) const noexcept { return fds_[static_cast<int>(e)] >= 0; }
+
+        void start() noexcept {
+#if defined(__linux__)
+            if (!isOpen()) return;
+            ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        PerfCounts stop() noexcept {
+            PerfCounts counts;
+#if defined(__linux__)
+            if (!isOpen()) return counts;
+            ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+            // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, value[nr]
+            uint64_t buffer[3 + kPerfEventCount] = {};
+            if (::read(leader_, buffer, sizeof(buffer)) < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+                return counts;
+            }
+            const uint64_t enabled = buffer[1];
+            const uint64_t running = buffer[2];
+            if (running == 0) return counts;   // Never scheduled on the PMU
+            const double scale = static_cast<double>(enabled) / static_cast<double>(running);
+            counts.multiplexRatio = static_cast<double>(running) / static_cast<double>(enabled);
+
+            for (int i = 0; i < kPerfEventCount; ++i) {
+                if (fds_[i] >= 0 && slot_[i] < static_cast<int>(buffer[0])) {
+                    counts.values[i] = static_cast<double>(buffer[3 + slot_[i]]) * scale;
+                }
+            }
+#endif
+            return counts;
+        }
+
+    private:
+#if defined(__linux__)
+        static int openEvent(PerfEvent event, int groupFd) noexcept {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.disabled = groupFd < 0 ? 1 : 0;   // Leader gates the whole group
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            switch (event) {
+                case PerfEvent::Cycles:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                    break;
+                case PerfEvent::Instructions:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                    break;
+                case PerfEvent::L1dMisses:
+                    attr.type = PERF_TYPE_HW_CACHE;
+                    attr.config = PERF_COUNT_HW_CACHE_L1D
+                                  | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                  | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                    break;
+                case PerfEvent::BranchMisses:
+                    attr.type = PERF_TYPE_HARDWARE;
+                    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                    break;
+                default:
+                    return -1;
+            }
+
+            // pid 0 = this thread, cpu -1 = wherever it runs
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+        }
+#endif
+
+        void close() noexcept {
+#if defined(__linux__)
+            for (int i = kPerfEventCount - 1; i >= 0; --i) {
+                if (fds_[i] >= 0) ::close(fds_[i]);
+            }
+#endif
+            for (int i = 0; i < kPerfEventCount; ++i) {
+                fds_[i] = -1;
+                slot_[i] = -1;
+            }
+            leader_ = -1;
+            members_ = 0;
+        }
+
+        int fds_[kPerfEventCount] = {-1, -1, -1, -1};
+        int slot_[kPerfEventCount] = {-1, -1, -1, -1};   // Position in the group read
+        int leader_ = -1;
+        int members_ = 0;
+        std::string error_;
+    };
+
+    struct PerfMeasurement {
+        PerfCounts counts;
+        uint64_t blocks = 0;
+        uint64_t samples = 0;
+    };
+
+    /**
+     * Runs kernel(call) for `blocks` blocks (after the same warmup as measure())
+     * with the counter group enabled around the loop only.
+     */
+    template<typename Kernel>
+    PerfMeasurement measureCounters(Kernel&& kernel, int blockSize, PerfCounterGroup& group,
+                                    uint64_t blocks, int warmupBlocks) {
+        for (int i = 0; i < warmupBlocks; ++i) {
+            kernel(i);
+        }
+
+        PerfMeasurement m;
+        m.blocks = blocks;
+        m.samples = blocks * static_cast<uint64_t>(blockSize);
+
+        int call = warmupBlocks;
+        group.start();
+        for (uint64_t b = 0; b < blocks; ++b) {
+            kernel(call++);
+        }
+        m.counts = group.stop();
+        return m;
+    }
+
+    // "counters": { "blocks": N, "per_block": {...}, "per_sample": {...}, "ipc": x }
+    inline void writePerfCounters(JsonWriter& json, const PerfMeasurement& m) {
+        const double blocks = static_cast<double>(m.blocks);
+        const double samples = static_cast<double>(m.samples);
+
+        json.beginObject("counters");
+        json.field("blocks", m.blocks);
+        json.beginObject("per_block");
+        for (int i = 0; i < kPerfEventCount; ++i) {
+            json.field(perfEventName(static_cast<PerfEvent>(i)), m.counts.values[i] / blocks);
+        }
+        json.endObject();
+        json.beginObject("per_sample");
+        for (int i = 0; i < kPerfEventCount; ++i) {
+            json.field(perfEventName(static_cast<PerfEvent>(i)), m.counts.values[i] / samples);
+        }
+        json.endObject();
+        json.field("ipc", m.counts[PerfEvent::Instructions] / m.counts[PerfEvent::Cycles]);
+        json.field("multiplex_ratio", m.counts.multiplexRatio);
+        json.endObject();
+    }
+
+} // namespace soundarch::bench
@@ -0,0 +1,466 @@
+// ==============================================================================
+// SoundArch RingBuffer Benchmark - utils/RingBuffer.h queue family
+// ==============================================================================
+//
+// RingBuffer vs the previous implementation (kept here as LegacyRingBuffer:
+// per-element copy with a mask per sample, head/tail on one cache line, both
+// indices reloaded on every call):
+//
+//   engine_path   One onAudioReady() worth of ring traffic, single thread:
+//                   legacy  = device read into a temp buffer, push(), pop()
+//                   current = device read straight into prepareWrite() spans,
+//                             commitWrite(), pop()
+//   spsc_threads  Producer and consumer on two threads, push()/pop() of
+//                 block-sized chunks: index cache-line traffic dominates
+//
+// Rest of the family, stereo float frames, frames/sec with every thread busy:
+//
+//   frame_spsc    FrameRingBuffer, block-sized push()/pop()
+//   mpsc          MpscQueue, 1/2/4 producers → one consumer ("retries" =
+//                 full-queue push attempts per delivered frame)
+//   broadcast     BroadcastQueue, one producer → 1/2/4 readers ("lost" =
+//                 fraction a reader skipped because it was lapped)
+//
+// Threaded scenarios need two cores to mean anything; on a single-core host
+// they run only when named with --scenario (or in --quick smoke mode).
+//
+//   {
+//     "schema": "soundarch-ringbuffer-bench/1",
+//     "host": { ... },
+//     "results": [
+//       { "scenario": "engine_path", "block_size": 192,
+//         "legacy":  { "ns_per_sample": 0.61, ... },
+//         "current": { "ns_per_sample": 0.09, ... }, "speedup": 6.7 },
+//       { "scenario": "mpsc", "threads": 4, "frames": 4194304,
+//         "frames_per_sec": 2.1e7, "retries": 0.03 }
+//     ]
+//   }
+//
+// Usage:
+//   soundarch_ringbuffer_bench [--scenario NAME] [--min-block N] [--max-block N]
+//                              [--min-time SEC] [--reps N] [--quick] [--output FILE]
+//
+// ==============================================================================
+
+#include "BenchmarkHarness.h"
+
+#include "utils/RingBuffer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#ifndef SOUNDARCH_BUILD_TYPE
+#define SOUNDARCH_BUILD_TYPE "unknown"
+#endif
+
+using namespace soundarch;
+
+namespace {
+
+    constexpr size_t kRingSize = 16384;            // OboeEngine::kRingBufferSize
+    constexpr float kSampleRate = 48000.0f;
+
+    // Previous utils/RingBuffer.h, verbatim apart from the name
+    template<typename T, size_t N>
+    class LegacyRingBuffer {
+        T buffer[N];
+        std::atomic<size_t> head{0};
+        std::atomic<size_t> tail{0};
+
+    public:
+        size_t availableToWrite() const {
+            return N - (head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire));
+        }
+
+        size_t availableToRead() const {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+        }
+
+        bool push(const T* data, size_t count) noexcept {
+            if (availableToWrite() < count) return false;
+            size_t localHead = head.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < count; ++i) {
+                buffer[(localHead + i) & (N - 1)] = data[i];
+            }
+            head.store(localHead + count, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(T* out, size_t count) noexcept {
+            if (availableToRead() < count) return false;
+            size_t localTail = tail.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = buffer[(localTail + i) & (N - 1)];
+            }
+            tail.store(localTail + count, std::memory_order_release);
+            return true;
+        }
+    };
+
+    using Legacy = LegacyRingBuffer<float, kRingSize>;
+    using Current = RingBuffer<float, kRingSize>;
+
+    struct StereoFrame {
+        float channel[2];
+    };
+    constexpr size_t kQueueSize = 4096;            // Frames, every family member
+
+    struct Options {
+        const char* scenario = nullptr;
+        const char* output = nullptr;
+        int minBlock = 16;
+        int maxBlock = 4096;
+        bench::TimingConfig timing;
+        size_t threadedSamples = 1u << 22;          // Per spsc_threads repetition
+    };
+
+    void printUsage(const char* argv0) {
+        std::fprintf(stderr,
+                     "Usage: %s [--scenario engine_path|spsc_threads|frame_spsc|mpsc|broadcast]\n"
+                     "          [--min-block N] [--max-block N]\n"
+                     "          [--min-time SEC] [--reps N] [--quick] [--output FILE]\n", argv0);
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            const char* a = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (!std::strcmp(a, "--scenario") && hasValue) opt.scenario = argv[++i];
+            else if (!std::strcmp(a, "--output") && hasValue) opt.output = argv[++i];
+            else if (!std::strcmp(a, "--min-block") && hasValue) opt.minBlock = std::atoi(argv[++i]);
+            else if (!std::strcmp(a, "--max-block") && hasValue) opt.maxBlock = std::atoi(argv[++i]);
+            else if (!std::strcmp(a, "--min-time") && hasValue) opt.timing.minSeconds = std::atof(argv[++i]);
+            else if (!std::strcmp(a, "--reps") && hasValue) opt.timing.repetitions = std::atoi(argv[++i]);
+            else if (!std::strcmp(a, "--quick")) {
+                // Smoke-test mode: exercise every path, numbers are meaningless
+                opt.timing.minSeconds = 0.001;
+                opt.timing.repetitions = 1;
+                opt.threadedSamples = 1u << 16;
+            } else return false;
+        }
+        return opt.minBlock > 0 && opt.maxBlock >= opt.minBlock
+               && static_cast<size_t>(opt.maxBlock) <= kRingSize / 2 && opt.timing.repetitions > 0;
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🎧 ENGINE PATH - device read → ring → output, one thread
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // The "device" is a memcpy from a one-second capture signal; the ring
+    // carries two blocks of latency so reservations regularly wrap.
+
+    bench::Measurement engineLegacy(const std::vector<float>& device, int block, const Options& opt) {
+        auto ring = std::make_unique<Legacy>();
+        std::vector<float> temp(static_cast<size_t>(block));
+        std::vector<float> output(static_cast<size_t>(block));
+        const size_t n = static_cast<size_t>(block);
+        ring->push(output.data(), n);
+        ring->push(output.data(), n);
+
+        return bench::measure([&](int call) {
+            const size_t offset = (static_cast<size_t>(call) * n) % (device.size() - n);
+            std::memcpy(temp.data(), device.data() + offset, n * sizeof(float));   // readInput()
+            ring->push(temp.data(), n);
+            ring->pop(output.data(), n);
+            bench::doNotOptimize(output.data());
+        }, block, kSampleRate, opt.timing);
+    }
+
+    bench::Measurement engineCurrent(const std::vector<float>& device, int block, const Options& opt) {
+        auto ring = std::make_unique<Current>();
+        std::vector<float> output(static_cast<size_t>(block));
+        const size_t n = static_cast<size_t>(block);
+        ring->push(output.data(), n);
+        ring->push(output.data(), n);
+
+        return bench::measure([&](int call) {
+            const size_t offset = (static_cast<size_t>(call) * n) % (device.size() - n);
+            const auto r = ring->prepareWrite(n);
+            std::memcpy(r.first.data, device.data() + offset, r.first.size * sizeof(float));   // readInput()
+            if (r.second.size) {
+                std::memcpy(r.second.data, device.data() + offset + r.first.size, r.second.size * sizeof(float));
+            }
+            ring->commitWrite(r.size());
+            ring->pop(output.data(), n);
+            bench::doNotOptimize(output.data());
+        }, block, kSampleRate, opt.timing);
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🧵 SPSC THREADS - producer and consumer on separate cores
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    template<typename Ring>
+    bench::Measurement threaded(int block, const Options& opt) {
+        using Clock = std::chrono::steady_clock;
+        const size_t n = static_cast<size_t>(block);
+        const size_t blocks = opt.threadedSamples / n;
+
+        std::vector<bench::Measurement> reps;
+        for (int r = 0; r < opt.timing.repetitions; ++r) {
+            auto ring = std::make_unique<Ring>();
+            std::vector<float> in(n, 0.25f);
+            std::vector<float> out(n);
+
+            const auto start = Clock::now();
+            std::thread producer([&] {
+                for (size_t b = 0; b < blocks; ++b) {
+                    while (!ring->push(in.data(), n)) {
+                        std::this_thread::yield();   // Single-core hosts: let the consumer run
+                    }
+                }
+            });
+            for (size_t b = 0; b < blocks; ++b) {
+                while (!ring->pop(out.data(), n)) {
+                    std::this_thread::yield();
+                }
+                bench::doNotOptimize(out.data());
+            }
+            producer.join();
+            const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            bench::Measurement m;
+            m.samples = blocks * n;
+            m.nsPerSample = elapsed * 1e9 / static_cast<double>(m.samples);
+            m.samplesPerSec = static_cast<double>(m.samples) / elapsed;
+            m.realtimeFactor = m.samplesPerSec / kSampleRate;
+            reps.push_back(m);
+        }
+
+        std::sort(reps.begin(), reps.end(), [](const bench::Measurement& a, const bench::Measurement& b) {
+            return a.nsPerSample < b.nsPerSample;
+        });
+        return reps[reps.size() / 2];
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🎚️ FAMILY - frame ring, MPSC, broadcast (frames/sec under contention)
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    struct Contention {
+        uint64_t frames = 0;           // Delivered (broadcast: published)
+        double framesPerSec = 0.0;
+        double ratio = 0.0;            // mpsc: retries per frame, broadcast: lost fraction
+    };
+
+    template<typename Run>
+    Contention medianOf(const Options& opt, Run&& run) {
+        std::vector<Contention> reps;
+        for (int r = 0; r < opt.timing.repetitions; ++r) reps.push_back(run());
+        std::sort(reps.begin(), reps.end(), [](const Contention& a, const Contention& b) {
+            return a.framesPerSec < b.framesPerSec;
+        });
+        return reps[reps.size() / 2];
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    Contention frameSpsc(int block, const Options& opt) {
+        return medianOf(opt, [&] {
+            auto ring = std::make_unique<FrameRingBuffer<float, 2, kQueueSize>>();
+            const size_t n = static_cast<size_t>(block);
+            const size_t blocks = opt.threadedSamples / n;
+            std::vector<float> in(2 * n, 0.25f);
+            std::vector<float> out(2 * n);
+
+            const auto start = std::chrono::steady_clock::now();
+            std::thread producer([&] {
+                for (size_t b = 0; b < blocks; ++b) {
+                    while (!ring->push(in.data(), n)) std::this_thread::yield();
+                }
+            });
+            for (size_t b = 0; b < blocks; ++b) {
+                while (!ring->pop(out.data(), n)) std::this_thread::yield();
+                bench::doNotOptimize(out.data());
+            }
+            producer.join();
+
+            Contention c;
+            c.frames = blocks * n;
+            c.framesPerSec = static_cast<double>(c.frames) / secondsSince(start);
+            return c;
+        });
+    }
+
+    Contention mpsc(int producers, const Options& opt) {
+        return medianOf(opt, [&] {
+            auto queue = std::make_unique<MpscQueue<StereoFrame, kQueueSize>>();
+            const size_t perProducer = opt.threadedSamples / static_cast<size_t>(producers);
+            std::atomic<uint64_t> retries{0};
+
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.emplace_back([&] {
+                    uint64_t full = 0;
+                    const StereoFrame frame{{0.25f, -0.25f}};
+                    for (size_t i = 0; i < perProducer; ++i) {
+                        while (!queue->tryPush(frame)) {
+                            ++full;
+                            std::this_thread::yield();
+                        }
+                    }
+                    retries.fetch_add(full, std::memory_order_relaxed);
+                });
+            }
+
+            const size_t total = perProducer * static_cast<size_t>(producers);
+            StereoFrame batch[256];
+            for (size_t received = 0; received < total;) {
+                const size_t n = queue->popBulk(batch, 256);
+                if (n == 0) std::this_thread::yield();
+                bench::doNotOptimize(batch);
+                received += n;
+            }
+            for (auto& t : threads) t.join();
+
+            Contention c;
+            c.frames = total;
+            c.framesPerSec = static_cast<double>(total) / secondsSince(start);
+            c.ratio = static_cast<double>(retries.load()) / static_cast<double>(total);
+            return c;
+        });
+    }
+
+    Contention broadcast(int readers, const Options& opt) {
+        return medianOf(opt, [&] {
+            using Queue = BroadcastQueue<StereoFrame, kQueueSize>;
+            auto queue = std::make_unique<Queue>();
+            const size_t total = opt.threadedSamples;
+            std::atomic<bool> done{false};
+            std::atomic<uint64_t> lost{0};
+
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (int r = 0; r < readers; ++r) {
+                threads.emplace_back([&, reader = queue->reader()]() mutable {
+                    StereoFrame frame{};
+                    for (;;) {
+                        const bool finished = done.load(std::memory_order_acquire);
+                        if (reader.tryPop(frame)) {
+                            bench::doNotOptimize(&frame);
+                        } else if (finished) {
+                            break;
+                        } else {
+                            std::this_thread::yield();
+                        }
+                    }
+                    lost.fetch_add(reader.lostCount(), std::memory_order_relaxed);
+                });
+            }
+
+            const StereoFrame frame{{0.25f, -0.25f}};
+            for (size_t i = 0; i < total; ++i) queue->publish(frame);
+            const double seconds = secondsSince(start);
+            done.store(true, std::memory_order_release);
+            for (auto& t : threads) t.join();
+
+            Contention c;
+            c.frames = total;
+            c.framesPerSec = static_cast<double>(total) / seconds;
+            c.ratio = static_cast<double>(lost.load()) / static_cast<double>(total * static_cast<size_t>(readers));
+            return c;
+        });
+    }
+
+    void writeContention(bench::JsonWriter& json, const char* scenario, const char* key, int value,
+                         const Contention& c, const char* ratioName) {
+        json.beginObject();
+        json.field("scenario", scenario);
+        json.field(key, value);
+        json.field("frames", c.frames);
+        json.field("frames_per_sec", c.framesPerSec);
+        if (ratioName) json.field(ratioName, c.ratio);
+        json.endObject();
+    }
+
+    void writeComparison(bench::JsonWriter& json, const char* scenario, int block,
+                         const bench::Measurement& legacy, const bench::Measurement& current) {
+        json.beginObject();
+        json.field("scenario", scenario);
+        json.field("block_size", block);
+        json.beginObject("legacy");
+        bench::writeMeasurement(json, legacy);
+        json.endObject();
+        json.beginObject("current");
+        bench::writeMeasurement(json, current);
+        json.endObject();
+        json.field("speedup", current.nsPerSample > 0.0 ? legacy.nsPerSample / current.nsPerSample : 0.0);
+        json.endObject();
+    }
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    const char* const kScenarios[] = {"engine_path", "spsc_threads", "frame_spsc", "mpsc", "broadcast"};
+    bool run[5] = {};
+    bool known = false;
+    for (int i = 0; i < 5; ++i) {
+        run[i] = !opt.scenario || !std::strcmp(opt.scenario, kScenarios[i]);
+        known = known || run[i];
+    }
+    if (!known) {
+        std::fprintf(stderr, "Unknown --scenario %s\n", opt.scenario);
+        return 1;
+    }
+
+    // One core: threaded scenarios measure context switches, not the queues (ask for them explicitly)
+    const unsigned cores = std::thread::hardware_concurrency();
+    if (!opt.scenario && cores < 2 && opt.threadedSamples >= (1u << 22)) {
+        std::fprintf(stderr, "Single core host: skipping threaded scenarios\n");
+        for (int i = 1; i < 5; ++i) run[i] = false;
+    }
+
+    FILE* out = opt.output ? std::fopen(opt.output, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "Cannot open %s\n", opt.output);
+        return 1;
+    }
+
+    const std::vector<float> device = bench::makeTestSignal(static_cast<size_t>(kSampleRate), kSampleRate, -20.0f);
+    const std::vector<int> sizes = bench::blockSizes(opt.minBlock, opt.maxBlock);
+
+    bench::JsonWriter json(out);
+    json.beginObject();
+    json.field("schema", "soundarch-ringbuffer-bench/1");
+    json.beginObject("host");
+    json.field("arch", bench::hostArchitecture());
+    json.field("compiler", bench::compilerId());
+    json.field("build_type", SOUNDARCH_BUILD_TYPE);
+    json.field("cores", static_cast<int>(cores));
+    json.endObject();
+    json.field("ring_size", static_cast<uint64_t>(kRingSize));
+    json.beginArray("results");
+
+    for (int block : sizes) {
+        if (run[0]) {
+            writeComparison(json, "engine_path", block,
+                            engineLegacy(device, block, opt), engineCurrent(device, block, opt));
+        }
+        if (run[1]) {
+            writeComparison(json, "spsc_threads", block, threaded<Legacy>(block, opt), threaded<Current>(block, opt));
+        }
+        if (run[2]) writeContention(json, "frame_spsc", "block_size", block, frameSpsc(block, opt), nullptr);
+    }
+    for (int threads : {1, 2, 4}) {
+        if (run[3]) writeContention(json, "mpsc", "threads", threads, mpsc(threads, opt), "retries");
+        if (run[4]) writeContention(json, "broadcast", "threads", threads, broadcast(threads, opt), "lost");
+    }
+
+    json.endArray();
+    json.endObject();
+    json.finish();
+
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,260 @@
+// ==============================================================================
+// SoundArch Stage Benchmark - per-stage callback timing on the simulated device
+// ==============================================================================
+//
+// Runs the whole OboeEngine + DSPChain callback path (same wiring as
+// native-lib.cpp) on SimulatedBackend and reports the StageProfiler
+// histograms: per stage p50 / p99 / p99.9 / max, plus the total callback time
+// as a fraction of the buffer period.
+//
+//   {
+//     "schema": "soundarch-stage-bench/1",
+//     "host": { "arch": "x86_64", "compiler": "...", "build_type": "Release" },
+//     "sample_rate": 48000,
+//     "results": [
+//       { "config": "production", "block_size": 192, "callbacks": 7500,
+//         "stages": [ { "stage": "agc", "count": 7500, "p50_ns": 1810, ... } ],
+//         "budget": { "p50": 0.004, "p99": 0.009, "deadline_misses": 0, ... } }
+//     ]
+//   }
+//
+// Usage:
+//   soundarch_stage_bench [--config NAME] [--block N] [--seconds SEC]
+//                         [--sample-rate HZ] [--trace FILE] [--quick] [--list]
+//                         [--output FILE]
+//
+// --trace writes the callback timeline of the last run as Chrome trace-event
+// JSON (utils/TraceRecorder.h); combine with --config and --block. The
+// simulated device runs faster than real time, so callbacks appear back to
+// back: the timeline shows DSP load, not device jitter.
+//
+// ==============================================================================
+
+#include "BenchmarkHarness.h"
+
+#include "OboeEngine.h"
+#include "SimulatedBackend.h"
+#include "dsp/DSPChain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+#ifndef SOUNDARCH_BUILD_TYPE
+#define SOUNDARCH_BUILD_TYPE "unknown"
+#endif
+
+using namespace soundarch;
+
+namespace {
+
+    struct StageConfig {
+        const char* name;
+        std::function<void(dsp::DSPChain&)> apply;
+    };
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🎛️ CHAIN CONFIGS - DSPChain defaults are the startAudio() production chain
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    std::vector<StageConfig> makeConfigs() {
+        std::vector<StageConfig> configs;
+        configs.push_back({"production", [](dsp::DSPChain&) {}});
+        configs.push_back({"voice_curve", [](dsp::DSPChain& c) {
+            static const float kVoice[10] = {-6, -4, -2, 0, 2, 4, 5, 3, 0, -3};
+            for (int b = 0; b < dsp::Equalizer::kNumBands; ++b) c.equalizer().setBandGain(b, kVoice[b]);
+            c.setVoiceGainDb(6.0f);
+        }});
+        configs.push_back({"production_multi_pass", [](dsp::DSPChain& c) { c.setFusedProcessing(false); }});
+        configs.push_back({"dynamics_off", [](dsp::DSPChain& c) {
+            c.setAGCEnabled(false);
+            c.setCompressorEnabled(false);
+            c.setLimiterEnabled(false);
+        }});
+        if (dsp::DSPChain::hasNoiseCanceller()) {
+            configs.push_back({"noise_canceller", [](dsp::DSPChain& c) { c.setNoiseCancellerEnabled(true); }});
+        }
+        return configs;
+    }
+
+    // Typical Android bursts (Pixel 96/192, Samsung 240/480, Bluetooth 960)
+    const int kDefaultBlocks[] = {48, 96, 192, 240, 480, 960};
+
+    struct Options {
+        const char* config = nullptr;
+        const char* output = nullptr;
+        const char* trace = nullptr;
+        int block = 0;                 // 0 = every default block size
+        int32_t sampleRate = 48000;
+        double seconds = 20.0;         // Virtual device time per run
+        bool list = false;
+    };
+
+    void printUsage(const char* argv0) {
+        std::fprintf(stderr,
+                     "Usage: %s [--config NAME] [--block N] [--seconds SEC] [--sample-rate HZ]\n"
+                     "          [--trace FILE] [--quick] [--list] [--output FILE]\n", argv0);
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            const char* a = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (!std::strcmp(a, "--config") && hasValue) opt.config = argv[++i];
+            else if (!std::strcmp(a, "--output") && hasValue) opt.output = argv[++i];
+            else if (!std::strcmp(a, "--trace") && hasValue) opt.trace = argv[++i];
+            else if (!std::strcmp(a, "--block") && hasValue) opt.block = std::atoi(argv[++i]);
+            else if (!std::strcmp(a, "--seconds") && hasValue) opt.seconds = std::atof(argv[++i]);
+            else if (!std::strcmp(a, "--sample-rate") && hasValue) opt.sampleRate = std::atoi(argv[++i]);
+            else if (!std::strcmp(a, "--list")) opt.list = true;
+            else if (!std::strcmp(a, "--quick")) opt.seconds = 0.25;   // Smoke-test mode
+            else return false;
+        }
+        return opt.block >= 0 && opt.sampleRate > 0 && opt.seconds > 0.0;
+    }
+
+    void writeStages(bench::JsonWriter& json, const utils::StageProfiler& profiler) {
+        json.beginArray("stages");
+        for (int i = 0; i < utils::kStageCount; ++i) {
+            const auto stage = static_cast<utils::Stage>(i);
+            const utils::StageSummary s = profiler.summary(stage);
+            if (s.count == 0) continue;   // Stage disabled in this config
+            json.beginObject();
+            json.field("stage", utils::stageName(stage));
+            json.field("count", s.count);
+            json.field("p50_ns", s.p50Ns);
+            json.field("p99_ns", s.p99Ns);
+            json.field("p999_ns", s.p999Ns);
+            json.field("max_ns", s.maxNs);
+            json.endObject();
+        }
+        json.endArray();
+
+        const utils::BudgetSummary b = profiler.budget();
+        json.beginObject("budget");
+        json.field("count", b.count);
+        json.field("p50", b.p50);
+        json.field("p99", b.p99);
+        json.field("p999", b.p999);
+        json.field("max", b.max);
+        json.field("deadline_misses", b.deadlineMisses);
+        json.endObject();
+    }
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    const std::vector<StageConfig> configs = makeConfigs();
+
+    if (opt.list) {
+        for (const auto& c : configs) std::printf("%s\n", c.name);
+        return 0;
+    }
+
+    FILE* out = opt.output ? std::fopen(opt.output, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "Cannot open %s\n", opt.output);
+        return 1;
+    }
+
+    std::vector<int> blocks;
+    if (opt.block > 0) blocks.push_back(opt.block);
+    else blocks.assign(std::begin(kDefaultBlocks), std::end(kDefaultBlocks));
+
+    bench::JsonWriter json(out);
+    json.beginObject();
+    json.field("schema", "soundarch-stage-bench/1");
+    json.beginObject("host");
+    json.field("arch", bench::hostArchitecture());
+    json.field("compiler", bench::compilerId());
+    json.field("build_type", SOUNDARCH_BUILD_TYPE);
+    json.endObject();
+    json.field("sample_rate", opt.sampleRate);
+    json.field("virtual_seconds", opt.seconds);
+    json.beginArray("results");
+
+    int matched = 0;
+    bool ok = true;
+    for (const auto& c : configs) {
+        if (opt.config && std::strcmp(opt.config, c.name) != 0) continue;
+        ++matched;
+
+        for (int block : blocks) {
+            // Fresh device, engine and chain per run: histograms start empty
+            audio::SimulatedDeviceConfig device;
+            device.sampleRate = opt.sampleRate;
+            device.framesPerBurst = block;
+
+            auto backend = std::make_unique<audio::SimulatedBackend>(device);
+            audio::SimulatedBackend* sim = backend.get();
+            OboeEngine engine(std::move(backend));
+            engine.setTelemetryThreadEnabled(false);
+
+            dsp::DSPChain chain(static_cast<float>(opt.sampleRate));
+            c.apply(chain);
+
+            engine.setAudioCallback([&engine, &chain, &opt](float* in, float* out, int32_t n) {
+                if (in != out) std::memcpy(out, in, static_cast<size_t>(n) * sizeof(float));
+                dsp::BlockContext ctx;
+                ctx.sampleRate = opt.sampleRate;
+                ctx.profiler = &engine.profiler();
+                chain.processBlock(out, n, ctx);
+            });
+
+            if (!engine.start()) {
+                std::fprintf(stderr, "%s/%d: engine failed to start\n", c.name, block);
+                ok = false;
+                continue;
+            }
+            // Trace: manual drain between slices keeps the track ring from overflowing
+            if (opt.trace) engine.trace().start(3600.0, false);
+
+            const auto wallStart = std::chrono::steady_clock::now();
+            for (double elapsed = 0.0; elapsed < opt.seconds; elapsed += 0.1) {
+                sim->advance(std::min(0.1, opt.seconds - elapsed));
+                if (opt.trace) engine.trace().drain();
+            }
+            const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+            if (opt.trace) {
+                engine.trace().stop();
+                FILE* traceFile = std::fopen(opt.trace, "w");
+                if (!traceFile || !engine.trace().writeChromeTrace(traceFile)) {
+                    std::fprintf(stderr, "Cannot write %s\n", opt.trace);
+                    ok = false;
+                }
+                if (traceFile) std::fclose(traceFile);
+            }
+
+            json.beginObject();
+            json.field("config", c.name);
+            json.field("block_size", block);
+            json.field("callbacks", sim->stats().callbacks);
+            json.field("realtime_factor", wall > 0.0 ? opt.seconds / wall : 0.0);
+            writeStages(json, engine.profiler());
+            json.endObject();
+
+            engine.stop();
+        }
+    }
+
+    json.endArray();
+    json.endObject();
+    json.finish();
+
+    if (out != stdout) std::fclose(out);
+
+    if (matched == 0) {
+        std::fprintf(stderr, "No config matches --config %s\n", opt.config);
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -2,11 +2,11 @@
 #include "DSPMath.h"
 #include <cmath>
 #include <algorithm>
-#include <android/log.h>
+#include "../utils/Log.h"
 
 #define TAG "AGC"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, TAG, __VA_ARGS__)
-#define LOGW(...) __android_log_print(ANDROID_LOG_WARN, TAG, __VA_ARGS__)
+#define LOGI(...) SA_LOGI(TAG, __VA_ARGS__)
+#define LOGW(...) SA_LOGW(TAG, __VA_ARGS__)
 
 namespace soundarch::dsp {
 
@@ -23,16 +23,18 @@ namespace soundarch::dsp {
     void AGC::setAttackTime(float seconds) noexcept {
         const float tau = std::max(0.1f, seconds);
         attackCoef_ = std::exp(-1.0f / (tau * sampleRate_));
+        attackSegment_.set(attackCoef_, controlInterval_);
     }
 
     void AGC::setReleaseTime(float seconds) noexcept {
         const float tau = std::max(0.5f, seconds);
         releaseCoef_ = std::exp(-1.0f / (tau * sampleRate_));
+        releaseSegment_.set(releaseCoef_, controlInterval_);
     }
 
     void AGC::setMaxGain(float db) noexcept {
+        // Limited to 30 dB for safety. No log here: DSPChain applies it on the audio thread
         maxGainDb_ = std::clamp(db, 0.0f, 30.0f);
-        LOGI("🎯 AGC Max Gain set to %.1f dB (limited to 30 dB for safety)", maxGainDb_);
     }
 
     void AGC::setMinGain(float db) noexcept {
@@ -46,35 +48,55 @@ namespace soundarch::dsp {
     void AGC::setWindowSize(float seconds) noexcept {
         const float clampedSeconds = std::clamp(seconds, 0.1f, 2.0f);
         windowSize_ = static_cast<size_t>(clampedSeconds * sampleRate_);
-        windowSize_ = std::min(windowSize_, kMaxWindowSize);
-        reset();
+        windowSize_ = std::clamp(windowSize_, static_cast<size_t>(kEnergyBlock), kMaxWindowSize);
+        clearState();   // RT-safe part of reset(): may run on the audio thread
+    }
+
+    void AGC::setControlInterval(int samples) noexcept {
+        controlInterval_ = clampControlInterval(samples);
+        attackSegment_.set(attackCoef_, controlInterval_);
+        releaseSegment_.set(releaseCoef_, controlInterval_);
     }
 
     float AGC::calculateRMS() noexcept {
         if (windowSize_ == 0) return 0.0f;
 
-        const float meanSquare = rmsSum_ / static_cast<float>(windowSize_);
+        const float meanSquare = windowEnergy() * invWindowSize_;
         return std::sqrt(std::max(0.0f, meanSquare));
     }
 
+    // A block is complete: into the ring, the block K back leaves the K newest
+    void AGC::commitEnergyBlock() noexcept {
+        size_t next = blockIndex_ + 1;
+        if (next == historyBlocks_) next = 0;
+        historySum_ += static_cast<double>(blockSum_) - blockEnergy_[next];
+        blockEnergy_[blockIndex_] = blockSum_;
+        blockIndex_ = next;
+
+        // Ring wrapped: exact total from the block sums (no drift)
+        if (blockIndex_ == 0) {
+            historySum_ = 0.0;
+            for (size_t i = 1; i < historyBlocks_; ++i) historySum_ += blockEnergy_[i];
+        }
+
+        size_t oldest = blockIndex_ + 1;
+        if (oldest == historyBlocks_) oldest = 0;
+        outgoingEnergy_ = blockEnergy_[blockIndex_];
+        oldestEnergy_ = blockEnergy_[oldest];
+        historyEnergy_ = static_cast<float>(std::max(historySum_, 0.0));
+        blockSum_ = 0.0f;
+        blockFill_ = 0;
+    }
+
     float AGC::process(float input) noexcept {
         // ✅ PROTECTION 1: Input clamp
         input = std::clamp(input, -1.0f, 1.0f);
 
-        // ✅ RMS sliding window
-        const float oldSample = rmsBuffer_[writeIndex_];
-        const float newSample = input * input;
+        // ✅ RMS sliding window (block energies, see AGC.h)
+        addToWindow(input * input);
 
-        rmsBuffer_[writeIndex_] = newSample;
-        rmsSum_ += (newSample - oldSample);
-
-        // ✅ PROTECTION 2: RMS sum sécurité
-        if (rmsSum_ < 0.0f) rmsSum_ = 0.0f;
-
-        writeIndex_ = (writeIndex_ + 1) % windowSize_;
-
-        // Calculate current level (epsilon intégré)
-        const float rms = std::sqrt(rmsSum_ / static_cast<float>(windowSize_) + 1e-10f);
+        // Calculate current level (epsilon intégré; windowEnergy() ≥ 0)
+        const float rms = std::sqrt(windowEnergy() * invWindowSize_ + 1e-10f);
 
         // ✅ OPTIMISATION LUT: log10 remplacé par lookup table
         auto& dspMath = getDSPMath();
@@ -109,50 +131,99 @@ namespace soundarch::dsp {
         return std::clamp(output, -0.95f, 0.95f);
     }
 
+    // Squares of a segment into the window: spans up to the next block
+    // boundary, one vectorized sum of squares per span
+    void AGC::advanceWindow(const float* clamped, int numFrames) noexcept {
+        for (int start = 0; start < numFrames;) {
+            const int span = std::min(numFrames - start, kEnergyBlock - blockFill_);
+            const float* in = clamped + start;
+
+            float sum = 0.0f;
+            for (int i = 0; i < span; ++i) sum += in[i] * in[i];
+            blockSum_ += sum;
+            blockFill_ += span;
+            if (blockFill_ == kEnergyBlock) commitEnergyBlock();
+            start += span;
+        }
+    }
+
+    void AGC::processControlRate(const float* input, float* output, int numFrames) noexcept {
+        auto& dspMath = getDSPMath();
+        const int chunk = controlChunkFrames(controlInterval_);
+
+        // The ramp starts where the previous segment ended
+        float gain = dspMath.dbToLinear(currentGainDb_);
+
+        for (int chunkStart = 0; chunkStart < numFrames; chunkStart += chunk) {
+            const int frames = std::min(chunk, numFrames - chunkStart);
+            float* out = output + chunkStart;
+
+            // ✅ PROTECTION 1: Input clamp (the window sees the clamped samples)
+            const float* in = input + chunkStart;
+            for (int i = 0; i < frames; ++i) out[i] = std::clamp(in[i], -1.0f, 1.0f);
+
+            for (int start = 0; start < frames; start += controlInterval_) {
+                const int n = std::min(controlInterval_, frames - start);
+                advanceWindow(out + start, n);
+
+                const float rms = std::sqrt(windowEnergy() * invWindowSize_ + 1e-10f);
+                currentLevelDb_ = dspMath.linearToDb(rms);
+
+                // Noise gate: the gain holds
+                isFrozen_ = currentLevelDb_ < noiseThresholdDb_;
+                if (!isFrozen_) {
+                    const float error = targetLevelDb_ - currentLevelDb_;
+                    const float targetGainDb = std::clamp(error, minGainDb_, maxGainDb_);
+                    const float coef = (targetGainDb > currentGainDb_) ? attackSegment_.over(n)
+                                                                       : releaseSegment_.over(n);
+                    currentGainDb_ = coef * currentGainDb_ + (1.0f - coef) * targetGainDb;
+                }
+
+                const float next = dspMath.dbToLinear(currentGainDb_);
+                applyGainRamp(out + start, out + start, n, gain, next);
+                gain = next;
+            }
+
+            // ✅ PROTECTION 3: Hard limit final
+            for (int i = 0; i < frames; ++i) out[i] = std::clamp(out[i], -0.95f, 0.95f);
+        }
+    }
+
     // ✅ OPTIMIZED: Block processing - amortized RMS and gain calculations
     void AGC::processBlock(const float* input, float* output, int numFrames) noexcept {
+        if (controlInterval_ > 1) {
+            processControlRate(input, output, numFrames);
+            return;
+        }
+
         auto& dspMath = getDSPMath();
 
         for (int i = 0; i < numFrames; ++i) {
-            float sample = std::clamp(input[i], -1.0f, 1.0f);
-
-            // Update RMS
-            const float oldSample = rmsBuffer_[writeIndex_];
-            const float newSample = sample * sample;
-            rmsBuffer_[writeIndex_] = newSample;
-            rmsSum_ += (newSample - oldSample);
-            if (rmsSum_ < 0.0f) rmsSum_ = 0.0f;
-            writeIndex_ = (writeIndex_ + 1) % windowSize_;
-
-            // Calculate level (every sample for accuracy)
-            const float rms = std::sqrt(rmsSum_ / static_cast<float>(windowSize_) + 1e-10f);
-            currentLevelDb_ = dspMath.linearToDb(rms);
-
-            // Noise gate and gain calculation
-            if (currentLevelDb_ < noiseThresholdDb_) {
-                isFrozen_ = true;
-            } else {
-                isFrozen_ = false;
-                const float error = targetLevelDb_ - currentLevelDb_;
-                float targetGainDb = std::clamp(error, minGainDb_, maxGainDb_);
-                const float coef = (targetGainDb > currentGainDb_) ? attackCoef_ : releaseCoef_;
-                currentGainDb_ = coef * currentGainDb_ + (1.0f - coef) * targetGainDb;
-            }
-
-            // Apply gain
-            const float linearGain = dspMath.dbToLinear(currentGainDb_);
-            output[i] = std::clamp(sample * linearGain, -0.95f, 0.95f);
+            output[i] = processSample(input[i], dspMath);
         }
     }
 
     void AGC::reset() noexcept {
-        rmsBuffer_.fill(0.0f);
-        rmsSum_ = 0.0f;
-        writeIndex_ = 0;
+        clearState();
+        LOGI("🔄 AGC reset");
+    }
+
+    void AGC::clearState() noexcept {
+        // Window layout: K complete blocks + the remainder from block K + 1
+        historyBlocks_ = windowSize_ / kEnergyBlock + 1;
+        windowRemainder_ = static_cast<int>(windowSize_ % kEnergyBlock);
+        invWindowSize_ = 1.0f / static_cast<float>(windowSize_);
+        std::fill_n(blockEnergy_.begin(), historyBlocks_, 0.0f);
+        blockIndex_ = 0;
+        historySum_ = 0.0;
+        historyEnergy_ = 0.0f;
+        outgoingEnergy_ = 0.0f;
+        oldestEnergy_ = 0.0f;
+        blockSum_ = 0.0f;
+        blockFill_ = 0;
         currentGainDb_ = 0.0f;
         currentLevelDb_ = -60.0f;
         isFrozen_ = false;
-        LOGI("🔄 AGC reset");
     }
 
     void AGC::updateCoefficients() noexcept {
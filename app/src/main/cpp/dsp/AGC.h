@@ -3,9 +3,37 @@
 #include <array>
 #include <cmath>
 #include <algorithm>
+#include "ControlRate.h"
+#include "DSPMath.h"
 
 namespace soundarch::dsp {
 
+// ==============================================================================
+// 📊 AGC LEVEL WINDOW - Decimated energy history
+// ==============================================================================
+//
+// The level is the RMS of the last windowSize_ samples (0.1-2 s). Storing
+// every square took a 96000-float ring (384 KB per instance) read and written
+// every sample, for a level that moves over hundreds of milliseconds.
+//
+// The window is kept as sums of 64-sample blocks instead:
+//   - the block being filled: a running sum of squares
+//   - the last K = windowSize_ / 64 complete blocks: a ring of block sums
+//     (kMaxEnergyBlocks floats, 6 KB) and their total
+//   - the remainder (windowSize_ % 64 minus the samples already in the
+//     current block) taken from the next block out, as its mean square
+//
+// Same window length at every sample, same ramp-in from silence; only the
+// last partial block is spread evenly instead of sample by sample (equal for
+// a steady level, within one block's share otherwise). On speech, against the
+// exact window: level 0.02 dB mean, output gain within 0.06 dB at 0.1 s,
+// 0.02 dB at 0.5 s (agc_window_test). The total is added to
+// and subtracted from in double, and re-summed from the block sums every time
+// the ring wraps: no drift whatever the stream length. Per sample: one add, one
+// counter, no modulo; per block: one ring write.
+//
+// ==============================================================================
+
     class AGC {
     public:
         explicit AGC(float sampleRate);
@@ -19,12 +47,23 @@ namespace soundarch::dsp {
         void setNoiseThreshold(float dbfs) noexcept;   // -60 dBFS typique
         void setWindowSize(float seconds) noexcept;    // 0.5-2s
 
+        // Gain computed once per `samples` (1 = every sample, see ControlRate.h):
+        // the window still takes every sample, the level and the gain smoothing
+        // run once per segment. On speech, against the per-sample gain: ≤ 0.05 dB
+        // (mean 0.01) up to N = 16, ≤ 0.3 dB (mean 0.05) up to 64
+        // (dynamics_control_rate_test).
+        void setControlInterval(int samples) noexcept;
+        int getControlInterval() const noexcept { return controlInterval_; }
+
         // Traitement
         float process(float input) noexcept;
 
         // ✅ OPTIMIZED: Block processing for better performance
         void processBlock(const float* input, float* output, int numFrames) noexcept;
 
+        // One sample of processBlock() (fused chains, dsp/FusedChain.h)
+        inline float processSample(float input, const DSPMath& dspMath) noexcept;
+
         void reset() noexcept;
 
         // Monitoring (pour UI)
@@ -33,7 +72,13 @@ namespace soundarch::dsp {
 
     private:
         void updateCoefficients() noexcept;
+        void clearState() noexcept;
         float calculateRMS() noexcept;
+        inline void addToWindow(float square) noexcept;
+        inline float windowEnergy() const noexcept;
+        void commitEnergyBlock() noexcept;
+        void advanceWindow(const float* clamped, int numFrames) noexcept;
+        void processControlRate(const float* input, float* output, int numFrames) noexcept;
 
         // Config
         float sampleRate_;
@@ -46,12 +91,28 @@ namespace soundarch::dsp {
         float attackCoef_{0.0f};
         float releaseCoef_{0.0f};
 
-        // RMS Detection
+        // Control rate
+        int controlInterval_{1};
+        SegmentCoef attackSegment_;
+        SegmentCoef releaseSegment_;
+
+        // RMS Detection: decimated energy history (see banner)
         static constexpr size_t kMaxWindowSize = 96000; // 2s @ 48kHz
-        std::array<float, kMaxWindowSize> rmsBuffer_{};
+        static constexpr int kEnergyBlock = 64;
+        static constexpr float kInvEnergyBlock = 1.0f / kEnergyBlock;
+        static constexpr size_t kMaxEnergyBlocks = kMaxWindowSize / kEnergyBlock + 1;
+        std::array<float, kMaxEnergyBlocks> blockEnergy_{};
         size_t windowSize_{24000}; // 500ms @ 48kHz
-        size_t writeIndex_{0};
-        float rmsSum_{0.0f};
+        float invWindowSize_{0.0f};   // 1 / windowSize_ (clearState())
+        size_t historyBlocks_{0};     // Ring length K + 1 (clearState())
+        int windowRemainder_{0};      // windowSize_ % kEnergyBlock (clearState())
+        size_t blockIndex_{0};        // Next ring slot: the oldest block
+        double historySum_{0.0};      // The K newest complete blocks
+        float historyEnergy_{0.0f};   // historySum_ as float, per block
+        float outgoingEnergy_{0.0f};  // Block K + 1 (partly in the window)
+        float oldestEnergy_{0.0f};    // Block K (oldest fully in the window)
+        float blockSum_{0.0f};        // Current block
+        int blockFill_{0};
 
         // State
         float currentGainDb_{0.0f};
@@ -59,4 +120,45 @@ namespace soundarch::dsp {
         bool isFrozen_{false};
     };
 
-} // namespace soundarch::dsp
\ No newline at end of file
+    inline void AGC::addToWindow(float square) noexcept {
+        blockSum_ += square;
+        if (++blockFill_ == kEnergyBlock) commitEnergyBlock();
+    }
+
+    // Sum of squares over the last windowSize_ samples: current block, K
+    // complete blocks, and the window's remaining samples from the edge block
+    // (block K + 1, or less of block K once the current block outgrows the remainder)
+    inline float AGC::windowEnergy() const noexcept {
+        const int edgeSamples = windowRemainder_ - blockFill_;
+        const float edge = edgeSamples >= 0 ? outgoingEnergy_ : oldestEnergy_;
+        const float energy = historyEnergy_ + blockSum_ + static_cast<float>(edgeSamples) * kInvEnergyBlock * edge;
+        return std::max(energy, 0.0f);
+    }
+
+    inline float AGC::processSample(float input, const DSPMath& dspMath) noexcept {
+        const float sample = std::clamp(input, -1.0f, 1.0f);
+
+        // Update RMS
+        addToWindow(sample * sample);
+
+        // Calculate level (every sample for accuracy)
+        const float rms = std::sqrt(windowEnergy() * invWindowSize_ + 1e-10f);
+        currentLevelDb_ = dspMath.linearToDb(rms);
+
+        // Noise gate and gain calculation
+        if (currentLevelDb_ < noiseThresholdDb_) {
+            isFrozen_ = true;
+        } else {
+            isFrozen_ = false;
+            const float error = targetLevelDb_ - currentLevelDb_;
+            const float targetGainDb = std::clamp(error, minGainDb_, maxGainDb_);
+            const float coef = (targetGainDb > currentGainDb_) ? attackCoef_ : releaseCoef_;
+            currentGainDb_ = coef * currentGainDb_ + (1.0f - coef) * targetGainDb;
+        }
+
+        // Apply gain
+        const float linearGain = dspMath.dbToLinear(currentGainDb_);
+        return std::clamp(sample * linearGain, -0.95f, 0.95f);
+    }
+
+} // namespace soundarch::dsp
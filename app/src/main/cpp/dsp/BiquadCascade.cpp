@@ -0,0 +1,356 @@
+#include "BiquadCascade.h"
+#include "BiquadCascadeKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SOUNDARCH_CASCADE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SOUNDARCH_CASCADE_NEON 1
+#endif
+
+#ifndef SOUNDARCH_HAS_AVX2_KERNEL
+#define SOUNDARCH_HAS_AVX2_KERNEL 0
+#endif
+
+namespace soundarch::dsp {
+
+    namespace {
+        constexpr uint32_t kDitherSeed = 0x12345678u;   // As BiquadFilter
+        constexpr float kDitherAmplitude = 1e-7f;       // ~-140 dBFS
+
+        // One sample of one section: BiquadFilter::step() on a lane
+        inline float stepLane(CascadeLanes& l, int s, float in) noexcept {
+            l.dither[s] = l.dither[s] * cascade::kLcgMul + cascade::kLcgAdd;
+            const float dither = ((l.dither[s] >> 16) & 0xFFFF) / 65535.0f - 0.5f;
+
+            const float out = l.b0[s] * in + l.b1[s] * l.x1[s] + l.b2[s] * l.x2[s]
+                              - l.a1[s] * l.y1[s] - l.a2[s] * l.y2[s]
+                              + dither * l.ditherGain[s];
+
+            l.x2[s] = l.x1[s];
+            l.x1[s] = in;
+            l.y2[s] = l.y1[s];
+            l.y1[s] = (std::abs(out) < cascade::kDenormalThreshold) ? 0.0f : out;
+            return l.y1[s];
+        }
+
+        inline void glideLane(CascadeLanes& l, int s) noexcept {
+            l.b0[s] += l.db0[s];
+            l.b1[s] += l.db1[s];
+            l.b2[s] += l.db2[s];
+            l.a1[s] += l.da1[s];
+            l.a2[s] += l.da2[s];
+        }
+
+#if SOUNDARCH_CASCADE_SSE
+        // x86-64 baseline: SSE2 only (no 32-bit multiply, no blend)
+        struct SseOps {
+            using Float = __m128;
+            using Uint = __m128i;
+            using Mask = __m128;
+            static constexpr int kWidth = 4;
+
+            static Float load(const float* p) noexcept { return _mm_load_ps(p); }
+            static void store(float* p, Float v) noexcept { _mm_store_ps(p, v); }
+            static Uint loadUint(const uint32_t* p) noexcept { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+            static void storeUint(uint32_t* p, Uint v) noexcept { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+            static Float zero() noexcept { return _mm_setzero_ps(); }
+            static Float set1(float x) noexcept { return _mm_set1_ps(x); }
+            static Uint set1Uint(uint32_t x) noexcept { return _mm_set1_epi32(static_cast<int>(x)); }
+
+            static Float add(Float a, Float b) noexcept { return _mm_add_ps(a, b); }
+            static Float sub(Float a, Float b) noexcept { return _mm_sub_ps(a, b); }
+            static Float mul(Float a, Float b) noexcept { return _mm_mul_ps(a, b); }
+            static Float abs(Float a) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+            static Mask lessThan(Float a, Float b) noexcept { return _mm_cmplt_ps(a, b); }
+            static Float clearWhere(Mask m, Float a) noexcept { return _mm_andnot_ps(m, a); }
+            static Float select(Mask m, Float a, Float b) noexcept {
+                return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+            }
+            static Uint selectUint(Mask m, Uint a, Uint b) noexcept {
+                const __m128i mi = _mm_castps_si128(m);
+                return _mm_or_si128(_mm_and_si128(mi, a), _mm_andnot_si128(mi, b));
+            }
+
+            static Uint addUint(Uint a, Uint b) noexcept { return _mm_add_epi32(a, b); }
+            static Uint mulUint(Uint a, Uint b) noexcept {
+                // Low 32 bits of each product: even and odd lanes through _mm_mul_epu32
+                const __m128i even = _mm_mul_epu32(a, b);
+                const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+                return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                          _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+            }
+            static Uint shr16(Uint a) noexcept { return _mm_srli_epi32(a, 16); }
+            static Uint andUint(Uint a, Uint b) noexcept { return _mm_and_si128(a, b); }
+            static Float toFloat(Uint a) noexcept { return _mm_cvtepi32_ps(a); }   // Values < 2^16
+
+            // [carry's last lane, v0, v1, v2]
+            static Float shiftIn(Float v, Float carry) noexcept {
+                return _mm_move_ss(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)),
+                                   _mm_shuffle_ps(carry, carry, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+            static float lastLane(Float v) noexcept {
+                return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+
+            // Lanes first..first+3 whose sample t - lane lies in [0, n)
+            static Mask liveLanes(int t, int n, int first) noexcept {
+                const __m128i sample = _mm_sub_epi32(_mm_set1_epi32(t - first), _mm_setr_epi32(0, 1, 2, 3));
+                return _mm_castsi128_ps(_mm_and_si128(_mm_cmpgt_epi32(sample, _mm_set1_epi32(-1)),
+                                                      _mm_cmpgt_epi32(_mm_set1_epi32(n), sample)));
+            }
+        };
+#endif
+
+#if SOUNDARCH_CASCADE_NEON
+        struct NeonOps {
+            using Float = float32x4_t;
+            using Uint = uint32x4_t;
+            using Mask = uint32x4_t;
+            static constexpr int kWidth = 4;
+
+            static Float load(const float* p) noexcept { return vld1q_f32(p); }
+            static void store(float* p, Float v) noexcept { vst1q_f32(p, v); }
+            static Uint loadUint(const uint32_t* p) noexcept { return vld1q_u32(p); }
+            static void storeUint(uint32_t* p, Uint v) noexcept { vst1q_u32(p, v); }
+            static Float zero() noexcept { return vdupq_n_f32(0.0f); }
+            static Float set1(float x) noexcept { return vdupq_n_f32(x); }
+            static Uint set1Uint(uint32_t x) noexcept { return vdupq_n_u32(x); }
+
+            static Float add(Float a, Float b) noexcept { return vaddq_f32(a, b); }
+            static Float sub(Float a, Float b) noexcept { return vsubq_f32(a, b); }
+            static Float mul(Float a, Float b) noexcept { return vmulq_f32(a, b); }
+            static Float abs(Float a) noexcept { return vabsq_f32(a); }
+            static Mask lessThan(Float a, Float b) noexcept { return vcltq_f32(a, b); }
+            static Float clearWhere(Mask m, Float a) noexcept {
+                return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(a), m));
+            }
+            static Float select(Mask m, Float a, Float b) noexcept { return vbslq_f32(m, a, b); }
+            static Uint selectUint(Mask m, Uint a, Uint b) noexcept { return vbslq_u32(m, a, b); }
+
+            static Uint addUint(Uint a, Uint b) noexcept { return vaddq_u32(a, b); }
+            static Uint mulUint(Uint a, Uint b) noexcept { return vmulq_u32(a, b); }
+            static Uint shr16(Uint a) noexcept { return vshrq_n_u32(a, 16); }
+            static Uint andUint(Uint a, Uint b) noexcept { return vandq_u32(a, b); }
+            static Float toFloat(Uint a) noexcept { return vcvtq_f32_u32(a); }
+
+            // [carry's last lane, v0, v1, v2]
+            static Float shiftIn(Float v, Float carry) noexcept { return vextq_f32(carry, v, 3); }
+            static float lastLane(Float v) noexcept { return vgetq_lane_f32(v, 3); }
+
+            static Mask liveLanes(int t, int n, int first) noexcept {
+                static const int32_t kLane[4] = {0, 1, 2, 3};
+                const int32x4_t sample = vsubq_s32(vdupq_n_s32(t - first), vld1q_s32(kLane));
+                return vandq_u32(vcgeq_s32(sample, vdupq_n_s32(0)), vcltq_s32(sample, vdupq_n_s32(n)));
+            }
+        };
+#endif
+
+    } // anonymous namespace
+
+    const char* cascadeKernelName(CascadeKernel kernel) noexcept {
+        switch (kernel) {
+            case CascadeKernel::Scalar: return "scalar";
+            case CascadeKernel::SSE: return "sse";
+            case CascadeKernel::AVX2: return "avx2";
+            case CascadeKernel::NEON: return "neon";
+            default: return "?";
+        }
+    }
+
+    namespace cascade {
+
+        // Reference: section after section over the whole block
+        void processScalar(CascadeLanes& lanes, int sections, const float* input, float* output,
+                           int numFrames, bool glide) noexcept {
+            if (sections == 0 && input != output) std::copy(input, input + numFrames, output);
+            for (int s = 0; s < sections; ++s) {
+                const float* src = (s == 0) ? input : output;
+                if (glide) {
+                    for (int i = 0; i < numFrames; ++i) {
+                        glideLane(lanes, s);
+                        output[i] = stepLane(lanes, s, src[i]);
+                    }
+                } else {
+                    for (int i = 0; i < numFrames; ++i) output[i] = stepLane(lanes, s, src[i]);
+                }
+            }
+        }
+
+#if SOUNDARCH_CASCADE_SSE
+        void processSSE(CascadeLanes& lanes, int sections, const float* input, float* output,
+                        int numFrames, bool glide) noexcept {
+            runWavefront<SseOps, 4>(lanes, sections, input, output, numFrames, glide);
+        }
+#else
+        void processSSE(CascadeLanes& lanes, int sections, const float* input, float* output,
+                        int numFrames, bool glide) noexcept {
+            processScalar(lanes, sections, input, output, numFrames, glide);
+        }
+#endif
+
+#if SOUNDARCH_CASCADE_NEON
+        void processNEON(CascadeLanes& lanes, int sections, const float* input, float* output,
+                         int numFrames, bool glide) noexcept {
+            runWavefront<NeonOps, 4>(lanes, sections, input, output, numFrames, glide);
+        }
+#else
+        void processNEON(CascadeLanes& lanes, int sections, const float* input, float* output,
+                         int numFrames, bool glide) noexcept {
+            processScalar(lanes, sections, input, output, numFrames, glide);
+        }
+#endif
+
+#if !SOUNDARCH_HAS_AVX2_KERNEL
+        void processAVX2(CascadeLanes& lanes, int sections, const float* input, float* output,
+                         int numFrames, bool glide) noexcept {
+            processScalar(lanes, sections, input, output, numFrames, glide);
+        }
+#endif
+
+    } // namespace cascade
+
+    BiquadCascade::BiquadCascade() noexcept {
+        setSectionCount(0);
+        reset();
+        setKernel(bestKernel());
+    }
+
+    void BiquadCascade::setSectionCount(int count) noexcept {
+        sectionCount_ = std::clamp(count, 0, kMaxSections);
+        for (int s = 0; s < kMaxSections; ++s) {
+            lanes_.ditherGain[s] = (s < sectionCount_) ? kDitherAmplitude : 0.0f;
+            if (s >= sectionCount_) setSection(s, BiquadCoefficients{1.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+        }
+    }
+
+    void BiquadCascade::setSection(int section, const BiquadCoefficients& c) noexcept {
+        if (section < 0 || section >= kMaxSections) return;
+        lanes_.b0[section] = c.b0;
+        lanes_.b1[section] = c.b1;
+        lanes_.b2[section] = c.b2;
+        lanes_.a1[section] = c.a1;
+        lanes_.a2[section] = c.a2;
+        lanes_.db0[section] = lanes_.db1[section] = lanes_.db2[section] = 0.0f;
+        lanes_.da1[section] = lanes_.da2[section] = 0.0f;
+        targets_[section] = c;
+    }
+
+    void BiquadCascade::setSectionTarget(int section, const BiquadCoefficients& target) noexcept {
+        if (section < 0 || section >= sectionCount_) return;   // Pass-through lanes stay identity
+        targets_[section] = target;
+    }
+
+    void BiquadCascade::startGlide(int numFrames) noexcept {
+        if (numFrames <= 0) {
+            finishGlide();
+            return;
+        }
+        const float step = 1.0f / static_cast<float>(numFrames);
+        for (int s = 0; s < sectionCount_; ++s) {
+            const BiquadCoefficients& t = targets_[s];
+            lanes_.db0[s] = (t.b0 - lanes_.b0[s]) * step;
+            lanes_.db1[s] = (t.b1 - lanes_.b1[s]) * step;
+            lanes_.db2[s] = (t.b2 - lanes_.b2[s]) * step;
+            lanes_.da1[s] = (t.a1 - lanes_.a1[s]) * step;
+            lanes_.da2[s] = (t.a2 - lanes_.a2[s]) * step;
+        }
+        glideRemaining_ = numFrames;
+    }
+
+    // Lands on the targets exactly (no accumulated rounding)
+    void BiquadCascade::finishGlide() noexcept {
+        for (int s = 0; s < sectionCount_; ++s) setSection(s, targets_[s]);
+        glideRemaining_ = 0;
+    }
+
+    bool BiquadCascade::isSupported(CascadeKernel kernel) noexcept {
+        switch (kernel) {
+            case CascadeKernel::Scalar:
+                return true;
+            case CascadeKernel::SSE:
+#if SOUNDARCH_CASCADE_SSE
+                return true;
+#else
+                return false;
+#endif
+            case CascadeKernel::AVX2:
+#if SOUNDARCH_HAS_AVX2_KERNEL
+                return __builtin_cpu_supports("avx2");
+#else
+                return false;
+#endif
+            case CascadeKernel::NEON:
+#if SOUNDARCH_CASCADE_NEON
+                return true;
+#else
+                return false;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    CascadeKernel BiquadCascade::bestKernel() noexcept {
+        if (isSupported(CascadeKernel::AVX2)) return CascadeKernel::AVX2;
+        if (isSupported(CascadeKernel::SSE)) return CascadeKernel::SSE;
+        if (isSupported(CascadeKernel::NEON)) return CascadeKernel::NEON;
+        return CascadeKernel::Scalar;
+    }
+
+    void BiquadCascade::setKernel(CascadeKernel kernel) noexcept {
+        kernel_ = isSupported(kernel) ? kernel : CascadeKernel::Scalar;
+    }
+
+    void BiquadCascade::process(const float* input, float* output, int numFrames) noexcept {
+        if (numFrames <= 0) return;
+
+        // Gliding samples first, then the rest of the block on fixed coefficients
+        if (glideRemaining_ > 0) {
+            const int gliding = std::min(numFrames, glideRemaining_);
+            run(input, output, gliding, true);
+            glideRemaining_ -= gliding;
+            if (glideRemaining_ == 0) finishGlide();
+            input += gliding;
+            output += gliding;
+            numFrames -= gliding;
+        }
+        if (numFrames > 0) run(input, output, numFrames, false);
+    }
+
+    void BiquadCascade::run(const float* input, float* output, int numFrames, bool glide) noexcept {
+        switch (kernel_) {
+            case CascadeKernel::SSE: cascade::processSSE(lanes_, sectionCount_, input, output, numFrames, glide); break;
+            case CascadeKernel::AVX2: cascade::processAVX2(lanes_, sectionCount_, input, output, numFrames, glide); break;
+            case CascadeKernel::NEON: cascade::processNEON(lanes_, sectionCount_, input, output, numFrames, glide); break;
+            default: cascade::processScalar(lanes_, sectionCount_, input, output, numFrames, glide); break;
+        }
+    }
+
+    float BiquadCascade::processSample(float input) noexcept {
+        if (glideRemaining_ > 0) {
+            for (int s = 0; s < sectionCount_; ++s) {
+                glideLane(lanes_, s);
+                input = stepLane(lanes_, s, input);
+            }
+            if (--glideRemaining_ == 0) finishGlide();
+            return input;
+        }
+        for (int s = 0; s < sectionCount_; ++s) input = stepLane(lanes_, s, input);
+        return input;
+    }
+
+    void BiquadCascade::reset() noexcept {
+        std::fill(std::begin(lanes_.x1), std::end(lanes_.x1), 0.0f);
+        std::fill(std::begin(lanes_.x2), std::end(lanes_.x2), 0.0f);
+        std::fill(std::begin(lanes_.y1), std::end(lanes_.y1), 0.0f);
+        std::fill(std::begin(lanes_.y2), std::end(lanes_.y2), 0.0f);
+        std::fill(std::begin(lanes_.dither), std::end(lanes_.dither), kDitherSeed);
+    }
+
+} // namespace soundarch::dsp
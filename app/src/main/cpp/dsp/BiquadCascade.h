@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+
+namespace soundarch::dsp {
+
+// ==============================================================================
+// 🧮 BIQUAD CASCADE - Serial biquad sections, SIMD across sections
+// ==============================================================================
+//
+// A cascade has no parallelism inside one sample: section k needs the output
+// of section k-1, and each section needs its own previous output. Across
+// samples it does - section k can run sample t while section k-1 already
+// runs sample t+1. The vector kernels put one section per lane and run the
+// whole cascade as a wavefront:
+//
+//   step t:  lane 0 → sample t    lane 1 → sample t-1   ...   lane L-1 → t-L+1
+//
+// Every step is one vector biquad per group of lanes (3 × 4 lanes for 10
+// sections on SSE/NEON, 2 × 8 on AVX2); lane k's input is lane k-1's output
+// of the previous step, shifted in. The first and last L-1 steps of a block
+// run only part of the lanes (masked state update), so the output is the
+// same as section after section - no added latency, any block size, in place.
+//
+// Per section, the math is BiquadFilter::processBlock(): direct form I, the
+// -140 dBFS LCG dither and the denormal flush. Lanes past the last section
+// pass samples through. Float results differ from the scalar kernel only by
+// rounding order (tests: biquad_cascade_test).
+//
+// Kernels:
+//   - Scalar  reference, section after section (the former Equalizer path)
+//   - SSE     x86 (SSE2 baseline)
+//   - AVX2    x86, own translation unit built with -mavx2, chosen at runtime
+//   - NEON    arm64 / armv7 with NEON
+//
+// State and coefficients live in one aligned structure-of-arrays block;
+// kernels load it into registers once per block.
+//
+// Coefficient glides: setSectionTarget() + startGlide(n) move every section
+// linearly from its current coefficients to its target over the next n
+// samples (one add per coefficient per sample, in every kernel), then land
+// exactly on the target. A straight line between two stable biquads stays
+// stable (the (a1, a2) stability triangle is convex), and the filter state
+// is carried through - no click where the coefficients change.
+//
+// ==============================================================================
+
+    struct alignas(16) BiquadCoefficients {
+        float b0, b1, b2, a1, a2;
+    };
+
+    enum class CascadeKernel : int {
+        Scalar = 0,
+        SSE,
+        AVX2,
+        NEON
+    };
+
+    const char* cascadeKernelName(CascadeKernel kernel) noexcept;
+
+    // Structure of arrays, one lane per section (kernels and tests only)
+    struct alignas(32) CascadeLanes {
+        static constexpr int kLanes = 16;   // 2 × AVX2, 4 × SSE/NEON
+
+        float b0[kLanes];
+        float b1[kLanes];
+        float b2[kLanes];
+        float a1[kLanes];
+        float a2[kLanes];
+        float ditherGain[kLanes];   // -140 dBFS per section, 0 on pass-through lanes
+
+        // Per-sample coefficient step while gliding (0 on still sections)
+        float db0[kLanes];
+        float db1[kLanes];
+        float db2[kLanes];
+        float da1[kLanes];
+        float da2[kLanes];
+
+        float x1[kLanes];
+        float x2[kLanes];
+        float y1[kLanes];
+        float y2[kLanes];
+        uint32_t dither[kLanes];    // LCG state per section
+    };
+
+    class BiquadCascade {
+    public:
+        static constexpr int kMaxSections = CascadeLanes::kLanes;
+
+        BiquadCascade() noexcept;   // Pass-through, best supported kernel
+
+        // Sections run in index order: 0 first
+        void setSectionCount(int count) noexcept;
+        void setSection(int section, const BiquadCoefficients& c) noexcept;   // Immediate, ends its glide
+        int sectionCount() const noexcept { return sectionCount_; }
+
+        // Glide (audio thread): targets for the sections that move, then
+        // startGlide(n) - the next n processed samples interpolate towards
+        // them, across as many process() calls as it takes. A new glide
+        // starts from wherever the current one got to.
+        void setSectionTarget(int section, const BiquadCoefficients& target) noexcept;
+        void startGlide(int numFrames) noexcept;
+        bool isGliding() const noexcept { return glideRemaining_ > 0; }
+
+        // Kernel choice (tests, benchmarks); unsupported kernels fall back to Scalar
+        static bool isSupported(CascadeKernel kernel) noexcept;
+        static CascadeKernel bestKernel() noexcept;
+        void setKernel(CascadeKernel kernel) noexcept;
+        CascadeKernel kernel() const noexcept { return kernel_; }
+
+        // Audio thread. input == output allowed.
+        void process(const float* input, float* output, int numFrames) noexcept;
+
+        // One sample through every section (scalar, same state as process())
+        float processSample(float input) noexcept;
+
+        void reset() noexcept;   // Clears state and dither, keeps coefficients
+
+    private:
+        void run(const float* input, float* output, int numFrames, bool glide) noexcept;
+        void finishGlide() noexcept;
+
+        CascadeLanes lanes_{};
+        BiquadCoefficients targets_[kMaxSections]{};
+        int glideRemaining_ = 0;
+        int sectionCount_ = 0;
+        CascadeKernel kernel_ = CascadeKernel::Scalar;
+    };
+
+    // ━━━ Kernels (BiquadCascade.cpp, BiquadCascadeAVX2.cpp) ━━━
+    // glide: coefficients step by the lanes' deltas before every sample
+    namespace cascade {
+        void processScalar(CascadeLanes& lanes, int sections, const float* input, float* output, int numFrames,
+                           bool glide) noexcept;
+        void processSSE(CascadeLanes& lanes, int sections, const float* input, float* output, int numFrames,
+                        bool glide) noexcept;
+        void processAVX2(CascadeLanes& lanes, int sections, const float* input, float* output, int numFrames,
+                         bool glide) noexcept;
+        void processNEON(CascadeLanes& lanes, int sections, const float* input, float* output, int numFrames,
+                         bool glide) noexcept;
+    }
+
+} // namespace soundarch::dsp
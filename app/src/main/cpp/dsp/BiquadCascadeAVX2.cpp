@@ -0,0 +1,69 @@
+// AVX2 wavefront kernel (BiquadCascade.h). Built with -mavx2 on x86 only:
+// nothing here may run unless BiquadCascade::isSupported(CascadeKernel::AVX2).
+
+#include "BiquadCascadeKernel.h"
+
+#include <immintrin.h>
+
+namespace soundarch::dsp {
+
+    namespace {
+        struct Avx2Ops {
+            using Float = __m256;
+            using Uint = __m256i;
+            using Mask = __m256;
+            static constexpr int kWidth = 8;
+
+            static Float load(const float* p) noexcept { return _mm256_load_ps(p); }
+            static void store(float* p, Float v) noexcept { _mm256_store_ps(p, v); }
+            static Uint loadUint(const uint32_t* p) noexcept { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+            static void storeUint(uint32_t* p, Uint v) noexcept { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+            static Float zero() noexcept { return _mm256_setzero_ps(); }
+            static Float set1(float x) noexcept { return _mm256_set1_ps(x); }
+            static Uint set1Uint(uint32_t x) noexcept { return _mm256_set1_epi32(static_cast<int>(x)); }
+
+            static Float add(Float a, Float b) noexcept { return _mm256_add_ps(a, b); }
+            static Float sub(Float a, Float b) noexcept { return _mm256_sub_ps(a, b); }
+            static Float mul(Float a, Float b) noexcept { return _mm256_mul_ps(a, b); }
+            static Float abs(Float a) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+            static Mask lessThan(Float a, Float b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+            static Float clearWhere(Mask m, Float a) noexcept { return _mm256_andnot_ps(m, a); }
+            static Float select(Mask m, Float a, Float b) noexcept { return _mm256_blendv_ps(b, a, m); }
+            static Uint selectUint(Mask m, Uint a, Uint b) noexcept {
+                return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b), _mm256_castsi256_ps(a), m));
+            }
+
+            static Uint addUint(Uint a, Uint b) noexcept { return _mm256_add_epi32(a, b); }
+            static Uint mulUint(Uint a, Uint b) noexcept { return _mm256_mullo_epi32(a, b); }
+            static Uint shr16(Uint a) noexcept { return _mm256_srli_epi32(a, 16); }
+            static Uint andUint(Uint a, Uint b) noexcept { return _mm256_and_si256(a, b); }
+            static Float toFloat(Uint a) noexcept { return _mm256_cvtepi32_ps(a); }   // Values < 2^16
+
+            // [carry's last lane, v0 .. v6] - one lane-crossing permute each
+            static Float shiftIn(Float v, Float carry) noexcept {
+                const Float shifted = _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6));
+                const Float last = _mm256_permutevar8x32_ps(carry, _mm256_set1_epi32(7));
+                return _mm256_blend_ps(shifted, last, 0x01);
+            }
+            static float lastLane(Float v) noexcept {
+                const __m128 high = _mm256_extractf128_ps(v, 1);
+                return _mm_cvtss_f32(_mm_shuffle_ps(high, high, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+
+            static Mask liveLanes(int t, int n, int first) noexcept {
+                const __m256i sample = _mm256_sub_epi32(_mm256_set1_epi32(t - first),
+                                                        _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+                return _mm256_castsi256_ps(_mm256_and_si256(_mm256_cmpgt_epi32(sample, _mm256_set1_epi32(-1)),
+                                                            _mm256_cmpgt_epi32(_mm256_set1_epi32(n), sample)));
+            }
+        };
+    } // anonymous namespace
+
+    namespace cascade {
+        void processAVX2(CascadeLanes& lanes, int sections, const float* input, float* output,
+                         int numFrames, bool glide) noexcept {
+            runWavefront<Avx2Ops, 2>(lanes, sections, input, output, numFrames, glide);
+        }
+    }
+
+} // namespace soundarch::dsp
@@ -0,0 +1,177 @@
+#pragma once
+
+// ==============================================================================
+// Wavefront kernel shared by the SIMD paths (BiquadCascade.h)
+// ==============================================================================
+//
+// Ops is the ISA: vector types, width W and a handful of lane operations.
+// Include only from the kernel translation units, with Ops in an anonymous
+// namespace - the AVX2 one is built with different flags, its instantiations
+// must stay private to it.
+//
+// ==============================================================================
+
+#include "BiquadCascade.h"
+
+namespace soundarch::dsp::cascade {
+
+    constexpr float kDenormalThreshold = 1e-15f;   // As BiquadFilter
+    constexpr uint32_t kLcgMul = 1664525u;
+    constexpr uint32_t kLcgAdd = 1013904223u;
+
+    template<typename Ops, int Groups, bool Glide>
+    class Wavefront {
+    public:
+        using F = typename Ops::Float;
+        using U = typename Ops::Uint;
+        using M = typename Ops::Mask;
+        static constexpr int kWidth = Ops::kWidth;
+        static constexpr int kLanes = kWidth * Groups;
+        static_assert(kLanes <= CascadeLanes::kLanes, "More lanes than CascadeLanes holds");
+
+        explicit Wavefront(CascadeLanes& lanes) noexcept : lanes_(lanes) {
+            for (int g = 0; g < Groups; ++g) {
+                const int l = g * kWidth;
+                b0_[g] = Ops::load(lanes.b0 + l);
+                b1_[g] = Ops::load(lanes.b1 + l);
+                b2_[g] = Ops::load(lanes.b2 + l);
+                a1_[g] = Ops::load(lanes.a1 + l);
+                a2_[g] = Ops::load(lanes.a2 + l);
+                gain_[g] = Ops::load(lanes.ditherGain + l);
+                if constexpr (Glide) {
+                    db0_[g] = Ops::load(lanes.db0 + l);
+                    db1_[g] = Ops::load(lanes.db1 + l);
+                    db2_[g] = Ops::load(lanes.db2 + l);
+                    da1_[g] = Ops::load(lanes.da1 + l);
+                    da2_[g] = Ops::load(lanes.da2 + l);
+                }
+                x1_[g] = Ops::load(lanes.x1 + l);
+                x2_[g] = Ops::load(lanes.x2 + l);
+                y1_[g] = Ops::load(lanes.y1 + l);
+                y2_[g] = Ops::load(lanes.y2 + l);
+                dither_[g] = Ops::loadUint(lanes.dither + l);
+                out_[g] = Ops::zero();
+            }
+        }
+
+        ~Wavefront() {
+            for (int g = 0; g < Groups; ++g) {
+                const int l = g * kWidth;
+                Ops::store(lanes_.x1 + l, x1_[g]);
+                Ops::store(lanes_.x2 + l, x2_[g]);
+                Ops::store(lanes_.y1 + l, y1_[g]);
+                Ops::store(lanes_.y2 + l, y2_[g]);
+                Ops::storeUint(lanes_.dither + l, dither_[g]);
+                if constexpr (Glide) {
+                    Ops::store(lanes_.b0 + l, b0_[g]);
+                    Ops::store(lanes_.b1 + l, b1_[g]);
+                    Ops::store(lanes_.b2 + l, b2_[g]);
+                    Ops::store(lanes_.a1 + l, a1_[g]);
+                    Ops::store(lanes_.a2 + l, a2_[g]);
+                }
+            }
+        }
+
+        // Steps [0, L-1) and [n, n+L-1) run part of the lanes; the rest all of them
+        void run(const float* input, float* output, int n) noexcept {
+            const int steps = n + kLanes - 1;
+            const int fullBegin = kLanes - 1;
+            const int fullEnd = n > fullBegin ? n : fullBegin;
+
+            int t = 0;
+            for (; t < fullBegin && t < steps; ++t) step<true>(input, output, t, n);
+            for (; t < fullEnd; ++t) step<false>(input, output, t, n);
+            for (; t < steps; ++t) step<true>(input, output, t, n);
+        }
+
+    private:
+        template<bool Partial>
+        inline void step(const float* input, float* output, int t, int n) noexcept {
+            const F head = Ops::set1(t < n ? input[t] : 0.0f);
+
+            // Last group first: each group's input comes from the previous
+            // group's output of the previous step
+            for (int g = Groups - 1; g >= 0; --g) {
+                const F in = Ops::shiftIn(out_[g], g == 0 ? head : out_[g - 1]);
+                M live{};
+                if constexpr (Partial) live = Ops::liveLanes(t, n, g * kWidth);
+                if constexpr (Glide) {
+                    b0_[g] = bump<Partial>(b0_[g], db0_[g], live);
+                    b1_[g] = bump<Partial>(b1_[g], db1_[g], live);
+                    b2_[g] = bump<Partial>(b2_[g], db2_[g], live);
+                    a1_[g] = bump<Partial>(a1_[g], da1_[g], live);
+                    a2_[g] = bump<Partial>(a2_[g], da2_[g], live);
+                }
+
+                const U dither = Ops::addUint(Ops::mulUint(dither_[g], Ops::set1Uint(kLcgMul)),
+                                              Ops::set1Uint(kLcgAdd));
+                const F noise = Ops::mul(Ops::sub(Ops::mul(Ops::toFloat(Ops::andUint(Ops::shr16(dither), Ops::set1Uint(0xFFFFu))),
+                                                           Ops::set1(1.0f / 65535.0f)),
+                                                  Ops::set1(0.5f)),
+                                         gain_[g]);
+
+                F y = Ops::add(Ops::add(Ops::add(Ops::mul(b0_[g], in), Ops::mul(b1_[g], x1_[g])),
+                                        Ops::sub(Ops::mul(b2_[g], x2_[g]), Ops::mul(a1_[g], y1_[g]))),
+                               Ops::sub(noise, Ops::mul(a2_[g], y2_[g])));
+                y = Ops::clearWhere(Ops::lessThan(Ops::abs(y), Ops::set1(kDenormalThreshold)), y);
+                out_[g] = y;
+
+                if constexpr (Partial) {
+                    x2_[g] = Ops::select(live, x1_[g], x2_[g]);
+                    x1_[g] = Ops::select(live, in, x1_[g]);
+                    y2_[g] = Ops::select(live, y1_[g], y2_[g]);
+                    y1_[g] = Ops::select(live, y, y1_[g]);
+                    dither_[g] = Ops::selectUint(live, dither, dither_[g]);
+                } else {
+                    x2_[g] = x1_[g];
+                    x1_[g] = in;
+                    y2_[g] = y1_[g];
+                    y1_[g] = y;
+                    dither_[g] = dither;
+                }
+            }
+
+            const int done = t - (kLanes - 1);
+            if (done >= 0 && done < n) output[done] = Ops::lastLane(out_[Groups - 1]);
+        }
+
+        // One coefficient step per sample a lane filters: lanes outside the
+        // block keep theirs, so every section ends n steps further
+        template<bool Partial>
+        static inline F bump(F coefficient, F delta, M live) noexcept {
+            const F next = Ops::add(coefficient, delta);
+            if constexpr (Partial) return Ops::select(live, next, coefficient);
+            else return next;
+        }
+
+        CascadeLanes& lanes_;
+        F b0_[Groups], b1_[Groups], b2_[Groups], a1_[Groups], a2_[Groups], gain_[Groups];
+        F db0_[Groups], db1_[Groups], db2_[Groups], da1_[Groups], da2_[Groups];   // Glide only
+        F x1_[Groups], x2_[Groups], y1_[Groups], y2_[Groups];
+        U dither_[Groups];
+        F out_[Groups];   // Previous step's outputs: next step's inputs, one lane on
+    };
+
+    template<typename Ops, int Groups>
+    inline void runGroups(CascadeLanes& lanes, const float* input, float* output, int numFrames,
+                          bool glide) noexcept {
+        if (glide) Wavefront<Ops, Groups, true>(lanes).run(input, output, numFrames);
+        else Wavefront<Ops, Groups, false>(lanes).run(input, output, numFrames);
+    }
+
+    // Fewest groups covering the sections (lanes past them pass through)
+    template<typename Ops, int MaxGroups>
+    inline void runWavefront(CascadeLanes& lanes, int sections, const float* input, float* output,
+                             int numFrames, bool glide) noexcept {
+        const int groups = (sections + Ops::kWidth - 1) / Ops::kWidth;
+        if constexpr (MaxGroups >= 4) {
+            if (groups >= 4) { runGroups<Ops, 4>(lanes, input, output, numFrames, glide); return; }
+        }
+        if constexpr (MaxGroups >= 3) {
+            if (groups == 3) { runGroups<Ops, 3>(lanes, input, output, numFrames, glide); return; }
+        }
+        if (groups == 2) { runGroups<Ops, 2>(lanes, input, output, numFrames, glide); return; }
+        runGroups<Ops, 1>(lanes, input, output, numFrames, glide);
+    }
+
+} // namespace soundarch::dsp::cascade
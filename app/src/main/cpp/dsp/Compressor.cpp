@@ -34,6 +34,7 @@ namespace soundarch::dsp {
             : sampleRate_(sampleRate)
             , thresholdDb_(thresholdDb)
             , ratio_(ratio)
+            , slope_(1.0f - 1.0f / ratio)
             , kneeDb_(kneeDb)
             , makeupGainDb_(makeupGainDb)
             , envelope_(-60.0f)
@@ -41,30 +42,11 @@ namespace soundarch::dsp {
     {
         attackCoef_ = calcCoef(attackMs, sampleRate_);
         releaseCoef_ = calcCoef(releaseMs, sampleRate_);
+        attackSegment_.set(attackCoef_, controlInterval_);
+        releaseSegment_.set(releaseCoef_, controlInterval_);
 
         // ✅ OPTIMISATION LUT: Pré-calculer le makeup gain linéaire
-        makeupGainLin_ = getDSPMath().dbToLinear(makeupGainDb_);
-    }
-
-    float Compressor::detectLevel(float input) noexcept {
-        if (detectionMode_ == DetectionMode::PEAK) {
-            // Peak detection: instant absolute value
-            return std::fabs(input);
-        } else {
-            // RMS detection: windowed root-mean-square
-            const float oldSample = rmsBuffer_[rmsWriteIndex_];
-            const float newSample = input * input;
-
-            rmsBuffer_[rmsWriteIndex_] = newSample;
-            rmsSum_ += (newSample - oldSample);
-
-            // Safety: prevent negative sum due to float precision
-            if (rmsSum_ < 0.0f) rmsSum_ = 0.0f;
-
-            rmsWriteIndex_ = (rmsWriteIndex_ + 1) % rmsWindowSize_;
-
-            return std::sqrt(rmsSum_ / static_cast<float>(rmsWindowSize_) + 1e-10f);
-        }
+        makeupGainLin_.setImmediate(getDSPMath().dbToLinear(makeupGainDb_));
     }
 
     float Compressor::process(float input) noexcept {
@@ -78,30 +60,213 @@ namespace soundarch::dsp {
         const float coef = (inputDb > envelope_) ? attackCoef_ : releaseCoef_;
         envelope_ = coef * envelope_ + (1.0f - coef) * inputDb;
 
-        gainReductionDb_ = computeGain(envelope_);
+        gainReductionDb_ = computeGain(envelope_, thresholdDb_.next(), slope_.next(), kneeDb_);
 
         // ✅ OPTIMISATION LUT: pow remplacé par lookup table
         const float gainLin = dspMath.dbToLinear(gainReductionDb_);
-        const float output = input * gainLin * makeupGainLin_;
+        const float output = input * gainLin * makeupGainLin_.next();
 
         return output;
     }
 
-    // ✅ OPTIMIZED: Block processing - vectorizable envelope detection
-    void Compressor::processBlock(const float* input, float* output, int numFrames) noexcept {
+    // Per-sample path while a parameter ramp is in flight
+    void Compressor::processBlockRamping(const float* input, float* output, int numFrames) noexcept {
         auto& dspMath = getDSPMath();
 
         for (int i = 0; i < numFrames; ++i) {
-            const float inputLevel = detectLevel(input[i]);
-            const float inputDb = dspMath.linearToDb(inputLevel);
+            output[i] = processSample(input[i], thresholdDb_.next(), slope_.next(), makeupGainLin_.next(), dspMath);
+        }
+    }
 
-            const float coef = (inputDb > envelope_) ? attackCoef_ : releaseCoef_;
-            envelope_ = coef * envelope_ + (1.0f - coef) * inputDb;
+    // RMS window over a chunk: level[i] = sqrt(sum / W + 1e-10), the sum
+    // updated as detectLevel() does
+    void Compressor::detectRmsLevels(const float* input, float* level, int numFrames) noexcept {
+        const float window = static_cast<float>(rmsWindowSize_);
+        double sum = rmsSum_;
+
+        for (int start = 0; start < numFrames;) {
+            // Contiguous span of the ring: no wrap inside, no modulo
+            const int span = static_cast<int>(std::min<size_t>(numFrames - start, rmsWindowSize_ - rmsWriteIndex_));
+            float* ring = rmsBuffer_.data() + rmsWriteIndex_;
+            const float* in = input + start;
+            float* out = level + start;
+
+            // Only the add is on the dependency chain: squares and ring swaps overlap
+            for (int i = 0; i < span; ++i) {
+                const float square = in[i] * in[i];
+                sum = std::max(sum + (static_cast<double>(square) - ring[i]), 0.0);
+                ring[i] = square;
+                out[i] = static_cast<float>(sum);
+            }
+
+            rmsWriteIndex_ += static_cast<size_t>(span);
+            if (rmsWriteIndex_ == rmsWindowSize_) rmsWriteIndex_ = 0;
+            start += span;
+        }
+        rmsSum_ = sum;
+
+        for (int i = 0; i < numFrames; ++i) {
+            level[i] = std::sqrt(level[i] / window + 1e-10f);
+        }
+    }
 
-            gainReductionDb_ = computeGain(envelope_);
+    float Compressor::advanceRmsWindow(const float* input, int numFrames) noexcept {
+        double sum = rmsSum_;
+
+        for (int start = 0; start < numFrames;) {
+            const int span = static_cast<int>(std::min<size_t>(numFrames - start, rmsWindowSize_ - rmsWriteIndex_));
+            float* ring = rmsBuffer_.data() + rmsWriteIndex_;
+            const float* in = input + start;
+
+            // No per-sample level needed: one vectorized sum of the span's deltas
+            double delta = 0.0;
+            for (int i = 0; i < span; ++i) {
+                const float square = in[i] * in[i];
+                delta += static_cast<double>(square) - ring[i];
+                ring[i] = square;
+            }
+            sum = std::max(sum + delta, 0.0);
+
+            rmsWriteIndex_ += static_cast<size_t>(span);
+            if (rmsWriteIndex_ == rmsWindowSize_) rmsWriteIndex_ = 0;
+            start += span;
+        }
+        rmsSum_ = sum;
+
+        return std::sqrt(static_cast<float>(sum) / static_cast<float>(rmsWindowSize_) + 1e-10f);
+    }
 
-            const float gainLin = dspMath.dbToLinear(gainReductionDb_);
-            output[i] = input[i] * gainLin * makeupGainLin_;
+    void Compressor::processControlRate(const float* input, float* output, int numFrames,
+                                        float thresholdDb, float slope, float makeupLinear) noexcept {
+        auto& dspMath = getDSPMath();
+        alignas(32) float levelDb[kControlChunk];
+        const int chunk = controlChunkFrames(controlInterval_);
+        const bool peakMode = detectionMode_ == DetectionMode::PEAK;
+
+        // The ramp starts where the previous segment ended
+        float gain = dspMath.dbToLinear(gainReductionDb_) * makeupLinear;
+
+        for (int chunkStart = 0; chunkStart < numFrames; chunkStart += chunk) {
+            const int frames = std::min(chunk, numFrames - chunkStart);
+            const float* in = input + chunkStart;
+
+            // PEAK: every sample's level in dB, one batch for the chunk
+            if (peakMode) {
+                for (int i = 0; i < frames; ++i) {
+                    levelDb[i] = std::clamp(std::fabs(in[i]), DSPMath::LIN_MIN, DSPMath::LIN_MAX);
+                }
+                fastmath::linearToDb(levelDb, levelDb, frames);
+            }
+
+            for (int start = 0; start < frames; start += controlInterval_) {
+                const int n = std::min(controlInterval_, frames - start);
+
+                if (peakMode) {
+                    // One envelope step for the segment: attack on the mean excess
+                    // above it, release on the mean shortfall below it - the
+                    // per-sample recursion to first order
+                    const float env = envelope_;
+                    const float* db = levelDb + start;
+                    float above = 0.0f;
+                    float below = 0.0f;
+                    for (int i = 0; i < n; ++i) {
+                        above += std::max(db[i] - env, 0.0f);
+                        below += std::max(env - db[i], 0.0f);
+                    }
+                    const float inv = 1.0f / static_cast<float>(n);
+                    envelope_ = env + (1.0f - attackSegment_.over(n)) * above * inv
+                                    - (1.0f - releaseSegment_.over(n)) * below * inv;
+                } else {
+                    // RMS: the window after the segment's last sample
+                    const float rmsDb = dspMath.linearToDb(advanceRmsWindow(in + start, n));
+                    const float coef = rmsDb > envelope_ ? attackSegment_.over(n) : releaseSegment_.over(n);
+                    envelope_ = coef * envelope_ + (1.0f - coef) * rmsDb;
+                }
+                gainReductionDb_ = computeGain(envelope_, thresholdDb, slope, kneeDb_);
+
+                const float next = dspMath.dbToLinear(gainReductionDb_) * makeupLinear;
+                applyGainRamp(in + start, output + chunkStart + start, n, gain, next);
+                gain = next;
+            }
+        }
+    }
+
+    void Compressor::processTile(const float* input, float* output, int numFrames,
+                                 float thresholdDb, float slope, float makeupLinear) noexcept {
+        if (controlInterval_ > 1) {
+            processControlRate(input, output, numFrames, thresholdDb, slope, makeupLinear);
+            return;
+        }
+
+        // Gain curve, branch-free: the knee parabola is clamped to 0 below the
+        // knee and replaced by the straight line above it
+        const float halfKnee = 0.5f * kneeDb_;
+        const float kneeScale = kneeDb_ > 0.0f ? slope / (2.0f * kneeDb_) : 0.0f;
+        const float attack = attackCoef_;
+        const float release = releaseCoef_;
+
+        alignas(32) float work[kChunk];
+
+        for (int start = 0; start < numFrames; start += kChunk) {
+            const int n = std::min(kChunk, numFrames - start);
+            const float* in = input + start;
+
+            // 1️⃣ Level, clamped to the dB range (as DSPMath::linearToDb)
+            if (detectionMode_ == DetectionMode::PEAK) {
+                for (int i = 0; i < n; ++i) work[i] = std::fabs(in[i]);
+            } else {
+                detectRmsLevels(in, work, n);
+            }
+            for (int i = 0; i < n; ++i) {
+                work[i] = std::clamp(work[i], DSPMath::LIN_MIN, DSPMath::LIN_MAX);
+            }
+
+            // 2️⃣ → dB
+            fastmath::linearToDb(work, work, n);
+
+            // 3️⃣ Envelope: the recursion, select instead of branch
+            float env = envelope_;
+            for (int i = 0; i < n; ++i) {
+                const float x = work[i];
+                const float up = attack * env + (1.0f - attack) * x;
+                const float down = release * env + (1.0f - release) * x;
+                env = x > env ? up : down;
+                work[i] = env;
+            }
+            envelope_ = env;
+
+            // 4️⃣ Gain curve (dB, ≤ 0)
+            for (int i = 0; i < n; ++i) {
+                const float over = work[i] - thresholdDb;
+                const float x = std::clamp(over + halfKnee, 0.0f, kneeDb_);
+                const float reduction = over >= halfKnee ? over * slope : x * x * kneeScale;
+                work[i] = -reduction;
+            }
+            gainReductionDb_ = work[n - 1];
+            for (int i = 0; i < n; ++i) {
+                work[i] = std::max(work[i], DSPMath::DB_MIN);
+            }
+
+            // 5️⃣ → linear
+            fastmath::dbToLinear(work, work, n);
+
+            // 6️⃣ Apply (last: in place safe)
+            float* out = output + start;
+            for (int i = 0; i < n; ++i) {
+                out[i] = in[i] * work[i] * makeupLinear;
+            }
+        }
+    }
+
+    // ✅ OPTIMIZED: Block processing - vectorized pipeline in steady state
+    void Compressor::processBlock(const float* input, float* output, int numFrames) noexcept {
+        // One branch per block: the per-sample ramp loop only runs while a
+        // parameter update is being smoothed
+        if (isRamping()) {
+            processBlockRamping(input, output, numFrames);
+        } else {
+            processTile(input, output, numFrames,
+                        thresholdDb_.current(), slope_.current(), makeupGainLin_.current());
         }
     }
 
@@ -112,66 +277,61 @@ namespace soundarch::dsp {
 
         // Reset RMS buffer
         rmsBuffer_.fill(0.0f);
-        rmsSum_ = 0.0f;
+        rmsSum_ = 0.0;
         rmsWriteIndex_ = 0;
     }
 
-    float Compressor::computeGain(float inputLevelDb) noexcept {
-        const float overThreshold = inputLevelDb - thresholdDb_;
-
-        float gainReductionDb = 0.0f;
-
-        if (overThreshold <= -kneeDb_ / 2.0f) {
-            gainReductionDb = 0.0f;
-        }
-        else if (overThreshold >= kneeDb_ / 2.0f) {
-            gainReductionDb = overThreshold * (1.0f - 1.0f / ratio_);
-        }
-        else {
-            const float x = overThreshold + kneeDb_ / 2.0f;
-            gainReductionDb = x * x / (2.0f * kneeDb_) * (1.0f - 1.0f / ratio_);
-        }
-
-        return -gainReductionDb;
-    }
-
     void Compressor::reset() noexcept {
         envelope_ = -60.0f;
         gainReductionDb_ = 0.0f;
 
+        // Pending ramps land on their targets
+        thresholdDb_.finish();
+        slope_.finish();
+        makeupGainLin_.finish();
+
         // Reset RMS detection
         rmsBuffer_.fill(0.0f);
-        rmsSum_ = 0.0f;
+        rmsSum_ = 0.0;
         rmsWriteIndex_ = 0;
     }
 
-    void Compressor::setThreshold(float thresholdDb) noexcept {
-        thresholdDb_ = std::clamp(thresholdDb, -60.0f, 0.0f);
+    void Compressor::setThreshold(float thresholdDb, int32_t rampSamples) noexcept {
+        thresholdDb_.setTarget(std::clamp(thresholdDb, -60.0f, 0.0f), rampSamples);
     }
 
-    void Compressor::setRatio(float ratio) noexcept {
+    void Compressor::setRatio(float ratio, int32_t rampSamples) noexcept {
         ratio_ = std::clamp(ratio, 1.0f, 20.0f);
+        slope_.setTarget(1.0f - 1.0f / ratio_, rampSamples);
     }
 
     void Compressor::setAttack(float attackMs) noexcept {
         attackMs = std::clamp(attackMs, 0.1f, 100.0f);
         attackCoef_ = calcCoef(attackMs, sampleRate_);
+        attackSegment_.set(attackCoef_, controlInterval_);
     }
 
     void Compressor::setRelease(float releaseMs) noexcept {
         releaseMs = std::clamp(releaseMs, 10.0f, 1000.0f);
         releaseCoef_ = calcCoef(releaseMs, sampleRate_);
+        releaseSegment_.set(releaseCoef_, controlInterval_);
+    }
+
+    void Compressor::setControlInterval(int samples) noexcept {
+        controlInterval_ = clampControlInterval(samples);
+        attackSegment_.set(attackCoef_, controlInterval_);
+        releaseSegment_.set(releaseCoef_, controlInterval_);
     }
 
     void Compressor::setKnee(float kneeDb) noexcept {
         kneeDb_ = std::clamp(kneeDb, 0.0f, 12.0f);
     }
 
-    void Compressor::setMakeupGain(float gainDb) noexcept {
+    void Compressor::setMakeupGain(float gainDb, int32_t rampSamples) noexcept {
         makeupGainDb_ = std::clamp(gainDb, 0.0f, 24.0f);
 
-        // ✅ OPTIMISATION LUT: Recalculer le makeup gain linéaire
-        makeupGainLin_ = getDSPMath().dbToLinear(makeupGainDb_);
+        // ✅ OPTIMISATION LUT: Recalculer le makeup gain linéaire (ramp in the linear domain)
+        makeupGainLin_.setTarget(getDSPMath().dbToLinear(makeupGainDb_), rampSamples);
     }
 
     float Compressor::calculateAutoMakeupGain() const noexcept {
@@ -188,7 +348,7 @@ namespace soundarch::dsp {
          *
          * Note: This is an estimate. Actual reduction depends on signal level.
          */
-        const float avgReduction = std::abs(thresholdDb_) * (1.0f - 1.0f / ratio_);
+        const float avgReduction = std::abs(thresholdDb_.target()) * slope_.target();
         return avgReduction * 0.5f;  // Average over signal range
     }
 
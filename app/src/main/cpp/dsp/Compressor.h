@@ -3,6 +3,10 @@
 #include <cmath>
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include "ControlRate.h"
+#include "DSPMath.h"
+#include "SmoothedValue.h"
 
 namespace soundarch::dsp {
 
@@ -12,6 +16,38 @@ namespace soundarch::dsp {
         RMS     // RMS with sliding window (smooth, musical)
     };
 
+    // ==============================================================================
+    // 🗜️ COMPRESSOR - Block pipeline, per-sample reference
+    // ==============================================================================
+    //
+    // processBlock() runs a steady block (no ramp in flight) as passes over
+    // chunks of kChunk samples, each pass one loop the compiler vectorizes,
+    // except the envelope - the only recursion:
+    //
+    //   1. level      |x| (PEAK), or the RMS window: squares swapped into the
+    //                 ring over contiguous spans (no modulo), running sum (double), sqrt
+    //   2. → dB       fastmath::linearToDb batch (SIMD kernel)
+    //   3. envelope   attack/release one-pole, both branches computed, one select
+    //   4. gain curve threshold / ratio / knee without branches
+    //   5. → linear   fastmath::dbToLinear batch (SIMD kernel)
+    //   6. apply      x · gain · makeup
+    //
+    // Control rate (setControlInterval(N > 1), ControlRate.h): the envelope
+    // steps once per N-sample segment - PEAK: by the segment's mean distance
+    // above / below it (per-sample dB, batch), RMS: towards the window level
+    // after the segment's last sample; one gain curve and one dB → linear per
+    // segment, the linear gain ramped in between. Against the per-sample gain
+    // on speech: ≤ 0.15 dB (mean 0.025) up to N = 16, ≤ 0.5 dB (mean 0.12)
+    // up to 64 (dynamics_control_rate_test).
+    //
+    // process() and processSample() stay the per-sample reference (ramping
+    // blocks, ramped per-sample parameters). The pipeline matches them within
+    // 1e-5 relative on the output gain: fastmath::dbToLinear (6e-7) in place
+    // of the interpolated table (6e-6), knee term rounded once differently
+    // (compressor_pipeline_test).
+    //
+    // ==============================================================================
+
     class Compressor {
     public:
         explicit Compressor(
@@ -29,17 +65,35 @@ namespace soundarch::dsp {
         // ✅ OPTIMIZED: Block processing for better performance
         void processBlock(const float* input, float* output, int numFrames) noexcept;
 
+        // One sample of processBlock() with the block's gain curve (fused
+        // chains, dsp/FusedChain.h). Steady state only: no ramp in flight.
+        inline float processSample(float input, float thresholdDb, float slope, float makeupLinear,
+                                   const DSPMath& dspMath) noexcept;
+        // processBlock()'s steady-state pipeline with the block's gain curve
+        // (fused chains run it per tile). In place allowed.
+        void processTile(const float* input, float* output, int numFrames,
+                         float thresholdDb, float slope, float makeupLinear) noexcept;
+        float thresholdDb() const noexcept { return thresholdDb_.current(); }
+        float slope() const noexcept { return slope_.current(); }
+        float makeupGainLinear() const noexcept { return makeupGainLin_.current(); }
+
         void reset() noexcept;
 
-        void setThreshold(float thresholdDb) noexcept;
-        void setRatio(float ratio) noexcept;
+        // rampSamples > 0: per-sample linear ramp to the new value (audio
+        // thread only, see DSPChain parameter queue). 0 = immediate.
+        void setThreshold(float thresholdDb, int32_t rampSamples = 0) noexcept;
+        void setRatio(float ratio, int32_t rampSamples = 0) noexcept;
         void setAttack(float attackMs) noexcept;
         void setRelease(float releaseMs) noexcept;
         void setKnee(float kneeDb) noexcept;
-        void setMakeupGain(float gainDb) noexcept;
+        void setMakeupGain(float gainDb, int32_t rampSamples = 0) noexcept;
         void setDetectionMode(DetectionMode mode) noexcept { detectionMode_ = mode; }
         void setRMSWindowSize(float ms) noexcept;
 
+        // Gain computed once per `samples` (1 = every sample, see ControlRate.h)
+        void setControlInterval(int samples) noexcept;
+        int getControlInterval() const noexcept { return controlInterval_; }
+
         // ✅ Auto makeup gain: calculates optimal gain based on threshold/ratio
         // Formula: makeup ≈ threshold × (1 - 1/ratio) / 2
         void enableAutoMakeupGain(bool enable) noexcept;
@@ -48,21 +102,34 @@ namespace soundarch::dsp {
         float getCurrentGainReduction() const noexcept { return gainReductionDb_; }
         DetectionMode getDetectionMode() const noexcept { return detectionMode_; }
 
+        // Threshold / ratio / makeup still moving toward a new value
+        bool isRamping() const noexcept {
+            return thresholdDb_.isRamping() || slope_.isRamping() || makeupGainLin_.isRamping();
+        }
+
     private:
-        void updateCoefficients() noexcept;
-        float computeGain(float inputLevelDb) noexcept;
-        float detectLevel(float input) noexcept;  // Peak or RMS detection
+        void processBlockRamping(const float* input, float* output, int numFrames) noexcept;
+        static inline float computeGain(float inputLevelDb, float thresholdDb, float slope, float kneeDb) noexcept;
+        inline float detectLevel(float input) noexcept;  // Peak or RMS detection
+        void detectRmsLevels(const float* input, float* level, int numFrames) noexcept;
+        float advanceRmsWindow(const float* input, int numFrames) noexcept;   // Level after the last sample
+        void processControlRate(const float* input, float* output, int numFrames,
+                                float thresholdDb, float slope, float makeupLinear) noexcept;
+
+        // Samples per pipeline pass: one scratch buffer on the stack (1 KB)
+        static constexpr int kChunk = 256;
 
         float sampleRate_;
-        float thresholdDb_;
+        SmoothedValue thresholdDb_;
         float ratio_;
+        SmoothedValue slope_;          // 1 - 1/ratio: what the gain curve uses (and ramps)
         float kneeDb_;
         float makeupGainDb_;
         float attackCoef_;
         float releaseCoef_;
         float envelope_;
         float gainReductionDb_;
-        float makeupGainLin_;
+        SmoothedValue makeupGainLin_;
 
         // RMS Detection
         DetectionMode detectionMode_ = DetectionMode::PEAK;
@@ -70,10 +137,70 @@ namespace soundarch::dsp {
         std::array<float, kMaxRMSWindowSize> rmsBuffer_{};
         size_t rmsWindowSize_ = 480;  // 10ms @ 48kHz
         size_t rmsWriteIndex_ = 0;
-        float rmsSum_ = 0.0f;
+        double rmsSum_ = 0.0;   // Running sum: in float, a loud burst leaves rounding residue
+                                // larger than a quiet passage's whole sum
 
         // Auto makeup gain
         bool autoMakeupGain_ = false;
+
+        // Control rate
+        int controlInterval_ = 1;
+        SegmentCoef attackSegment_;
+        SegmentCoef releaseSegment_;
     };
 
-} // namespace soundarch::dsp
\ No newline at end of file
+    inline float Compressor::detectLevel(float input) noexcept {
+        if (detectionMode_ == DetectionMode::PEAK) {
+            // Peak detection: instant absolute value
+            return std::fabs(input);
+        } else {
+            // RMS detection: windowed root-mean-square
+            const float oldSample = rmsBuffer_[rmsWriteIndex_];
+            const float newSample = input * input;
+
+            rmsBuffer_[rmsWriteIndex_] = newSample;
+            rmsSum_ += static_cast<double>(newSample) - oldSample;
+
+            // Safety: prevent negative sum due to float precision
+            if (rmsSum_ < 0.0) rmsSum_ = 0.0;
+
+            if (++rmsWriteIndex_ == rmsWindowSize_) rmsWriteIndex_ = 0;
+
+            return std::sqrt(static_cast<float>(rmsSum_) / static_cast<float>(rmsWindowSize_) + 1e-10f);
+        }
+    }
+
+    inline float Compressor::computeGain(float inputLevelDb, float thresholdDb, float slope, float kneeDb) noexcept {
+        const float overThreshold = inputLevelDb - thresholdDb;
+
+        float gainReductionDb = 0.0f;
+
+        if (overThreshold <= -kneeDb / 2.0f) {
+            gainReductionDb = 0.0f;
+        }
+        else if (overThreshold >= kneeDb / 2.0f) {
+            gainReductionDb = overThreshold * slope;
+        }
+        else {
+            const float x = overThreshold + kneeDb / 2.0f;
+            gainReductionDb = x * x / (2.0f * kneeDb) * slope;
+        }
+
+        return -gainReductionDb;
+    }
+
+    inline float Compressor::processSample(float input, float thresholdDb, float slope, float makeupLinear,
+                                           const DSPMath& dspMath) noexcept {
+        const float inputLevel = detectLevel(input);
+        const float inputDb = dspMath.linearToDb(inputLevel);
+
+        const float coef = (inputDb > envelope_) ? attackCoef_ : releaseCoef_;
+        envelope_ = coef * envelope_ + (1.0f - coef) * inputDb;
+
+        gainReductionDb_ = computeGain(envelope_, thresholdDb, slope, kneeDb_);
+
+        const float gainLin = dspMath.dbToLinear(gainReductionDb_);
+        return input * gainLin * makeupLinear;
+    }
+
+} // namespace soundarch::dsp
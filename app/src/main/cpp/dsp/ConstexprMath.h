@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace soundarch::dsp::constmath {
+
+// ==============================================================================
+// 🧱 CONSTEXPR MATH - Transcendentals for compile-time tables (DSPTables.h)
+// ==============================================================================
+//
+// Double precision, range reduction + series run to convergence: ~1e-15
+// relative on the ranges the tables use (checked in DSPTables.cpp). Meant for
+// constant expressions only - at run time use FastMath.h or <cmath>.
+//
+// ==============================================================================
+
+    constexpr double kPi = 3.14159265358979323846;
+    constexpr double kLn2 = 0.69314718055994530942;
+    constexpr double kLn10 = 2.30258509299404568402;
+    constexpr double kSqrt2 = 1.41421356237309504880;
+
+    constexpr double abs(double x) noexcept { return x < 0.0 ? -x : x; }
+
+    constexpr long long roundToInt(double x) noexcept {
+        return static_cast<long long>(x < 0.0 ? x - 0.5 : x + 0.5);
+    }
+
+    // e^x - 1 for |x| ≤ ln2 / 2 (Taylor, no leading 1: exact near 0)
+    constexpr double expm1Reduced(double r) noexcept {
+        double term = r;
+        double sum = r;
+        for (int n = 2; n < 24; ++n) {
+            term *= r / n;
+            sum += term;
+        }
+        return sum;
+    }
+
+    // 2^k by squaring
+    constexpr double pow2(long long k) noexcept {
+        double base = k < 0 ? 0.5 : 2.0;
+        unsigned long long e = static_cast<unsigned long long>(k < 0 ? -k : k);
+        double p = 1.0;
+        while (e) {
+            if (e & 1u) p *= base;
+            base *= base;
+            e >>= 1u;
+        }
+        return p;
+    }
+
+    // e^x = 2^k · e^r, x = k ln2 + r
+    constexpr double exp(double x) noexcept {
+        const long long k = roundToInt(x / kLn2);
+        const double r = x - static_cast<double>(k) * kLn2;
+        return (1.0 + expm1Reduced(r)) * pow2(k);
+    }
+
+    constexpr double expm1(double x) noexcept {
+        return abs(x) <= 0.5 * kLn2 ? expm1Reduced(x) : exp(x) - 1.0;
+    }
+
+    // ln x, x > 0: x = m · 2^e with m in [√½, √2), ln m = 2 atanh((m - 1) / (m + 1))
+    constexpr double log(double x) noexcept {
+        long long e = 0;
+        while (x >= kSqrt2) { x *= 0.5; ++e; }
+        while (x < 0.5 * kSqrt2) { x *= 2.0; --e; }
+        const double s = (x - 1.0) / (x + 1.0);
+        const double s2 = s * s;
+        double term = s;
+        double sum = 0.0;
+        for (int n = 1; n < 40; n += 2) {
+            sum += term / n;
+            term *= s2;
+        }
+        return 2.0 * sum + static_cast<double>(e) * kLn2;
+    }
+
+    constexpr double pow10(double x) noexcept { return exp(x * kLn10); }
+    constexpr double dbToLinear(double db) noexcept { return pow10(db / 20.0); }
+
+    // x reduced to [-π, π], Taylor
+    constexpr double sin(double x) noexcept {
+        const double r = x - 2.0 * kPi * static_cast<double>(roundToInt(x / (2.0 * kPi)));
+        double term = r;
+        double sum = r;
+        for (int n = 1; n < 20; ++n) {
+            term *= -r * r / ((2.0 * n) * (2.0 * n + 1.0));
+            sum += term;
+        }
+        return sum;
+    }
+
+    constexpr double cos(double x) noexcept {
+        const double r = x - 2.0 * kPi * static_cast<double>(roundToInt(x / (2.0 * kPi)));
+        double term = 1.0;
+        double sum = 1.0;
+        for (int n = 1; n < 20; ++n) {
+            term *= -r * r / ((2.0 * n - 1.0) * (2.0 * n));
+            sum += term;
+        }
+        return sum;
+    }
+
+    // tanh = e / (e + 2), e = expm1(2x): accurate near 0 and at saturation
+    constexpr double tanh(double x) noexcept {
+        if (x > 20.0) return 1.0;
+        if (x < -20.0) return -1.0;
+        const double e = expm1(2.0 * x);
+        return e / (e + 2.0);
+    }
+
+    // ━━━ Table builder: entry i = float(f(i)), evaluated by the compiler ━━━
+    template<size_t N, typename F>
+    constexpr std::array<float, N> makeTable(F f) noexcept {
+        std::array<float, N> table{};
+        for (size_t i = 0; i < N; ++i) table[i] = static_cast<float>(f(i));
+        return table;
+    }
+
+} // namespace soundarch::dsp::constmath
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "FastMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace soundarch::dsp {
+
+// ==============================================================================
+// 🎚️ CONTROL RATE - Dynamics gain computed once per N samples
+// ==============================================================================
+//
+// AGC, Compressor and Limiter compute their gain for every sample by
+// default: level → dB, gain curve, dB → linear, 48000 times a second, for
+// time constants of milliseconds (compressor, limiter release) to seconds
+// (AGC). setControlInterval(N), N > 1 (DSPChain: Param::DynamicsControlInterval),
+// cuts each block into segments of N samples:
+//
+//   - the detector still sees every sample (RMS window, segment peak / mean)
+//   - envelope and gain curve run once per segment, the one-pole
+//     coefficient raised to the segment length (SegmentCoef: c^n)
+//   - the audio rate only ramps the linear gain across the segment, from
+//     the previous segment's gain to the new one
+//
+// A segment's gain comes from its own samples: no added latency, no gain
+// late on a transient. Segments restart with every call (block, fused tile),
+// the last one of a block may be shorter.
+//
+// 1 (default) keeps the per-sample path, which stays the reference: each
+// module documents how far its control path may deviate from it, and
+// dynamics_control_rate_test checks those bounds at every interval.
+//
+// ==============================================================================
+
+    constexpr int kMaxControlInterval = 64;   // 1.3 ms @ 48 kHz
+
+    constexpr int clampControlInterval(int samples) noexcept {
+        return std::clamp(samples, 1, kMaxControlInterval);
+    }
+
+    // Per-sample passes (clamps, dB conversion, soft clip) run over chunks of
+    // whole segments, at most kControlChunk samples (stack scratch)
+    constexpr int kControlChunk = 256;
+
+    constexpr int controlChunkFrames(int interval) noexcept {
+        return (kControlChunk / interval) * interval;
+    }
+
+    // One-pole coefficient c (per sample) over a segment of n samples: c^n
+    class SegmentCoef {
+    public:
+        // Control side (setters): one log2 / pow per change
+        void set(float perSample, int interval) noexcept {
+            log2Coef_ = static_cast<float>(std::log2(static_cast<double>(perSample)));
+            interval_ = interval;
+            perInterval_ = static_cast<float>(std::pow(static_cast<double>(perSample), interval));
+        }
+
+        // Full segments read the cached power, a short last segment pays one exp2
+        float over(int n) const noexcept {
+            return n == interval_ ? perInterval_ : fastmath::exp2(log2Coef_ * static_cast<float>(n));
+        }
+
+    private:
+        float log2Coef_ = 0.0f;
+        float perInterval_ = 1.0f;
+        int interval_ = 1;
+    };
+
+    // ━━━ Segment kernels (vectorized) ━━━
+    struct SegmentLevel {
+        float peak;
+        float meanAbs;
+    };
+
+    // Peak and mean of |x| in one pass
+    inline SegmentLevel segmentLevel(const float* x, int n) noexcept {
+        float peak = 0.0f;
+        float sum = 0.0f;
+        for (int i = 0; i < n; ++i) {
+            const float a = std::fabs(x[i]);
+            peak = std::max(peak, a);
+            sum += a;
+        }
+        return {peak, sum / static_cast<float>(n)};
+    }
+
+    // out[i] = in[i] · g, g ramping linearly from `from` (previous sample) to
+    // `to` (reached on the last one). In place allowed.
+    inline void applyGainRamp(const float* in, float* out, int n, float from, float to) noexcept {
+        const float step = (to - from) / static_cast<float>(n);
+        for (int i = 0; i < n; ++i) out[i] = in[i] * (from + step * static_cast<float>(i + 1));
+    }
+
+} // namespace soundarch::dsp
@@ -0,0 +1,565 @@
+#include "DSPChain.h"
+#include "../utils/RtGuard.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace soundarch::dsp {
+
+    namespace {
+        // Parameter → one module instance. Range checks live in the setters.
+        void applyTo(AGC& agc, Param id, float value, int32_t /*rampSamples*/) noexcept {
+            // AGC: its gain already follows attack/release, settings apply at once
+            switch (id) {
+                case Param::AGCTargetLevel:       agc.setTargetLevel(value); break;
+                case Param::AGCMaxGain:           agc.setMaxGain(value); break;
+                case Param::AGCMinGain:           agc.setMinGain(value); break;
+                case Param::AGCAttackTime:        agc.setAttackTime(value); break;
+                case Param::AGCReleaseTime:       agc.setReleaseTime(value); break;
+                case Param::AGCNoiseThreshold:    agc.setNoiseThreshold(value); break;
+                case Param::AGCWindowSize:        agc.setWindowSize(value); break;
+                case Param::DynamicsControlInterval:
+                    agc.setControlInterval(static_cast<int>(std::lround(value))); break;
+                default: break;
+            }
+        }
+
+        void applyTo(Compressor& compressor, Param id, float value, int32_t rampSamples) noexcept {
+            switch (id) {
+                case Param::CompressorThreshold:  compressor.setThreshold(value, rampSamples); break;
+                case Param::CompressorRatio:      compressor.setRatio(value, rampSamples); break;
+                case Param::CompressorAttack:     compressor.setAttack(value); break;
+                case Param::CompressorRelease:    compressor.setRelease(value); break;
+                case Param::CompressorKnee:       compressor.setKnee(value); break;
+                case Param::CompressorMakeupGain: compressor.setMakeupGain(value, rampSamples); break;
+                case Param::DynamicsControlInterval:
+                    compressor.setControlInterval(static_cast<int>(std::lround(value))); break;
+                default: break;
+            }
+        }
+
+        void applyTo(Limiter& limiter, Param id, float value, int32_t rampSamples) noexcept {
+            switch (id) {
+                case Param::LimiterThreshold:     limiter.setThreshold(value, rampSamples); break;
+                case Param::LimiterRelease:       limiter.setRelease(value); break;
+                case Param::LimiterLookahead:     limiter.setLookahead(value); break;
+                case Param::DynamicsControlInterval:
+                    limiter.setControlInterval(static_cast<int>(std::lround(value))); break;
+                default: break;
+            }
+        }
+
+        void applyTo(Equalizer& equalizer, Param id, float value, int32_t rampSamples) noexcept {
+            const int band = static_cast<int>(id) - static_cast<int>(Param::EqBand0);
+            equalizer.setBandGain(band, value, rampSamples);   // Range-checked by the EQ
+        }
+
+        // Keeps the first `count` instances, builds the missing ones
+        template<typename T, typename Make>
+        void resizeInstances(std::vector<std::shared_ptr<T>>& instances, size_t count, Make&& make) {
+            instances.resize(std::min(instances.size(), count));
+            while (instances.size() < count) instances.push_back(make());
+        }
+
+        void copyFrames(const float* in, float* out, int32_t numFrames) noexcept {
+            if (in != out) std::memcpy(out, in, static_cast<size_t>(numFrames) * sizeof(float));
+        }
+    } // anonymous namespace
+
+    DSPChain::DSPChain(float sampleRate) {
+        auto modules = std::make_unique<Modules>();
+        modules->sampleRate = sampleRate;
+        std::lock_guard<std::mutex> lock(swapMutex_);
+        install(std::move(modules), GraphSpec::defaultChain());
+    }
+
+    DSPChain::~DSPChain() {
+        // No reader left: the current set goes now, retired ones with reclaimer_
+        delete modules_.load(std::memory_order_relaxed);
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🏭 MODULE INSTANCES - Production defaults (previously inlined in startAudio())
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    template<typename M>
+    void DSPChain::applyPostedParameters(M& module) const noexcept {
+        for (size_t i = 0; i < kParamCount; ++i) {
+            float value;
+            if (params_.latest(static_cast<Param>(i), value)) applyTo(module, static_cast<Param>(i), value, 0);
+        }
+    }
+
+    std::shared_ptr<AGC> DSPChain::makeAGC(float sampleRate) const {
+        auto agc = std::make_shared<AGC>(sampleRate);
+        agc->setTargetLevel(-20.0f);
+        agc->setMaxGain(25.0f);
+        agc->setMinGain(-10.0f);
+        agc->setAttackTime(0.1f);   // Fast attack: 100ms
+        agc->setReleaseTime(0.5f);  // Fast release: 500ms
+        agc->setNoiseThreshold(-55.0f);
+        agc->setWindowSize(0.1f);
+        applyPostedParameters(*agc);
+        return agc;
+    }
+
+    std::shared_ptr<Equalizer> DSPChain::makeEqualizer(float sampleRate) const {
+        auto equalizer = std::make_shared<Equalizer>(sampleRate);
+        applyPostedParameters(*equalizer);
+        return equalizer;
+    }
+
+    std::shared_ptr<Compressor> DSPChain::makeCompressor(float sampleRate) const {
+        auto compressor = std::make_shared<Compressor>(sampleRate);
+        compressor->setThreshold(-20.0f);
+        compressor->setRatio(4.0f);
+        compressor->setAttack(5.0f);
+        compressor->setRelease(50.0f);
+        compressor->setMakeupGain(0.0f);
+        applyPostedParameters(*compressor);
+        return compressor;
+    }
+
+    std::shared_ptr<Limiter> DSPChain::makeLimiter(float sampleRate) const {
+        auto limiter = std::make_shared<Limiter>(sampleRate);
+        limiter->setThreshold(-1.0f);
+        limiter->setRelease(50.0f);
+        applyPostedParameters(*limiter);
+        return limiter;
+    }
+
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+    // swapMutex_ held (install()): the NC settings can't change under it
+    std::shared_ptr<noisecancel::NoiseCanceller> DSPChain::makeNoiseCanceller(float sampleRate) const {
+        auto noiseCanceller = std::make_shared<noisecancel::NoiseCanceller>();
+        noiseCanceller->init(static_cast<int>(sampleRate), 512);  // 512-point FFT
+        noiseCanceller->applyPreset(ncPreset_);
+        if (ncParams_) noiseCanceller->setParams(*ncParams_);
+        return noiseCanceller;
+    }
+#endif
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // ⚡ AUDIO THREAD
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    void DSPChain::processBlock(float* buffer, int32_t numFrames, const BlockContext& ctx) noexcept {
+        // ✅ CRITICAL: This runs on real-time audio thread
+        // NO malloc, NO new, NO vector, NO mutex, NO system calls
+        SOUNDARCH_RT_SCOPE();   // 🚨 Enforced in test builds (utils/RtGuard.h)
+
+        // 🔁 One module set for the whole block: a concurrent swap lands at the next one
+        reclaimer_.enter();
+        const Modules& m = *modules_.load(std::memory_order_seq_cst);
+
+        // 📨 Parameter updates posted since the last block land here, before any stage
+        if (params_.pending()) applyPendingParameters(m);
+        primed_ = true;
+
+        processStages(m, buffer, numFrames, ctx);
+
+        // 🧩 Meters while the set is still guaranteed alive
+        agcGainDb_.store(m.agc[0]->getCurrentGain(), std::memory_order_relaxed);
+        agcLevelDb_.store(m.agc[0]->getCurrentLevel(), std::memory_order_relaxed);
+        compressorReductionDb_.store(m.compressor[0]->getCurrentGainReduction(), std::memory_order_relaxed);
+        limiterReductionDb_.store(m.limiter[0]->getGainReduction(), std::memory_order_relaxed);
+        reclaimer_.exit();
+    }
+
+    void DSPChain::processStages(const Modules& m, float* buffer, int32_t numFrames,
+                                 const BlockContext& ctx) noexcept {
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        // 🛡️ SAFE MODE: Bypass DSP on Bluetooth underruns (limiter + pass-through)
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        if (ctx.safeMode) {
+            // Only apply limiter for peak protection, then pass through
+            if (isLimiterEnabled()) {
+                utils::StageProfiler* const profiler = ctx.profiler;
+                const uint64_t t = profiler ? utils::StageProfiler::now() : 0;
+                m.limiter[0]->processBlock(buffer, buffer, numFrames);
+                if (profiler) profiler->lap(utils::Stage::Limiter, t);
+            }
+            return;
+        }
+
+        // ⚡ Production routing: one fused pass (meter included)
+        if (processFused(m, buffer, numFrames, ctx)) return;
+
+        if (m.scratchBuffers == 0) {
+            // Serial routing: every stage in place on the caller's block
+            runSchedule(m, buffer, numFrames, ctx);
+        } else {
+            // Parallel branches: scratch buffers hold kScratchFrames
+            for (int32_t offset = 0; offset < numFrames; offset += kScratchFrames) {
+                runSchedule(m, buffer + offset, std::min(kScratchFrames, numFrames - offset), ctx);
+            }
+        }
+
+        // 📊 Output levels: one more pass on this path
+        if (ctx.levels) {
+            float peak = 0.0f;
+            float sumSquares = 0.0f;
+            for (int32_t i = 0; i < numFrames; ++i) {
+                peak = std::max(peak, std::abs(buffer[i]));
+                sumSquares += buffer[i] * buffer[i];
+            }
+            ctx.levels->peak = peak;
+            ctx.levels->sumSquares = sumSquares;
+            ctx.levels->samples = numFrames;
+        }
+    }
+
+    bool DSPChain::processFused(const Modules& m, float* buffer, int32_t numFrames,
+                                const BlockContext& ctx) noexcept {
+        if (!m.fusable || !isFusedProcessing()) return false;
+        if (!isAGCEnabled() || !isCompressorEnabled() || !isLimiterEnabled() || isNoiseCancellerEnabled()) {
+            return false;
+        }
+
+        // Voice gain: the chain's own, constant for the block
+        BlockLevels discarded;
+        const DSPMath& dspMath = getDSPMath();
+        Chain<AGC, Equalizer, Gain, Compressor, Limiter, Meter> chain(
+                FusedStage<AGC>{m.agc[0].get(), &dspMath},
+                FusedStage<Equalizer>{m.equalizer[0].get()},
+                FusedStage<Gain>{voiceGain_.current(), voiceGain_.isRamping()},
+                FusedStage<Compressor>{m.compressor[0].get(), &dspMath},
+                FusedStage<Limiter>{m.limiter[0].get(), &dspMath},
+                FusedStage<Meter>{ctx.levels ? ctx.levels : &discarded});
+        if (!chain.fusable()) return false;   // Ramp in flight: per-sample ramps run stage by stage
+
+        utils::StageProfiler* const profiler = ctx.profiler;
+        const uint64_t t = profiler ? utils::StageProfiler::now() : 0;
+        chain.process(buffer, numFrames);
+        if (profiler) profiler->lap(utils::Stage::FusedChain, t);
+        return true;
+    }
+
+    void DSPChain::runSchedule(const Modules& m, float* buffer, int32_t numFrames,
+                               const BlockContext& ctx) noexcept {
+        // ⏱️ Stage timing: each stage records [t, now) only when it actually ran
+        utils::StageProfiler* const profiler = ctx.profiler;
+        uint64_t t = profiler ? utils::StageProfiler::now() : 0;
+
+        float* const scratch = m.scratch.get();
+        auto bufferAt = [buffer, scratch](uint8_t index) noexcept {
+            return index == 0 ? buffer : scratch + static_cast<size_t>(index - 1) * kScratchFrames;
+        };
+
+        // 🧭 Flat schedule: one entry per stage invocation, buffers preassigned
+        for (const GraphOp& op : m.schedule) {
+            const float* in = bufferAt(op.in);
+            float* out = bufferAt(op.out);
+
+            switch (op.kind) {
+                // 1️⃣ AGC (Automatic Gain Control)
+                case StageKind::AGC:
+                    if (isAGCEnabled()) {
+                        static_cast<AGC*>(op.module)->processBlock(in, out, numFrames);
+                        if (profiler) t = profiler->lap(utils::Stage::AGC, t);
+                    } else {
+                        copyFrames(in, out, numFrames);
+                    }
+                    break;
+
+                // 2️⃣ Equalizer (Frequency shaping)
+                case StageKind::Equalizer:
+                    static_cast<Equalizer*>(op.module)->processBlock(in, out, numFrames);
+                    if (profiler) t = profiler->lap(utils::Stage::Equalizer, t);
+                    break;
+
+                // 2.5️⃣ Voice Gain (post-EQ, pre-Dynamics), linear: converted once per update
+                case StageKind::VoiceGain:
+                    if (voiceGain_.isRamping()) {
+                        for (int32_t i = 0; i < numFrames; ++i) {
+                            out[i] = in[i] * voiceGain_.next();
+                        }
+                        if (profiler) t = profiler->lap(utils::Stage::VoiceGain, t);
+                    } else if (voiceGain_.current() != 1.0f) {
+                        const float gainLinear = voiceGain_.current();
+                        for (int32_t i = 0; i < numFrames; ++i) {
+                            out[i] = in[i] * gainLinear;
+                        }
+                        if (profiler) t = profiler->lap(utils::Stage::VoiceGain, t);
+                    } else {
+                        copyFrames(in, out, numFrames);
+                    }
+                    break;
+
+                // 3️⃣ Noise Canceller (Spectral subtraction)
+                // NOTE: When disabled, processBlock() performs ZERO work (no FFT, early return)
+                case StageKind::NoiseCanceller:
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+                    if (isNoiseCancellerEnabled()) {
+                        static_cast<noisecancel::NoiseCanceller*>(op.module)->processBlock(in, out, numFrames, ctx.sampleRate);
+                        if (profiler) t = profiler->lap(utils::Stage::NoiseCanceller, t);
+                        break;
+                    }
+#endif
+                    copyFrames(in, out, numFrames);
+                    break;
+
+                // 4️⃣ Compressor (Dynamic control)
+                case StageKind::Compressor:
+                    if (isCompressorEnabled()) {
+                        static_cast<Compressor*>(op.module)->processBlock(in, out, numFrames);
+                        if (profiler) t = profiler->lap(utils::Stage::Compressor, t);
+                    } else {
+                        copyFrames(in, out, numFrames);
+                    }
+                    break;
+
+                // 5️⃣ Limiter (Peak protection)
+                case StageKind::Limiter:
+                    if (isLimiterEnabled()) {
+                        static_cast<Limiter*>(op.module)->processBlock(in, out, numFrames);
+                        if (profiler) t = profiler->lap(utils::Stage::Limiter, t);
+                    } else {
+                        copyFrames(in, out, numFrames);
+                    }
+                    break;
+
+                // 🔀 Parallel branches meet
+                case StageKind::Mix: {
+                    const float* in2 = bufferAt(op.in2);
+                    for (int32_t i = 0; i < numFrames; ++i) {
+                        out[i] = op.gain * in[i] + op.gain2 * in2[i];
+                    }
+                    break;
+                }
+
+                case StageKind::Copy:
+                    copyFrames(in, out, numFrames);
+                    break;
+
+                case StageKind::Count:
+                    break;
+            }
+        }
+    }
+
+    void DSPChain::setParameterSmoothingMs(float ms) noexcept {
+        smoothingMs_.store(std::clamp(ms, 0.0f, kMaxSmoothingMs), std::memory_order_relaxed);
+    }
+
+    ModuleMeters DSPChain::moduleMeters() const noexcept {
+        ModuleMeters meters;
+        meters.agcGainDb = agcGainDb_.load(std::memory_order_relaxed);
+        meters.agcLevelDb = agcLevelDb_.load(std::memory_order_relaxed);
+        meters.compressorGainReductionDb = compressorReductionDb_.load(std::memory_order_relaxed);
+        meters.limiterGainReductionDb = limiterReductionDb_.load(std::memory_order_relaxed);
+        return meters;
+    }
+
+    void DSPChain::applyPendingParameters(const Modules& modules) noexcept {
+        // Nothing has been played yet: jump, so an up-front configuration is exact
+        const int32_t rampSamples = primed_
+                ? static_cast<int32_t>(getParameterSmoothingMs() * 0.001f * modules.sampleRate)
+                : 0;
+        // EQ bands are gathered: a slider drag or a preset = one update per EQ
+        Equalizer::BandGains eqGains{};
+        uint32_t eqBands = 0;
+        params_.drain([this, &modules, rampSamples, &eqGains, &eqBands](Param id, float value) noexcept {
+            if (id == Param::VoiceGain) {
+                voiceGain_.setTarget(std::pow(10.0f, value / 20.0f), rampSamples);
+            } else if (id >= Param::EqBand0 && id <= Param::EqBand9) {
+                const int band = static_cast<int>(id) - static_cast<int>(Param::EqBand0);
+                eqGains[band] = value;
+                eqBands |= 1u << band;
+            } else {
+                applyParameter(modules, id, value, rampSamples);
+            }
+        });
+        if (eqBands != 0) {
+            for (const auto& equalizer : modules.equalizer) equalizer->setBandGains(eqGains, eqBands, rampSamples);
+        }
+    }
+
+    void DSPChain::applyParameter(const Modules& modules, Param id, float value, int32_t rampSamples) noexcept {
+        // Every instance of the stage: repeated stages share their settings
+        if (id <= Param::AGCWindowSize) {
+            for (const auto& agc : modules.agc) applyTo(*agc, id, value, rampSamples);
+        } else if (id <= Param::CompressorMakeupGain) {
+            for (const auto& compressor : modules.compressor) applyTo(*compressor, id, value, rampSamples);
+        } else if (id <= Param::LimiterLookahead) {
+            for (const auto& limiter : modules.limiter) applyTo(*limiter, id, value, rampSamples);
+        } else if (id >= Param::EqBand0 && id <= Param::EqBand9) {
+            for (const auto& equalizer : modules.equalizer) applyTo(*equalizer, id, value, rampSamples);
+        } else if (id == Param::DynamicsControlInterval) {
+            for (const auto& agc : modules.agc) applyTo(*agc, id, value, rampSamples);
+            for (const auto& compressor : modules.compressor) applyTo(*compressor, id, value, rampSamples);
+            for (const auto& limiter : modules.limiter) applyTo(*limiter, id, value, rampSamples);
+        }
+        // VoiceGain: chain-level, see applyPendingParameters()
+    }
+
+    void DSPChain::reset() noexcept {
+        const Modules& m = current();
+        primed_ = false;
+        voiceGain_.finish();
+        for (const auto& agc : m.agc) agc->reset();
+        for (const auto& equalizer : m.equalizer) equalizer->reset();
+        for (const auto& compressor : m.compressor) compressor->reset();
+        for (const auto& limiter : m.limiter) limiter->reset();
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+        for (const auto& noiseCanceller : m.noiseCanceller) noiseCanceller->init(static_cast<int>(m.sampleRate), 512);
+#endif
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🔁 HOT SWAP - Control threads: read, copy, publish, retire
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    GraphError DSPChain::install(std::unique_ptr<Modules> next, const GraphSpec& graph) {
+        CompiledGraph compiled;
+        const GraphError error = compileGraph(graph, hasNoiseCanceller(), compiled);
+        if (error != GraphError::None) return error;
+
+        // Occurrence N of a stage runs on instance N; the first one always exists
+        const float rate = next->sampleRate;
+        auto count = [&compiled](StageKind kind) {
+            return std::max<size_t>(1, static_cast<size_t>(compiled.instances[static_cast<int>(kind)]));
+        };
+        resizeInstances(next->agc, count(StageKind::AGC), [this, rate] { return makeAGC(rate); });
+        resizeInstances(next->equalizer, count(StageKind::Equalizer), [this, rate] { return makeEqualizer(rate); });
+        resizeInstances(next->compressor, count(StageKind::Compressor), [this, rate] { return makeCompressor(rate); });
+        resizeInstances(next->limiter, count(StageKind::Limiter), [this, rate] { return makeLimiter(rate); });
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+        resizeInstances(next->noiseCanceller, count(StageKind::NoiseCanceller),
+                        [this, rate] { return makeNoiseCanceller(rate); });
+#endif
+
+        for (GraphOp& op : compiled.ops) {
+            switch (op.kind) {
+                case StageKind::AGC: op.module = next->agc[op.instance].get(); break;
+                case StageKind::Equalizer: op.module = next->equalizer[op.instance].get(); break;
+                case StageKind::Compressor: op.module = next->compressor[op.instance].get(); break;
+                case StageKind::Limiter: op.module = next->limiter[op.instance].get(); break;
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+                case StageKind::NoiseCanceller: op.module = next->noiseCanceller[op.instance].get(); break;
+#endif
+                default: break;
+            }
+        }
+
+        // Production order, one instance each, in place (the NC op is skipped while disabled)
+        static constexpr StageKind kFusedOrder[] = {StageKind::AGC, StageKind::Equalizer, StageKind::VoiceGain,
+                                                    StageKind::Compressor, StageKind::Limiter};
+        size_t matched = 0;
+        bool inPlace = compiled.scratchBuffers == 0;
+        for (const GraphOp& op : compiled.ops) {
+            inPlace = inPlace && op.in == 0 && op.out == 0;
+            if (op.kind == StageKind::NoiseCanceller) continue;
+            if (matched < std::size(kFusedOrder) && op.kind == kFusedOrder[matched]) ++matched;
+            else matched = std::size(kFusedOrder) + 1;
+        }
+        next->fusable = inPlace && matched == std::size(kFusedOrder);
+
+        next->graph = graph;
+        next->schedule = std::move(compiled.ops);
+        next->scratchBuffers = compiled.scratchBuffers;
+        if (next->scratchBuffers > 0) {
+            next->scratch = std::make_unique<float[]>(static_cast<size_t>(next->scratchBuffers) * kScratchFrames);
+        }
+
+        std::unique_ptr<Modules> retired(modules_.exchange(next.release(), std::memory_order_seq_cst));
+        reclaimer_.retire(std::move(retired));   // Shared modules live on in the new set
+        return GraphError::None;
+    }
+
+    GraphError DSPChain::setGraph(const GraphSpec& graph) {
+        std::lock_guard<std::mutex> lock(swapMutex_);
+        const Modules& now = current();
+        auto next = std::make_unique<Modules>();
+        next->agc = now.agc;
+        next->equalizer = now.equalizer;
+        next->compressor = now.compressor;
+        next->limiter = now.limiter;
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+        next->noiseCanceller = now.noiseCanceller;
+#endif
+        next->sampleRate = now.sampleRate;
+        return install(std::move(next), graph);
+    }
+
+    template<typename T>
+    void DSPChain::replaceFirst(std::vector<std::shared_ptr<T>> Modules::*slot, std::unique_ptr<T> module) {
+        if (!module) return;
+        std::lock_guard<std::mutex> lock(swapMutex_);
+        const Modules& now = current();
+        auto next = std::make_unique<Modules>();
+        next->agc = now.agc;
+        next->equalizer = now.equalizer;
+        next->compressor = now.compressor;
+        next->limiter = now.limiter;
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+        next->noiseCanceller = now.noiseCanceller;
+#endif
+        next->sampleRate = now.sampleRate;
+        (next.get()->*slot)[0] = std::shared_ptr<T>(std::move(module));
+        install(std::move(next), now.graph);   // Compiled before: cannot fail
+    }
+
+    void DSPChain::replaceAGC(std::unique_ptr<AGC> agc) { replaceFirst(&Modules::agc, std::move(agc)); }
+
+    void DSPChain::replaceEqualizer(std::unique_ptr<Equalizer> equalizer) {
+        replaceFirst(&Modules::equalizer, std::move(equalizer));
+    }
+
+    void DSPChain::replaceCompressor(std::unique_ptr<Compressor> compressor) {
+        replaceFirst(&Modules::compressor, std::move(compressor));
+    }
+
+    void DSPChain::replaceLimiter(std::unique_ptr<Limiter> limiter) {
+        replaceFirst(&Modules::limiter, std::move(limiter));
+    }
+
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+    void DSPChain::replaceNoiseCanceller(std::unique_ptr<noisecancel::NoiseCanceller> noiseCanceller) {
+        replaceFirst(&Modules::noiseCanceller, std::move(noiseCanceller));
+    }
+#endif
+
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+    // ━━━ NoiseCanceller settings: kept here, applied to the live instances ━━━
+    void DSPChain::applyNoiseCancellerPreset(noisecancel::NoiseCancellerParams::Preset preset) {
+        std::lock_guard<std::mutex> lock(swapMutex_);
+        ncPreset_ = preset;
+        ncParams_.reset();   // A preset replaces the params set before it
+        for (const auto& noiseCanceller : current().noiseCanceller) noiseCanceller->applyPreset(preset);
+    }
+
+    void DSPChain::setNoiseCancellerParams(const noisecancel::NoiseCancellerParams& params) {
+        std::lock_guard<std::mutex> lock(swapMutex_);
+        ncParams_ = params;
+        for (const auto& noiseCanceller : current().noiseCanceller) noiseCanceller->setParams(params);
+    }
+
+    float DSPChain::noiseCancellerNoiseFloorDb() {
+        std::lock_guard<std::mutex> lock(swapMutex_);
+        return current().noiseCanceller[0]->getNoiseFloorDb();
+    }
+
+    float DSPChain::noiseCancellerCpuMs() {
+        std::lock_guard<std::mutex> lock(swapMutex_);
+        return current().noiseCanceller[0]->getCpuMs();
+    }
+
+    void DSPChain::resetNoiseCancellerCpuStats() {
+        std::lock_guard<std::mutex> lock(swapMutex_);
+        for (const auto& noiseCanceller : current().noiseCanceller) noiseCanceller->resetCpuStats();
+    }
+#endif
+
+    void DSPChain::setSampleRate(float sampleRate) {
+        if (!(sampleRate > 0.0f)) return;
+
+        // Every instance rebuilt here, on the control thread (allocations, filter design)
+        std::lock_guard<std::mutex> lock(swapMutex_);
+        auto next = std::make_unique<Modules>();
+        next->sampleRate = sampleRate;
+        install(std::move(next), current().graph);
+    }
+
+} // namespace soundarch::dsp
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "AGC.h"
+#include "Compressor.h"
+#include "Equalizer.h"
+#include "FusedChain.h"
+#include "Limiter.h"
+#include "ParameterQueue.h"
+#include "ProcessingGraph.h"
+#include "SmoothedValue.h"
+#include "../utils/EpochReclaimer.h"
+#include "../utils/StageProfiler.h"
+
+// Set by CMake when dsp/noisecancel/ is compiled into soundarch_dsp
+#ifndef SOUNDARCH_HAS_NOISE_CANCELLER
+#define SOUNDARCH_HAS_NOISE_CANCELLER 0
+#endif
+
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+#include "noisecancel/NoiseCanceller.h"
+#endif
+
+namespace soundarch::dsp {
+
+// ==============================================================================
+// 🎛️ DSP CHAIN - AGC → EQ → Voice Gain → NC → Compressor → Limiter
+// ==============================================================================
+//
+// The one and only implementation of the processing chain. Used by:
+//   - audio/EngineContext.cpp        (live Oboe stream, RT thread)
+//   - tools/OfflineRenderer.cpp      (files, faster than real time)
+//
+// Keeping both paths on the same code is what lets the offline renderer
+// reproduce device output bit-for-bit (same modules, same defaults, same
+// order, same block-level decisions).
+//
+// Thread Safety:
+//   - processBlock(): audio thread only (zero allocations, zero locks)
+//   - Enable flags: std::atomic, writable from any thread
+//   - Live parameters (voice gain, AGC, EQ, Compressor, Limiter):
+//     setParameter() from any thread → ParameterQueue → applied at the top
+//     of the next processBlock(), never in the middle of a block
+//   - Module accessors: monitoring, and setup before/between processing on
+//     the processing thread (tests, offline tools)
+//
+// Smoothing:
+//   Once audio has flowed, level-type parameters (voice gain, compressor
+//   threshold/ratio/makeup, limiter ceiling, EQ band gains) glide to the new
+//   value over getParameterSmoothingMs() instead of jumping (zipper noise).
+//   Time constants (attack, release, knee, lookahead) and AGC settings apply
+//   at once: the AGC gain is already a smoothed follower. Updates posted
+//   before the first block (or after reset()) apply immediately, so a chain
+//   configured up front renders exactly like one built with those values.
+//
+// Routing (dsp/ProcessingGraph.h):
+//   The stage order above is GraphSpec::defaultChain(). setGraph() installs
+//   any other routing: stages reordered, repeated (one module instance per
+//   occurrence, all receiving setParameter()), bypassed, or split and mixed.
+//   It is compiled once into a flat schedule; processBlock() walks that
+//   array. The enable flags still apply to every instance of their stage.
+//
+// Hot swap (structural changes without stopping the stream):
+//   Modules + compiled schedule are published as one immutable set behind an
+//   atomic pointer. processBlock() loads it once per block between
+//   EpochReclaimer enter() and exit(). setGraph() / replace*() /
+//   setSampleRate() build the new set on the control thread, exchange the
+//   pointer, and retire the old set: it is deleted on a control thread once
+//   the audio thread has finished the block that might still use it. A swap
+//   lands between two blocks, never inside one. Modules kept by the new set
+//   are shared, not copied: their state carries over.
+//
+// Fused fast path (dsp/FusedChain.h):
+//   The production routing with AGC, Compressor and Limiter on and the
+//   NoiseCanceller off runs as one compile-time Chain<AGC, Equalizer, Gain,
+//   Compressor, Limiter, Meter>: a single pass over the block, tile by tile,
+//   instead of one per stage (and per biquad). Same output up to EQ float
+//   rounding. Every other block - other
+//   routing or switches, a ramp in flight, Safe Mode, setFusedProcessing(false)
+//   - walks the schedule stage by stage (the dynamic fallback).
+//
+// Steady-state cost: one pending check per block, one ramp flag per module,
+// two atomic increments and one pointer load for the hot-swap epoch, one
+// switch per scheduled stage (fallback) or none (fused).
+//
+// ==============================================================================
+
+    struct BlockContext {
+        bool safeMode = false;     // Bluetooth Safe Mode: limiter only
+        int sampleRate = 48000;    // Actual stream rate (NoiseCanceller framing)
+        utils::StageProfiler* profiler = nullptr;   // Per-stage timing (live stream), null = off
+        BlockLevels* levels = nullptr;              // Out: output peak / sum of squares, null = off
+    };
+
+    // Module meters, copied after every block (readable from any thread,
+    // unlike the module accessors, whose object may be swapped out)
+    struct ModuleMeters {
+        float agcGainDb = 0.0f;
+        float agcLevelDb = -60.0f;
+        float compressorGainReductionDb = 0.0f;   // Module convention: ≤ 0
+        float limiterGainReductionDb = 0.0f;      // Module convention: ≤ 0
+    };
+
+    class DSPChain {
+    public:
+        // Creates every module with the production defaults from startAudio()
+        explicit DSPChain(float sampleRate);
+        ~DSPChain();
+
+        DSPChain(const DSPChain&) = delete;
+        DSPChain& operator=(const DSPChain&) = delete;
+
+        // ⚡ In-place block processing (RT-safe)
+        void processBlock(float* buffer, int32_t numFrames, const BlockContext& ctx) noexcept;
+
+        // Control thread only (re-initializes the NoiseCanceller)
+        void reset() noexcept;
+
+        // Module access (setup, monitoring): first instance of each stage.
+        // Control thread, and not across a setGraph() / replace*() /
+        // setSampleRate() issued from another thread.
+        AGC& agc() noexcept { return *current().agc[0]; }
+        Equalizer& equalizer() noexcept { return *current().equalizer[0]; }
+        Compressor& compressor() noexcept { return *current().compressor[0]; }
+        Limiter& limiter() noexcept { return *current().limiter[0]; }
+        const AGC& agc() const noexcept { return *current().agc[0]; }
+        const Equalizer& equalizer() const noexcept { return *current().equalizer[0]; }
+        const Compressor& compressor() const noexcept { return *current().compressor[0]; }
+        const Limiter& limiter() const noexcept { return *current().limiter[0]; }
+
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+        noisecancel::NoiseCanceller& noiseCanceller() noexcept { return *current().noiseCanceller[0]; }
+        const noisecancel::NoiseCanceller& noiseCanceller() const noexcept { return *current().noiseCanceller[0]; }
+#endif
+
+        // Meters of the last block (any thread)
+        ModuleMeters moduleMeters() const noexcept;
+
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        // 🔁 HOT SWAP (control threads, safe while processBlock() runs)
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        // New routing from the next block. Occurrence N of a stage keeps
+        // instance N of the current set (state and settings); extra instances
+        // are built with the production defaults plus every value posted
+        // through setParameter(). Returns the compile error, if any (the
+        // current routing stays).
+        GraphError setGraph(const GraphSpec& graph);
+        GraphSpec graph() const { return current().graph; }
+        size_t scheduledStageCount() const noexcept { return current().schedule.size(); }
+
+        // First instance of a stage. The new module must be fully built and
+        // configured, at getSampleRate(). It takes over from the next block;
+        // the old one is deleted off the audio thread. Null is ignored.
+        void replaceAGC(std::unique_ptr<AGC> agc);
+        void replaceEqualizer(std::unique_ptr<Equalizer> equalizer);
+        void replaceCompressor(std::unique_ptr<Compressor> compressor);
+        void replaceLimiter(std::unique_ptr<Limiter> limiter);
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+        void replaceNoiseCanceller(std::unique_ptr<noisecancel::NoiseCanceller> noiseCanceller);
+#endif
+
+        // Rebuilds every instance for a new stream rate (production defaults, then
+        // every value posted through setParameter() and the NoiseCanceller
+        // preset/params set below)
+        void setSampleRate(float sampleRate);
+
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+        // 🔇 NoiseCanceller settings and stats (control threads, not RT). The
+        // chain keeps the last preset and the params set after it, and hands
+        // them to every instance it builds later. Serialized with the swaps:
+        // no module is retired under these calls, unlike noiseCanceller().
+        void applyNoiseCancellerPreset(noisecancel::NoiseCancellerParams::Preset preset);
+        void setNoiseCancellerParams(const noisecancel::NoiseCancellerParams& params);
+        float noiseCancellerNoiseFloorDb();
+        float noiseCancellerCpuMs();
+        void resetNoiseCancellerCpuStats();
+#endif
+
+        // Frees retired modules the audio thread has moved past (also done by
+        // every swap). Returns how many still wait for the block in progress.
+        size_t reclaimRetired() noexcept { return reclaimer_.reclaim(); }
+        static constexpr bool hasNoiseCanceller() noexcept { return SOUNDARCH_HAS_NOISE_CANCELLER != 0; }
+
+        // ⚡ Fused single-pass path for the production routing (default on).
+        // Off: every block runs stage by stage, with per-stage profiler laps.
+        void setFusedProcessing(bool enabled) noexcept { fusedEnabled_.store(enabled, std::memory_order_relaxed); }
+        bool isFusedProcessing() const noexcept { return fusedEnabled_.load(std::memory_order_relaxed); }
+
+        // Enable/Disable flags (atomic, relaxed: no ordering needed)
+        void setAGCEnabled(bool e) noexcept { agcEnabled_.store(e, std::memory_order_relaxed); }
+        void setNoiseCancellerEnabled(bool e) noexcept { ncEnabled_.store(e, std::memory_order_relaxed); }
+        void setCompressorEnabled(bool e) noexcept { compressorEnabled_.store(e, std::memory_order_relaxed); }
+        void setLimiterEnabled(bool e) noexcept { limiterEnabled_.store(e, std::memory_order_relaxed); }
+        bool isAGCEnabled() const noexcept { return agcEnabled_.load(std::memory_order_relaxed); }
+        bool isNoiseCancellerEnabled() const noexcept { return ncEnabled_.load(std::memory_order_relaxed); }
+        bool isCompressorEnabled() const noexcept { return compressorEnabled_.load(std::memory_order_relaxed); }
+        bool isLimiterEnabled() const noexcept { return limiterEnabled_.load(std::memory_order_relaxed); }
+
+        // 📨 Live parameter update (any thread, coalesced, applied at the next block)
+        void setParameter(Param id, float value) noexcept { params_.post(id, value); }
+
+        // Ramp length for live updates (0 = jump, like a direct setter)
+        void setParameterSmoothingMs(float ms) noexcept;
+        float getParameterSmoothingMs() const noexcept { return smoothingMs_.load(std::memory_order_relaxed); }
+
+        // Voice Gain (post-EQ, pre-Dynamics), in dB. Range is enforced by the caller.
+        // Any thread: goes through the parameter queue like setParameter()
+        void setVoiceGainDb(float db) noexcept {
+            voiceGainDb_.store(db, std::memory_order_relaxed);
+            params_.post(Param::VoiceGain, db);
+        }
+        float getVoiceGainDb() const noexcept { return voiceGainDb_.load(std::memory_order_relaxed); }
+
+        float getSampleRate() const noexcept { return current().sampleRate; }
+
+        static constexpr float kDefaultSmoothingMs = 20.0f;
+        static constexpr float kMaxSmoothingMs = 500.0f;
+
+    private:
+        // One published generation: module instances + compiled schedule, never
+        // modified once published (scratch contents aside). Modules are
+        // heap-allocated (the Compressor carries a 19 KB RMS ring) and shared
+        // between generations; the last retired owner frees them, on a control
+        // thread.
+        struct Modules {
+            // [0] = first occurrence (accessors, safe mode); always present
+            std::vector<std::shared_ptr<AGC>> agc;
+            std::vector<std::shared_ptr<Equalizer>> equalizer;
+            std::vector<std::shared_ptr<Compressor>> compressor;
+            std::vector<std::shared_ptr<Limiter>> limiter;
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+            std::vector<std::shared_ptr<noisecancel::NoiseCanceller>> noiseCanceller;
+#endif
+            float sampleRate = 48000.0f;
+
+            GraphSpec graph;                      // Routing the schedule was compiled from
+            std::vector<GraphOp> schedule;        // Bound to the instances above
+            int scratchBuffers = 0;
+            std::unique_ptr<float[]> scratch;     // scratchBuffers x kScratchFrames (audio thread)
+            bool fusable = false;                 // Production order, in place: Chain<...> applies
+        };
+
+        // Graphs with parallel branches run in chunks of this many frames
+        static constexpr int32_t kScratchFrames = 256;
+
+        const Modules& current() const noexcept { return *modules_.load(std::memory_order_acquire); }
+
+        // Control thread: one instance with the production defaults + posted values
+        std::shared_ptr<AGC> makeAGC(float sampleRate) const;
+        std::shared_ptr<Equalizer> makeEqualizer(float sampleRate) const;
+        std::shared_ptr<Compressor> makeCompressor(float sampleRate) const;
+        std::shared_ptr<Limiter> makeLimiter(float sampleRate) const;
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+        std::shared_ptr<noisecancel::NoiseCanceller> makeNoiseCanceller(float sampleRate) const;
+#endif
+
+        // Control thread (swapMutex_ held): compiles `graph` for `next`, adds the
+        // missing instances, binds the schedule and publishes the set
+        GraphError install(std::unique_ptr<Modules> next, const GraphSpec& graph);
+
+        // Control thread: swaps the first instance of one stage
+        template<typename T>
+        void replaceFirst(std::vector<std::shared_ptr<T>> Modules::*slot, std::unique_ptr<T> module);
+
+        // Audio thread: every stage of one block / of one scratch-sized chunk
+        void processStages(const Modules& m, float* buffer, int32_t numFrames, const BlockContext& ctx) noexcept;
+        void runSchedule(const Modules& m, float* buffer, int32_t numFrames, const BlockContext& ctx) noexcept;
+        bool processFused(const Modules& m, float* buffer, int32_t numFrames, const BlockContext& ctx) noexcept;
+
+        // Audio thread: drain params_ and route each value to its module
+        void applyPendingParameters(const Modules& modules) noexcept;
+        // Module parameters only (VoiceGain belongs to the chain): every instance
+        static void applyParameter(const Modules& modules, Param id, float value, int32_t rampSamples) noexcept;
+        template<typename M>
+        void applyPostedParameters(M& module) const noexcept;
+
+        std::atomic<Modules*> modules_{nullptr};
+        utils::EpochReclaimer reclaimer_;
+        std::mutex swapMutex_;   // Serializes control-thread swaps (read-copy-publish)
+
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+        // swapMutex_: last preset, then the params set after it (none = preset's own)
+        noisecancel::NoiseCancellerParams::Preset ncPreset_ = noisecancel::NoiseCancellerParams::Preset::Default;
+        std::optional<noisecancel::NoiseCancellerParams> ncParams_;
+#endif
+
+        // Written after every block (relaxed): see moduleMeters()
+        std::atomic<float> agcGainDb_{0.0f};
+        std::atomic<float> agcLevelDb_{-60.0f};
+        std::atomic<float> compressorReductionDb_{0.0f};
+        std::atomic<float> limiterReductionDb_{0.0f};
+
+        std::atomic<bool> agcEnabled_{true};
+        std::atomic<bool> ncEnabled_{false};     // Disabled by default
+        std::atomic<bool> compressorEnabled_{true};
+        std::atomic<bool> limiterEnabled_{true};
+        std::atomic<bool> fusedEnabled_{true};
+
+        std::atomic<float> voiceGainDb_{0.0f};   // Default: 0dB (unity gain), last value requested
+
+        // Live parameters
+        ParameterQueue params_;
+        std::atomic<float> smoothingMs_{kDefaultSmoothingMs};
+        bool primed_ = false;                    // Audio thread: a block went out, updates must ramp
+        SmoothedValue voiceGain_{1.0f};          // Audio thread: linear voice gain actually applied
+    };
+
+} // namespace soundarch::dsp
@@ -0,0 +1,88 @@
+// ==============================================================================
+// Build-time accuracy check of the compile-time tables (DSPTables.h)
+// ==============================================================================
+//
+// Nothing here runs: every check is a static_assert, evaluated once when the
+// library builds. A table or generator outside its bound fails the build.
+//
+// ==============================================================================
+
+#include "DSPTables.h"
+#include "DSPMath.h"
+
+namespace soundarch::dsp::tables {
+
+    namespace {
+
+        constexpr bool near(double value, double expected, double relTol) noexcept {
+            return constmath::abs(value - expected) <= relTol * constmath::abs(expected);
+        }
+
+        // ━━━ Generators against libm reference values (double) ━━━
+        static_assert(near(constmath::exp(1.0), 2.718281828459045, 1e-14));
+        static_assert(near(constmath::exp(-10.0), 4.5399929762484854e-05, 1e-14));
+        static_assert(near(constmath::exp(5.0), 148.4131591025766, 1e-14));
+        static_assert(near(constmath::expm1(1e-5), 1.0000050000166668e-05, 1e-14));
+        static_assert(near(constmath::log(10.0), 2.302585092994046, 1e-14));
+        static_assert(near(constmath::log(1e-3), -6.907755278982137, 1e-14));
+        static_assert(near(constmath::log(3e5), 12.611537753638338, 1e-14));
+        static_assert(near(constmath::pow10(-3.0), 1e-3, 1e-14));
+        static_assert(near(constmath::pow10(3.0), 1e3, 1e-14));
+        static_assert(near(constmath::sin(1.0), 0.8414709848078965, 1e-14));
+        static_assert(near(constmath::sin(3.0), 0.1411200080598672, 1e-13));
+        static_assert(near(constmath::sin(100.0), -0.5063656411097588, 1e-13));
+        static_assert(near(constmath::cos(1.0), 0.5403023058681398, 1e-14));
+        static_assert(near(constmath::cos(-2.5), -0.8011436155469337, 1e-14));
+        static_assert(near(constmath::tanh(0.95), 0.7397830512740042, 1e-14));
+        static_assert(near(constmath::tanh(1e-4), 9.999999966666668e-05, 1e-14));
+        static_assert(near(constmath::tanh(-5.0), -0.9999092042625951, 1e-14));
+
+        // ━━━ dB → linéaire ━━━
+        constexpr double kDbStep = (static_cast<double>(kDbMax) - kDbMin) / (kDbTableSize - 1);
+
+        // Every entry is float(10^(dB/20)): half an ulp (6e-8) per entry, so
+        // mirrored entries multiply to 1 and neighbours keep a constant ratio
+        constexpr bool dbTableIsConsistent() noexcept {
+            const double ratio = constmath::dbToLinear(kDbStep);
+            for (int i = 0; i < kDbTableSize; ++i) {
+                const double mirrored = static_cast<double>(kDbToLinear[i]) * kDbToLinear[kDbTableSize - 1 - i];
+                if (!near(mirrored, 1.0, 1.5e-7)) return false;
+                if (i + 1 < kDbTableSize &&
+                    !near(static_cast<double>(kDbToLinear[i + 1]) / kDbToLinear[i], ratio, 1.5e-7)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        static_assert(near(kDbToLinear.front(), 1e-3, 6e-8));
+        static_assert(near(kDbToLinear.back(), 1e3, 6e-8));
+        static_assert(dbTableIsConsistent());
+
+        // DSPMath::dbToLinear interpolates: worst case is mid-interval
+        constexpr double maxInterpolationError() noexcept {
+            double worst = 0.0;
+            for (int i = 0; i + 1 < kDbTableSize; ++i) {
+                const float db = static_cast<float>(kDbMin + (i + 0.5) * kDbStep);
+                const double expected = constmath::dbToLinear(db);
+                const double error = constmath::abs(getDSPMath().dbToLinear(db) - expected) / expected;
+                if (error > worst) worst = error;
+            }
+            return worst;
+        }
+        static_assert(maxInterpolationError() < 6e-6, "DSPMath::dbToLinear: > 6e-6 relative");
+
+        // ━━━ Soft clip ━━━
+        static_assert(near(kSoftClipNorm, 1.3517476485543536, 6e-8));
+
+        // ━━━ Band sin/cos ━━━
+        constexpr std::array<float, 2> kProbe = {1000.0f, 16000.0f};
+        constexpr auto kProbe48000 = trigTable(kProbe, 48000.0);
+        constexpr auto kProbe44100 = trigTable(kProbe, 44100.0);
+        static_assert(near(kProbe48000.sin[0], 0.13052619222005157, 6e-8));
+        static_assert(near(kProbe44100.cos[1], -0.6509364691486809, 6e-8));
+        static_assert(near(static_cast<double>(kProbe48000.sin[1]) * kProbe48000.sin[1] +
+                           static_cast<double>(kProbe48000.cos[1]) * kProbe48000.cos[1], 1.0, 2e-7));
+
+    } // anonymous namespace
+
+} // namespace soundarch::dsp::tables
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ConstexprMath.h"
+
+#include <array>
+#include <cstddef>
+
+namespace soundarch::dsp::tables {
+
+// ==============================================================================
+// 📋 DSP TABLES - Generated by the compiler, read-only data
+// ==============================================================================
+//
+// Every table the DSP reads is a constexpr array: computed at build time in
+// double precision (ConstexprMath.h), stored in .rodata, one copy per process
+// whatever the number of engines, and mapped from the library file - shared
+// between processes and never written. No constructor, no first-use guard,
+// no transcendental math at startup.
+//
+// DSPTables.cpp checks them at build time (static_assert): a table outside
+// its bound fails the build. dsp_tables_test checks the same against libm.
+//
+// Adding one: a constexpr generator here (or next to its only user), the
+// bound in DSPTables.cpp.
+//
+// ==============================================================================
+
+    // ━━━ dB → linéaire (DSPMath): -60..+60 dB, 2400 points (~0.05 dB) ━━━
+    constexpr float kDbMin = -60.0f;
+    constexpr float kDbMax = 60.0f;
+    constexpr int kDbTableSize = 2400;
+
+    inline constexpr std::array<float, kDbTableSize> kDbToLinear =
+            constmath::makeTable<kDbTableSize>([](size_t i) {
+                const double step = (static_cast<double>(kDbMax) - kDbMin) / (kDbTableSize - 1);
+                return constmath::dbToLinear(kDbMin + static_cast<double>(i) * step);
+            });
+
+    // ━━━ Soft clip (Limiter): tanh(x · drive) / tanh(drive) maps ±1 → ±1 ━━━
+    constexpr float kSoftClipDrive = 0.95f;
+    constexpr float kSoftClipNorm = static_cast<float>(1.0 / constmath::tanh(kSoftClipDrive));
+
+    // ━━━ sin/cos of 2π f / rate for fixed frequencies (EQ bands) ━━━
+    // omega is rounded to float first, as std::sin(float) gets it at run time:
+    // a table and the run-time fallback for other rates agree to the ulp
+    template<size_t N>
+    struct TrigTable {
+        std::array<float, N> sin{};
+        std::array<float, N> cos{};
+    };
+
+    template<size_t N>
+    constexpr TrigTable<N> trigTable(const std::array<float, N>& freqs, double sampleRate) noexcept {
+        TrigTable<N> table{};
+        for (size_t i = 0; i < N; ++i) {
+            const double omega = static_cast<float>(2.0 * constmath::kPi * freqs[i] / sampleRate);
+            table.sin[i] = static_cast<float>(constmath::sin(omega));
+            table.cos[i] = static_cast<float>(constmath::cos(omega));
+        }
+        return table;
+    }
+
+} // namespace soundarch::dsp::tables
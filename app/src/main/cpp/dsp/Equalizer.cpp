@@ -1,4 +1,7 @@
 #include "Equalizer.h"
+#include "DSPTables.h"
+#include "FastMath.h"
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 
@@ -24,111 +27,145 @@ namespace soundarch::dsp {
     }
 
     void BiquadFilter::processBlock(const float* input, float* output, int numFrames) noexcept {
-        // ✅ OPTIMIZED: Block processing - compiler can vectorize this loop
-
-        // ✅ STABILITY: Flush denormals to zero (prevents 100x CPU hit)
-        // Denormal numbers occur when signals decay to near-zero
-        constexpr float DENORMAL_THRESHOLD = 1e-15f;
-
-        // ✅ STABILITY: Minimal dither to prevent denormal accumulation
-        // Tiny noise floor at -140dB - inaudible but prevents complete silence
-        constexpr float DITHER_AMPLITUDE = 1e-7f;  // ~-140dBFS
+        // ✅ OPTIMIZED: Block processing - dither state kept in a register
+        uint32_t dither_state = ditherState_;
 
         for (int i = 0; i < numFrames; ++i) {
-            const float in = input[i];
-
-            // Add minimal thermal dither (simple PRNG)
-            static uint32_t dither_state = 0x12345678;
-            dither_state = dither_state * 1664525u + 1013904223u;
-            const float dither = ((dither_state >> 16) & 0xFFFF) / 65535.0f - 0.5f;
-
-            const float out = coef_.b0 * in + coef_.b1 * x1_ + coef_.b2 * x2_
-                              - coef_.a1 * y1_ - coef_.a2 * y2_
-                              + dither * DITHER_AMPLITUDE;
-
-            // Update state with denormal flushing
-            x2_ = x1_;
-            x1_ = in;
-            y2_ = y1_;
-
-            // Flush denormals to zero
-            y1_ = (std::abs(out) < DENORMAL_THRESHOLD) ? 0.0f : out;
-
-            output[i] = y1_;
+            output[i] = step(input[i], dither_state);
         }
+
+        ditherState_ = dither_state;
     }
 
     void BiquadFilter::reset() noexcept {
         x1_ = x2_ = y1_ = y2_ = 0.0f;
+        ditherState_ = kDitherSeed;
+    }
+
+    namespace {
+        // process(float) has no block: a new set glides over this many samples
+        constexpr int kSampleGlideFrames = 64;
+
+        // sin/cos of the band centres at the device rates, built at compile time
+        constexpr auto kBandTrig44100 = tables::trigTable(Equalizer::kCenterFreqs, 44100.0);
+        constexpr auto kBandTrig48000 = tables::trigTable(Equalizer::kCenterFreqs, 48000.0);
     }
 
     Equalizer::Equalizer(float sampleRate)
             : sampleRate_(sampleRate) {
 
+        if (sampleRate_ == 48000.0f || sampleRate_ == 44100.0f) {
+            const auto& trig = (sampleRate_ == 48000.0f) ? kBandTrig48000 : kBandTrig44100;
+            sinOmega_ = trig.sin;
+            cosOmega_ = trig.cos;
+        } else {
+            for (int i = 0; i < kNumBands; ++i) {
+                const float omega = 2.0f * M_PI * kCenterFreqs[i] / sampleRate_;
+                sinOmega_[i] = std::sin(omega);
+                cosOmega_[i] = std::cos(omega);
+            }
+        }
+
         for (auto& gain : gains_) {
             gain.store(0.0f, std::memory_order_relaxed);
         }
 
-        // Initialise les deux jeux de filtres
-        for (int i = 0; i < kNumBands; ++i) {
-            updateCoefficients(i);
+        // Bandes à plat, chargées directement (rien à publier)
+        cascade_.setSectionCount(kNumBands);
+        for (int band = 0; band < kNumBands; ++band) {
+            uiSet_[band] = peakingCoefficients(band, 0.0f);
+            cascade_.setSection(section(band), uiSet_[band]);
         }
     }
 
 // ✅ FIX: Thread-safe setBandGain
-    void Equalizer::setBandGain(int band, float gainDb) noexcept {
+    void Equalizer::setBandGain(int band, float gainDb, int32_t rampSamples) noexcept {
         if (band < 0 || band >= kNumBands) return;
 
-        gainDb = std::clamp(gainDb, -12.0f, 12.0f);
-        gains_[band].store(gainDb, std::memory_order_release);
-
-        // Prépare les nouveaux coefficients sur le set INACTIF
-        updateCoefficients(band);
+        BandGains gains{};
+        gains[band] = gainDb;
+        setBandGains(gains, 1u << band, rampSamples);
     }
 
-// ✅ FIX: Lock-free process
-    float Equalizer::process(float input) noexcept {
-        // Lit le set actif atomiquement
-        int current = activeFilterSet_.load(std::memory_order_acquire);
+    void Equalizer::setBandGains(const BandGains& gainsDb, uint32_t bands, int32_t rampSamples) noexcept {
+        bands &= kAllBands;
+        if (bands == 0) return;
+
+        for (int band = 0; band < kNumBands; ++band) {
+            const uint32_t bit = 1u << band;
+            if (!(bands & bit)) continue;
+            const float gainDb = std::clamp(gainsDb[band], -12.0f, 12.0f);
+
+            if (rampSamples > 0) {
+                // Audio thread: glide from the gain the filter uses right now
+                SmoothedValue& ramp = bandRamps_[band];
+                if (!(rampingBands_ & bit)) ramp.setImmediate(gains_[band].load(std::memory_order_relaxed));
+                ramp.setTarget(gainDb, rampSamples);
+                if (ramp.isRamping()) rampingBands_ |= bit;
+                // The set holds the target too: a later unramped publish
+                // retargets every band and must not bring the old gain back
+                uiSet_[band] = peakingCoefficients(band, gainDb);
+            } else {
+                // A jump ends a glide in flight: advanceRamps() must not retarget the band
+                rampingBands_ &= ~bit;
+                bandRamps_[band].setImmediate(gainDb);
 
-        float out = input;
-        for (int i = 0; i < kNumBands; ++i) {
-            out = filters_[current][i].process(out);
+                // Prépare les nouveaux coefficients sur le set du thread de contrôle
+                uiSet_[band] = peakingCoefficients(band, gainDb);
+            }
+            gains_[band].store(gainDb, std::memory_order_release);
         }
 
-        return out;
+        // ✅ One publish for every band of the call
+        if (rampSamples <= 0) published_.write(uiSet_);
     }
 
-    // ✅ OPTIMIZED: Block processing - 5-30% less CPU
-    void Equalizer::processBlock(const float* input, float* output, int numFrames) noexcept {
-        int current = activeFilterSet_.load(std::memory_order_acquire);
+// ✅ FIX: Lock-free process
+    float Equalizer::process(float input) noexcept {
+        if (loadCoefficients()) cascade_.startGlide(started_ ? kSampleGlideFrames : 0);
+        started_ = true;
+        return cascade_.processSample(input);
+    }
 
+    // ✅ OPTIMIZED: Block processing - all bands in one SIMD cascade
+    void Equalizer::processBlock(const float* input, float* output, int numFrames) noexcept {
         // ✅ STABILITY: Process high→low frequency for better numerical stability
         // High-Q low-frequency filters accumulate errors less when processed last
+        prepareBlock(numFrames).process(input, output, numFrames);
+    }
 
-        // First band (16kHz - highest): input → output
-        filters_[current][kNumBands - 1].processBlock(input, output, numFrames);
-
-        // Remaining bands: in-place processing (high to low)
-        for (int band = kNumBands - 2; band >= 0; --band) {
-            filters_[current][band].processBlock(output, output, numFrames);
+    BiquadCascade& Equalizer::prepareBlock(int numFrames) noexcept {
+        // New set and/or moving ramps: the cascade glides there over this
+        // block. Nothing played yet: jump, an up-front configuration is exact.
+        bool moved = loadCoefficients();
+        if (rampingBands_ != 0) {
+            advanceRamps(numFrames);
+            moved = true;
         }
+        if (moved) cascade_.startGlide(started_ ? numFrames : 0);
+        started_ = true;
+        return cascade_;
     }
 
     void Equalizer::reset() noexcept {
-        for (auto& gain : gains_) {
-            gain.store(0.0f, std::memory_order_relaxed);
+        rampingBands_ = 0;
+        for (auto& ramp : bandRamps_) {
+            ramp.setImmediate(0.0f);
         }
 
-        for (auto& filterSet : filters_) {
-            for (auto& f : filterSet) {
-                f.reset();
-            }
+        for (auto& gain : gains_) {
+            gain.store(0.0f, std::memory_order_relaxed);
         }
 
-        for (int i = 0; i < kNumBands; ++i) {
-            updateCoefficients(i);
+        // Flat at once (no glide out of the old curve), published last so a
+        // stale set still in the buffer can't come back
+        cascade_.reset();
+        started_ = false;
+        for (int band = 0; band < kNumBands; ++band) {
+            uiSet_[band] = peakingCoefficients(band, 0.0f);
+            cascade_.setSection(section(band), uiSet_[band]);
         }
+        published_.write(uiSet_);
     }
 
     float Equalizer::getBandGain(int band) const noexcept {
@@ -136,18 +173,24 @@ namespace soundarch::dsp {
         return gains_[band].load(std::memory_order_acquire);
     }
 
-// ✅ FIX: Update sur le set INACTIF puis swap
-    void Equalizer::updateCoefficients(int band) noexcept {
-        if (band < 0 || band >= kNumBands) return;
+    // Audio thread: latest published set → cascade targets
+    bool Equalizer::loadCoefficients() noexcept {
+        CoefficientSet set;
+        if (!published_.read(set)) return false;
+
+        for (int band = 0; band < kNumBands; ++band) {
+            cascade_.setSectionTarget(section(band), set[band]);
+        }
+        return true;
+    }
 
-        const float freq = kCenterFreqs[band];
-        const float gain = gains_[band].load(std::memory_order_acquire);
+    // RBJ peaking EQ at the band's centre frequency
+    BiquadCoefficients Equalizer::peakingCoefficients(int band, float gainDb) const noexcept {
         const float Q = kDefaultQ;
 
-        const float A = std::pow(10.0f, gain / 40.0f);
-        const float omega = 2.0f * M_PI * freq / sampleRate_;
-        const float sn = std::sin(omega);
-        const float cs = std::cos(omega);
+        const float A = fastmath::dbToLinear(0.5f * gainDb);   // 10^(dB/40), exactly 1 at 0 dB
+        const float sn = sinOmega_[band];
+        const float cs = cosOmega_[band];
         const float alpha = sn / (2.0f * Q);
 
         const float a0 = 1.0f + alpha / A;
@@ -163,23 +206,21 @@ namespace soundarch::dsp {
         c.b2 = b2 / a0;
         c.a1 = a1 / a0;
         c.a2 = a2 / a0;
+        return c;
+    }
 
-        // ✅ Applique sur le set INACTIF
-        int current = activeFilterSet_.load(std::memory_order_acquire);
-        int inactive = 1 - current;
-
-        // Copie l'état des filtres pour éviter les clics
-        for (int i = 0; i < kNumBands; ++i) {
-            if (i == band) {
-                filters_[inactive][i].setCoefficients(c);
-            } else {
-                // Copie les coefficients existants
-                filters_[inactive][i] = filters_[current][i];
-            }
+    // Audio thread: moving bands target the coefficients of the gain they
+    // reach at the end of this block; the cascade glides there sample by sample
+    void Equalizer::advanceRamps(int numFrames) noexcept {
+        for (int band = 0; band < kNumBands; ++band) {
+            const uint32_t bit = 1u << band;
+            if (!(rampingBands_ & bit)) continue;
+
+            SmoothedValue& ramp = bandRamps_[band];
+            const float gainDb = ramp.skip(numFrames);
+            cascade_.setSectionTarget(section(band), peakingCoefficients(band, gainDb));
+            if (!ramp.isRamping()) rampingBands_ &= ~bit;
         }
-
-        // ✅ Swap atomique - pas de glitch
-        activeFilterSet_.store(inactive, std::memory_order_release);
     }
 
-} // namespace soundarch::dsp
\ No newline at end of file
+} // namespace soundarch::dsp
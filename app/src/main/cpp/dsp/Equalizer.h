@@ -2,28 +2,20 @@
 
 #include <array>
 #include <atomic>
+#include <cmath>
+#include <cstdint>
+#include "BiquadCascade.h"
+#include "SmoothedValue.h"
+#include "../utils/TripleBuffer.h"
 
 namespace soundarch::dsp {
 
-    struct alignas(16) BiquadCoefficients {
-        float b0, b1, b2, a1, a2;
-    };
-
     /**
-     * PERFORMANCE NOTE: Structure-of-Arrays (SoA) vs Array-of-Structures (AoS)
-     *
-     * Current: AoS layout - x1_, x2_, y1_, y2_ stored separately per filter
-     * - Simple implementation, cache-friendly for single filter
-     * - Prevents SIMD vectorization across multiple filters
+     * Single biquad section (AoS: one filter, its own state).
      *
-     * Alternative: SoA layout - all x1_[10], all x2_[10], all y1_[10], all y2_[10]
-     * - Enables NEON 4-way vectorization (process 4 bands in parallel)
-     * - More complex code, requires filter reordering
-     * - Estimated benefit: 10-20% faster for 10-band EQ
-     * - Trade-off: High refactor cost vs moderate performance gain
-     *
-     * Decision: Defer SoA refactor - current denormal + block optimizations
-     * provide 5-30% improvement with minimal complexity.
+     * PERFORMANCE NOTE: the Equalizer no longer runs ten of these one after
+     * the other - it keeps its bands in a BiquadCascade (SoA layout, one
+     * section per SIMD lane, see BiquadCascade.h). Same per-section math.
      */
     class BiquadFilter {
     public:
@@ -33,40 +25,83 @@ namespace soundarch::dsp {
         void reset() noexcept;
 
     private:
+        inline float step(float input, uint32_t& ditherState) noexcept;
+
         BiquadCoefficients coef_{};
         float x1_ = 0.0f, x2_ = 0.0f;
         float y1_ = 0.0f, y2_ = 0.0f;
+
+        // Per-filter dither PRNG: output depends only on this filter's input,
+        // not on what other filters (or other chains) processed before it
+        static constexpr uint32_t kDitherSeed = 0x12345678u;
+        uint32_t ditherState_ = kDitherSeed;
     };
 
+    inline float BiquadFilter::step(float in, uint32_t& ditherState) noexcept {
+        // ✅ STABILITY: Flush denormals to zero (prevents 100x CPU hit)
+        // Denormal numbers occur when signals decay to near-zero
+        constexpr float DENORMAL_THRESHOLD = 1e-15f;
+
+        // ✅ STABILITY: Minimal dither to prevent denormal accumulation
+        // Tiny noise floor at -140dB - inaudible but prevents complete silence
+        constexpr float DITHER_AMPLITUDE = 1e-7f;  // ~-140dBFS
+
+        // Add minimal thermal dither (simple PRNG)
+        ditherState = ditherState * 1664525u + 1013904223u;
+        const float dither = ((ditherState >> 16) & 0xFFFF) / 65535.0f - 0.5f;
+
+        const float out = coef_.b0 * in + coef_.b1 * x1_ + coef_.b2 * x2_
+                          - coef_.a1 * y1_ - coef_.a2 * y2_
+                          + dither * DITHER_AMPLITUDE;
+
+        // Update state with denormal flushing
+        x2_ = x1_;
+        x1_ = in;
+        y2_ = y1_;
+
+        // Flush denormals to zero
+        y1_ = (std::abs(out) < DENORMAL_THRESHOLD) ? 0.0f : out;
+        return y1_;
+    }
+
 // ==============================================================================
-// 🔒 THREAD-SAFE EQUALIZER - LOCK-FREE DOUBLE BUFFERING
+// 🔒 THREAD-SAFE EQUALIZER - WHOLE-SET PUBLISH + COEFFICIENT GLIDE
 // ==============================================================================
 //
 // Problem:
 //   Updating biquad coefficients during audio processing causes glitches
-//   (discontinuities in filter state as coefficients change mid-stream)
+//   (discontinuities in filter state as coefficients change mid-stream),
+//   and a slider drag moves several bands per UI frame
 //
-// Solution: DOUBLE BUFFERING with atomic swap
-//   1. UI thread updates INACTIVE filter set (filters_[1-activeFilterSet_])
-//   2. UI thread atomically flips activeFilterSet_ (0→1 or 1→0)
-//   3. Audio thread always reads activeFilterSet_ and uses that filter set
-//   4. Audio thread sees consistent filter state (no half-updated coefficients)
+// Solution: ONE PUBLISH PER UPDATE, INTERPOLATED ON THE AUDIO SIDE
+//   1. Control thread computes the new coefficients of every band it moves
+//      into its own copy of the set (uiSet_) - no filter state involved
+//   2. The whole set goes through a wait-free TripleBuffer: one publish per
+//      setBandGains() call, however many bands changed
+//   3. Audio thread picks the latest set up at the top of a block and glides
+//      the cascade to it over that block (BiquadCascade::startGlide)
+//   4. Audio thread never sees a half-written set, and never a step
 //
 // Thread Safety:
-//   - setBandGain() (UI thread):
-//       → Writes to inactive filter set
-//       → Atomic store to activeFilterSet_ with memory_order_release
-//       → Publishes all coefficient writes
+//   - setBandGain() / setBandGains() (one control thread):
+//       → Writes uiSet_ (its own), then TripleBuffer::write()
 //
 //   - processBlock() (Audio RT thread):
-//       → Atomic load of activeFilterSet_ with memory_order_acquire
-//       → Sees all coefficient updates from UI thread
-//       → Always processes with consistent filter state
+//       → TripleBuffer::read(): latest set or nothing, never waits
+//       → Filter state lives in the cascade, touched by the audio thread only
+//
+// Processing:
+//   - The ten bands run high → low as one BiquadCascade (section 0 = 16 kHz):
+//     SIMD wavefront across bands on SSE/AVX2/NEON, scalar elsewhere
 //
-// Performance:
-//   - Zero contention: UI and audio never access same filter set
-//   - Zero allocations: Both filter sets pre-allocated at construction
-//   - Zero latency penalty: Single atomic load per block (not per sample)
+// Live updates (DSPChain parameter queue):
+//   - setBandGains(gains, bands, rampSamples > 0) runs ON the audio thread
+//     and glides the band gains over rampSamples: once per block the moving
+//     bands get the coefficients of the gain at the block's end (one
+//     fastmath::dbToLinear per moving band; sin/cos of the centre frequencies
+//     come from compile-time tables at 44.1/48 kHz) and
+//     the cascade glides to them across the block. Don't mix with
+//     control-thread setBandGain() calls on the same chain.
 //
 // ==============================================================================
 
@@ -78,11 +113,20 @@ namespace soundarch::dsp {
                 1000.0f, 2000.0f, 4000.0f, 8000.0f, 16000.0f
         };
         static constexpr float kDefaultQ = 1.4142f;
+        static constexpr uint32_t kAllBands = (1u << kNumBands) - 1;
+
+        using BandGains = std::array<float, kNumBands>;
 
         explicit Equalizer(float sampleRate);
 
-        // ✅ Thread-safe: called from UI thread
-        void setBandGain(int band, float gainDb) noexcept;
+        // ✅ Thread-safe: called from UI thread (rampSamples == 0)
+        // rampSamples > 0: audio thread only, gain glides block by block
+        void setBandGain(int band, float gainDb, int32_t rampSamples = 0) noexcept;
+
+        // Bands whose bit is set in `bands` take gainsDb[band]: one publish
+        // (or one set of audio-thread ramps) for all of them
+        void setBandGains(const BandGains& gainsDb, uint32_t bands = kAllBands,
+                          int32_t rampSamples = 0) noexcept;
 
         // ✅ Lock-free: called from audio RT thread
         float process(float input) noexcept;
@@ -90,25 +134,49 @@ namespace soundarch::dsp {
         // ✅ OPTIMIZED: Block processing for better performance
         void processBlock(const float* input, float* output, int numFrames) noexcept;
 
+        // Fused chains (dsp/FusedChain.h): prepareBlock() once per block - the
+        // per-block part of processBlock() - then the cascade it returns.
+        // Same output as processBlock().
+        BiquadCascade& prepareBlock(int numFrames) noexcept;
+
+        // Kernel of the band cascade (tests, benchmarks): default is the best one
+        void setCascadeKernel(CascadeKernel kernel) noexcept { cascade_.setKernel(kernel); }
+        CascadeKernel cascadeKernel() const noexcept { return cascade_.kernel(); }
+
         void reset() noexcept;
         float getBandGain(int band) const noexcept;
+        bool isRamping() const noexcept { return rampingBands_ != 0; }
 
     private:
-        void updateCoefficients(int band) noexcept;
+        using CoefficientSet = std::array<BiquadCoefficients, kNumBands>;
+
+        // Band b runs as cascade section kNumBands-1-b (high → low)
+        static constexpr int section(int band) noexcept { return kNumBands - 1 - band; }
+
+        bool loadCoefficients() noexcept;
+        BiquadCoefficients peakingCoefficients(int band, float gainDb) const noexcept;
+        void advanceRamps(int numFrames) noexcept;
 
         float sampleRate_;
 
-        // ✅ DOUBLE BUFFERING: Two complete filter sets
-        // Audio thread reads filters_[activeFilterSet_]
-        // UI thread updates filters_[1 - activeFilterSet_], then swaps
-        std::array<BiquadFilter, kNumBands> filters_[2];
-        std::atomic<int> activeFilterSet_{0};  // 0 or 1
+        // ✅ Control thread's set, published whole; audio thread reads the latest
+        CoefficientSet uiSet_{};
+        utils::TripleBuffer<CoefficientSet> published_;
+
+        // Filter state + kernels (audio thread)
+        BiquadCascade cascade_;
+        bool started_ = false;   // Processed since construction / reset(): new sets glide
 
         // Gain storage for coefficient recalculation
         std::array<std::atomic<float>, kNumBands> gains_;
 
-        // Update flag (set by UI, cleared after swap)
-        std::atomic<bool> needsUpdate_{false};
+        // Fixed centre frequencies: sin/cos of omega (DSPTables.h at 44.1/48 kHz)
+        std::array<float, kNumBands> sinOmega_{};
+        std::array<float, kNumBands> cosOmega_{};
+
+        // Audio-thread gain ramps (setBandGain with rampSamples > 0)
+        std::array<SmoothedValue, kNumBands> bandRamps_{};
+        uint32_t rampingBands_ = 0;   // Bit per band still gliding
     };
 
-} // namespace soundarch::dsp
\ No newline at end of file
+} // namespace soundarch::dsp
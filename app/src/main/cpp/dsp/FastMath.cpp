@@ -0,0 +1,235 @@
+#include "FastMath.h"
+
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SOUNDARCH_FASTMATH_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SOUNDARCH_FASTMATH_NEON 1
+#endif
+
+#ifndef SOUNDARCH_HAS_AVX2_KERNEL
+#define SOUNDARCH_HAS_AVX2_KERNEL 0
+#endif
+
+namespace soundarch::dsp::fastmath {
+
+    namespace {
+
+        template<typename Ops>
+        constexpr MathKernels makeKernels() noexcept {
+            return {
+                    batch<Ops, exp2Core<Ops>>,
+                    batch<Ops, expCore<Ops>>,
+                    batch<Ops, log2Core<Ops>>,
+                    batch<Ops, tanhCore<Ops>>,
+                    batch<Ops, dbToLinearCore<Ops>>,
+                    batch<Ops, linearToDbCore<Ops>>,
+            };
+        }
+
+#if SOUNDARCH_FASTMATH_SSE
+        // x86-64 baseline: SSE2 only (no blend, no round instruction)
+        struct SseOps {
+            using Float = __m128;
+            using Int = __m128i;
+            using Mask = __m128;
+            static constexpr int kWidth = 4;
+
+            static Float loadu(const float* p) noexcept { return _mm_loadu_ps(p); }
+            static void storeu(float* p, Float v) noexcept { _mm_storeu_ps(p, v); }
+            static Float set1(float x) noexcept { return _mm_set1_ps(x); }
+
+            static Float add(Float a, Float b) noexcept { return _mm_add_ps(a, b); }
+            static Float sub(Float a, Float b) noexcept { return _mm_sub_ps(a, b); }
+            static Float mul(Float a, Float b) noexcept { return _mm_mul_ps(a, b); }
+            static Float div(Float a, Float b) noexcept { return _mm_div_ps(a, b); }
+            static Float min(Float a, Float b) noexcept { return _mm_min_ps(a, b); }
+            static Float max(Float a, Float b) noexcept { return _mm_max_ps(a, b); }
+            static Float abs(Float a) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+            static Float copySign(Float magnitude, Float sign) noexcept {
+                const __m128 signBit = _mm_set1_ps(-0.0f);
+                return _mm_or_ps(_mm_andnot_ps(signBit, magnitude), _mm_and_ps(signBit, sign));
+            }
+            static Mask greaterThan(Float a, Float b) noexcept { return _mm_cmpgt_ps(a, b); }
+            static Float select(Mask m, Float a, Float b) noexcept {
+                return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+            }
+
+            static Int roundToInt(Float x) noexcept { return _mm_cvtps_epi32(x); }   // MXCSR: nearest
+            static Float toFloat(Int n) noexcept { return _mm_cvtepi32_ps(n); }
+            static Float scaleByPow2(Float p, Int n) noexcept {
+                return _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(p), _mm_slli_epi32(n, 23)));
+            }
+            static Float exponent(Float x) noexcept {
+                return _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(x), 23), _mm_set1_epi32(127)));
+            }
+            static Float mantissa(Float x) noexcept {
+                return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(_mm_castps_si128(x), _mm_set1_epi32(0x007FFFFF)),
+                                                     _mm_set1_epi32(0x3F800000)));
+            }
+        };
+#endif
+
+#if SOUNDARCH_FASTMATH_NEON
+        struct NeonOps {
+            using Float = float32x4_t;
+            using Int = int32x4_t;
+            using Mask = uint32x4_t;
+            static constexpr int kWidth = 4;
+
+            static Float loadu(const float* p) noexcept { return vld1q_f32(p); }
+            static void storeu(float* p, Float v) noexcept { vst1q_f32(p, v); }
+            static Float set1(float x) noexcept { return vdupq_n_f32(x); }
+
+            static Float add(Float a, Float b) noexcept { return vaddq_f32(a, b); }
+            static Float sub(Float a, Float b) noexcept { return vsubq_f32(a, b); }
+            static Float mul(Float a, Float b) noexcept { return vmulq_f32(a, b); }
+            static Float div(Float a, Float b) noexcept {
+#if defined(__aarch64__)
+                return vdivq_f32(a, b);
+#else
+                // armv7: reciprocal estimate + two Newton steps (~1 ulp)
+                float32x4_t r = vrecpeq_f32(b);
+                r = vmulq_f32(vrecpsq_f32(b, r), r);
+                r = vmulq_f32(vrecpsq_f32(b, r), r);
+                return vmulq_f32(a, r);
+#endif
+            }
+            static Float min(Float a, Float b) noexcept { return vminq_f32(a, b); }
+            static Float max(Float a, Float b) noexcept { return vmaxq_f32(a, b); }
+            static Float abs(Float a) noexcept { return vabsq_f32(a); }
+            static Float copySign(Float magnitude, Float sign) noexcept {
+                return vbslq_f32(vdupq_n_u32(0x80000000u), sign, magnitude);
+            }
+            static Mask greaterThan(Float a, Float b) noexcept { return vcgtq_f32(a, b); }
+            static Float select(Mask m, Float a, Float b) noexcept { return vbslq_f32(m, a, b); }
+
+            static Int roundToInt(Float x) noexcept {
+#if defined(__aarch64__)
+                return vcvtnq_s32_f32(x);
+#else
+                // armv7 converts toward zero: add ±0.5 first (ties away from zero)
+                const float32x4_t half = vbslq_f32(vdupq_n_u32(0x80000000u), x, vdupq_n_f32(0.5f));
+                return vcvtq_s32_f32(vaddq_f32(x, half));
+#endif
+            }
+            static Float toFloat(Int n) noexcept { return vcvtq_f32_s32(n); }
+            static Float scaleByPow2(Float p, Int n) noexcept {
+                return vreinterpretq_f32_s32(vaddq_s32(vreinterpretq_s32_f32(p), vshlq_n_s32(n, 23)));
+            }
+            static Float exponent(Float x) noexcept {
+                const int32x4_t e = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_f32(x), 23));
+                return vcvtq_f32_s32(vsubq_s32(e, vdupq_n_s32(127)));
+            }
+            static Float mantissa(Float x) noexcept {
+                return vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x007FFFFFu)),
+                                                       vdupq_n_u32(0x3F800000u)));
+            }
+        };
+#endif
+
+    } // anonymous namespace
+
+    constexpr MathKernels kScalarKernels = makeKernels<ScalarOps>();
+
+#if SOUNDARCH_FASTMATH_SSE
+    constexpr MathKernels kSseKernels = makeKernels<SseOps>();
+#else
+    constexpr MathKernels kSseKernels = makeKernels<ScalarOps>();
+#endif
+
+#if SOUNDARCH_FASTMATH_NEON
+    constexpr MathKernels kNeonKernels = makeKernels<NeonOps>();
+#else
+    constexpr MathKernels kNeonKernels = makeKernels<ScalarOps>();
+#endif
+
+#if !SOUNDARCH_HAS_AVX2_KERNEL
+    constexpr MathKernels kAvx2Kernels = makeKernels<ScalarOps>();
+#endif
+
+    bool isSupported(MathKernel kernel) noexcept {
+        switch (kernel) {
+            case MathKernel::Scalar:
+                return true;
+            case MathKernel::SSE:
+#if SOUNDARCH_FASTMATH_SSE
+                return true;
+#else
+                return false;
+#endif
+            case MathKernel::AVX2:
+#if SOUNDARCH_HAS_AVX2_KERNEL
+                __builtin_cpu_init();   // May run before main (batch call from a static initializer)
+                return __builtin_cpu_supports("avx2");
+#else
+                return false;
+#endif
+            case MathKernel::NEON:
+#if SOUNDARCH_FASTMATH_NEON
+                return true;
+#else
+                return false;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    MathKernel bestKernel() noexcept {
+        if (isSupported(MathKernel::AVX2)) return MathKernel::AVX2;
+        if (isSupported(MathKernel::SSE)) return MathKernel::SSE;
+        if (isSupported(MathKernel::NEON)) return MathKernel::NEON;
+        return MathKernel::Scalar;
+    }
+
+    const char* mathKernelName(MathKernel kernel) noexcept {
+        switch (kernel) {
+            case MathKernel::Scalar: return "scalar";
+            case MathKernel::SSE: return "sse";
+            case MathKernel::AVX2: return "avx2";
+            case MathKernel::NEON: return "neon";
+            default: return "?";
+        }
+    }
+
+    const MathKernels& kernels(MathKernel kernel) noexcept {
+        if (!isSupported(kernel)) return kScalarKernels;
+        switch (kernel) {
+            case MathKernel::SSE: return kSseKernels;
+            case MathKernel::AVX2: return kAvx2Kernels;
+            case MathKernel::NEON: return kNeonKernels;
+            default: return kScalarKernels;
+        }
+    }
+
+    // ━━━ Batch dispatch: resolver stubs until the first call ━━━
+    namespace {
+
+        // Idempotent: threads racing on the first call store the same table
+        const MathKernels& resolveBatchKernels() noexcept {
+            const MathKernels& best = kernels(bestKernel());
+            gBatchKernels.store(&best, std::memory_order_relaxed);
+            return best;
+        }
+
+        template<BatchFunction MathKernels::*Function>
+        void resolveAndRun(const float* input, float* output, int numFrames) noexcept {
+            (resolveBatchKernels().*Function)(input, output, numFrames);
+        }
+
+        constexpr MathKernels kResolverKernels = {
+                resolveAndRun<&MathKernels::exp2>,
+                resolveAndRun<&MathKernels::exp>,
+                resolveAndRun<&MathKernels::log2>,
+                resolveAndRun<&MathKernels::tanh>,
+                resolveAndRun<&MathKernels::dbToLinear>,
+                resolveAndRun<&MathKernels::linearToDb>,
+        };
+
+    } // anonymous namespace
+
+    std::atomic<const MathKernels*> gBatchKernels{&kResolverKernels};
+
+} // namespace soundarch::dsp::fastmath
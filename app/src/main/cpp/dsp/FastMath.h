@@ -0,0 +1,97 @@
+#pragma once
+
+#include "FastMathKernel.h"
+
+#include <atomic>
+
+namespace soundarch::dsp::fastmath {
+
+// ==============================================================================
+// ⚡ FAST MATH - Bit-trick + minimax kernels, per sample and per block
+// ==============================================================================
+//
+// exp2 splits x into n + f (|f| ≤ 1/2): a degree-5 polynomial gives 2^f and
+// n goes straight into the exponent bits. log2 reads the exponent from the
+// bits and runs a degree-7 polynomial on the mantissa. Everything else is
+// built on those two: no libm call, no table, no branch (selects only).
+//
+// Max error against double precision (fastmath_test scans these ranges on
+// every kernel this CPU runs and fails above them):
+//
+//   exp2(x)         rel 2.5e-7      x in [-125, 127] (clamped outside)
+//   exp(x)          rel 3.0e-7      |x| ≤ 1;  4.5e-6 on [-86.5, 88]
+//   dbToLinear(dB)  rel 6.0e-7      [-60, +24] dB;  1.6e-6 on [-200, +60]
+//   log2(x)         abs 2.5e-7      x in [1/2, 2];  4e-6 over all floats
+//   linearToDb(x)   abs 1.2e-5 dB   [1e-5, 1];  2.2e-5 dB on [1e-10, 1e4]
+//   tanh(x)         abs 2.5e-7      all x (|x| ≥ 10 → ±1)
+//
+// The wide ranges only lose what a float argument can't carry (x · log2 e
+// rounds; a result near ±128 has an ulp of 1.5e-5). Exact where it counts:
+// exp2(0) = dbToLinear(0) = 1, log2(1) = linearToDb(1) = 0, tanh(0) = 0.
+// x ≤ 1e-10 gives -200 dB (linearToDb) and x < FLT_MIN gives -126 (log2).
+//
+// The scalar functions below are the same instructions on one float: use
+// them inside per-sample recursions (envelopes, soft clip); use the batch
+// functions on whole blocks. Batch: input == output allowed, any length.
+//
+// Kernels: Scalar, SSE (SSE2), AVX2 (own translation unit built with -mavx2,
+// picked at runtime), NEON. The batch entry points use the best one.
+//
+// ==============================================================================
+
+    // ━━━ Per sample ━━━
+    inline float exp2(float x) noexcept { return exp2Core<ScalarOps>(x); }
+    inline float exp(float x) noexcept { return expCore<ScalarOps>(x); }
+    inline float log2(float x) noexcept { return log2Core<ScalarOps>(x); }
+    inline float tanh(float x) noexcept { return tanhCore<ScalarOps>(x); }
+    inline float dbToLinear(float db) noexcept { return dbToLinearCore<ScalarOps>(db); }
+    inline float linearToDb(float x) noexcept { return linearToDbCore<ScalarOps>(x); }
+
+    // ━━━ Per block ━━━
+    enum class MathKernel : int {
+        Scalar = 0,
+        SSE,
+        AVX2,
+        NEON
+    };
+
+    using BatchFunction = void (*)(const float* input, float* output, int numFrames) noexcept;
+
+    struct MathKernels {
+        BatchFunction exp2;
+        BatchFunction exp;
+        BatchFunction log2;
+        BatchFunction tanh;
+        BatchFunction dbToLinear;
+        BatchFunction linearToDb;
+    };
+
+    bool isSupported(MathKernel kernel) noexcept;
+    MathKernel bestKernel() noexcept;
+    const char* mathKernelName(MathKernel kernel) noexcept;
+
+    // One kernel's functions (tests, benchmarks); unsupported kernels give Scalar
+    const MathKernels& kernels(MathKernel kernel) noexcept;
+
+    // Table the batch entry points call. Constant-initialized to resolver
+    // stubs, so it is valid before any dynamic initializer runs: the first
+    // batch call picks bestKernel() and stores its table here, later calls
+    // go straight to it (no guard, no branch)
+    extern std::atomic<const MathKernels*> gBatchKernels;
+
+    inline const MathKernels& batchKernels() noexcept { return *gBatchKernels.load(std::memory_order_relaxed); }
+
+    inline void exp2(const float* in, float* out, int n) noexcept { batchKernels().exp2(in, out, n); }
+    inline void exp(const float* in, float* out, int n) noexcept { batchKernels().exp(in, out, n); }
+    inline void log2(const float* in, float* out, int n) noexcept { batchKernels().log2(in, out, n); }
+    inline void tanh(const float* in, float* out, int n) noexcept { batchKernels().tanh(in, out, n); }
+    inline void dbToLinear(const float* in, float* out, int n) noexcept { batchKernels().dbToLinear(in, out, n); }
+    inline void linearToDb(const float* in, float* out, int n) noexcept { batchKernels().linearToDb(in, out, n); }
+
+    // Kernel tables per ISA (FastMath.cpp, FastMathAVX2.cpp), constexpr-initialized
+    extern const MathKernels kScalarKernels;
+    extern const MathKernels kSseKernels;
+    extern const MathKernels kAvx2Kernels;
+    extern const MathKernels kNeonKernels;
+
+} // namespace soundarch::dsp::fastmath
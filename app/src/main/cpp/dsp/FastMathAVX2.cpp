@@ -0,0 +1,61 @@
+// AVX2 fast-math kernels (FastMath.h). Built with -mavx2 on x86 only:
+// nothing here may run unless fastmath::isSupported(MathKernel::AVX2).
+
+#include "FastMath.h"
+
+#include <immintrin.h>
+
+namespace soundarch::dsp::fastmath {
+
+    namespace {
+        struct Avx2Ops {
+            using Float = __m256;
+            using Int = __m256i;
+            using Mask = __m256;
+            static constexpr int kWidth = 8;
+
+            static Float loadu(const float* p) noexcept { return _mm256_loadu_ps(p); }
+            static void storeu(float* p, Float v) noexcept { _mm256_storeu_ps(p, v); }
+            static Float set1(float x) noexcept { return _mm256_set1_ps(x); }
+
+            static Float add(Float a, Float b) noexcept { return _mm256_add_ps(a, b); }
+            static Float sub(Float a, Float b) noexcept { return _mm256_sub_ps(a, b); }
+            static Float mul(Float a, Float b) noexcept { return _mm256_mul_ps(a, b); }
+            static Float div(Float a, Float b) noexcept { return _mm256_div_ps(a, b); }
+            static Float min(Float a, Float b) noexcept { return _mm256_min_ps(a, b); }
+            static Float max(Float a, Float b) noexcept { return _mm256_max_ps(a, b); }
+            static Float abs(Float a) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+            static Float copySign(Float magnitude, Float sign) noexcept {
+                const __m256 signBit = _mm256_set1_ps(-0.0f);
+                return _mm256_or_ps(_mm256_andnot_ps(signBit, magnitude), _mm256_and_ps(signBit, sign));
+            }
+            static Mask greaterThan(Float a, Float b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+            static Float select(Mask m, Float a, Float b) noexcept { return _mm256_blendv_ps(b, a, m); }
+
+            static Int roundToInt(Float x) noexcept { return _mm256_cvtps_epi32(x); }   // MXCSR: nearest
+            static Float toFloat(Int n) noexcept { return _mm256_cvtepi32_ps(n); }
+            static Float scaleByPow2(Float p, Int n) noexcept {
+                return _mm256_castsi256_ps(_mm256_add_epi32(_mm256_castps_si256(p), _mm256_slli_epi32(n, 23)));
+            }
+            static Float exponent(Float x) noexcept {
+                return _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(x), 23),
+                                                           _mm256_set1_epi32(127)));
+            }
+            static Float mantissa(Float x) noexcept {
+                return _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(_mm256_castps_si256(x),
+                                                                            _mm256_set1_epi32(0x007FFFFF)),
+                                                           _mm256_set1_epi32(0x3F800000)));
+            }
+        };
+    } // anonymous namespace
+
+    constexpr MathKernels kAvx2Kernels = {
+            batch<Avx2Ops, exp2Core<Avx2Ops>>,
+            batch<Avx2Ops, expCore<Avx2Ops>>,
+            batch<Avx2Ops, log2Core<Avx2Ops>>,
+            batch<Avx2Ops, tanhCore<Avx2Ops>>,
+            batch<Avx2Ops, dbToLinearCore<Avx2Ops>>,
+            batch<Avx2Ops, linearToDbCore<Avx2Ops>>,
+    };
+
+} // namespace soundarch::dsp::fastmath
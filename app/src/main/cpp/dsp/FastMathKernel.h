@@ -0,0 +1,177 @@
+#pragma once
+
+// ==============================================================================
+// Fast-math cores shared by every ISA (FastMath.h)
+// ==============================================================================
+//
+// Ops is the ISA, as for the biquad cascade (BiquadCascadeKernel.h): float
+// and int32 vector types, width W and the lane operations below. ScalarOps
+// (width 1) is the scalar kernel and the per-sample inline functions; the
+// SIMD Ops live in the kernel translation units. Same instruction sequence
+// for every width, so the kernels differ only where an ISA rounds a step
+// differently (armv7 has no round-to-nearest conversion).
+//
+// Polynomials: minimax (Remez) fits, coefficients rounded to float.
+//
+// ==============================================================================
+
+#include <cstdint>
+#include <cstring>
+
+namespace soundarch::dsp::fastmath {
+
+    namespace poly {
+        // 2^f, f in [-0.5, 0.5]: relative error 1e-7 (degree 5, c0 = 1 so 2^0 = 1 exactly)
+        constexpr float kExp2[6] = {1.0f, 0.69314696706f, 0.24022119724f,
+                                    0.055507132735f, 0.0096755413342f, 0.0013276471979f};
+
+        // log2(1 + t) / t, t in [sqrt(1/2) - 1, sqrt(2) - 1]: relative error 1.7e-7 (degree 7)
+        constexpr float kLog2[8] = {1.4426949620f, -0.72135278806f, 0.48092324231f, -0.36023963972f,
+                                    0.28709869955f, -0.24887686475f, 0.23404237039f, -0.14581168829f};
+
+        constexpr float kLog2e = 1.44269504089f;          // log2(e)
+        constexpr float kDbToLog2 = 0.166096404744f;      // log2(10) / 20
+        constexpr float kLog2ToDb = 6.02059991328f;       // 20 / log2(10)
+        constexpr float kSqrt2 = 1.41421356237f;
+
+        constexpr float kExp2Min = -125.0f;               // Keeps 2^n a normal float
+        constexpr float kExp2Max = 127.0f;
+        constexpr float kTanhLinear = 1.0f / 4096.0f;     // Below: tanh(x) = x to 5e-12
+        constexpr float kTanhMax = 10.0f;                 // 1 ± e^-20 = 1 in float: tanh = ±1 exactly
+        constexpr float kLinearFloor = 1e-10f;            // -200 dB
+    }
+
+    // ━━━ Cores: one vector (or one float) in, one out ━━━
+
+    // 2^x: n = round(x), 2^f by polynomial, 2^n added into the exponent bits
+    template<typename Ops>
+    inline typename Ops::Float exp2Core(typename Ops::Float x) noexcept {
+        using F = typename Ops::Float;
+        x = Ops::min(Ops::max(x, Ops::set1(poly::kExp2Min)), Ops::set1(poly::kExp2Max));
+        const typename Ops::Int n = Ops::roundToInt(x);
+        const F f = Ops::sub(x, Ops::toFloat(n));
+
+        F p = Ops::set1(poly::kExp2[5]);
+        p = Ops::add(Ops::mul(p, f), Ops::set1(poly::kExp2[4]));
+        p = Ops::add(Ops::mul(p, f), Ops::set1(poly::kExp2[3]));
+        p = Ops::add(Ops::mul(p, f), Ops::set1(poly::kExp2[2]));
+        p = Ops::add(Ops::mul(p, f), Ops::set1(poly::kExp2[1]));
+        p = Ops::add(Ops::mul(p, f), Ops::set1(poly::kExp2[0]));
+        return Ops::scaleByPow2(p, n);
+    }
+
+    // log2(x), x > 0: exponent from the bits, mantissa folded into
+    // [sqrt(1/2), sqrt(2)) so log2(1) = 0 exactly, polynomial in t = m - 1
+    template<typename Ops>
+    inline typename Ops::Float log2Core(typename Ops::Float x) noexcept {
+        using F = typename Ops::Float;
+        x = Ops::max(x, Ops::set1(1.17549435e-38f));   // FLT_MIN: no zero / denormal / negative
+        F e = Ops::exponent(x);
+        F m = Ops::mantissa(x);                        // [1, 2)
+
+        const typename Ops::Mask high = Ops::greaterThan(m, Ops::set1(poly::kSqrt2));
+        m = Ops::select(high, Ops::mul(m, Ops::set1(0.5f)), m);
+        e = Ops::select(high, Ops::add(e, Ops::set1(1.0f)), e);
+
+        const F t = Ops::sub(m, Ops::set1(1.0f));
+        F q = Ops::set1(poly::kLog2[7]);
+        q = Ops::add(Ops::mul(q, t), Ops::set1(poly::kLog2[6]));
+        q = Ops::add(Ops::mul(q, t), Ops::set1(poly::kLog2[5]));
+        q = Ops::add(Ops::mul(q, t), Ops::set1(poly::kLog2[4]));
+        q = Ops::add(Ops::mul(q, t), Ops::set1(poly::kLog2[3]));
+        q = Ops::add(Ops::mul(q, t), Ops::set1(poly::kLog2[2]));
+        q = Ops::add(Ops::mul(q, t), Ops::set1(poly::kLog2[1]));
+        q = Ops::add(Ops::mul(q, t), Ops::set1(poly::kLog2[0]));
+        return Ops::add(e, Ops::mul(t, q));
+    }
+
+    // tanh(x) = sign(x) · (1 - 2e / (1 + e)), e = 2^(-2|x| log2 e) in (0, 1]:
+    // no large e, and the correction vanishes near saturation whatever the
+    // division rounds to (the compiler may turn it into rcp + Newton)
+    template<typename Ops>
+    inline typename Ops::Float tanhCore(typename Ops::Float x) noexcept {
+        using F = typename Ops::Float;
+        const F a = Ops::min(Ops::abs(x), Ops::set1(poly::kTanhMax));
+        const F e = exp2Core<Ops>(Ops::mul(a, Ops::set1(-2.0f * poly::kLog2e)));
+        F t = Ops::sub(Ops::set1(1.0f), Ops::div(Ops::add(e, e), Ops::add(Ops::set1(1.0f), e)));
+        t = Ops::select(Ops::greaterThan(a, Ops::set1(poly::kTanhLinear)), t, a);   // tanh(0) = 0 exactly
+        return Ops::copySign(t, x);
+    }
+
+    template<typename Ops>
+    inline typename Ops::Float expCore(typename Ops::Float x) noexcept {
+        return exp2Core<Ops>(Ops::mul(x, Ops::set1(poly::kLog2e)));
+    }
+
+    template<typename Ops>
+    inline typename Ops::Float dbToLinearCore(typename Ops::Float db) noexcept {
+        return exp2Core<Ops>(Ops::mul(db, Ops::set1(poly::kDbToLog2)));
+    }
+
+    template<typename Ops>
+    inline typename Ops::Float linearToDbCore(typename Ops::Float x) noexcept {
+        return Ops::mul(log2Core<Ops>(Ops::max(x, Ops::set1(poly::kLinearFloor))), Ops::set1(poly::kLog2ToDb));
+    }
+
+    // ━━━ Batch loop: whole vectors, then the tail through a padded vector ━━━
+    // (same instructions for the tail: results don't depend on the position)
+    template<typename Ops, typename Ops::Float (*Core)(typename Ops::Float)>
+    inline void batch(const float* input, float* output, int numFrames) noexcept {
+        constexpr int W = Ops::kWidth;
+        int i = 0;
+        for (; i + W <= numFrames; i += W) Ops::storeu(output + i, Core(Ops::loadu(input + i)));
+        if (i < numFrames) {
+            float tail[W] = {};
+            const int rest = numFrames - i;
+            std::memcpy(tail, input + i, sizeof(float) * static_cast<size_t>(rest));
+            Ops::storeu(tail, Core(Ops::loadu(tail)));
+            std::memcpy(output + i, tail, sizeof(float) * static_cast<size_t>(rest));
+        }
+    }
+
+    // ━━━ Scalar ISA (width 1) ━━━
+    struct ScalarOps {
+        using Float = float;
+        using Int = int32_t;
+        using Mask = bool;
+        static constexpr int kWidth = 1;
+
+        static Float loadu(const float* p) noexcept { return *p; }
+        static void storeu(float* p, Float v) noexcept { *p = v; }
+        static Float set1(float x) noexcept { return x; }
+
+        static Float add(Float a, Float b) noexcept { return a + b; }
+        static Float sub(Float a, Float b) noexcept { return a - b; }
+        static Float mul(Float a, Float b) noexcept { return a * b; }
+        static Float div(Float a, Float b) noexcept { return a / b; }
+        static Float min(Float a, Float b) noexcept { return a < b ? a : b; }
+        static Float max(Float a, Float b) noexcept { return a > b ? a : b; }
+        static Float abs(Float a) noexcept { return fromBits(bits(a) & 0x7FFFFFFFu); }
+        static Float copySign(Float magnitude, Float sign) noexcept {
+            return fromBits((bits(magnitude) & 0x7FFFFFFFu) | (bits(sign) & 0x80000000u));
+        }
+        static Mask greaterThan(Float a, Float b) noexcept { return a > b; }
+        static Float select(Mask m, Float a, Float b) noexcept { return m ? a : b; }
+
+        // Round half to even, as cvtps2dq / fcvtns
+        static Int roundToInt(Float x) noexcept { return static_cast<Int>(__builtin_lrintf(x)); }
+        static Float toFloat(Int n) noexcept { return static_cast<Float>(n); }
+        static Float scaleByPow2(Float p, Int n) noexcept {
+            return fromBits(bits(p) + (static_cast<uint32_t>(n) << 23));
+        }
+        static Float exponent(Float x) noexcept { return static_cast<Float>(static_cast<Int>(bits(x) >> 23) - 127); }
+        static Float mantissa(Float x) noexcept { return fromBits((bits(x) & 0x007FFFFFu) | 0x3F800000u); }
+
+        static uint32_t bits(Float x) noexcept {
+            uint32_t u;
+            std::memcpy(&u, &x, sizeof u);
+            return u;
+        }
+        static Float fromBits(uint32_t u) noexcept {
+            Float x;
+            std::memcpy(&x, &u, sizeof x);
+            return x;
+        }
+    };
+
+} // namespace soundarch::dsp::fastmath
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "AGC.h"
+#include "Compressor.h"
+#include "DSPMath.h"
+#include "Equalizer.h"
+#include "Limiter.h"
+
+namespace soundarch::dsp {
+
+// ==============================================================================
+// ⚡ FUSED CHAIN - Compile-time stage list, one pass over the block
+// ==============================================================================
+//
+// The multi-pass chain walks the block once per stage: AGC, ten biquads,
+// voice gain, compressor, limiter, then the output meter - about 15 trips
+// through memory per callback, each with its own loop setup.
+//
+//   Chain<AGC, Equalizer, Gain, Compressor, Limiter, Meter> chain(...);
+//   if (chain.fusable()) chain.process(buffer, numFrames);
+//
+// expands at compile time into ONE walk over the buffer, 128 samples at a
+// time: every stage runs over the tile while it sits in L1, then the next
+// tile. No virtual call, no per-stage switch, the per-block work (EQ ramps,
+// limiter lookahead length, ramp-free parameters) runs once in prepare().
+//
+// Why tiles and not one sample through all stages: each stage carries its
+// own recursion (biquad state, envelopes), and a whole-chain sample is a
+// ~200-cycle dependency chain. One sample per iteration leaves the
+// out-of-order core nothing to overlap - measured slower than the
+// multi-pass chain on x86 (bench/DSPBenchmark.cpp, module "Chain").
+// Within a tile a stage's iterations only share its own recursion.
+//
+// The EQ takes the tile through its SIMD cascade (BiquadCascade.h). The
+// cascade pays a pipeline fill of one step per section on every call, hence
+// 128-sample tiles rather than 32: at 32 the fill costs more than the fused
+// walk saves. With the vector EQ the fused pass runs level with the
+// multi-pass chain on x86 (the EQ was what fusion used to save on).
+//
+// Each stage runs the module's own processSample() - the body of its
+// processBlock() loop - and the EQ and the compressor the same tile kernels
+// as their processBlock(), so the result is the multi-pass chain's up to float
+// rounding (-ffast-math may order the sums differently per inlining site).
+// With a control interval set (ControlRate.h), AGC, compressor and limiter
+// run their control-rate path on the tile; segments restart with each tile,
+// so segment boundaries - not the math - differ from the multi-pass blocks.
+//
+// fusable() is false while a parameter ramp is in flight (compressor,
+// limiter, voice gain): those blocks take the multi-pass path (DSPChain
+// keeps it as the dynamic fallback, see DSPChain.h).
+//
+// ==============================================================================
+
+    struct Gain {};    // Tag: constant gain (DSPChain voice gain)
+    struct Meter {};   // Tag: peak / sum of squares of the output (OboeEngine meter)
+
+    // Output levels of one block, as the engine's peak/RMS meter computes them
+    struct BlockLevels {
+        float peak = 0.0f;
+        float sumSquares = 0.0f;
+        int32_t samples = 0;   // 0 = not measured
+    };
+
+    // Stage adapters: prepare() once per block, tick() per sample, finish() after
+    template<typename Stage>
+    struct FusedStage;
+
+    template<>
+    struct FusedStage<AGC> {
+        AGC* agc;
+        const DSPMath* dspMath;
+
+        bool fusable() const noexcept { return true; }
+        void prepare(int32_t) noexcept {}
+        float tick(float x) noexcept { return agc->processSample(x, *dspMath); }
+        void processTile(float* x, int32_t n) noexcept { agc->processBlock(x, x, n); }   // Control rate aware
+        void finish() noexcept {}
+    };
+
+    template<>
+    struct FusedStage<Equalizer> {
+        Equalizer* equalizer;
+        BiquadCascade* cascade = nullptr;
+
+        bool fusable() const noexcept { return true; }   // Band ramps move once per block
+        void prepare(int32_t numFrames) noexcept { cascade = &equalizer->prepareBlock(numFrames); }
+        float tick(float x) noexcept { return cascade->processSample(x); }
+        void processTile(float* x, int32_t n) noexcept { cascade->process(x, x, n); }   // SIMD cascade
+        void finish() noexcept {}
+    };
+
+    template<>
+    struct FusedStage<Gain> {
+        float gain;
+        bool ramping = false;
+
+        bool fusable() const noexcept { return !ramping; }
+        void prepare(int32_t) noexcept {}
+        float tick(float x) const noexcept { return x * gain; }
+        void finish() noexcept {}
+    };
+
+    template<>
+    struct FusedStage<Compressor> {
+        Compressor* compressor;
+        const DSPMath* dspMath;
+        float thresholdDb = 0.0f;
+        float slope = 0.0f;
+        float makeup = 1.0f;
+
+        bool fusable() const noexcept { return !compressor->isRamping(); }
+        void prepare(int32_t) noexcept {
+            thresholdDb = compressor->thresholdDb();
+            slope = compressor->slope();
+            makeup = compressor->makeupGainLinear();
+        }
+        float tick(float x) noexcept { return compressor->processSample(x, thresholdDb, slope, makeup, *dspMath); }
+        void processTile(float* x, int32_t n) noexcept {   // Vectorized pipeline
+            compressor->processTile(x, x, n, thresholdDb, slope, makeup);
+        }
+        void finish() noexcept {}
+    };
+
+    template<>
+    struct FusedStage<Limiter> {
+        Limiter* limiter;
+        const DSPMath* dspMath;
+        float threshold = 1.0f;
+
+        bool fusable() const noexcept { return !limiter->isRamping(); }
+        void prepare(int32_t) noexcept {
+            limiter->updateLookahead();
+            threshold = limiter->thresholdLinear();
+        }
+        float tick(float x) noexcept { return limiter->processSample(x, threshold, *dspMath); }
+        void processTile(float* x, int32_t n) noexcept { limiter->processTile(x, x, n, threshold); }
+        void finish() noexcept {}
+    };
+
+    template<>
+    struct FusedStage<Meter> {
+        BlockLevels* levels;
+        float peak = 0.0f;
+        float sumSquares = 0.0f;
+        int32_t samples = 0;
+
+        bool fusable() const noexcept { return true; }
+        void prepare(int32_t numFrames) noexcept {
+            peak = 0.0f;
+            sumSquares = 0.0f;
+            samples = numFrames;
+        }
+        float tick(float x) noexcept {
+            peak = std::max(peak, std::abs(x));
+            sumSquares += x * x;
+            return x;
+        }
+        void finish() noexcept {
+            levels->peak = peak;
+            levels->sumSquares = sumSquares;
+            levels->samples = samples;
+        }
+    };
+
+    // Stages with a tile kernel of their own (the SIMD EQ cascade, the
+    // compressor pipeline, the dynamics' control-rate paths) take the whole
+    // tile at once; the others run tick() sample by sample
+    template<typename S, typename = void>
+    struct HasTileKernel : std::false_type {};
+    template<typename S>
+    struct HasTileKernel<S, std::void_t<decltype(std::declval<S&>().processTile(nullptr, 0))>> : std::true_type {};
+
+    template<typename... Stages>
+    class Chain {
+    public:
+        explicit Chain(FusedStage<Stages>... stages) noexcept : stages_(stages...) {}
+
+        // Every stage can run this block sample by sample
+        bool fusable() const noexcept {
+            return std::apply([](const auto&... stage) { return (stage.fusable() && ...); }, stages_);
+        }
+
+        // In place. Call only when fusable().
+        void process(float* buffer, int32_t numFrames) noexcept {
+            std::apply([buffer, numFrames](auto&... stage) {
+                (stage.prepare(numFrames), ...);
+                for (int32_t start = 0; start < numFrames; start += kTile) {
+                    const int32_t end = std::min(numFrames, start + kTile);
+                    (runTile(stage, buffer, start, end), ...);
+                }
+                (stage.finish(), ...);
+            }, stages_);
+        }
+
+        // Samples every stage runs before the next one takes the tile
+        static constexpr int32_t kTile = 128;
+
+    private:
+        template<typename S>
+        static void runTile(S& stage, float* buffer, int32_t start, int32_t end) noexcept {
+            if constexpr (HasTileKernel<S>::value) {
+                stage.processTile(buffer + start, end - start);
+            } else {
+                for (int32_t i = start; i < end; ++i) buffer[i] = stage.tick(buffer[i]);
+            }
+        }
+
+        std::tuple<FusedStage<Stages>...> stages_;
+    };
+
+} // namespace soundarch::dsp
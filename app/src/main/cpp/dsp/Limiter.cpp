@@ -5,29 +5,21 @@
 
 namespace soundarch::dsp {
 
-    // ✅ SAFETY: Soft clipper prevents inter-sample peaks and harsh distortion
-    // Uses tanh for smooth, musical clipping (vs hard clip at ±1.0)
-    float Limiter::softClip(float x) noexcept {
-        // Normalized tanh: maps ±0.95 → ±1.0, providing headroom
-        constexpr float DRIVE = 0.95f;
-        const float NORM = 1.0f / std::tanh(DRIVE);  // Not constexpr - computed at runtime
-        return std::tanh(x * DRIVE) * NORM;
-    }
-
     Limiter::Limiter(float sampleRate)
-            : sampleRate_(sampleRate) {
+            : sampleRate_(sampleRate),
+              lookaheadBuffer_(static_cast<size_t>((kMaxLookaheadMs / 1000.0f) * sampleRate) + 1, 0.0f) {
         setThreshold(-1.0f);
         setRelease(50.0f);
         setLookahead(0.0f);
         reset();
     }
 
-    void Limiter::setThreshold(float thresholdDb) noexcept {
+    void Limiter::setThreshold(float thresholdDb, int32_t rampSamples) noexcept {
         // ✅ PARAMETER CLAMPING: Threshold must be in range [-12dB, 0dB]
         thresholdDb = std::clamp(thresholdDb, -12.0f, 0.0f);
 
         // ✅ OPTIMISATION LUT: Pré-calculer le threshold linéaire
-        thresholdLinear_ = getDSPMath().dbToLinear(thresholdDb);
+        thresholdLinear_.setTarget(getDSPMath().dbToLinear(thresholdDb), rampSamples);
     }
 
     void Limiter::setRelease(float releaseMs) noexcept {
@@ -36,33 +28,40 @@ namespace soundarch::dsp {
 
         float releaseTimeSamples = (releaseMs / 1000.0f) * sampleRate_;
         releaseCoeff_ = std::exp(-1.0f / releaseTimeSamples);
+        releaseSegment_.set(releaseCoeff_, controlInterval_);
+    }
+
+    void Limiter::setControlInterval(int samples) noexcept {
+        controlInterval_ = clampControlInterval(samples);
+        releaseSegment_.set(releaseCoeff_, controlInterval_);
+
+        // The first segment ramps from the gain the per-sample path left
+        const float threshold = thresholdLinear_.current();
+        controlGain_ = envelope_ > threshold ? threshold / envelope_ : 1.0f;
     }
 
     void Limiter::setLookahead(float lookaheadMs) noexcept {
         // ✅ PARAMETER CLAMPING: Lookahead must be in range [0ms, 10ms]
-        lookaheadMs = std::clamp(lookaheadMs, 0.0f, 10.0f);
+        lookaheadMs = std::clamp(lookaheadMs, 0.0f, kMaxLookaheadMs);
 
-        if (lookaheadMs <= 0.0f) {
-            useLookahead_ = false;
-            lookaheadBuffer_.clear();
-            return;
-        }
+        const size_t length = static_cast<size_t>((lookaheadMs / 1000.0f) * sampleRate_);
+        requestedLookahead_.store(std::min(length, lookaheadBuffer_.size()), std::memory_order_relaxed);
+    }
 
-        size_t bufferSize = static_cast<size_t>((lookaheadMs / 1000.0f) * sampleRate_);
-        lookaheadBuffer_.resize(bufferSize, 0.0f);
+    void Limiter::updateLookahead() noexcept {
+        const size_t requested = requestedLookahead_.load(std::memory_order_relaxed);
+        if (requested == lookaheadLength_) return;
+
+        // New delay line starts silent (bounded: ≤ 10 ms of samples)
+        std::fill(lookaheadBuffer_.begin(), lookaheadBuffer_.begin() + static_cast<std::ptrdiff_t>(requested), 0.0f);
+        lookaheadLength_ = requested;
         lookaheadIndex_ = 0;
-        useLookahead_ = true;
     }
 
     float Limiter::process(float input) noexcept {
-        float sample = input;
-
+        updateLookahead();
         // Lookahead buffer (si activé)
-        if (useLookahead_ && !lookaheadBuffer_.empty()) {
-            lookaheadBuffer_[lookaheadIndex_] = sample;
-            sample = lookaheadBuffer_[(lookaheadIndex_ + 1) % lookaheadBuffer_.size()];
-            lookaheadIndex_ = (lookaheadIndex_ + 1) % lookaheadBuffer_.size();
-        }
+        const float sample = lookaheadLength_ > 0 ? delay(input) : input;
 
         // Détection du niveau
         float level = std::abs(input);
@@ -75,9 +74,10 @@ namespace soundarch::dsp {
         }
 
         // Calcul du gain
+        const float threshold = thresholdLinear_.next();
         float gain = 1.0f;
-        if (envelope_ > thresholdLinear_) {
-            gain = thresholdLinear_ / envelope_;  // Ratio ∞:1
+        if (envelope_ > threshold) {
+            gain = threshold / envelope_;  // Ratio ∞:1
         }
 
         // ✅ OPTIMISATION LUT: Stocker la réduction en dB
@@ -88,49 +88,96 @@ namespace soundarch::dsp {
         return softClip(limited);
     }
 
-    // ✅ OPTIMIZED: Block processing - vectorizable peak detection
-    void Limiter::processBlock(const float* input, float* output, int numFrames) noexcept {
+    // Per-sample path while the ceiling ramps
+    void Limiter::processBlockRamping(const float* input, float* output, int numFrames) noexcept {
         auto& dspMath = getDSPMath();
 
         for (int i = 0; i < numFrames; ++i) {
-            float sample = input[i];
+            output[i] = processSample(input[i], thresholdLinear_.next(), dspMath);
+        }
+    }
 
-            // Lookahead buffer (if enabled)
-            if (useLookahead_ && !lookaheadBuffer_.empty()) {
-                lookaheadBuffer_[lookaheadIndex_] = sample;
-                sample = lookaheadBuffer_[(lookaheadIndex_ + 1) % lookaheadBuffer_.size()];
-                lookaheadIndex_ = (lookaheadIndex_ + 1) % lookaheadBuffer_.size();
-            }
+    void Limiter::processControlRate(const float* input, float* output, int numFrames, float threshold) noexcept {
+        alignas(32) float delayed[kControlChunk];
+        const int chunk = controlChunkFrames(controlInterval_);
+        float gain = controlGain_;
 
-            // Level detection
-            float level = std::abs(input[i]);
+        for (int chunkStart = 0; chunkStart < numFrames; chunkStart += chunk) {
+            const int frames = std::min(chunk, numFrames - chunkStart);
+            const float* in = input + chunkStart;
+            float* out = output + chunkStart;
 
-            // Envelope follower
-            if (level > envelope_) {
-                envelope_ = level;  // Instant attack
-            } else {
-                envelope_ = releaseCoeff_ * envelope_ + (1.0f - releaseCoeff_) * level;
+            const float* source = in;
+            if (lookaheadLength_ > 0) {
+                for (int i = 0; i < frames; ++i) delayed[i] = delay(in[i]);
+                source = delayed;
             }
 
-            // Gain calculation
-            float gain = 1.0f;
-            if (envelope_ > thresholdLinear_) {
-                gain = thresholdLinear_ / envelope_;  // Ratio ∞:1
+            for (int start = 0; start < frames; start += controlInterval_) {
+                const int n = std::min(controlInterval_, frames - start);
+
+                // Envelope: instant attack on the segment peak; the release is
+                // linear in |x|, so the segment's mean level stands for its samples
+                const SegmentLevel level = segmentLevel(in + start, n);
+                if (level.peak > envelope_) {
+                    envelope_ = level.peak;
+                } else {
+                    const float coef = releaseSegment_.over(n);
+                    envelope_ = coef * envelope_ + (1.0f - coef) * level.meanAbs;
+                }
+
+                // Ratio ∞:1 on max(envelope, peak): every sample of the segment fits
+                const float detected = std::max(envelope_, level.peak);
+                const float next = detected > threshold ? threshold / detected : 1.0f;
+
+                // Gain going down: from the first sample (never late). Going up: ramp.
+                // Soft clip drive folded into the gain.
+                const float from = next < gain ? next : gain;
+                applyGainRamp(source + start, out + start, n,
+                              from * tables::kSoftClipDrive, next * tables::kSoftClipDrive);
+                gain = next;
             }
 
-            gainReduction_ = dspMath.linearToDb(gain);
+            // Soft clip, whole chunk
+            fastmath::tanh(out, out, frames);
+            for (int i = 0; i < frames; ++i) out[i] *= tables::kSoftClipNorm;
+        }
+
+        controlGain_ = gain;
+        gainReduction_ = getDSPMath().linearToDb(gain);
+    }
+
+    void Limiter::processTile(const float* input, float* output, int numFrames, float threshold) noexcept {
+        if (controlInterval_ > 1) {
+            processControlRate(input, output, numFrames, threshold);
+            return;
+        }
+
+        auto& dspMath = getDSPMath();
+        for (int i = 0; i < numFrames; ++i) {
+            output[i] = processSample(input[i], threshold, dspMath);
+        }
+    }
 
-            // Apply gain + soft clip safety
-            float limited = sample * gain;
-            output[i] = softClip(limited);
+    // ✅ OPTIMIZED: Block processing - vectorizable peak detection
+    void Limiter::processBlock(const float* input, float* output, int numFrames) noexcept {
+        updateLookahead();
+
+        // One branch per block: ceiling ramp only while a new threshold settles
+        if (thresholdLinear_.isRamping()) {
+            processBlockRamping(input, output, numFrames);
+        } else {
+            processTile(input, output, numFrames, thresholdLinear_.current());
         }
     }
 
     void Limiter::reset() noexcept {
         envelope_ = 0.0f;
         gainReduction_ = 0.0f;
+        controlGain_ = 1.0f;
         lookaheadIndex_ = 0;
         std::fill(lookaheadBuffer_.begin(), lookaheadBuffer_.end(), 0.0f);
+        thresholdLinear_.finish();
     }
 
 } // namespace soundarch::dsp
\ No newline at end of file
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
 #include <vector>
+#include "ControlRate.h"
+#include "DSPMath.h"
+#include "SmoothedValue.h"
 
 namespace soundarch::dsp {
 
@@ -11,40 +16,117 @@ namespace soundarch::dsp {
         explicit Limiter(float sampleRate);
 
         // Configuration
-        void setThreshold(float thresholdDb) noexcept;
+        // rampSamples > 0: per-sample linear ramp of the ceiling (audio thread only)
+        void setThreshold(float thresholdDb, int32_t rampSamples = 0) noexcept;
         void setRelease(float releaseMs) noexcept;
+        // Safe while the audio thread runs: only publishes the new length
         void setLookahead(float lookaheadMs) noexcept;
 
+        // Gain computed once per `samples` (1 = every sample, see ControlRate.h).
+        // Attack stays instant: a segment whose peak needs less gain takes the
+        // new gain from its first sample (never late, at most N - 1 samples
+        // early); releases ramp. The gain comes from max(envelope, segment
+        // peak), so no sample goes over the ceiling before the soft clip.
+        // Otherwise within 0.025 dB mean of the per-sample gain up to N = 16,
+        // 0.1 dB up to 64 (dynamics_control_rate_test).
+        void setControlInterval(int samples) noexcept;
+        int getControlInterval() const noexcept { return controlInterval_; }
+
         // Traitement temps réel
         float process(float input) noexcept;
 
         // ✅ OPTIMIZED: Block processing for better performance
         void processBlock(const float* input, float* output, int numFrames) noexcept;
 
+        // Fused chains (dsp/FusedChain.h): updateLookahead() at the start of
+        // the block, then one processBlock() sample at a time with the block's
+        // ceiling. Steady state only: no ramp in flight.
+        void updateLookahead() noexcept;
+        inline float processSample(float input, float threshold, const DSPMath& dspMath) noexcept;
+        // processBlock() steady state with the block's ceiling (fused tiles). In place allowed.
+        void processTile(const float* input, float* output, int numFrames, float threshold) noexcept;
+        float thresholdLinear() const noexcept { return thresholdLinear_.current(); }
+
         // Reset state
         void reset() noexcept;
 
         // Getters pour UI (niveau de réduction)
         [[nodiscard]] float getGainReduction() const noexcept { return gainReduction_; }
+        [[nodiscard]] bool isRamping() const noexcept { return thresholdLinear_.isRamping(); }
 
     private:
         // ✅ SAFETY: Soft clipper to prevent inter-sample peaks
-        static float softClip(float x) noexcept;
+        static inline float softClip(float x) noexcept;
+
+        // Lookahead delay line: one sample in, the delayed one out
+        inline float delay(float input) noexcept;
+
+        void processBlockRamping(const float* input, float* output, int numFrames) noexcept;
+        void processControlRate(const float* input, float* output, int numFrames, float threshold) noexcept;
 
         float sampleRate_;
 
         // Paramètres
-        float thresholdLinear_ = 1.0f;  // Threshold en linéaire (0-1)
+        SmoothedValue thresholdLinear_{1.0f};  // Threshold en linéaire (0-1), ramped when set live
         float releaseCoeff_ = 0.0f;     // Coefficient de release
 
         // État interne
         float envelope_ = 0.0f;         // Envelope du signal
         float gainReduction_ = 0.0f;    // Gain réduit (dB) pour affichage
 
+        // Control rate
+        int controlInterval_ = 1;
+        SegmentCoef releaseSegment_;
+        float controlGain_ = 1.0f;      // Linear gain the last segment ended on
+
         // Lookahead buffer (optionnel)
+        // ✅ RT-SAFE: allocated once for kMaxLookaheadMs; setLookahead() only
+        // stores the requested length, the audio thread switches to it
+        static constexpr float kMaxLookaheadMs = 10.0f;
         std::vector<float> lookaheadBuffer_;
+        std::atomic<size_t> requestedLookahead_{0};   // Samples, written by setLookahead()
+        size_t lookaheadLength_ = 0;                  // Samples in use (audio thread)
         size_t lookaheadIndex_ = 0;
-        bool useLookahead_ = false;
     };
 
-} // namespace soundarch::dsp
\ No newline at end of file
+    // ✅ SAFETY: Soft clipper prevents inter-sample peaks and harsh distortion
+    // Uses tanh for smooth, musical clipping (vs hard clip at ±1.0)
+    inline float Limiter::softClip(float x) noexcept {
+        // Normalized tanh: maps ±0.95 → ±1.0, providing headroom
+        // (1 / tanh(drive) computed at compile time, DSPTables.h)
+        return fastmath::tanh(x * tables::kSoftClipDrive) * tables::kSoftClipNorm;
+    }
+
+    inline float Limiter::delay(float input) noexcept {
+        lookaheadBuffer_[lookaheadIndex_] = input;
+        if (++lookaheadIndex_ == lookaheadLength_) lookaheadIndex_ = 0;
+        return lookaheadBuffer_[lookaheadIndex_];
+    }
+
+    inline float Limiter::processSample(float input, float threshold, const DSPMath& dspMath) noexcept {
+        // Lookahead buffer (if enabled)
+        const float sample = lookaheadLength_ > 0 ? delay(input) : input;
+
+        // Level detection
+        const float level = std::abs(input);
+
+        // Envelope follower
+        if (level > envelope_) {
+            envelope_ = level;  // Instant attack
+        } else {
+            envelope_ = releaseCoeff_ * envelope_ + (1.0f - releaseCoeff_) * level;
+        }
+
+        // Gain calculation
+        float gain = 1.0f;
+        if (envelope_ > threshold) {
+            gain = threshold / envelope_;  // Ratio ∞:1
+        }
+
+        gainReduction_ = dspMath.linearToDb(gain);
+
+        // Apply gain + soft clip safety
+        return softClip(sample * gain);
+    }
+
+} // namespace soundarch::dsp
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "../utils/RingBuffer.h"
+
+namespace soundarch::dsp {
+
+// ==============================================================================
+// 📨 PARAMETER QUEUE - Control threads → audio thread, applied between blocks
+// ==============================================================================
+//
+// Problem:
+//   JNI setters used to write module members (Compressor threshold, ratio,
+//   attack...) while the audio thread was reading them mid-block: a group
+//   of related values could be half-applied, and nothing orders the plain
+//   float stores against the audio thread's loads.
+//
+// Solution: post → drain at the top of DSPChain::processBlock()
+//   1. post(id, value): stores the latest value in the parameter's slot,
+//      then enqueues the id unless it is already queued
+//   2. Audio thread drains the ids before the first stage runs and applies
+//      each slot's latest value through the module setters
+//
+// Coalescing: a slider firing 60 updates/s while the stream is stopped
+// leaves ONE entry per parameter, so the id queue (sized for every
+// parameter) can never overflow and the newest value always wins.
+//
+// Thread Safety:
+//   - post(): any thread (UI, BT bridge, ML) - lock-free, no allocation
+//   - pending() / drain(): the thread that runs processBlock()
+//
+// ==============================================================================
+
+    enum class Param : uint16_t {
+        // AGC
+        AGCTargetLevel,
+        AGCMaxGain,
+        AGCMinGain,
+        AGCAttackTime,
+        AGCReleaseTime,
+        AGCNoiseThreshold,
+        AGCWindowSize,
+
+        // Compressor
+        CompressorThreshold,
+        CompressorRatio,
+        CompressorAttack,
+        CompressorRelease,
+        CompressorKnee,
+        CompressorMakeupGain,
+
+        // Limiter
+        LimiterThreshold,
+        LimiterRelease,
+        LimiterLookahead,
+
+        // Voice Gain (dB)
+        VoiceGain,
+
+        // Equalizer band gains (dB): EqBand0 + band
+        EqBand0,
+        EqBand1,
+        EqBand2,
+        EqBand3,
+        EqBand4,
+        EqBand5,
+        EqBand6,
+        EqBand7,
+        EqBand8,
+        EqBand9,
+
+        // AGC, Compressor, Limiter: gain computed every N samples (ControlRate.h),
+        // 1 = per sample. Appended: the ids above are ABI (C API, Kotlin ordinals)
+        DynamicsControlInterval,
+
+        Count
+    };
+
+    constexpr size_t kParamCount = static_cast<size_t>(Param::Count);
+
+    constexpr Param eqBandParam(int band) noexcept {
+        return static_cast<Param>(static_cast<int>(Param::EqBand0) + band);
+    }
+
+    class ParameterQueue {
+    public:
+        ParameterQueue() noexcept {
+            for (auto& v : values_) v.store(0.0f, std::memory_order_relaxed);
+            for (auto& q : queued_) q.store(false, std::memory_order_relaxed);
+        }
+
+        ParameterQueue(const ParameterQueue&) = delete;
+        ParameterQueue& operator=(const ParameterQueue&) = delete;
+
+        // Any thread
+        void post(Param id, float value) noexcept {
+            const auto i = static_cast<size_t>(id);
+            if (i >= kParamCount) return;
+            values_[i].store(value, std::memory_order_relaxed);
+            if (!(posted_.load(std::memory_order_relaxed) & (1u << i))) {
+                posted_.fetch_or(1u << i, std::memory_order_relaxed);
+            }
+
+            // First post since the last drain of this id: hand it to the audio thread.
+            // acq_rel pairs with the consumer's exchange: whoever sees queued == true
+            // also sees the value stored before it.
+            if (!queued_[i].exchange(true, std::memory_order_acq_rel)) {
+                ids_.tryPush(static_cast<uint16_t>(i));   // Cannot fail: each id is queued at most once
+            }
+        }
+
+        // Audio thread: one acquire load when nothing was posted
+        [[nodiscard]] bool pending() const noexcept { return !ids_.empty(); }
+
+        // Audio thread: apply(Param, float) for every posted id, newest value
+        template<typename Apply>
+        void drain(Apply&& apply) noexcept {
+            uint16_t i;
+            while (ids_.tryPop(i)) {
+                // Clear BEFORE reading: a post racing with us re-queues the id
+                queued_[i].exchange(false, std::memory_order_acq_rel);
+                apply(static_cast<Param>(i), values_[i].load(std::memory_order_relaxed));
+            }
+        }
+
+        // Any thread: last value ever posted for id (false if never posted).
+        // Used to configure rebuilt modules like the ones they replace.
+        bool latest(Param id, float& value) const noexcept {
+            const auto i = static_cast<size_t>(id);
+            if (i >= kParamCount || !(posted_.load(std::memory_order_relaxed) & (1u << i))) return false;
+            value = values_[i].load(std::memory_order_relaxed);
+            return true;
+        }
+
+    private:
+        static constexpr size_t kQueueSize = 64;   // Power of two ≥ kParamCount
+        static_assert(kQueueSize >= kParamCount, "Every parameter must fit in the id queue");
+        static_assert(kParamCount <= 32, "posted_ has one bit per parameter");
+
+        std::array<std::atomic<float>, kParamCount> values_;
+        std::array<std::atomic<bool>, kParamCount> queued_;
+        MpscQueue<uint16_t, kQueueSize> ids_;
+        std::atomic<uint32_t> posted_{0};   // Bit i: id i was posted at least once
+    };
+
+} // namespace soundarch::dsp
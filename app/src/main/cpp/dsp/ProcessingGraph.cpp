@@ -0,0 +1,187 @@
+#include "ProcessingGraph.h"
+#include <algorithm>
+#include <functional>
+
+namespace soundarch::dsp {
+
+    GraphSpec GraphSpec::defaultChain() {
+        GraphSpec spec;
+        spec.add(StageKind::AGC, kGraphInput);
+        spec.add(StageKind::Equalizer);
+        spec.add(StageKind::VoiceGain);
+        spec.add(StageKind::NoiseCanceller);
+        spec.add(StageKind::Compressor);
+        spec.add(StageKind::Limiter);
+        return spec;
+    }
+
+    int GraphSpec::add(StageKind kind) {
+        return add(kind, static_cast<int>(nodes_.size()) - 1);
+    }
+
+    int GraphSpec::add(StageKind kind, int input) {
+        GraphNode node;
+        node.kind = kind;
+        node.input = input;
+        nodes_.push_back(node);
+        return static_cast<int>(nodes_.size()) - 1;
+    }
+
+    int GraphSpec::mix(int a, float gain, int b, float gainB) {
+        GraphNode node;
+        node.kind = StageKind::Mix;
+        node.input = a;
+        node.input2 = b;
+        node.gain = gain;
+        node.gain2 = gainB;
+        nodes_.push_back(node);
+        return static_cast<int>(nodes_.size()) - 1;
+    }
+
+    void GraphSpec::setBypassed(int node, bool bypassed) {
+        if (node >= 0 && node < static_cast<int>(nodes_.size())) nodes_[node].bypassed = bypassed;
+    }
+
+    GraphError compileGraph(const GraphSpec& spec, bool noiseCanceller, CompiledGraph& compiled) {
+        constexpr int kInput = GraphSpec::kGraphInput;
+        constexpr int kMaxBuffers = 256;   // GraphOp indexes buffers with uint8_t
+
+        const std::vector<GraphNode>& nodes = spec.nodes();
+        const int count = static_cast<int>(nodes.size());
+        const int output = spec.output();
+        if (count >= kMaxBuffers) return GraphError::TooLarge;
+        if (output < kInput || output >= count) return GraphError::BadInput;
+
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        // 1️⃣ Validation + value of each node (bypass = alias of its input)
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        std::vector<int> value(static_cast<size_t>(count));   // Producing node, or kInput
+        auto valueOf = [&value](int node) { return node == kInput ? kInput : value[static_cast<size_t>(node)]; };
+        int voiceGains = 0;
+
+        for (int i = 0; i < count; ++i) {
+            const GraphNode& node = nodes[static_cast<size_t>(i)];
+            if (node.kind >= StageKind::Copy) return GraphError::Unsupported;
+            if (node.input < kInput || node.input >= i) return GraphError::BadInput;
+            if (node.kind == StageKind::Mix && (node.input2 < kInput || node.input2 >= i)) return GraphError::BadInput;
+            if (node.kind == StageKind::VoiceGain && !node.bypassed && ++voiceGains > 1) {
+                return GraphError::DuplicateVoiceGain;
+            }
+            const bool bypassed = node.bypassed || (node.kind == StageKind::NoiseCanceller && !noiseCanceller);
+            value[static_cast<size_t>(i)] = bypassed ? valueOf(node.input) : i;
+        }
+
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        // 2️⃣ Liveness: only what reaches the output runs; last reader of each value
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        const int result = valueOf(output);
+        std::vector<bool> needed(static_cast<size_t>(count), false);
+        if (result != kInput) needed[static_cast<size_t>(result)] = true;
+        for (int i = count - 1; i >= 0; --i) {
+            if (!needed[static_cast<size_t>(i)]) continue;
+            const GraphNode& node = nodes[static_cast<size_t>(i)];
+            const int a = valueOf(node.input);
+            if (a != kInput) needed[static_cast<size_t>(a)] = true;
+            if (node.kind == StageKind::Mix) {
+                const int b = valueOf(node.input2);
+                if (b != kInput) needed[static_cast<size_t>(b)] = true;
+            }
+        }
+
+        // lastUse[v + 1]: index of the last node reading value v (slot 0 = graph input)
+        std::vector<int> lastUse(static_cast<size_t>(count) + 1, -1);
+        auto lastUseOf = [&lastUse](int v) -> int& { return lastUse[static_cast<size_t>(v + 1)]; };
+        for (int i = 0; i < count; ++i) {
+            if (!needed[static_cast<size_t>(i)]) continue;
+            const GraphNode& node = nodes[static_cast<size_t>(i)];
+            lastUseOf(valueOf(node.input)) = i;
+            if (node.kind == StageKind::Mix) lastUseOf(valueOf(node.input2)) = i;
+        }
+        lastUseOf(result) = count;   // Still needed after the last node
+
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        // 3️⃣ Buffer assignment: in place whenever the input dies here
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        CompiledGraph out;
+        std::vector<int> bufferOf(static_cast<size_t>(count) + 1, -1);   // Same slots as lastUse
+        auto bufferOfValue = [&bufferOf](int v) -> int& { return bufferOf[static_cast<size_t>(v + 1)]; };
+        std::vector<int> freeBuffers;   // Min-heap: lowest index first, deterministic layout
+        auto allocate = [&freeBuffers, &out]() {
+            if (freeBuffers.empty()) return ++out.scratchBuffers;
+            std::pop_heap(freeBuffers.begin(), freeBuffers.end(), std::greater<>());
+            const int buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+            return buffer;
+        };
+        auto release = [&freeBuffers](int buffer) {
+            freeBuffers.push_back(buffer);
+            std::push_heap(freeBuffers.begin(), freeBuffers.end(), std::greater<>());
+        };
+
+        bufferOfValue(kInput) = 0;
+        if (lastUseOf(kInput) < 0) release(0);   // Input never read: buffer 0 is scratch
+
+        for (int i = 0; i < count; ++i) {
+            if (!needed[static_cast<size_t>(i)] || value[static_cast<size_t>(i)] != i) continue;
+            const GraphNode& node = nodes[static_cast<size_t>(i)];
+            const int a = valueOf(node.input);
+            const int b = node.kind == StageKind::Mix ? valueOf(node.input2) : a;
+            const bool aDies = lastUseOf(a) == i;
+            const bool bDies = lastUseOf(b) == i;
+
+            GraphOp op;
+            op.kind = node.kind;
+            op.in = static_cast<uint8_t>(bufferOfValue(a));
+            op.in2 = static_cast<uint8_t>(bufferOfValue(b));
+            op.gain = node.gain;
+            op.gain2 = node.gain2;
+
+            int target;
+            if (aDies) {
+                target = bufferOfValue(a);
+            } else if (node.kind == StageKind::Mix && bDies) {
+                target = bufferOfValue(b);
+            } else {
+                target = allocate();
+            }
+            if (aDies && target != bufferOfValue(a)) release(bufferOfValue(a));
+            if (node.kind == StageKind::Mix && bDies && b != a && target != bufferOfValue(b)) release(bufferOfValue(b));
+            if (target >= kMaxBuffers) return GraphError::TooLarge;
+
+            op.out = static_cast<uint8_t>(target);
+            bufferOfValue(i) = target;
+            if (node.kind != StageKind::Mix) {
+                op.instance = static_cast<uint8_t>(out.instances[static_cast<int>(node.kind)]++);
+            }
+            out.ops.push_back(op);
+        }
+
+        // The result must end in the caller's buffer
+        if (bufferOfValue(result) != 0) {
+            GraphOp copy;
+            copy.kind = StageKind::Copy;
+            copy.in = static_cast<uint8_t>(bufferOfValue(result));
+            copy.out = 0;
+            out.ops.push_back(copy);
+        }
+
+        compiled = std::move(out);
+        return GraphError::None;
+    }
+
+    const char* stageKindName(StageKind kind) noexcept {
+        switch (kind) {
+            case StageKind::AGC: return "AGC";
+            case StageKind::Equalizer: return "Equalizer";
+            case StageKind::VoiceGain: return "VoiceGain";
+            case StageKind::NoiseCanceller: return "NoiseCanceller";
+            case StageKind::Compressor: return "Compressor";
+            case StageKind::Limiter: return "Limiter";
+            case StageKind::Mix: return "Mix";
+            case StageKind::Copy: return "Copy";
+            case StageKind::Count: break;
+        }
+        return "?";
+    }
+
+} // namespace soundarch::dsp
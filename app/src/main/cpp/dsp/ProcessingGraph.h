@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace soundarch::dsp {
+
+// ==============================================================================
+// 🧭 PROCESSING GRAPH - Stage routing, compiled to a flat schedule
+// ==============================================================================
+//
+// GraphSpec describes the routing (control thread, free to allocate):
+//   - Stages: AGC, Equalizer, VoiceGain, NoiseCanceller, Compressor, Limiter
+//   - Any order, any stage several times (each occurrence is its own module
+//     instance), any node bypassed
+//   - Parallel branches: several nodes may read the same node; Mix sums two
+//     of them (dry/wet, parallel compression)
+//   Nodes only read earlier nodes, so the list is already in execution order.
+//
+// compileGraph() turns it into GraphOps: one entry per stage invocation,
+// with buffers assigned ahead of time (buffer 0 = the caller's block,
+// 1..scratchBuffers = chain-owned scratch). Bypassed nodes and nodes that do
+// not reach the output emit nothing. A serial chain runs fully in place and
+// needs no scratch at all, exactly like the fixed chain it replaces.
+//
+// DSPChain binds each op to its module instance and publishes the result
+// with the module set (see DSPChain.h, hot swap): a routing change lands
+// between two blocks and costs the audio thread nothing extra.
+//
+// ==============================================================================
+
+    enum class StageKind : uint8_t {
+        AGC,
+        Equalizer,
+        VoiceGain,        // Chain-level gain: at most once per graph
+        NoiseCanceller,
+        Compressor,
+        Limiter,
+        Mix,              // out = gain * in + gain2 * in2
+        Copy,             // Emitted by the compiler only: out = in
+        Count
+    };
+
+    constexpr int kModuleKindCount = static_cast<int>(StageKind::Mix);   // Kinds backed by a module
+
+    struct GraphNode {
+        StageKind kind = StageKind::AGC;
+        int input = -1;          // Node index, or GraphSpec::kGraphInput
+        int input2 = -1;         // Mix only
+        float gain = 1.0f;       // Mix only
+        float gain2 = 1.0f;      // Mix only
+        bool bypassed = false;   // Output = input, no processing
+    };
+
+    class GraphSpec {
+    public:
+        static constexpr int kGraphInput = -1;
+
+        // AGC → EQ → Voice Gain → NC → Compressor → Limiter (the production chain)
+        static GraphSpec defaultChain();
+
+        // Appends a stage reading `input` (default: the node added last). Returns its index.
+        int add(StageKind kind);
+        int add(StageKind kind, int input);
+
+        // Appends out = gain * a + gainB * b. Returns its index.
+        int mix(int a, float gain, int b, float gainB);
+
+        void setBypassed(int node, bool bypassed);
+
+        // Node written to the caller's buffer (default: the last node, -1 = graph input)
+        void setOutput(int node) { output_ = node; outputSet_ = true; }
+        int output() const noexcept { return outputSet_ ? output_ : static_cast<int>(nodes_.size()) - 1; }
+
+        const std::vector<GraphNode>& nodes() const noexcept { return nodes_; }
+
+    private:
+        std::vector<GraphNode> nodes_;
+        int output_ = kGraphInput;
+        bool outputSet_ = false;
+    };
+
+    // One stage invocation of the flat schedule
+    struct GraphOp {
+        StageKind kind = StageKind::Copy;
+        uint8_t in = 0;            // Buffer indices (0 = caller's block)
+        uint8_t in2 = 0;           // Mix only
+        uint8_t out = 0;           // == in: processed in place
+        uint8_t instance = 0;      // N-th occurrence of this kind in the graph
+        float gain = 1.0f;         // Mix only
+        float gain2 = 1.0f;        // Mix only
+        void* module = nullptr;    // Bound by DSPChain
+    };
+
+    enum class GraphError {
+        None,
+        BadInput,            // Reads a node that does not exist yet
+        DuplicateVoiceGain,  // VoiceGain is a single chain-level ramp
+        Unsupported,         // Copy/Count in a spec
+        TooLarge             // More nodes or buffers than a GraphOp can index
+    };
+
+    struct CompiledGraph {
+        std::vector<GraphOp> ops;
+        int scratchBuffers = 0;                // Besides the caller's block
+        int instances[kModuleKindCount] = {};  // Module instances needed per kind
+    };
+
+    // Control thread. noiseCanceller = false: NoiseCanceller nodes act as bypassed
+    // (builds without dsp/noisecancel/, like the fixed chain's #if)
+    GraphError compileGraph(const GraphSpec& spec, bool noiseCanceller, CompiledGraph& compiled);
+
+    const char* stageKindName(StageKind kind) noexcept;
+
+} // namespace soundarch::dsp
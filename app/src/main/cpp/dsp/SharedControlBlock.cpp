@@ -0,0 +1,113 @@
+#include "SharedControlBlock.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace soundarch::dsp {
+
+    namespace {
+        uint32_t floatBits(float value) noexcept {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        // Exponent all ones: NaN or ±inf. On the bits, because -ffast-math
+        // (Release) lets the compiler assume std::isfinite() is always true.
+        bool isNonFinite(uint32_t bits) noexcept {
+            return (bits & 0x7F800000u) == 0x7F800000u;
+        }
+    } // anonymous namespace
+
+    SharedControlBlock::SharedControlBlock() noexcept {
+        auto& header = layout_.header;
+        header.magic = kMagic;
+        header.layoutVersion = kLayoutVersion;
+        header.sizeBytes = static_cast<uint32_t>(sizeof(Layout));
+        header.paramCount = static_cast<uint32_t>(kParamCount);
+        header.controlOffset = static_cast<uint32_t>(offsetof(Layout, control));
+        header.telemetryOffset = static_cast<uint32_t>(offsetof(Layout, telemetry));
+
+        // Nothing set by the UI yet: the chain keeps its own defaults
+        const float untouched = std::numeric_limits<float>::quiet_NaN();
+        auto& control = layout_.control;
+        control.generation.store(0, std::memory_order_relaxed);
+        for (auto& s : control.switches) s.store(kSwitchUntouched, std::memory_order_relaxed);
+        for (auto& p : control.params) p.store(untouched, std::memory_order_relaxed);
+
+        lastSwitches_.fill(kSwitchUntouched);
+        lastParamBits_.fill(floatBits(untouched));
+
+        publish(EngineMeters{});
+        layout_.telemetry.generation.store(0, std::memory_order_relaxed);
+    }
+
+    size_t SharedControlBlock::pump(DSPChain& chain) noexcept {
+        const uint32_t generation = layout_.control.generation.load(std::memory_order_acquire);
+        if (generation != seenGeneration_) {
+            seenGeneration_ = generation;
+            confirmScans_ = 1;                  // Values may land after the bump: look again next time
+        } else if (confirmScans_ > 0) {
+            --confirmScans_;
+        } else if (++idlePumps_ < kBackstopPumps) {
+            return 0;
+        }
+        idlePumps_ = 0;
+        return scan(chain);
+    }
+
+    size_t SharedControlBlock::scan(DSPChain& chain) noexcept {
+        auto& control = layout_.control;
+        size_t applied = 0;
+
+        for (size_t i = 0; i < kModuleSwitchCount; ++i) {
+            const int32_t state = control.switches[i].load(std::memory_order_relaxed);
+            if (state == kSwitchUntouched || state == lastSwitches_[i]) continue;
+            lastSwitches_[i] = state;
+
+            const bool enabled = state != 0;
+            switch (static_cast<ModuleSwitch>(i)) {
+                case ModuleSwitch::AGC: chain.setAGCEnabled(enabled); break;
+                case ModuleSwitch::NoiseCanceller: chain.setNoiseCancellerEnabled(enabled); break;
+                case ModuleSwitch::Compressor: chain.setCompressorEnabled(enabled); break;
+                case ModuleSwitch::Limiter: chain.setLimiterEnabled(enabled); break;
+                case ModuleSwitch::Count: break;
+            }
+            ++applied;
+        }
+
+        for (size_t i = 0; i < kParamCount; ++i) {
+            const float value = control.params[i].load(std::memory_order_relaxed);
+            const uint32_t bits = floatBits(value);
+            if (bits == lastParamBits_[i]) continue;
+            lastParamBits_[i] = bits;
+            if (isNonFinite(bits)) continue;   // NaN = untouched, ±inf = garbage
+
+            const auto id = static_cast<Param>(i);
+            if (id == Param::VoiceGain) {
+                chain.setVoiceGainDb(std::clamp(value, kVoiceGainMinDb, kVoiceGainMaxDb));
+            } else {
+                chain.setParameter(id, value);   // Drained by the processBlock() that follows
+            }
+            ++applied;
+        }
+        return applied;
+    }
+
+    void SharedControlBlock::publish(const EngineMeters& meters) noexcept {
+        auto& t = layout_.telemetry;
+        t.peakDb.store(meters.peakDb, std::memory_order_relaxed);
+        t.rmsDb.store(meters.rmsDb, std::memory_order_relaxed);
+        t.agcGainDb.store(meters.agcGainDb, std::memory_order_relaxed);
+        t.agcLevelDb.store(meters.agcLevelDb, std::memory_order_relaxed);
+        t.compressorReductionDb.store(meters.compressorReductionDb, std::memory_order_relaxed);
+        t.limiterReductionDb.store(meters.limiterReductionDb, std::memory_order_relaxed);
+        t.xRunCount.store(meters.xRunCount, std::memory_order_relaxed);
+        t.callbackFrames.store(meters.callbackFrames, std::memory_order_relaxed);
+        t.safeModeActive.store(meters.safeModeActive ? 1u : 0u, std::memory_order_relaxed);
+
+        // Single writer: no RMW needed
+        t.generation.store(t.generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+} // namespace soundarch::dsp
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "DSPChain.h"
+#include "ParameterQueue.h"
+
+namespace soundarch::dsp {
+
+// ==============================================================================
+// 🧩 SHARED CONTROL BLOCK - Kotlin ↔ native parameters and meters, no JNI per field
+// ==============================================================================
+//
+// Problem:
+//   Every slider move and every meter poll used to be its own JNI call
+//   (setAGCTargetLevel, getPeakDb, getRmsDb, getCompressorGainReduction...).
+//   A display-rate meter meant ~6 JNI crossings per frame, and a preset
+//   recall ~20 setter calls, each logging.
+//
+// Solution: one 320-byte region handed to Kotlin once as a DirectByteBuffer
+//   - Control   (Kotlin → native): parameter floats indexed by dsp::Param,
+//     module switches, and a generation counter Kotlin bumps after writing
+//   - Telemetry (native → Kotlin): meters published after every callback,
+//     with a generation counter Kotlin compares to skip unchanged frames
+//
+// Memory Layout (layout version 2, native byte order, all fields 32-bit):
+//
+//   offset   0  Header      magic 'SACB', layoutVersion, sizeBytes, paramCount,
+//                           controlOffset, telemetryOffset
+//   offset  64  Control     generation, switches[4] (-1 = untouched, 0/1),
+//                           params[kParamCount] (NaN = untouched)
+//   offset 256  Telemetry   generation, peakDb, rmsDb, agcGainDb, agcLevelDb,
+//                           compressorReductionDb, limiterReductionDb,
+//                           xRunCount, callbackFrames, safeModeActive
+//
+//   Mirrored by com.soundarch.engine.SharedControlBlock. Any change to the
+//   field order bumps kLayoutVersion (Kotlin refuses a version it doesn't know).
+//
+// Why a generation counter is only a hint:
+//   With minSdk 29 the JVM has no release store on a ByteBuffer (VarHandle
+//   views need API 33), so the generation bump can become visible before the
+//   values written ahead of it. Aligned 32-bit fields are never torn, so the
+//   pump simply scans once more on the next callback after every generation
+//   change, plus a slow backstop scan (kBackstopPumps) in case a bump itself
+//   was missed. Only values that differ from the last scan are posted.
+//
+// Thread Safety:
+//   - pump(): the audio thread, before DSPChain::processBlock()
+//   - publish(): the audio thread, after it
+//   - data()/sizeBytes(): any thread (the memory never moves)
+//   - Kotlin: one writer thread for control, any reader for telemetry
+//
+// Cost per callback: one generation load when idle, ~10 relaxed stores to publish.
+//
+// ==============================================================================
+
+    // Module on/off switches in the control section
+    enum class ModuleSwitch : uint32_t {
+        AGC,
+        NoiseCanceller,
+        Compressor,
+        Limiter,
+
+        Count
+    };
+
+    constexpr size_t kModuleSwitchCount = static_cast<size_t>(ModuleSwitch::Count);
+
+    // Values published to the telemetry section
+    struct EngineMeters {
+        float peakDb = -60.0f;
+        float rmsDb = -60.0f;
+        float agcGainDb = 0.0f;
+        float agcLevelDb = -60.0f;
+        float compressorReductionDb = 0.0f;   // Positive dB of reduction
+        float limiterReductionDb = 0.0f;      // Positive dB of reduction
+        uint32_t xRunCount = 0;
+        uint32_t callbackFrames = 0;
+        bool safeModeActive = false;
+    };
+
+    class SharedControlBlock {
+    public:
+        static constexpr uint32_t kMagic = 0x42434153;   // "SACB" in little-endian memory
+        static constexpr uint32_t kLayoutVersion = 2;   // 2: DynamicsControlInterval, telemetry at 256
+        static constexpr int32_t kSwitchUntouched = -1;
+        static constexpr uint32_t kBackstopPumps = 64;   // ≈ 0.25 s of 4 ms callbacks
+
+        struct Header {
+            uint32_t magic;
+            uint32_t layoutVersion;
+            uint32_t sizeBytes;
+            uint32_t paramCount;
+            uint32_t controlOffset;
+            uint32_t telemetryOffset;
+        };
+
+        struct alignas(64) Control {
+            std::atomic<uint32_t> generation;
+            std::atomic<int32_t> switches[kModuleSwitchCount];
+            std::atomic<float> params[kParamCount];
+        };
+
+        struct alignas(64) Telemetry {
+            std::atomic<uint32_t> generation;
+            std::atomic<float> peakDb;
+            std::atomic<float> rmsDb;
+            std::atomic<float> agcGainDb;
+            std::atomic<float> agcLevelDb;
+            std::atomic<float> compressorReductionDb;
+            std::atomic<float> limiterReductionDb;
+            std::atomic<uint32_t> xRunCount;
+            std::atomic<uint32_t> callbackFrames;
+            std::atomic<uint32_t> safeModeActive;
+        };
+
+        struct alignas(64) Layout {
+            Header header;
+            Control control;
+            Telemetry telemetry;
+        };
+
+        SharedControlBlock() noexcept;
+
+        SharedControlBlock(const SharedControlBlock&) = delete;
+        SharedControlBlock& operator=(const SharedControlBlock&) = delete;
+
+        // Backing memory for NewDirectByteBuffer()
+        [[nodiscard]] void* data() noexcept { return &layout_; }
+        [[nodiscard]] const void* data() const noexcept { return &layout_; }
+        static constexpr size_t sizeBytes() noexcept { return sizeof(Layout); }
+
+        // ⚡ Audio thread: forwards changed control values to the chain.
+        // Returns the number of parameters/switches applied.
+        size_t pump(DSPChain& chain) noexcept;
+
+        // ⚡ Audio thread: writes the meters and bumps the telemetry generation
+        void publish(const EngineMeters& meters) noexcept;
+
+        // Voice gain arrives unchecked from Kotlin (the JNI setter clamps the same way)
+        static constexpr float kVoiceGainMinDb = -12.0f;
+        static constexpr float kVoiceGainMaxDb = 12.0f;
+
+    private:
+        size_t scan(DSPChain& chain) noexcept;
+
+        Layout layout_;
+
+        // Audio thread only (never shared with Kotlin)
+        uint32_t seenGeneration_ = 0;
+        uint32_t confirmScans_ = 0;
+        uint32_t idlePumps_ = 0;
+        std::array<int32_t, kModuleSwitchCount> lastSwitches_{};
+        std::array<uint32_t, kParamCount> lastParamBits_{};
+    };
+
+    // Mirrored by com.soundarch.engine.SharedControlBlock: keep in sync
+    static_assert(sizeof(std::atomic<float>) == 4 && sizeof(std::atomic<uint32_t>) == 4,
+                  "Shared fields must be plain 32-bit words");
+    static_assert(std::atomic<float>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                  "Kotlin reads and writes the fields without locks");
+    static_assert(offsetof(SharedControlBlock::Layout, control) == 64);
+    static_assert(offsetof(SharedControlBlock::Layout, telemetry) == 256);
+    static_assert(SharedControlBlock::sizeBytes() == 320);
+    static_assert(offsetof(SharedControlBlock::Control, switches) == 4);
+    static_assert(offsetof(SharedControlBlock::Control, params) == 20);
+    static_assert(offsetof(SharedControlBlock::Telemetry, peakDb) == 4);
+    static_assert(offsetof(SharedControlBlock::Telemetry, safeModeActive) == 36);
+
+} // namespace soundarch::dsp
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+
+namespace soundarch::dsp {
+
+// ==============================================================================
+// 〰️ SMOOTHED VALUE - Linear parameter ramp, no transcendental per sample
+// ==============================================================================
+//
+// A parameter jump (threshold, makeup, voice gain...) applied between two
+// samples is a step in the gain curve: audible as a click, and as "zipper"
+// noise when a slider sends a burst of jumps. setTarget() turns the jump
+// into a straight line of rampSamples steps:
+//
+//   next()  → one add per sample while ramping, then the exact target
+//   skip(n) → n samples at once (block-rate users, e.g. EQ coefficients)
+//
+// The ramp runs in whatever domain the caller stores: linear gain for gains
+// (converted once per update, not per sample), dB for thresholds, the slope
+// 1 - 1/ratio for ratios.
+//
+// Not thread-safe: owned by the thread that processes (the audio thread
+// once the chain runs, see DSPChain parameter queue).
+//
+// ==============================================================================
+
+    class SmoothedValue {
+    public:
+        SmoothedValue() noexcept : SmoothedValue(0.0f) {}
+        explicit SmoothedValue(float value) noexcept
+                : current_(value), target_(value) {}
+
+        // Jump (no ramp)
+        void setImmediate(float value) noexcept {
+            current_ = target_ = value;
+            step_ = 0.0f;
+            remaining_ = 0;
+        }
+
+        // Ramp from the current value to target over rampSamples (≤ 0: jump).
+        // Retargeting mid-ramp starts from where the ramp is: no discontinuity.
+        void setTarget(float target, int32_t rampSamples) noexcept {
+            if (rampSamples <= 0 || target == current_) {
+                setImmediate(target);
+                return;
+            }
+            target_ = target;
+            step_ = (target - current_) / static_cast<float>(rampSamples);
+            remaining_ = rampSamples;
+        }
+
+        // Value for the next sample
+        float next() noexcept {
+            if (remaining_ > 0) {
+                current_ = (--remaining_ == 0) ? target_ : current_ + step_;
+            }
+            return current_;
+        }
+
+        // Advances n samples, returns the value reached
+        float skip(int32_t n) noexcept {
+            if (remaining_ > 0) {
+                if (n >= remaining_) {
+                    setImmediate(target_);
+                } else {
+                    remaining_ -= n;
+                    current_ += step_ * static_cast<float>(n);
+                }
+            }
+            return current_;
+        }
+
+        // Ends a ramp early (reset paths)
+        void finish() noexcept { setImmediate(target_); }
+
+        [[nodiscard]] bool isRamping() const noexcept { return remaining_ > 0; }
+        [[nodiscard]] float current() const noexcept { return current_; }
+        [[nodiscard]] float target() const noexcept { return target_; }
+
+    private:
+        float current_;
+        float target_;
+        float step_ = 0.0f;
+        int32_t remaining_ = 0;
+    };
+
+} // namespace soundarch::dsp
@@ -8,10 +8,11 @@
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 //
 // Thread 1: AUDIO RT THREAD (Oboe callback, SCHED_FIFO priority 18)
-//   - Runs audioCallback() with strict real-time constraints
+//   - Runs EngineContext::onDeviceAudio() with strict real-time constraints
 //   - ZERO allocations (malloc/new banned)
 //   - ZERO mutexes/locks (lock-free only)
 //   - ZERO system calls (no I/O, no logging)
+//   - Enforced by utils/RtGuard.h on host test builds (testing/RtGuardTest.cpp)
 //   - Uses lock-free RingBuffer for audio I/O
 //   - Uses std::atomic with memory_order_relaxed for enable flags
 //   - All DSP processing stays in C++ (AGC → EQ → Compressor → Limiter)
@@ -19,8 +20,9 @@
 // Thread 2: UI THREAD (Android Main Thread)
 //   - Handles JNI calls from MainActivity.kt
 //   - Can allocate memory (NewGlobalRef, GetFloatArrayElements)
-//   - Updates DSP parameters via lock-free atomics
-//   - Equalizer uses double-buffering (atomic filter set swap)
+//   - Posts DSP parameters to DSPChain's ParameterQueue (lock-free)
+//   - Module rebuilds / NoiseCanceller settings serialize on DSPChain's swap
+//     mutex, which the audio thread never takes
 //   - NEVER blocks audio thread
 //
 // Thread 3: LATENCY REPORTER (10Hz periodic callback)
@@ -33,44 +35,55 @@
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 //
 // UI → Audio (Control Flow):
-//   - Simple atomics: gAGCEnabled, gCompressorEnabled, gLimiterEnabled
-//     → std::atomic<bool> with memory_order_relaxed (no ordering needed)
+//   - Simple atomics: DSPChain enable flags (AGC, NC, Compressor, Limiter), voice gain
+//     → std::atomic with memory_order_relaxed (no ordering needed)
 //
-//   - Complex updates (Equalizer coefficients):
-//     → Double-buffering with std::atomic<int> activeFilterSet_
-//     → UI updates inactive set, then atomically swaps
-//     → Audio always reads consistent filter state
-//     → Zero glitches, zero contention
+//   - Parameter updates (AGC, EQ bands, Compressor, Limiter, voice gain):
+//     → DSPChain::setParameter() → ParameterQueue (coalesced per parameter)
+//     → drained at the top of the next block, never mid-block; level-type
+//       values glide over the smoothing time (see DSPChain.h, Thread Safety)
 //
-//   - Parameter updates (setThreshold, setRatio, etc.):
-//     → Direct member writes (single float, naturally atomic on ARM)
-//     → Audio reads eventually consistent values
+//   - Equalizer coefficients:
+//     → computed for the whole set, published through a wait-free TripleBuffer
+//     → the audio thread glides the cascade to the new set over one block
+//
+//   - Module swaps (sample rate, routing, NoiseCanceller settings):
+//     → built on the control thread, published with one atomic exchange,
+//       old set freed once the audio thread has left it (EpochReclaimer)
+//
+//   - Shared control block (dsp/SharedControlBlock.h):
+//     → Kotlin writes parameter floats into a DirectByteBuffer, bumps a generation
+//     → the audio callback posts the changed ones to the parameter queue
 //
 // Audio → UI (Monitoring):
-//   - Metrics: gProcessedFrames, gDroppedFrames
-//     → std::atomic<uint64_t> with memory_order_relaxed
-//   - Latency reporting via separate callback thread
+//   - Meters: published into the shared control block after every callback,
+//     read by Kotlin at display rate without any JNI call
+//   - Metrics: EngineContext processed frames, OboeEngine xruns
+//     → std::atomic with memory_order_relaxed
+//   - Latency reporting via OboeEngine's telemetry thread
 //     → sendLatencyToJava() runs at 10Hz, NOT in audio callback
 //
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 // 💾 ALLOCATION POLICY
 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 //
-// STARTUP (startAudio() - UI thread):
-//   ✅ std::make_unique for DSP modules (AGC, Equalizer, Compressor, Limiter)
+// STARTUP (JNI_OnLoad / startAudio() - UI thread):
+//   ✅ EngineContext: DSP modules (AGC, Equalizer, Compressor, Limiter) + OboeEngine
 //   ✅ NewGlobalRef for activity reference (once)
 //   ✅ OboeEngine initialization (stream creation)
 //
-// RUNTIME (audioCallback() - RT thread):
+// RUNTIME (audio callback - RT thread):
 //   ❌ NO malloc/calloc/realloc/new
 //   ❌ NO std::vector/std::string/std::map
 //   ❌ NO JNI calls (no NewFloatArray, NewStringUTF, etc.)
 //   ❌ NO mutexes/locks/condition_variables
-//   ✅ Stack buffers only (float temp[4096])
-//   ✅ Lock-free RingBuffer for audio I/O
+//   ✅ Input read straight into the lock-free RingBuffer's spans, processed
+//      in place in the output buffer (no intermediate copy)
 //
 // UI CALLS (JNI functions - UI thread):
 //   ✅ GetFloatArrayElements in setEqBands() - safe, not on RT thread
+//   ✅ Parameter setters post to DSPChain's parameter queue (lock-free);
+//      the audio callback applies them before processing its next block
 //   ✅ NewStringUTF in getCurrentLatency() - safe, polling only
 //
 // ==============================================================================
@@ -88,14 +101,10 @@
 #include <algorithm>
 
 // Audio Engine
-#include "audio/OboeEngine.h"
+#include "audio/EngineContext.h"
 
-// DSP Modules
-#include "dsp/Equalizer.h"
-#include "dsp/AGC.h"
-#include "dsp/Compressor.h"
-#include "dsp/Limiter.h"
-#include "dsp/noisecancel/NoiseCanceller.h"
+// DSP Modules (AGC → EQ → Voice Gain → NC → Compressor → Limiter)
+#include "dsp/DSPChain.h"
 
 // ML Engine
 #include "ml/TFLiteEngine.h"
@@ -110,34 +119,23 @@
 #define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, TAG, __VA_ARGS__)
 
 // ==============================================================================
-// 🎛️ GLOBAL DSP STATE (Thread-Safe)
+// 🎛️ SESSION STATE
 // ==============================================================================
 
 using namespace soundarch;
 
 namespace {
 
-// Audio Engine
-    OboeEngine gEngine;
-
-// DSP Modules (heap-allocated for controlled lifecycle)
-    std::unique_ptr<dsp::Equalizer> gEqualizer;
-    std::unique_ptr<dsp::AGC> gAGC;
-    std::unique_ptr<dsp::noisecancel::NoiseCanceller> gNoiseCanceller;
-    std::unique_ptr<dsp::Compressor> gCompressor;
-    std::unique_ptr<dsp::Limiter> gLimiter;
+// 🧳 The app's session (audio/EngineContext.h): OboeEngine, DSPChain (AGC, EQ,
+// NC, Compressor, Limiter, enable flags, voice gain), shared control block and
+// counters. Created in JNI_OnLoad, destroyed in JNI_OnUnload: never null in
+// between. Independent contexts: engine/NativeAudioEngine.kt or SoundArchEngine.h
+    std::unique_ptr<EngineContext> gSession;
 
 // ML Engine (heap-allocated, separate thread from audio RT)
     std::unique_ptr<ml::TFLiteEngine> gMLEngine;
 
-// Enable/Disable flags (atomic for thread safety)
-    std::atomic<bool> gAGCEnabled{true};
-    std::atomic<bool> gNoiseCancellerEnabled{false};  // Disabled by default
-    std::atomic<bool> gCompressorEnabled{true};
-    std::atomic<bool> gLimiterEnabled{true};
-
-// Voice Gain (post-EQ, pre-Dynamics) - atomic for thread safety
-    std::atomic<float> gVoiceGainDb{0.0f};  // Default: 0dB (unity gain)
+// Voice Gain range (post-EQ, pre-Dynamics) - value lives in DSPChain
     constexpr float VOICE_GAIN_MIN_DB = -12.0f;
     constexpr float VOICE_GAIN_MAX_DB = 12.0f;
     constexpr float VOICE_GAIN_SAFE_MAX_DB = 6.0f;  // Warn user past this
@@ -146,9 +144,10 @@ namespace {
     JavaVM* gJvm = nullptr;
     jobject gActivity = nullptr;
 
-// Performance Monitoring
-    std::atomic<uint64_t> gProcessedFrames{0};
-    std::atomic<uint32_t> gDroppedFrames{0};
+// Session accessors (the DSP chain is created with the session, at 48 kHz)
+    EngineContext& session() noexcept { return *gSession; }
+    OboeEngine& engine() noexcept { return *gSession->engine(); }
+    dsp::DSPChain& chain() noexcept { return gSession->chain(); }
 
 } // anonymous namespace
 
@@ -157,89 +156,11 @@ namespace {
 // ==============================================================================
 
 /**
- * Provide access to gEngine for BluetoothBridge.cpp
+ * Provide access to the session's engine for BluetoothBridge.cpp
  * This is safe because BluetoothBridge only calls thread-safe methods
  */
 OboeEngine& getGlobalEngine() noexcept {
-    return gEngine;
-}
-
-// ==============================================================================
-// ⚡ AUDIO CALLBACK - OPTIMIZED (Zero Allocation)
-// ==============================================================================
-
-// NOLINTNEXTLINE(readability-non-const-parameter) - input must be non-const to match OboeEngine std::function signature
-static void audioCallback(float* input, float* output, int32_t numFrames) noexcept {
-    // ✅ CRITICAL: This runs on real-time audio thread
-    // NO malloc, NO new, NO vector, NO mutex, NO system calls
-
-    if (!input || !output) return;  // Safety check for null pointers
-
-    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    // 🛡️ SAFE MODE: Bypass DSP on Bluetooth underruns (limiter + pass-through)
-    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    if (gEngine.isSafeModeActive()) {
-        // SAFE MODE ACTIVE: Skip AGC/EQ/Compressor to reduce CPU load
-        // Only apply limiter for peak protection, then pass through
-        if (gLimiter && gLimiterEnabled.load(std::memory_order_relaxed)) {
-            gLimiter->processBlock(input, output, numFrames);
-        }
-        // If limiter disabled or not available, pure pass-through (no-op since input==output)
-
-        gProcessedFrames.fetch_add(numFrames, std::memory_order_relaxed);
-        return;  // Exit early, skip full DSP chain
-    }
-
-    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    // 🎛️ NORMAL MODE: Full DSP chain
-    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-
-    // ✅ OPTIMIZED: Block processing - 5-30% less CPU
-    // Process entire blocks instead of sample-by-sample
-    // Enables SIMD vectorization and better cache locality
-
-    // 1️⃣ AGC (Automatic Gain Control)
-    // Note: input and output point to same buffer (in-place processing)
-    if (gAGC && gAGCEnabled.load(std::memory_order_relaxed)) {
-        gAGC->processBlock(input, output, numFrames);
-    }
-    // If AGC disabled, buffer remains unchanged (no copy needed)
-
-    // 2️⃣ Equalizer (Frequency shaping) - in-place
-    if (gEqualizer) {
-        gEqualizer->processBlock(output, output, numFrames);
-    }
-
-    // 2.5️⃣ Voice Gain (post-EQ, pre-Dynamics) - in-place
-    // Simple linear gain multiplication (dB → linear conversion)
-    const float voiceGainDb = gVoiceGainDb.load(std::memory_order_relaxed);
-    if (voiceGainDb != 0.0f) {
-        const float gainLinear = std::pow(10.0f, voiceGainDb / 20.0f);
-        for (int32_t i = 0; i < numFrames; ++i) {
-            output[i] *= gainLinear;
-        }
-    }
-
-    // 3️⃣ Noise Canceller (Spectral subtraction) - in-place
-    // NOTE: When disabled, processBlock() performs ZERO work (no FFT, early return)
-    // Positioned after EQ to remove noise from frequency-shaped signal
-    if (gNoiseCanceller && gNoiseCancellerEnabled.load(std::memory_order_relaxed)) {
-        const float sampleRate = gEngine.getSampleRate();  // ✅ FIXED: Get dynamically from OboeEngine
-        gNoiseCanceller->processBlock(output, output, numFrames, static_cast<int>(sampleRate));
-    }
-
-    // 4️⃣ Compressor (Dynamic control) - in-place
-    if (gCompressor && gCompressorEnabled.load(std::memory_order_relaxed)) {
-        gCompressor->processBlock(output, output, numFrames);
-    }
-
-    // 5️⃣ Limiter (Peak protection) - in-place
-    if (gLimiter && gLimiterEnabled.load(std::memory_order_relaxed)) {
-        gLimiter->processBlock(output, output, numFrames);
-    }
-
-    // Update metrics
-    gProcessedFrames.fetch_add(numFrames, std::memory_order_relaxed);
+    return engine();
 }
 
 // ==============================================================================
@@ -248,9 +169,16 @@ static void audioCallback(float* input, float* output, int32_t numFrames) noexce
 
 extern "C" {
 
+void sendLatencyToJava(double latency);  // 🔔 Defined below, registered with the engine in startAudio()
+
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
     gJvm = vm;
-    LOGI("✅ JNI_OnLoad: JavaVM cached");
+
+    // ⚡ The audio callback (EngineContext::onDeviceAudio) runs AGC → EQ → Voice Gain →
+    // NC → Compressor → Limiter, same code path as tools/OfflineRenderer.cpp
+    const float defaultSampleRate = 48000.0f;  // Common default for Android devices
+    gSession = std::make_unique<EngineContext>(defaultSampleRate, std::make_unique<OboeEngine>());
+    LOGI("✅ JNI_OnLoad: JavaVM cached, session created (DSP chain SR=%.0fHz)", defaultSampleRate);
     return JNI_VERSION_1_6;
 }
 
@@ -260,6 +188,8 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
 // CRITICAL: Release gActivity global reference to prevent MainActivity leak
 // Called automatically when native library is unloaded
 JNIEXPORT void JNICALL JNI_OnUnload(JavaVM* vm, void*) {
+    gSession.reset();   // Stops the stream before anything it calls back into goes away
+
     JNIEnv* env = nullptr;
     if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK) {
         if (gActivity) {
@@ -280,80 +210,26 @@ Java_com_soundarch_MainActivity_startAudio(JNIEnv* env, jobject thiz) {
     }
 
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    // 🎯 Initialize DSP Modules (if not already created)
-    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    // NOTE: We use a default sample rate for initialization. The DSP modules
-    // will handle resampling/adaptation automatically if needed.
-    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-
-    const float defaultSampleRate = 48000.0f;  // Common default for Android devices
-
-    if (!gAGC) {
-        gAGC = std::make_unique<dsp::AGC>(defaultSampleRate);
-        gAGC->setTargetLevel(-20.0f);
-        gAGC->setMaxGain(25.0f);
-        gAGC->setMinGain(-10.0f);
-        gAGC->setAttackTime(0.1f);   // Fast attack: 100ms
-        gAGC->setReleaseTime(0.5f);  // Fast release: 500ms
-        gAGC->setNoiseThreshold(-55.0f);
-        gAGC->setWindowSize(0.1f);
-        LOGI("✅ AGC initialized (Target=-20dB, Attack=100ms, Release=500ms, SR=%.0fHz)", defaultSampleRate);
-    }
-
-    if (!gEqualizer) {
-        gEqualizer = std::make_unique<dsp::Equalizer>(defaultSampleRate);
-        LOGI("✅ Equalizer initialized (10 bands, SR=%.0fHz)", defaultSampleRate);
-    }
-
-    if (!gNoiseCanceller) {
-        gNoiseCanceller = std::make_unique<dsp::noisecancel::NoiseCanceller>();
-        gNoiseCanceller->init(static_cast<int>(defaultSampleRate), 512);  // 512-point FFT
-        gNoiseCanceller->applyPreset(dsp::noisecancel::NoiseCancellerParams::Preset::Default);
-        LOGI("✅ NoiseCanceller initialized (BlockSize=512, Preset=Default, Disabled by default, SR=%.0fHz)", defaultSampleRate);
-    }
-
-    if (!gCompressor) {
-        gCompressor = std::make_unique<dsp::Compressor>(defaultSampleRate);
-        gCompressor->setThreshold(-20.0f);
-        gCompressor->setRatio(4.0f);
-        gCompressor->setAttack(5.0f);
-        gCompressor->setRelease(50.0f);
-        gCompressor->setMakeupGain(0.0f);
-        LOGI("✅ Compressor initialized (Threshold=-20dB, Ratio=4:1, SR=%.0fHz)", defaultSampleRate);
-    }
-
-    if (!gLimiter) {
-        gLimiter = std::make_unique<dsp::Limiter>(defaultSampleRate);
-        gLimiter->setThreshold(-1.0f);
-        gLimiter->setRelease(50.0f);
-        LOGI("✅ Limiter initialized (Threshold=-1dBFS, Release=50ms, SR=%.0fHz)", defaultSampleRate);
-    }
-
-    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-    // 🎧 Start Audio Engine
+    // 🎧 Start Audio Engine (DSP modules already live in the session)
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 
-    gEngine.setAudioCallback(audioCallback);
-    gEngine.start();
+    engine().setLatencyListener(sendLatencyToJava);
+    session().start();   // Also resets the processed frame counter
 
     // Log actual sample rate after starting
-    const float actualSampleRate = gEngine.getSampleRate();  // ✅ FIXED: Get actual sample rate from Oboe
+    const float actualSampleRate = engine().getSampleRate();  // ✅ FIXED: Get actual sample rate from Oboe
     LOGI("✅ Audio engine STARTED | Actual SR: %.0f Hz | DSP Chain: AGC → EQ → NC (disabled) → Comp → Limiter", actualSampleRate);
-
-    // Reset metrics
-    gProcessedFrames.store(0, std::memory_order_relaxed);
-    gDroppedFrames.store(0, std::memory_order_relaxed);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_stopAudio([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    gEngine.stop();
+    session().stop();
 
-    const uint64_t totalFrames = gProcessedFrames.load(std::memory_order_relaxed);
-    const uint32_t drops = gDroppedFrames.load(std::memory_order_relaxed);
+    const uint64_t totalFrames = session().processedFrames();
+    const uint32_t xruns = engine().getXRunCount();
 
-    LOGI("🛑 Audio engine STOPPED | Processed: %llu frames | Drops: %u",
-         (unsigned long long)totalFrames, drops);
+    LOGI("🛑 Audio engine STOPPED | Processed: %llu frames | XRuns: %u",
+         (unsigned long long)totalFrames, xruns);
 }
 
 // ==============================================================================
@@ -362,11 +238,6 @@ Java_com_soundarch_MainActivity_stopAudio([[maybe_unused]] JNIEnv* env, jobject
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setEqBands(JNIEnv* env, jobject /*thiz*/, jfloatArray gains) {
-    if (!gEqualizer) {
-        LOGW("⚠️ setEqBands: Equalizer not initialized");
-        return;
-    }
-
     jfloat* ptr = env->GetFloatArrayElements(gains, nullptr);
     if (!ptr) {
         LOGE("❌ setEqBands: Invalid float array");
@@ -376,8 +247,9 @@ Java_com_soundarch_MainActivity_setEqBands(JNIEnv* env, jobject /*thiz*/, jfloat
     const jsize len = env->GetArrayLength(gains);
     const jsize maxBands = std::min(len, static_cast<jsize>(dsp::Equalizer::kNumBands));
 
+    // 📨 Applied by the audio thread at its next block, each band gliding to its new gain
     for (jsize i = 0; i < maxBands; ++i) {
-        gEqualizer->setBandGain(i, ptr[i]);
+        chain().setParameter(dsp::eqBandParam(i), ptr[i]);
     }
 
     env->ReleaseFloatArrayElements(gains, ptr, JNI_ABORT);
@@ -390,74 +262,60 @@ Java_com_soundarch_MainActivity_setEqBands(JNIEnv* env, jobject /*thiz*/, jfloat
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setAGCTargetLevel([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jfloat targetDb) {
-    if (gAGC) {
-        gAGC->setTargetLevel(targetDb);
-        LOGI("🎯 AGC Target: %.1f dB", targetDb);
-    }
+    chain().setParameter(dsp::Param::AGCTargetLevel, targetDb);
+    LOGI("🎯 AGC Target: %.1f dB", targetDb);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setAGCMaxGain([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jfloat maxGainDb) {
-    if (gAGC) {
-        gAGC->setMaxGain(maxGainDb);
-        LOGI("📈 AGC MaxGain: +%.1f dB", maxGainDb);
-    }
+    chain().setParameter(dsp::Param::AGCMaxGain, maxGainDb);
+    LOGI("📈 AGC MaxGain: +%.1f dB", maxGainDb);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setAGCMinGain([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jfloat minGainDb) {
-    if (gAGC) {
-        gAGC->setMinGain(minGainDb);
-        LOGI("📉 AGC MinGain: %.1f dB", minGainDb);
-    }
+    chain().setParameter(dsp::Param::AGCMinGain, minGainDb);
+    LOGI("📉 AGC MinGain: %.1f dB", minGainDb);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setAGCAttackTime([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jfloat seconds) {
-    if (gAGC) {
-        gAGC->setAttackTime(seconds);
-        LOGI("⚡ AGC Attack: %.2f s", seconds);
-    }
+    chain().setParameter(dsp::Param::AGCAttackTime, seconds);
+    LOGI("⚡ AGC Attack: %.2f s", seconds);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setAGCReleaseTime([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jfloat seconds) {
-    if (gAGC) {
-        gAGC->setReleaseTime(seconds);
-        LOGI("🕒 AGC Release: %.2f s", seconds);
-    }
+    chain().setParameter(dsp::Param::AGCReleaseTime, seconds);
+    LOGI("🕒 AGC Release: %.2f s", seconds);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setAGCNoiseThreshold([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jfloat thresholdDb) {
-    if (gAGC) {
-        gAGC->setNoiseThreshold(thresholdDb);
-        LOGI("🔇 AGC NoiseGate: %.1f dB", thresholdDb);
-    }
+    chain().setParameter(dsp::Param::AGCNoiseThreshold, thresholdDb);
+    LOGI("🔇 AGC NoiseGate: %.1f dB", thresholdDb);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setAGCWindowSize([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jfloat seconds) {
-    if (gAGC) {
-        gAGC->setWindowSize(seconds);
-        LOGI("⏱️ AGC Window: %.2f s", seconds);
-    }
+    chain().setParameter(dsp::Param::AGCWindowSize, seconds);
+    LOGI("⏱️ AGC Window: %.2f s", seconds);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setAGCEnabled([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jboolean enabled) {
-    gAGCEnabled.store(enabled, std::memory_order_relaxed);
+    chain().setAGCEnabled(enabled);
     LOGI("%s AGC %s", enabled ? "✅" : "❌", enabled ? "ENABLED" : "DISABLED");
 }
 
 [[nodiscard]] JNIEXPORT jfloat JNICALL
 Java_com_soundarch_MainActivity_getAGCCurrentGain([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return gAGC ? gAGC->getCurrentGain() : 0.0f;
+    return chain().moduleMeters().agcGainDb;
 }
 
 [[nodiscard]] JNIEXPORT jfloat JNICALL
 Java_com_soundarch_MainActivity_getAGCCurrentLevel([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return gAGC ? gAGC->getCurrentLevel() : -60.0f;
+    return chain().moduleMeters().agcLevelDb;
 }
 
 // ==============================================================================
@@ -469,35 +327,32 @@ Java_com_soundarch_MainActivity_setCompressor(
         [[maybe_unused]] JNIEnv* env, jobject /*thiz*/,
         jfloat threshold, jfloat ratio, jfloat attack, jfloat release, jfloat makeupGain
 ) {
-    if (gCompressor) {
-        gCompressor->setThreshold(threshold);
-        gCompressor->setRatio(ratio);
-        gCompressor->setAttack(attack);
-        gCompressor->setRelease(release);
-        gCompressor->setMakeupGain(makeupGain);
-        LOGI("🎛️ Comp: Thr=%.1f Ratio=%.1f:1 Att=%.1fms Rel=%.1fms Makeup=%.1fdB",
-             threshold, ratio, attack, release, makeupGain);
-    }
+    // 📨 Queued for the audio thread: never half-applied inside a block
+    chain().setParameter(dsp::Param::CompressorThreshold, threshold);
+    chain().setParameter(dsp::Param::CompressorRatio, ratio);
+    chain().setParameter(dsp::Param::CompressorAttack, attack);
+    chain().setParameter(dsp::Param::CompressorRelease, release);
+    chain().setParameter(dsp::Param::CompressorMakeupGain, makeupGain);
+    LOGI("🎛️ Comp: Thr=%.1f Ratio=%.1f:1 Att=%.1fms Rel=%.1fms Makeup=%.1fdB",
+         threshold, ratio, attack, release, makeupGain);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setCompressorKnee([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jfloat kneeDb) {
-    if (gCompressor) {
-        gCompressor->setKnee(kneeDb);
-        LOGI("🎛️ Compressor Knee: %.1f dB", kneeDb);
-    }
+    chain().setParameter(dsp::Param::CompressorKnee, kneeDb);
+    LOGI("🎛️ Compressor Knee: %.1f dB", kneeDb);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setCompressorEnabled([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jboolean enabled) {
-    gCompressorEnabled.store(enabled, std::memory_order_relaxed);
+    chain().setCompressorEnabled(enabled);
     LOGI("%s Compressor %s", enabled ? "✅" : "❌", enabled ? "ENABLED" : "DISABLED");
 }
 
 [[nodiscard]] JNIEXPORT jfloat JNICALL
 Java_com_soundarch_MainActivity_getCompressorGainReduction([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
     // Compressor returns negative gain (e.g., -3dB), negate to get positive reduction (3dB)
-    return gCompressor ? -gCompressor->getCurrentGainReduction() : 0.0f;
+    return -chain().moduleMeters().compressorGainReductionDb;
 }
 
 // ==============================================================================
@@ -509,24 +364,22 @@ Java_com_soundarch_MainActivity_setLimiter(
         [[maybe_unused]] JNIEnv* env, jobject /*thiz*/,
         jfloat threshold, jfloat release, jfloat lookahead
 ) {
-    if (gLimiter) {
-        gLimiter->setThreshold(threshold);
-        gLimiter->setRelease(release);
-        gLimiter->setLookahead(lookahead);
-        LOGI("🚨 Limiter: Thr=%.1fdBFS Rel=%.1fms Lookahead=%.1fms", threshold, release, lookahead);
-    }
+    chain().setParameter(dsp::Param::LimiterThreshold, threshold);
+    chain().setParameter(dsp::Param::LimiterRelease, release);
+    chain().setParameter(dsp::Param::LimiterLookahead, lookahead);
+    LOGI("🚨 Limiter: Thr=%.1fdBFS Rel=%.1fms Lookahead=%.1fms", threshold, release, lookahead);
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setLimiterEnabled([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jboolean enabled) {
-    gLimiterEnabled.store(enabled, std::memory_order_relaxed);
+    chain().setLimiterEnabled(enabled);
     LOGI("%s Limiter %s", enabled ? "✅" : "❌", enabled ? "ENABLED" : "DISABLED");
 }
 
 [[nodiscard]] JNIEXPORT jfloat JNICALL
 Java_com_soundarch_MainActivity_getLimiterGainReduction([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
     // Limiter returns negative gain (e.g., -3dB), negate to get positive reduction (3dB)
-    return gLimiter ? -gLimiter->getGainReduction() : 0.0f;
+    return -chain().moduleMeters().limiterGainReductionDb;
 }
 
 // ==============================================================================
@@ -537,7 +390,7 @@ JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setVoiceGain([[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jfloat gainDb) {
     // Clamp to safe range [-12, +12] dB
     const float clampedGain = std::max(VOICE_GAIN_MIN_DB, std::min(VOICE_GAIN_MAX_DB, gainDb));
-    gVoiceGainDb.store(clampedGain, std::memory_order_relaxed);
+    chain().setVoiceGainDb(clampedGain);
 
     const char* warning = (clampedGain > VOICE_GAIN_SAFE_MAX_DB) ? " ⚠️ HIGH GAIN" : "";
     LOGI("🎤 Voice Gain: %+.1f dB%s", clampedGain, warning);
@@ -545,12 +398,12 @@ Java_com_soundarch_MainActivity_setVoiceGain([[maybe_unused]] JNIEnv* env, jobje
 
 [[nodiscard]] JNIEXPORT jfloat JNICALL
 Java_com_soundarch_MainActivity_getVoiceGain([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return gVoiceGainDb.load(std::memory_order_relaxed);
+    return chain().getVoiceGainDb();
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_resetVoiceGain([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    gVoiceGainDb.store(0.0f, std::memory_order_relaxed);
+    chain().setVoiceGainDb(0.0f);
     LOGI("🎤 Voice Gain: RESET to 0.0 dB");
 }
 
@@ -685,42 +538,207 @@ Java_com_soundarch_MainActivity_getMemoryUsage([[maybe_unused]] JNIEnv* env, job
 
 [[nodiscard]] JNIEXPORT jdouble JNICALL
 Java_com_soundarch_MainActivity_getLatencyInputMs([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return gEngine.getLatencyStats().inputMs;
+    return engine().getLatencyStats().inputMs;
 }
 
 [[nodiscard]] JNIEXPORT jdouble JNICALL
 Java_com_soundarch_MainActivity_getLatencyOutputMs([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return gEngine.getLatencyStats().outputMs;
+    return engine().getLatencyStats().outputMs;
 }
 
 [[nodiscard]] JNIEXPORT jdouble JNICALL
 Java_com_soundarch_MainActivity_getLatencyTotalMs([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return gEngine.getLatencyStats().totalMs;
+    return engine().getLatencyStats().totalMs;
 }
 
 [[nodiscard]] JNIEXPORT jdouble JNICALL
 Java_com_soundarch_MainActivity_getLatencyEmaMs([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return gEngine.getLatencyStats().emaMs;
+    return engine().getLatencyStats().emaMs;
 }
 
 [[nodiscard]] JNIEXPORT jdouble JNICALL
 Java_com_soundarch_MainActivity_getLatencyMinMs([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return gEngine.getLatencyStats().minMs;
+    return engine().getLatencyStats().minMs;
 }
 
 [[nodiscard]] JNIEXPORT jdouble JNICALL
 Java_com_soundarch_MainActivity_getLatencyMaxMs([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return gEngine.getLatencyStats().maxMs;
+    return engine().getLatencyStats().maxMs;
 }
 
 [[nodiscard]] JNIEXPORT jint JNICALL
 Java_com_soundarch_MainActivity_getXRunCount([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return static_cast<jint>(gEngine.getXRunCount());
+    return static_cast<jint>(engine().getXRunCount());
 }
 
 [[nodiscard]] JNIEXPORT jint JNICALL
 Java_com_soundarch_MainActivity_getCallbackSize([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return static_cast<jint>(gEngine.getLastCallbackSize());
+    return static_cast<jint>(engine().getLastCallbackSize());
+}
+
+// ==============================================================================
+// 📸 BULK METRICS SNAPSHOT - One JNI crossing per UI frame
+// ==============================================================================
+// Fills a caller-owned DoubleArray (no allocation) from a single consistent
+// EngineMetricsSnapshot. Layout mirrored by com.soundarch.engine.MetricsSnapshot.
+// Returns the number of fields written, or 0 if the array is too small.
+namespace {
+    enum MetricsSnapshotField : int {
+        kLatencyInputMs = 0,
+        kLatencyOutputMs,
+        kLatencyTotalMs,
+        kLatencyEmaMs,
+        kLatencyMinMs,
+        kLatencyMaxMs,
+        kBurstLatencyMs,
+        kBufferLatencyMs,
+        kRingBufferLatencyMs,
+        kPerceivedLatencyMs,
+        kBluetoothCodecMs,
+        kInputFramesPending,
+        kOutputFramesPending,
+        kCpuUsagePercent,
+        kRamUsedBytes,
+        kRamAvailableBytes,
+        kRamUsagePercent,
+        kXRunCount,
+        kCallbackSize,
+        kBufferFillRatio,
+        kSafeModeActive,
+        kPeakDb,
+        kRmsDb,
+        kTelemetryVersion,
+        kMetricsSnapshotFieldCount
+    };
+}
+
+JNIEXPORT jint JNICALL
+Java_com_soundarch_MainActivity_getMetricsSnapshot(JNIEnv* env, jobject /*thiz*/, jdoubleArray out) {
+    if (!out || env->GetArrayLength(out) < kMetricsSnapshotFieldCount) return 0;
+
+    const EngineMetricsSnapshot snapshot = engine().getMetricsSnapshot();
+    const LatencyStats& latency = snapshot.latency;
+    const PerformanceMetrics& perf = snapshot.performance;
+
+    jdouble fields[kMetricsSnapshotFieldCount];
+    fields[kLatencyInputMs] = latency.inputMs;
+    fields[kLatencyOutputMs] = latency.outputMs;
+    fields[kLatencyTotalMs] = latency.totalMs;
+    fields[kLatencyEmaMs] = latency.emaMs;
+    fields[kLatencyMinMs] = latency.minMs;
+    fields[kLatencyMaxMs] = latency.maxMs;
+    fields[kBurstLatencyMs] = perf.burstLatencyMs;
+    fields[kBufferLatencyMs] = perf.bufferLatencyMs;
+    fields[kRingBufferLatencyMs] = perf.ringBufferLatencyMs;
+    fields[kPerceivedLatencyMs] = perf.perceivedLatencyMs;
+    fields[kBluetoothCodecMs] = perf.bluetoothCodecMs;
+    fields[kInputFramesPending] = static_cast<jdouble>(perf.inputFramesPending);
+    fields[kOutputFramesPending] = static_cast<jdouble>(perf.outputFramesPending);
+    fields[kCpuUsagePercent] = perf.cpuUsagePercent;
+    fields[kRamUsedBytes] = static_cast<jdouble>(perf.ramUsedBytes);
+    fields[kRamAvailableBytes] = static_cast<jdouble>(perf.ramAvailableBytes);
+    fields[kRamUsagePercent] = perf.ramUsagePercent;
+    fields[kXRunCount] = snapshot.xRunCount;
+    fields[kCallbackSize] = snapshot.lastCallbackSize;
+    fields[kBufferFillRatio] = perf.bufferFillRatio;
+    fields[kSafeModeActive] = perf.safeModeActive ? 1.0 : 0.0;
+    fields[kPeakDb] = snapshot.peakDb;
+    fields[kRmsDb] = snapshot.rmsDb;
+    fields[kTelemetryVersion] = snapshot.telemetryVersion;
+
+    env->SetDoubleArrayRegion(out, 0, kMetricsSnapshotFieldCount, fields);
+    return kMetricsSnapshotFieldCount;
+}
+
+// ==============================================================================
+// 🧩 SHARED CONTROL BLOCK - Parameters and meters without a JNI call per field
+// ==============================================================================
+// Direct ByteBuffer over the session's dsp::SharedControlBlock (never moves,
+// lives until the library unloads). Layout mirrored by
+// com.soundarch.engine.SharedControlBlock. Kotlin writes parameters and bumps
+// the control generation; the audio callback picks them up and publishes
+// meters every callback (values written before startAudio() wait for it).
+[[nodiscard]] JNIEXPORT jobject JNICALL
+Java_com_soundarch_MainActivity_getSharedControlBlock(JNIEnv* env, jobject /*thiz*/) {
+    jobject buffer = env->NewDirectByteBuffer(session().sharedControl().data(),
+                                              static_cast<jlong>(dsp::SharedControlBlock::sizeBytes()));
+    if (!buffer) {
+        LOGE("❌ getSharedControlBlock: direct buffers unsupported");
+        return nullptr;
+    }
+    LOGI("🧩 Shared control block mapped (%zu bytes, layout v%u)",
+         dsp::SharedControlBlock::sizeBytes(), dsp::SharedControlBlock::kLayoutVersion);
+    return buffer;
+}
+
+// ==============================================================================
+// ⏱️ STAGE TIMINGS (per-stage callback histograms)
+// ==============================================================================
+// Layout (mirrored by engine/StageTimings.kt): one row of kStageTimingColumns
+// per utils::Stage in enum order, then one budget row.
+//   Stage row:  count, p50 µs, p99 µs, p99.9 µs, max µs
+//   Budget row: p50 %, p99 %, p99.9 % and max % of the buffer period, deadline misses
+
+namespace {
+    constexpr jsize kStageTimingColumns = 5;
+    constexpr jsize kStageTimingFieldCount = (soundarch::utils::kStageCount + 1) * kStageTimingColumns;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_soundarch_MainActivity_getStageTimings(JNIEnv* env, jobject /*thiz*/, jdoubleArray out) {
+    if (!out || env->GetArrayLength(out) < kStageTimingFieldCount) return 0;
+
+    const soundarch::utils::StageProfiler& profiler = engine().profiler();
+    jdouble fields[kStageTimingFieldCount];
+    jdouble* row = fields;
+
+    for (int i = 0; i < soundarch::utils::kStageCount; ++i, row += kStageTimingColumns) {
+        const soundarch::utils::StageSummary s = profiler.summary(static_cast<soundarch::utils::Stage>(i));
+        row[0] = static_cast<jdouble>(s.count);
+        row[1] = s.p50Ns * 1e-3;
+        row[2] = s.p99Ns * 1e-3;
+        row[3] = s.p999Ns * 1e-3;
+        row[4] = s.maxNs * 1e-3;
+    }
+
+    const soundarch::utils::BudgetSummary budget = profiler.budget();
+    row[0] = budget.p50 * 100.0;
+    row[1] = budget.p99 * 100.0;
+    row[2] = budget.p999 * 100.0;
+    row[3] = budget.max * 100.0;
+    row[4] = static_cast<jdouble>(budget.deadlineMisses);
+
+    env->SetDoubleArrayRegion(out, 0, kStageTimingFieldCount, fields);
+    return kStageTimingFieldCount;
+}
+
+// ==============================================================================
+// 🎞️ CALLBACK TRACE (Chrome trace-event JSON, chrome://tracing / ui.perfetto.dev)
+// ==============================================================================
+// Rolling window of callbacks, stage spans, ring fill, XRuns and Safe Mode
+// switches. The file is written by the recorder's background thread.
+
+JNIEXPORT jboolean JNICALL
+Java_com_soundarch_MainActivity_startTrace(JNIEnv* /*env*/, jobject /*thiz*/, jfloat windowSeconds) {
+    const bool ok = engine().trace().start(windowSeconds);
+    LOGI("🎞️ Trace %s (window %.1fs)", ok ? "started" : "NOT started", windowSeconds);
+    return ok ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_soundarch_MainActivity_stopTrace(JNIEnv* /*env*/, jobject /*thiz*/) {
+    engine().trace().stop();
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_soundarch_MainActivity_dumpTrace(JNIEnv* env, jobject /*thiz*/, jstring path) {
+    if (!path) return JNI_FALSE;
+    const char* pathCStr = env->GetStringUTFChars(path, nullptr);
+    if (!pathCStr) return JNI_FALSE;
+    engine().trace().requestDump(pathCStr);
+    LOGI("🎞️ Trace dump requested → %s", pathCStr);
+    env->ReleaseStringUTFChars(path, pathCStr);
+    return JNI_TRUE;
 }
 
 // ==============================================================================
@@ -731,25 +749,34 @@ Java_com_soundarch_MainActivity_getCallbackSize([[maybe_unused]] JNIEnv* env, jo
 Java_com_soundarch_MainActivity_getPeakDb([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
     // Get peak level in dBFS from audio engine
     // Returns -60.0f if engine not running or no signal
-    return gEngine.getPeakDb();
+    return engine().getPeakDb();
 }
 
 [[nodiscard]] JNIEXPORT jfloat JNICALL
 Java_com_soundarch_MainActivity_getRmsDb([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
     // Get RMS level in dBFS from audio engine
     // Returns -60.0f if engine not running or no signal
-    return gEngine.getRmsDb();
+    return engine().getRmsDb();
 }
 
 // ==============================================================================
 // 🔔 LATENCY CALLBACK (Async update from audio thread)
 // ==============================================================================
 
+// Called on OboeEngine's telemetry thread: attached once, detached when the
+// thread exits (ART aborts on attached native threads that exit)
 void sendLatencyToJava(double latency) {
     if (!gJvm || !gActivity) return;
 
+    struct ThreadDetacher {
+        bool attached = false;
+        ~ThreadDetacher() { if (attached && gJvm) gJvm->DetachCurrentThread(); }
+    };
+    thread_local ThreadDetacher detacher;
+
     JNIEnv* env = nullptr;
     if (gJvm->AttachCurrentThread(&env, nullptr) != JNI_OK) return;
+    detacher.attached = true;
 
     jclass cls = env->GetObjectClass(gActivity);
     jmethodID mid = env->GetStaticMethodID(cls, "updateLatencyText", "(D)V");
@@ -766,7 +793,7 @@ JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_setNoiseCancellerEnabled(
     [[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jboolean enabled) {
 
-    gNoiseCancellerEnabled.store(enabled, std::memory_order_relaxed);
+    chain().setNoiseCancellerEnabled(enabled);
     LOGI("✅ NoiseCanceller %s", enabled ? "ENABLED" : "DISABLED");
 }
 
@@ -774,11 +801,6 @@ JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_applyNoiseCancellerPreset(
     [[maybe_unused]] JNIEnv* env, jobject /*thiz*/, jint presetIndex) {
 
-    if (!gNoiseCanceller) {
-        LOGE("❌ NoiseCanceller not initialized");
-        return;
-    }
-
     dsp::noisecancel::NoiseCancellerParams::Preset preset;
     const char* presetName = "Unknown";
 
@@ -804,7 +826,7 @@ Java_com_soundarch_MainActivity_applyNoiseCancellerPreset(
             return;
     }
 
-    gNoiseCanceller->applyPreset(preset);
+    chain().applyNoiseCancellerPreset(preset);
     LOGI("✅ NoiseCanceller preset: %s", presetName);
 }
 
@@ -819,13 +841,8 @@ Java_com_soundarch_MainActivity_setNoiseCancellerParams(
     jfloat residualBoostDb,
     jfloat artifactSuppress) {
 
-    if (!gNoiseCanceller) {
-        LOGE("❌ NoiseCanceller not initialized");
-        return;
-    }
-
     dsp::noisecancel::NoiseCancellerParams params;
-    params.setEnabled(gNoiseCancellerEnabled.load(std::memory_order_relaxed));
+    params.setEnabled(chain().isNoiseCancellerEnabled());
     params.setStrength(strength);
     params.setSpectralFloor(spectralFloor);
     params.setSmoothing(smoothing);
@@ -834,7 +851,7 @@ Java_com_soundarch_MainActivity_setNoiseCancellerParams(
     params.setResidualBoost(residualBoostDb);
     params.setArtifactSuppression(artifactSuppress);
 
-    gNoiseCanceller->setParams(params);
+    chain().setNoiseCancellerParams(params);
     LOGI("✅ NoiseCanceller params: strength=%.2f, floor=%.1fdB", strength, spectralFloor);
 }
 
@@ -842,11 +859,7 @@ Java_com_soundarch_MainActivity_setNoiseCancellerParams(
 Java_com_soundarch_MainActivity_getNoiseCancellerNoiseFloor(
     [[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
 
-    if (!gNoiseCanceller) {
-        return -100.0f;
-    }
-
-    return gNoiseCanceller->getNoiseFloorDb();
+    return chain().noiseCancellerNoiseFloorDb();
 }
 
 #ifdef NC_BENCHMARK
@@ -854,20 +867,14 @@ Java_com_soundarch_MainActivity_getNoiseCancellerNoiseFloor(
 Java_com_soundarch_MainActivity_getNoiseCancellerCpuMs(
     [[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
 
-    if (!gNoiseCanceller) {
-        return 0.0f;
-    }
-
-    return gNoiseCanceller->getCpuMs();
+    return chain().noiseCancellerCpuMs();
 }
 
 JNIEXPORT void JNICALL
 Java_com_soundarch_MainActivity_resetNoiseCancellerCpuStats(
     [[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
 
-    if (gNoiseCanceller) {
-        gNoiseCanceller->resetCpuStats();
-    }
+    chain().resetNoiseCancellerCpuStats();
 }
 #endif
 
@@ -978,18 +985,18 @@ Java_com_soundarch_MainActivity_getMLThreadAffinity([[maybe_unused]] JNIEnv* env
 
 [[nodiscard]] JNIEXPORT jboolean JNICALL
 Java_com_soundarch_MainActivity_isSafeModeActive([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return gEngine.isSafeModeActive() ? JNI_TRUE : JNI_FALSE;
+    return engine().isSafeModeActive() ? JNI_TRUE : JNI_FALSE;
 }
 
 [[nodiscard]] JNIEXPORT jint JNICALL
 Java_com_soundarch_MainActivity_getSafeModeStatus([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
     // Return Safe Mode enum as int: NORMAL=0, TRIGGERED=1, ACTIVE=2, RECOVERING=3
-    return static_cast<jint>(gEngine.getBluetoothRouter().getSafeModeStatus());
+    return static_cast<jint>(engine().getBluetoothRouter().getSafeModeStatus());
 }
 
 [[nodiscard]] JNIEXPORT jint JNICALL
 Java_com_soundarch_MainActivity_getBluetoothUnderrunCount([[maybe_unused]] JNIEnv* env, jobject /*thiz*/) {
-    return static_cast<jint>(gEngine.getBluetoothRouter().getUnderrunCount());
+    return static_cast<jint>(engine().getBluetoothRouter().getUnderrunCount());
 }
 
 // ==============================================================================
@@ -0,0 +1,205 @@
+// ==============================================================================
+// AGC level window (decimated energy history, AGC.h) - against an exact
+// sliding window of squares kept in double precision
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "dsp/AGC.h"
+#include "dsp/DSPMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+using namespace soundarch::dsp;
+
+namespace {
+
+    // Voice-like: two partials, syllable envelope, pauses, noise
+    std::vector<float> speech(int frames, float rate) {
+        std::vector<float> x(static_cast<size_t>(frames));
+        uint32_t seed = 777u;
+        for (int i = 0; i < frames; ++i) {
+            const float t = static_cast<float>(i) / rate;
+            seed = seed * 1664525u + 1013904223u;
+            const float noise = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+            const float syllable = std::max(0.0f, std::sin(2.0f * static_cast<float>(M_PI) * 3.0f * t));
+            const float pause = (static_cast<int>(t * 2.0f) % 4 == 3) ? 0.02f : 1.0f;
+            x[static_cast<size_t>(i)] = 0.3f * pause * syllable *
+                    (0.6f * std::sin(2.0f * static_cast<float>(M_PI) * 180.0f * t) +
+                     0.3f * std::sin(2.0f * static_cast<float>(M_PI) * 1900.0f * t) + 0.1f * noise);
+        }
+        return x;
+    }
+
+    // Exact sliding window of squares (double), same level formula as the AGC
+    class ExactWindow {
+    public:
+        explicit ExactWindow(size_t window) : squares_(window, 0.0) {}
+
+        double push(float x) {
+            const double square = static_cast<double>(x) * x;
+            sum_ += square - squares_.front();
+            squares_.pop_front();
+            squares_.push_back(square);
+            return std::max(sum_, 0.0) / static_cast<double>(squares_.size());
+        }
+
+    private:
+        std::deque<double> squares_;
+        double sum_ = 0.0;
+    };
+
+    double levelDb(double meanSquare) { return std::max(10.0 * std::log10(meanSquare + 1e-10), -60.0); }
+
+    // Chain defaults (DSPChain::makeAGC)
+    AGC makeAGC(float rate, float windowSeconds) {
+        AGC agc(rate);
+        agc.setTargetLevel(-20.0f);
+        agc.setMaxGain(25.0f);
+        agc.setMinGain(-10.0f);
+        agc.setAttackTime(0.1f);
+        agc.setReleaseTime(0.5f);
+        agc.setNoiseThreshold(-55.0f);
+        agc.setWindowSize(windowSeconds);
+        return agc;
+    }
+
+    // AGC::process() on the exact window: same gate, target, smoothing and dB → linear
+    class ReferenceAGC {
+    public:
+        ReferenceAGC(float rate, size_t window)
+                : window_(window),
+                  attack_(std::exp(-1.0f / (0.1f * rate))),
+                  release_(std::exp(-1.0f / (0.5f * rate))) {}
+
+        double gain(float x) {
+            const double level = levelDb(window_.push(x));
+            if (level >= -55.0) {
+                const float target = std::clamp(static_cast<float>(-20.0 - level), -10.0f, 25.0f);
+                const float coef = target > gainDb_ ? attack_ : release_;
+                gainDb_ = coef * gainDb_ + (1.0f - coef) * target;
+            }
+            return getDSPMath().dbToLinear(gainDb_);
+        }
+
+    private:
+        ExactWindow window_;
+        float attack_;
+        float release_;
+        float gainDb_ = 0.0f;
+    };
+
+    struct Errors {
+        double levelMeanDb = 0.0;   // Level above -50 dBFS
+        double gainMaxDb = 0.0;     // Output gain, samples above -60 dBFS
+    };
+
+    Errors against_exact_window(float rate, float windowSeconds) {
+        const auto window = static_cast<size_t>(windowSeconds * rate);
+        AGC agc = makeAGC(rate, windowSeconds);
+        ExactWindow exact(window);
+        ReferenceAGC reference(rate, window);
+        Errors e;
+        size_t levels = 0;
+        for (float x : speech(static_cast<int>(rate * 6.0f), rate)) {
+            const float out = agc.process(x);
+            const double expectedGain = reference.gain(x);
+            const double expectedLevel = levelDb(exact.push(x));
+            if (expectedLevel > -50.0) {
+                e.levelMeanDb += std::fabs(agc.getCurrentLevel() - expectedLevel);
+                ++levels;
+            }
+            if (std::fabs(x) > 1e-3f && std::fabs(out) < 0.95f) {
+                e.gainMaxDb = std::max(e.gainMaxDb, std::fabs(20.0 * std::log10(out / x / expectedGain)));
+            }
+        }
+        e.levelMeanDb /= static_cast<double>(std::max<size_t>(levels, 1));
+        return e;
+    }
+
+} // namespace
+
+// ~6 KB of block sums in place of the 384 KB sample ring
+TEST_CASE(history_is_a_few_kilobytes) {
+    std::printf("    sizeof(AGC) = %zu bytes\n", sizeof(AGC));
+    EXPECT_TRUE(sizeof(AGC) < 8 * 1024);
+}
+
+// Window lengths on and off the 64-sample grid (44.1 kHz: 4410 = 68 · 64 + 58).
+// The level may swing by a fraction of the edge block's energy (up to 0.7 dB
+// at 0.1 s on quiet passages), which the gain smoothing mostly absorbs.
+TEST_CASE(gain_follows_the_exact_window) {
+    struct Case {
+        float rate;
+        float seconds;
+    };
+    for (Case c : {Case{48000.0f, 0.1f}, Case{44100.0f, 0.1f}, Case{48000.0f, 0.5f}, Case{44100.0f, 2.0f}}) {
+        const Errors e = against_exact_window(c.rate, c.seconds);
+        std::printf("    %5.0f Hz, %.1f s window: level mean error %.4f dB, gain max error %.5f dB\n",
+                    c.rate, c.seconds, e.levelMeanDb, e.gainMaxDb);
+        EXPECT_TRUE(e.levelMeanDb < 0.03);
+        EXPECT_TRUE(e.gainMaxDb < 0.1);
+    }
+}
+
+// From silence the window fills over exactly windowSize samples, clamped to 0.1-2 s
+TEST_CASE(window_size_semantics_unchanged) {
+    constexpr float kRate = 48000.0f;
+    struct Case {
+        float requested;
+        size_t samples;
+    };
+    for (Case c : {Case{0.05f, 4800}, Case{0.3f, 14400}, Case{5.0f, 96000}}) {
+        AGC agc = makeAGC(kRate, c.requested);
+        agc.setNoiseThreshold(-80.0f);
+        double worst = 0.0;
+        for (size_t t = 1; t <= c.samples + 1000; ++t) {
+            agc.process(0.5f);
+            const double filled = static_cast<double>(std::min(t, c.samples)) / static_cast<double>(c.samples);
+            const double expected = std::max(10.0 * std::log10(0.25 * filled + 1e-10), -60.0);
+            worst = std::max(worst, std::fabs(agc.getCurrentLevel() - expected));
+        }
+        std::printf("    setWindowSize(%.2f): %zu samples, max error %.5f dB\n", c.requested, c.samples, worst);
+        EXPECT_TRUE(worst < 0.01);
+    }
+}
+
+// Minutes of signal, then silence: the total comes back to zero (no residue)
+TEST_CASE(no_drift_after_long_streams) {
+    constexpr float kRate = 48000.0f;
+    AGC agc = makeAGC(kRate, 2.0f);
+    const std::vector<float> voice = speech(static_cast<int>(kRate * 6.0f), kRate);
+    std::vector<float> out(256);
+    for (int pass = 0; pass < 20; ++pass) {
+        for (size_t i = 0; i + 256 <= voice.size(); i += 256) agc.processBlock(voice.data() + i, out.data(), 256);
+    }
+    const std::vector<float> silence(256, 0.0f);
+    for (int i = 0; i < 96000 / 256 + 1; ++i) agc.processBlock(silence.data(), out.data(), 256);
+    std::printf("    level after 2 min + 2 s of silence: %.2f dB\n", agc.getCurrentLevel());
+    EXPECT_TRUE(agc.getCurrentLevel() <= -59.9f);
+}
+
+// processBlock() at control rate feeds the same window
+TEST_CASE(control_rate_reads_the_same_window) {
+    constexpr float kRate = 48000.0f;
+    const std::vector<float> voice = speech(static_cast<int>(kRate * 2.0f), kRate);
+    AGC perSample = makeAGC(kRate, 0.25f);
+    AGC control = makeAGC(kRate, 0.25f);
+    control.setControlInterval(64);
+    std::vector<float> out(192);
+    double worst = 0.0;
+    for (size_t i = 0; i + 192 <= voice.size(); i += 192) {
+        perSample.processBlock(voice.data() + i, out.data(), 192);
+        control.processBlock(voice.data() + i, out.data(), 192);
+        // 192 = 3 segments of 64: both report the level after the block's last sample
+        worst = std::max(worst, static_cast<double>(std::fabs(perSample.getCurrentLevel() - control.getCurrentLevel())));
+    }
+    EXPECT_TRUE(worst < 1e-3);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,128 @@
+// ==============================================================================
+// Compressor block pipeline - against the per-sample reference (process())
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "dsp/Compressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace soundarch::dsp;
+
+namespace {
+
+    constexpr float kRate = 48000.0f;
+
+    // Output gain ratio: documented bound in Compressor.h
+    constexpr double kGainRel = 1e-5;
+
+    // Bursts with silences between: attack, release, below threshold, knee
+    std::vector<float> bursts(int frames) {
+        std::vector<float> x(static_cast<size_t>(frames));
+        for (int i = 0; i < frames; ++i) {
+            const float t = static_cast<float>(i) / kRate;
+            const float envelope = (i / 2400) % 3 == 2 ? 0.001f : 0.05f + 0.9f * std::fabs(std::sin(7.0f * t));
+            x[static_cast<size_t>(i)] = envelope * std::sin(2.0f * 3.14159265f * 440.0f * t);
+        }
+        return x;
+    }
+
+    struct Setup {
+        DetectionMode mode;
+        float kneeDb;
+        float rmsWindowMs;
+        float makeupDb;
+    };
+
+    // Worst relative error of the applied gain (out / in), block against per-sample
+    double worstGainError(const Setup& setup, int blockSize) {
+        const std::vector<float> input = bursts(48000);
+        Compressor reference(kRate, -24.0f, 6.0f, 2.0f, 80.0f, setup.kneeDb, setup.makeupDb);
+        Compressor pipeline(kRate, -24.0f, 6.0f, 2.0f, 80.0f, setup.kneeDb, setup.makeupDb);
+        for (Compressor* c : {&reference, &pipeline}) {
+            c->setDetectionMode(setup.mode);
+            c->setRMSWindowSize(setup.rmsWindowMs);
+        }
+
+        std::vector<float> output(input.size());
+        double worst = 0.0;
+        for (size_t start = 0; start < input.size(); start += static_cast<size_t>(blockSize)) {
+            const int n = static_cast<int>(std::min(input.size() - start, static_cast<size_t>(blockSize)));
+            pipeline.processBlock(input.data() + start, output.data() + start, n);
+            for (int i = 0; i < n; ++i) {
+                const float x = input[start + static_cast<size_t>(i)];
+                const float expected = reference.process(x);
+                if (std::fabs(x) < 1e-6f) continue;
+                worst = std::max(worst, std::fabs(static_cast<double>(output[start + static_cast<size_t>(i)]) - expected) /
+                                        std::fabs(static_cast<double>(expected)));
+            }
+            if (std::fabs(pipeline.getCurrentGainReduction() - reference.getCurrentGainReduction()) > 1e-3f) {
+                return 1.0;
+            }
+        }
+        return worst;
+    }
+
+} // namespace
+
+TEST_CASE(peak_matches_per_sample) {
+    for (float knee : {0.0f, 6.0f, 12.0f}) {
+        for (int block : {1, 64, 192, 257, 1024}) {
+            const double error = worstGainError({DetectionMode::PEAK, knee, 10.0f, 3.0f}, block);
+            if (block == 192) std::printf("    PEAK knee %4.1f dB: max gain error %.3g\n", knee, error);
+            EXPECT_TRUE(error < kGainRel);
+        }
+    }
+}
+
+// Windows shorter and longer than a pipeline chunk: the ring wraps inside one
+TEST_CASE(rms_matches_per_sample) {
+    for (float windowMs : {1.0f, 10.0f, 100.0f}) {
+        for (int block : {1, 64, 192, 257, 1024}) {
+            const double error = worstGainError({DetectionMode::RMS, 6.0f, windowMs, 0.0f}, block);
+            if (block == 192) std::printf("    RMS %5.1f ms: max gain error %.3g\n", windowMs, error);
+            EXPECT_TRUE(error < kGainRel);
+        }
+    }
+}
+
+TEST_CASE(in_place_matches_out_of_place) {
+    const std::vector<float> input = bursts(4800);
+    Compressor a(kRate), b(kRate);
+    a.setDetectionMode(DetectionMode::RMS);
+    b.setDetectionMode(DetectionMode::RMS);
+
+    std::vector<float> out(input.size());
+    std::vector<float> inPlace = input;
+    a.processBlock(input.data(), out.data(), static_cast<int>(input.size()));
+    b.processBlock(inPlace.data(), inPlace.data(), static_cast<int>(inPlace.size()));
+    EXPECT_TRUE(out == inPlace);
+}
+
+// A ramp in flight takes the per-sample path, then back to the pipeline
+TEST_CASE(ramp_then_pipeline_stays_continuous) {
+    const std::vector<float> input = bursts(9600);
+    Compressor reference(kRate), pipeline(kRate);
+    reference.setThreshold(-30.0f, 480);
+    pipeline.setThreshold(-30.0f, 480);
+
+    std::vector<float> output(input.size());
+    double worst = 0.0;
+    for (size_t start = 0; start < input.size(); start += 192) {
+        pipeline.processBlock(input.data() + start, output.data() + start, 192);
+        for (size_t i = start; i < start + 192; ++i) {
+            const float expected = reference.process(input[i]);
+            if (std::fabs(expected) > 1e-6f) {
+                worst = std::max(worst, std::fabs(static_cast<double>(output[i]) - expected) / std::fabs(expected));
+            }
+        }
+    }
+    EXPECT_TRUE(!pipeline.isRamping());
+    EXPECT_TRUE(worst < kGainRel);
+}
+
+SOUNDARCH_TEST_MAIN()
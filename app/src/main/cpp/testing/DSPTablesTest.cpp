@@ -0,0 +1,122 @@
+// ==============================================================================
+// Compile-time DSP tables - against libm at run time, and where they live
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "dsp/DSPMath.h"
+#include "dsp/DSPTables.h"
+#include "dsp/Equalizer.h"
+#include "dsp/FastMath.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <type_traits>
+
+using namespace soundarch::dsp;
+
+namespace {
+
+    double relativeError(double value, double expected) {
+        return std::fabs(value - expected) / std::fabs(expected);
+    }
+
+    // Permissions of the mapping holding p ("r--p", "r-xp", ...), Linux only
+    bool mappingPermissions(const void* p, char perms[5]) {
+        FILE* maps = std::fopen("/proc/self/maps", "r");
+        if (!maps) return false;
+        const uintptr_t address = reinterpret_cast<uintptr_t>(p);
+        bool found = false;
+        char line[512];
+        while (!found && std::fgets(line, sizeof line, maps)) {
+            uintptr_t begin = 0, end = 0;
+            if (std::sscanf(line, "%" SCNxPTR "-%" SCNxPTR " %4s", &begin, &end, perms) == 3) {
+                found = address >= begin && address < end;
+            }
+        }
+        std::fclose(maps);
+        return found;
+    }
+
+} // namespace
+
+// Constant-initialized: nothing to build, nothing per instance
+static_assert(std::is_empty_v<DSPMath>);
+static_assert(&getDSPMath() == &kDSPMath);
+static_assert(getDSPMath().dbToLinearFast(tables::kDbMin) == tables::kDbToLinear[0]);
+
+TEST_CASE(db_table_matches_libm) {
+    const double step = (static_cast<double>(tables::kDbMax) - tables::kDbMin) / (tables::kDbTableSize - 1);
+    double worst = 0.0;
+    for (int i = 0; i < tables::kDbTableSize; ++i) {
+        const double expected = std::pow(10.0, (tables::kDbMin + i * step) / 20.0);
+        worst = std::max(worst, relativeError(tables::kDbToLinear[i], expected));
+    }
+    std::printf("    table entries: max relative error %.3g\n", worst);
+    EXPECT_TRUE(worst <= 6e-8);   // Half a float ulp
+}
+
+TEST_CASE(db_to_linear_interpolation_matches_libm) {
+    const DSPMath& math = getDSPMath();
+    double worst = 0.0;
+    for (int i = 0; i <= 240000; ++i) {
+        const float db = -60.0f + 0.0005f * static_cast<float>(i);
+        worst = std::max(worst, relativeError(math.dbToLinear(db), std::pow(10.0, db / 20.0)));
+    }
+    std::printf("    DSPMath::dbToLinear: max relative error %.3g\n", worst);
+    EXPECT_TRUE(worst < 6e-6);
+    EXPECT_NEAR(math.dbToLinear(-100.0f), 1e-3, 1e-9);   // Clamped to the table
+    EXPECT_NEAR(math.dbToLinear(100.0f), 1e3, 1e-3);
+}
+
+TEST_CASE(constexpr_math_matches_libm) {
+    double worstExp = 0.0, worstLog = 0.0, worstTrig = 0.0, worstTanh = 0.0;
+    for (int i = -2000; i <= 2000; ++i) {
+        const double x = i * 0.01;
+        worstExp = std::max(worstExp, relativeError(constmath::exp(x), std::exp(x)));
+        worstTrig = std::max({worstTrig, std::fabs(constmath::sin(x) - std::sin(x)),
+                              std::fabs(constmath::cos(x) - std::cos(x))});
+        worstTanh = std::max(worstTanh, std::fabs(constmath::tanh(x) - std::tanh(x)));
+        const double positive = std::exp(x);
+        worstLog = std::max(worstLog, std::fabs(constmath::log(positive) - std::log(positive)));
+    }
+    std::printf("    exp %.3g (rel), log %.3g, sin/cos %.3g, tanh %.3g (abs)\n",
+                worstExp, worstLog, worstTrig, worstTanh);
+    EXPECT_TRUE(worstExp < 1e-14);
+    EXPECT_TRUE(worstLog < 1e-14);
+    EXPECT_TRUE(worstTrig < 1e-14);
+    EXPECT_TRUE(worstTanh < 1e-15);
+}
+
+TEST_CASE(band_trig_tables_match_libm) {
+    for (double rate : {44100.0, 48000.0}) {
+        const auto table = tables::trigTable(Equalizer::kCenterFreqs, rate);
+        for (int b = 0; b < Equalizer::kNumBands; ++b) {
+            const double omega = 2.0 * M_PI * Equalizer::kCenterFreqs[b] / rate;
+            EXPECT_NEAR(table.sin[b], std::sin(omega), 6e-8);
+            EXPECT_NEAR(table.cos[b], std::cos(omega), 6e-8);
+        }
+    }
+}
+
+TEST_CASE(soft_clip_maps_unity_to_unity) {
+    EXPECT_NEAR(tables::kSoftClipNorm, 1.0 / std::tanh(0.95), 1e-7);
+    // Limiter::softClip(±1)
+    EXPECT_NEAR(fastmath::tanh(tables::kSoftClipDrive) * tables::kSoftClipNorm, 1.0, 5e-7);
+    EXPECT_NEAR(fastmath::tanh(-tables::kSoftClipDrive) * tables::kSoftClipNorm, -1.0, 5e-7);
+}
+
+// .rodata: never written, shared by every engine (and process) using the library
+TEST_CASE(tables_live_in_read_only_pages) {
+    char perms[5] = {};
+    if (!mappingPermissions(tables::kDbToLinear.data(), perms)) {
+        std::printf("    /proc/self/maps unavailable - skipped\n");
+        return;
+    }
+    std::printf("    kDbToLinear mapping: %s\n", perms);
+    EXPECT_TRUE(perms[0] == 'r');
+    EXPECT_TRUE(perms[1] == '-');
+}
+
+SOUNDARCH_TEST_MAIN()
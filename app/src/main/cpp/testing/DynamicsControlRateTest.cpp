@@ -0,0 +1,211 @@
+// ==============================================================================
+// Dynamics at control rate (ControlRate.h) - against the per-sample path
+// ==============================================================================
+//
+// Same input through two instances, one per-sample (interval 1), one at
+// control rate, at every interval the modules accept. The gain each one
+// applied is read back from the output (out / in; the limiter's soft clip
+// inverted first) and compared in dB, sample by sample, against the bounds
+// documented in AGC.h, Compressor.h and Limiter.h.
+//
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "dsp/AGC.h"
+#include "dsp/Compressor.h"
+#include "dsp/DSPChain.h"
+#include "dsp/DSPTables.h"
+#include "dsp/Limiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace soundarch::dsp;
+
+namespace {
+
+    constexpr float kRate = 48000.0f;
+    constexpr int kBlock = 192;
+    const int kIntervals[] = {8, 16, 32, 64};
+
+    // Documented bounds (dB): a tighter one up to N = 16, the loose one up to 64
+    struct Bound {
+        double maxDb;
+        double meanDb;
+    };
+
+    Bound bound(int interval, Bound upTo16, Bound upTo64) { return interval <= 16 ? upTo16 : upTo64; }
+
+    // Voice-like: two partials, syllable envelope, pauses, loud onsets
+    std::vector<float> speech(int frames, float amplitude) {
+        std::vector<float> x(static_cast<size_t>(frames));
+        uint32_t seed = 12345u;
+        for (int i = 0; i < frames; ++i) {
+            const float t = static_cast<float>(i) / kRate;
+            seed = seed * 1664525u + 1013904223u;
+            const float noise = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+            const float syllable = std::max(0.0f, std::sin(2.0f * static_cast<float>(M_PI) * 3.0f * t));
+            const float pause = (i / 24000) % 4 == 3 ? 0.02f : 1.0f;
+            x[static_cast<size_t>(i)] = amplitude * pause * syllable *
+                    (0.6f * std::sin(2.0f * static_cast<float>(M_PI) * 180.0f * t) +
+                     0.3f * std::sin(2.0f * static_cast<float>(M_PI) * 1900.0f * t) + 0.1f * noise);
+        }
+        return x;
+    }
+
+    struct Deviation {
+        double maxDb = 0.0;
+        double meanDb = 0.0;
+        double aboveDb = 0.0;   // Worst control gain above the reference (limiter: late)
+    };
+
+    using Process = std::function<void(const float*, float*, int)>;
+
+    // Gain applied = gainOf(in, out); compared where the input is above -60 dBFS
+    Deviation compare(const std::vector<float>& input, const Process& reference, const Process& control,
+                      const std::function<double(float, float)>& gainOf) {
+        std::vector<float> a(input.size()), b(input.size());
+        for (size_t start = 0; start < input.size(); start += kBlock) {
+            const int n = static_cast<int>(std::min<size_t>(kBlock, input.size() - start));
+            reference(input.data() + start, a.data() + start, n);
+            control(input.data() + start, b.data() + start, n);
+        }
+        Deviation d;
+        size_t counted = 0;
+        for (size_t i = 0; i < input.size(); ++i) {
+            if (std::fabs(input[i]) < 1e-3f) continue;
+            const double signedDiff = 20.0 * std::log10(gainOf(input[i], b[i]) / gainOf(input[i], a[i]));
+            const double diff = std::fabs(signedDiff);
+            d.maxDb = std::max(d.maxDb, diff);
+            d.aboveDb = std::max(d.aboveDb, signedDiff);
+            d.meanDb += diff;
+            ++counted;
+        }
+        d.meanDb /= static_cast<double>(std::max<size_t>(counted, 1));
+        return d;
+    }
+
+    double plainGain(float in, float out) { return static_cast<double>(out) / in; }
+
+} // namespace
+
+TEST_CASE(agc_control_rate_matches_per_sample) {
+    const std::vector<float> input = speech(48000 * 6, 0.05f);
+    for (int interval : kIntervals) {
+        auto make = [](int n) {
+            auto agc = std::make_shared<AGC>(kRate);
+            agc->setTargetLevel(-20.0f);
+            agc->setMaxGain(25.0f);
+            agc->setMinGain(-10.0f);
+            agc->setAttackTime(0.1f);
+            agc->setReleaseTime(0.5f);
+            agc->setNoiseThreshold(-55.0f);
+            agc->setWindowSize(0.1f);
+            agc->setControlInterval(n);
+            return agc;
+        };
+        auto ref = make(1), ctl = make(interval);
+        const Deviation d = compare(input,
+                [ref](const float* in, float* out, int n) { ref->processBlock(in, out, n); },
+                [ctl](const float* in, float* out, int n) { ctl->processBlock(in, out, n); }, plainGain);
+        std::printf("    AGC N=%2d: max %.4f dB, mean %.5f dB\n", interval, d.maxDb, d.meanDb);
+        const Bound b = bound(interval, {0.05, 0.01}, {0.3, 0.05});
+        EXPECT_TRUE(d.maxDb < b.maxDb);
+        EXPECT_TRUE(d.meanDb < b.meanDb);
+    }
+}
+
+TEST_CASE(compressor_control_rate_matches_per_sample) {
+    const std::vector<float> input = speech(48000 * 4, 0.7f);
+    for (DetectionMode mode : {DetectionMode::PEAK, DetectionMode::RMS}) {
+        for (int interval : kIntervals) {
+            auto make = [mode](int n) {
+                auto c = std::make_shared<Compressor>(kRate, -24.0f, 4.0f, 5.0f, 50.0f, 6.0f, 0.0f);
+                c->setDetectionMode(mode);
+                c->setControlInterval(n);
+                return c;
+            };
+            auto ref = make(1), ctl = make(interval);
+            const Deviation d = compare(input,
+                    [ref](const float* in, float* out, int n) { ref->processBlock(in, out, n); },
+                    [ctl](const float* in, float* out, int n) { ctl->processBlock(in, out, n); }, plainGain);
+            std::printf("    Compressor %s N=%2d: max %.4f dB, mean %.5f dB\n",
+                        mode == DetectionMode::PEAK ? "PEAK" : "RMS ", interval, d.maxDb, d.meanDb);
+            const Bound b = bound(interval, {0.15, 0.025}, {0.5, 0.12});
+            EXPECT_TRUE(d.maxDb < b.maxDb);
+            EXPECT_TRUE(d.meanDb < b.meanDb);
+        }
+    }
+}
+
+// The limiter may cut up to N - 1 samples early (attack from the segment's
+// first sample), never late: bounded one way only, above = the release ramp
+TEST_CASE(limiter_control_rate_matches_per_sample) {
+    const std::vector<float> input = speech(48000 * 4, 1.2f);
+    for (int interval : kIntervals) {
+        auto make = [](int n) {
+            auto l = std::make_shared<Limiter>(kRate);
+            l->setThreshold(-6.0f);
+            l->setRelease(50.0f);
+            l->setControlInterval(n);
+            return l;
+        };
+        auto ref = make(1), ctl = make(interval);
+        const Deviation d = compare(input,
+                [ref](const float* in, float* out, int n) { ref->processBlock(in, out, n); },
+                [ctl](const float* in, float* out, int n) { ctl->processBlock(in, out, n); },
+                [](float in, float out) {
+                    return std::atanh(static_cast<double>(out) / tables::kSoftClipNorm) / tables::kSoftClipDrive / in;
+                });
+        std::printf("    Limiter N=%2d: max %.4f dB, mean %.5f dB, above %.5f dB\n", interval, d.maxDb, d.meanDb, d.aboveDb);
+        const Bound b = bound(interval, {0.03, 0.025}, {0.15, 0.1});
+        EXPECT_TRUE(d.aboveDb < b.maxDb);
+        EXPECT_TRUE(d.meanDb < b.meanDb);
+    }
+}
+
+// Instant attack kept: before the soft clip, no sample above the threshold
+TEST_CASE(limiter_control_rate_holds_the_ceiling) {
+    std::vector<float> input = speech(48000 * 2, 1.2f);
+    for (size_t i = 0; i < input.size(); i += 4801) input[i] = 4.0f;   // Isolated spikes, mid-segment
+    const float threshold = std::pow(10.0f, -6.0f / 20.0f);
+    for (int interval : kIntervals) {
+        Limiter limiter(kRate);
+        limiter.setThreshold(-6.0f);
+        limiter.setRelease(50.0f);
+        limiter.setControlInterval(interval);
+        std::vector<float> out(input.size());
+        for (size_t start = 0; start < input.size(); start += kBlock) {
+            limiter.processBlock(input.data() + start, out.data() + start, kBlock);
+        }
+        double worst = 0.0;
+        for (float y : out) {
+            worst = std::max(worst, std::fabs(std::atanh(static_cast<double>(y) / tables::kSoftClipNorm) / tables::kSoftClipDrive));
+        }
+        std::printf("    Limiter N=%2d: peak before soft clip %.5f (threshold %.5f)\n", interval, worst, threshold);
+        EXPECT_TRUE(worst <= threshold * 1.0001);
+    }
+}
+
+// Param::DynamicsControlInterval reaches the three modules, clamped to 1..64
+TEST_CASE(chain_parameter_sets_every_dynamics_module) {
+    DSPChain chain(kRate);
+    std::vector<float> buffer(kBlock, 0.1f);
+    BlockContext ctx;
+    for (auto [value, expected] : {std::pair{32.0f, 32}, std::pair{1000.0f, 64}, std::pair{0.0f, 1}}) {
+        chain.setParameter(Param::DynamicsControlInterval, value);
+        chain.processBlock(buffer.data(), kBlock, ctx);
+        EXPECT_EQ(chain.agc().getControlInterval(), expected);
+        EXPECT_EQ(chain.compressor().getControlInterval(), expected);
+        EXPECT_EQ(chain.limiter().getControlInterval(), expected);
+    }
+}
+
+SOUNDARCH_TEST_MAIN()
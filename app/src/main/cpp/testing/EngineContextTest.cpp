@@ -0,0 +1,199 @@
+// ==============================================================================
+// EngineContext / C ABI - independent engines, offline and live
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "EngineContext.h"
+#include "SimulatedBackend.h"
+#include "SoundArchEngine.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace soundarch;
+using audio::SimulatedBackend;
+using audio::SimulatedDeviceConfig;
+
+namespace {
+
+    constexpr float kSampleRate = 48000.0f;
+    constexpr int32_t kBlock = 192;
+    constexpr int kBlocks = 500;   // 2 s
+
+    // Speech-like test signal: two tones with a slow envelope
+    std::vector<float> makeSignal(int32_t frames) {
+        std::vector<float> signal(static_cast<size_t>(frames));
+        for (int32_t i = 0; i < frames; ++i) {
+            const float t = static_cast<float>(i) / kSampleRate;
+            const float envelope = 0.5f + 0.5f * std::sin(2.0f * 3.14159265f * 1.5f * t);
+            signal[static_cast<size_t>(i)] = envelope * (0.3f * std::sin(2.0f * 3.14159265f * 440.0f * t)
+                                                         + 0.2f * std::sin(2.0f * 3.14159265f * 2500.0f * t));
+        }
+        return signal;
+    }
+
+    struct Setup {
+        float compressorThreshold;
+        float eqBand3;
+        float voiceGainDb;
+    };
+
+    constexpr Setup kSetupA{-30.0f, 6.0f, 3.0f};
+    constexpr Setup kSetupB{-12.0f, -9.0f, -6.0f};
+
+    void configure(SoundArchEngine* engine, const Setup& setup) {
+        soundarch_engine_set_param(engine, static_cast<uint32_t>(dsp::Param::CompressorThreshold),
+                                   setup.compressorThreshold);
+        soundarch_engine_set_param(engine, static_cast<uint32_t>(dsp::eqBandParam(3)), setup.eqBand3);
+        soundarch_engine_set_param(engine, static_cast<uint32_t>(dsp::Param::VoiceGain), setup.voiceGainDb);
+    }
+
+    // Block-by-block render through a fresh handle
+    std::vector<float> render(const Setup& setup) {
+        SoundArchEngine* engine = soundarch_engine_create(kSampleRate, 0);
+        configure(engine, setup);
+        std::vector<float> buffer = makeSignal(kBlock * kBlocks);
+        for (int b = 0; b < kBlocks; ++b) {
+            soundarch_engine_process(engine, buffer.data() + b * kBlock, kBlock);
+            std::this_thread::yield();   // Interleave with the other renders on small hosts
+        }
+        soundarch_engine_destroy(engine);
+        return buffer;
+    }
+
+    bool bitExact(const std::vector<float>& a, const std::vector<float>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+
+    uint32_t telemetryWord(const void* block, size_t offset) {
+        uint32_t value;
+        std::memcpy(&value, static_cast<const uint8_t*>(block) + offset, sizeof(value));
+        return value;
+    }
+
+} // anonymous namespace
+
+TEST_CASE(c_abi_offline_round_trip) {
+    SoundArchEngine* engine = soundarch_engine_create(kSampleRate, 0);
+    EXPECT_TRUE(engine != nullptr);
+
+    std::vector<float> buffer = makeSignal(kBlock);
+    EXPECT_EQ(soundarch_engine_process(engine, buffer.data(), kBlock), 1);
+    EXPECT_EQ(soundarch_engine_processed_frames(engine), static_cast<uint64_t>(kBlock));
+
+    // Offline handles have no device
+    EXPECT_EQ(soundarch_engine_start(engine), 0);
+
+    // Ids are validated
+    EXPECT_EQ(soundarch_engine_set_param(engine, static_cast<uint32_t>(dsp::kParamCount), 0.0f), 0);
+    EXPECT_EQ(soundarch_engine_set_module_enabled(engine, static_cast<uint32_t>(dsp::kModuleSwitchCount), 1), 0);
+    EXPECT_EQ(soundarch_engine_set_module_enabled(engine, static_cast<uint32_t>(dsp::ModuleSwitch::Limiter), 0), 1);
+
+    // The block published the meters of this handle
+    size_t size = 0;
+    void* block = soundarch_engine_shared_block(engine, &size);
+    EXPECT_TRUE(block != nullptr);
+    EXPECT_EQ(size, dsp::SharedControlBlock::sizeBytes());
+    EXPECT_EQ(telemetryWord(block, 256), 1u);         // Telemetry generation
+    EXPECT_EQ(telemetryWord(block, 256 + 32), 192u);  // callbackFrames
+
+    soundarch_engine_destroy(engine);
+}
+
+TEST_CASE(c_abi_rejects_null_and_invalid_arguments) {
+    EXPECT_TRUE(soundarch_engine_create(0.0f, 0) == nullptr);
+    EXPECT_TRUE(soundarch_engine_create(kSampleRate, SOUNDARCH_ENGINE_LIVE) == nullptr);   // No device on the host
+
+    float sample = 0.0f;
+    size_t size = 123;
+    EXPECT_EQ(soundarch_engine_process(nullptr, &sample, 1), 0);
+    EXPECT_EQ(soundarch_engine_set_param(nullptr, 0, 0.0f), 0);
+    EXPECT_EQ(soundarch_engine_start(nullptr), 0);
+    EXPECT_TRUE(soundarch_engine_shared_block(nullptr, &size) == nullptr);
+    EXPECT_EQ(size, 0u);
+    EXPECT_EQ(soundarch_engine_processed_frames(nullptr), 0u);
+    soundarch_engine_stop(nullptr);
+    soundarch_engine_destroy(nullptr);
+
+    SoundArchEngine* engine = soundarch_engine_create(kSampleRate, 0);
+    EXPECT_EQ(soundarch_engine_process(engine, nullptr, kBlock), 0);
+    EXPECT_EQ(soundarch_engine_process(engine, &sample, 0), 0);
+    soundarch_engine_destroy(engine);
+}
+
+TEST_CASE(interleaved_contexts_do_not_interfere) {
+    const std::vector<float> referenceA = render(kSetupA);
+    const std::vector<float> referenceB = render(kSetupB);
+    EXPECT_TRUE(!bitExact(referenceA, referenceB));
+
+    // Same two setups, blocks alternating between the handles on one thread
+    SoundArchEngine* a = soundarch_engine_create(kSampleRate, 0);
+    SoundArchEngine* b = soundarch_engine_create(kSampleRate, 0);
+    configure(a, kSetupA);
+    configure(b, kSetupB);
+    std::vector<float> outA = makeSignal(kBlock * kBlocks);
+    std::vector<float> outB = outA;
+    for (int block = 0; block < kBlocks; ++block) {
+        soundarch_engine_process(a, outA.data() + block * kBlock, kBlock);
+        soundarch_engine_process(b, outB.data() + block * kBlock, kBlock);
+    }
+    soundarch_engine_destroy(a);
+    soundarch_engine_destroy(b);
+
+    EXPECT_TRUE(bitExact(outA, referenceA));
+    EXPECT_TRUE(bitExact(outB, referenceB));
+}
+
+TEST_CASE(concurrent_offline_renders_match_serial) {
+    const std::vector<float> referenceA = render(kSetupA);
+    const std::vector<float> referenceB = render(kSetupB);
+
+    constexpr int kThreads = 4;
+    std::vector<std::vector<float>> outputs(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&outputs, t] { outputs[static_cast<size_t>(t)] = render(t % 2 ? kSetupB : kSetupA); });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    for (int t = 0; t < kThreads; ++t) {
+        EXPECT_TRUE(bitExact(outputs[static_cast<size_t>(t)], t % 2 ? referenceB : referenceA));
+    }
+}
+
+TEST_CASE(live_context_beside_offline_render) {
+    auto backend = std::make_unique<SimulatedBackend>(SimulatedDeviceConfig{});
+    SimulatedBackend* device = backend.get();
+    auto engine = std::make_unique<OboeEngine>(std::move(backend));
+    engine->setTelemetryThreadEnabled(false);
+    EngineContext live(kSampleRate, std::move(engine));
+    EXPECT_TRUE(live.isLive());
+
+    std::vector<float> offlineBuffer = makeSignal(kBlock);
+    EngineContext offline(kSampleRate);
+    EXPECT_TRUE(!offline.isLive());
+    EXPECT_TRUE(offline.engine() == nullptr);
+    offline.process(offlineBuffer.data(), kBlock);
+    EXPECT_EQ(offline.processedFrames(), static_cast<uint64_t>(kBlock));
+
+    live.setParameter(dsp::Param::VoiceGain, 4.0f);
+    EXPECT_NEAR(live.chain().getVoiceGainDb(), 4.0f, 1e-6f);
+    EXPECT_NEAR(offline.chain().getVoiceGainDb(), 0.0f, 1e-6f);
+
+    EXPECT_TRUE(live.start());
+    EXPECT_TRUE(device->advance(1.0));
+    const uint64_t frames = live.processedFrames();
+    EXPECT_TRUE(frames >= static_cast<uint64_t>(kSampleRate * 0.9f));
+    EXPECT_EQ(telemetryWord(live.sharedControl().data(), 256 + 32), 192u);
+    live.stop();
+
+    // Offline context untouched by the live session
+    EXPECT_EQ(offline.processedFrames(), static_cast<uint64_t>(kBlock));
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,217 @@
+// ==============================================================================
+// Fast math - every kernel this CPU runs, scanned against double precision
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "dsp/FastMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace soundarch::dsp;
+
+namespace {
+
+    const fastmath::MathKernel kAllKernels[] = {fastmath::MathKernel::Scalar, fastmath::MathKernel::SSE,
+                                                fastmath::MathKernel::AVX2, fastmath::MathKernel::NEON};
+
+    // Bounds documented in FastMath.h. Large arguments lose what the float
+    // argument itself can't carry (x · log2 e rounds, |log2 x| ≈ 128 has an
+    // ulp of 1.5e-5), so the wide ranges get their own, looser bound.
+    constexpr double kExp2Rel = 2.5e-7;
+    constexpr double kExpRel = 3e-7;               // |x| ≤ 1
+    constexpr double kExpWideRel = 4.5e-6;         // x in [-86.5, 88]
+    constexpr double kDbToLinearRel = 6e-7;        // [-60, +24] dB
+    constexpr double kDbToLinearWideRel = 1.6e-6;  // [-200, +60] dB
+    constexpr double kLog2Abs = 2.5e-7;            // x in [1/2, 2]
+    constexpr double kLog2WideAbs = 4e-6;          // all positive floats
+    constexpr double kLinearToDbAbs = 1.2e-5;       // [1e-5, 1]: -100..0 dB
+    constexpr double kLinearToDbWideAbs = 2.2e-5;  // [1e-10, 1e4]
+    constexpr double kTanhAbs = 2.5e-7;
+
+    // Batch call from a static initializer: may run before FastMath.cpp's own
+    const float kStaticInitGain = [] {
+        const float db = 6.0f;
+        float gain = 0.0f;
+        fastmath::dbToLinear(&db, &gain, 1);
+        return gain;
+    }();
+
+    std::vector<float> linspace(float lo, float hi, int n) {
+        std::vector<float> x(static_cast<size_t>(n));
+        for (int i = 0; i < n; ++i) {
+            x[static_cast<size_t>(i)] = lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(n - 1);
+        }
+        return x;
+    }
+
+    // Log-spaced positive values, dense enough to hit every mantissa region
+    std::vector<float> logspace(float lo, float hi, int n) {
+        std::vector<float> x(static_cast<size_t>(n));
+        const double a = std::log(static_cast<double>(lo));
+        const double b = std::log(static_cast<double>(hi));
+        for (int i = 0; i < n; ++i) {
+            x[static_cast<size_t>(i)] = static_cast<float>(std::exp(a + (b - a) * i / (n - 1)));
+        }
+        return x;
+    }
+
+    template<typename Reference>
+    double maxError(fastmath::BatchFunction kernel, const std::vector<float>& x, Reference reference,
+                    bool relative) {
+        std::vector<float> y(x.size());
+        kernel(x.data(), y.data(), static_cast<int>(x.size()));
+        double worst = 0.0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            const double expected = reference(static_cast<double>(x[i]));
+            double error = std::fabs(static_cast<double>(y[i]) - expected);
+            if (relative) error /= std::fabs(expected);
+            worst = std::max(worst, error);
+        }
+        return worst;
+    }
+
+    template<typename Check>
+    void forEachKernel(Check check) {
+        for (fastmath::MathKernel kernel : kAllKernels) {
+            if (!fastmath::isSupported(kernel)) continue;
+            check(kernel, fastmath::kernels(kernel));
+        }
+    }
+
+    void report(const char* function, fastmath::MathKernel kernel, double error) {
+        std::printf("    %-11s %-6s max error %.3g\n", function, fastmath::mathKernelName(kernel), error);
+    }
+
+} // namespace
+
+TEST_CASE(exp_family_is_within_the_documented_bounds) {
+    const std::vector<float> exp2Range = linspace(-125.0f, 127.0f, 1 << 20);
+    const std::vector<float> expRange = linspace(-1.0f, 1.0f, 1 << 18);
+    const std::vector<float> expWide = linspace(-86.5f, 88.0f, 1 << 20);
+    const std::vector<float> gains = linspace(-60.0f, 24.0f, 1 << 18);
+    const std::vector<float> gainsWide = linspace(-200.0f, 60.0f, 1 << 20);
+    const auto exp2 = [](double x) { return std::exp2(x); };
+    const auto exp = [](double x) { return std::exp(x); };
+    const auto dbToLinear = [](double x) { return std::pow(10.0, x / 20.0); };
+
+    forEachKernel([&](fastmath::MathKernel kernel, const fastmath::MathKernels& k) {
+        const double errors[] = {maxError(k.exp2, exp2Range, exp2, true),
+                                 maxError(k.exp, expRange, exp, true),
+                                 maxError(k.exp, expWide, exp, true),
+                                 maxError(k.dbToLinear, gains, dbToLinear, true),
+                                 maxError(k.dbToLinear, gainsWide, dbToLinear, true)};
+        report("exp2", kernel, errors[0]);
+        report("exp", kernel, errors[1]);
+        report("exp wide", kernel, errors[2]);
+        report("dbToLinear", kernel, errors[3]);
+        report("dB wide", kernel, errors[4]);
+        EXPECT_TRUE(errors[0] <= kExp2Rel);
+        EXPECT_TRUE(errors[1] <= kExpRel);
+        EXPECT_TRUE(errors[2] <= kExpWideRel);
+        EXPECT_TRUE(errors[3] <= kDbToLinearRel);
+        EXPECT_TRUE(errors[4] <= kDbToLinearWideRel);
+    });
+}
+
+TEST_CASE(log_family_is_within_the_documented_bounds) {
+    const std::vector<float> nearOne = linspace(0.5f, 2.0f, 1 << 20);
+    const std::vector<float> logWide = logspace(1.2e-38f, 3.0e38f, 1 << 20);
+    const std::vector<float> levels = logspace(1e-5f, 1.0f, 1 << 18);
+    const std::vector<float> levelsWide = logspace(1e-10f, 1e4f, 1 << 20);
+    const auto log2 = [](double x) { return std::log2(x); };
+    const auto linearToDb = [](double x) { return 20.0 * std::log10(x); };
+
+    forEachKernel([&](fastmath::MathKernel kernel, const fastmath::MathKernels& k) {
+        const double errors[] = {maxError(k.log2, nearOne, log2, false),
+                                 maxError(k.log2, logWide, log2, false),
+                                 maxError(k.linearToDb, levels, linearToDb, false),
+                                 maxError(k.linearToDb, levelsWide, linearToDb, false)};
+        report("log2", kernel, errors[0]);
+        report("log2 wide", kernel, errors[1]);
+        report("linearToDb", kernel, errors[2]);
+        report("dB wide", kernel, errors[3]);
+        EXPECT_TRUE(errors[0] <= kLog2Abs);
+        EXPECT_TRUE(errors[1] <= kLog2WideAbs);
+        EXPECT_TRUE(errors[2] <= kLinearToDbAbs);
+        EXPECT_TRUE(errors[3] <= kLinearToDbWideAbs);
+    });
+}
+
+TEST_CASE(tanh_is_within_the_documented_bound) {
+    const std::vector<float> range = linspace(-12.0f, 12.0f, 1 << 20);
+    forEachKernel([&](fastmath::MathKernel kernel, const fastmath::MathKernels& k) {
+        const double e = maxError(k.tanh, range, [](double x) { return std::tanh(x); }, false);
+        report("tanh", kernel, e);
+        EXPECT_TRUE(e <= kTanhAbs);
+    });
+}
+
+TEST_CASE(edge_values) {
+    forEachKernel([&](fastmath::MathKernel, const fastmath::MathKernels& k) {
+        const float in[] = {0.0f, -0.0f, 1.0f, 1e-12f, -1.0f, 1e30f, -1e30f, 1000.0f};
+        float out[8];
+
+        k.log2(in + 2, out, 1);
+        EXPECT_EQ(out[0], 0.0f);                                  // log2(1) exactly
+        k.exp2(in, out, 1);
+        EXPECT_EQ(out[0], 1.0f);                                  // 0 dB is unity gain exactly
+        k.linearToDb(in, out, 5);                                 // 0, -0, 1, tiny, negative
+        EXPECT_NEAR(out[0], -200.0, 1e-3);
+        EXPECT_NEAR(out[1], -200.0, 1e-3);
+        EXPECT_EQ(out[2], 0.0f);
+        EXPECT_NEAR(out[3], -200.0, 1e-3);
+        EXPECT_NEAR(out[4], -200.0, 1e-3);
+
+        k.tanh(in, out, 8);
+        EXPECT_EQ(out[0], 0.0f);
+        EXPECT_EQ(out[1], 0.0f);
+        EXPECT_EQ(out[5], 1.0f);
+        EXPECT_EQ(out[6], -1.0f);
+
+        k.exp2(in + 5, out, 3);                                   // Clamped, finite
+        EXPECT_TRUE(std::isfinite(out[0]) && out[0] > 1e38f);
+        EXPECT_TRUE(out[1] > 0.0f && out[1] < 1e-37f);
+        EXPECT_TRUE(std::isfinite(out[2]));
+    });
+}
+
+// Batch kernels: same values as the scalar functions, any length, in place
+TEST_CASE(batch_matches_scalar_for_every_length) {
+    const std::vector<float> source = linspace(-30.0f, 30.0f, 67);
+    forEachKernel([&](fastmath::MathKernel, const fastmath::MathKernels& k) {
+        for (int n = 0; n <= 67; ++n) {
+            std::vector<float> out(static_cast<size_t>(n) + 1, 123.0f);   // Guard after the end
+            k.dbToLinear(source.data(), out.data(), n);
+            for (int i = 0; i < n; ++i) {
+                const float expected = fastmath::dbToLinear(source[static_cast<size_t>(i)]);
+                EXPECT_NEAR(out[static_cast<size_t>(i)], expected, 1e-6 * expected);
+            }
+            EXPECT_EQ(out[static_cast<size_t>(n)], 123.0f);
+
+            std::vector<float> inPlace(source.begin(), source.begin() + n);
+            k.tanh(inPlace.data(), inPlace.data(), n);
+            for (int i = 0; i < n; ++i) {
+                EXPECT_NEAR(inPlace[static_cast<size_t>(i)], fastmath::tanh(source[static_cast<size_t>(i)]), 1e-7);
+            }
+        }
+    });
+}
+
+TEST_CASE(batch_dispatch_works_during_static_init) {
+    EXPECT_NEAR(kStaticInitGain, std::pow(10.0, 6.0 / 20.0), 1e-6);
+}
+
+TEST_CASE(best_kernel_is_supported) {
+    EXPECT_TRUE(fastmath::isSupported(fastmath::bestKernel()));
+    const float x = 1.0f;
+    float y = 0.0f;
+    fastmath::exp2(&x, &y, 1);   // Resolved by the first batch call at the latest
+    EXPECT_TRUE(&fastmath::kernels(fastmath::bestKernel()) == &fastmath::batchKernels());
+    std::printf("    best kernel: %s\n", fastmath::mathKernelName(fastmath::bestKernel()));
+}
+
+SOUNDARCH_TEST_MAIN()
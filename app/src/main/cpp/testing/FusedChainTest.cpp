@@ -0,0 +1,227 @@
+// ==============================================================================
+// Fused chain - single-pass Chain<...> against the stage-by-stage chain
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "EngineContext.h"
+#include "SimulatedBackend.h"
+#include "dsp/DSPChain.h"
+#include "dsp/FusedChain.h"
+#include "utils/StageProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace soundarch;
+using audio::SimulatedBackend;
+using audio::SimulatedDeviceConfig;
+using dsp::Param;
+using utils::Stage;
+
+namespace {
+
+    constexpr float kRate = 48000.0f;
+    constexpr int32_t kBlock = 192;
+
+    // Both paths do the same math; with -ffast-math the compiler may round the
+    // biquad sums in another order, and the low, high-Q bands carry that along
+    constexpr float kTolerance = 1e-3f;   // Measured: 1.6e-4
+
+    std::vector<float> voice(size_t n, float amplitude) {
+        std::vector<float> x(n);
+        for (size_t i = 0; i < n; ++i) {
+            const float t = static_cast<float>(i) / kRate;
+            const float envelope = 0.6f + 0.4f * std::sin(2.0f * static_cast<float>(M_PI) * 3.0f * t);
+            x[i] = amplitude * envelope * (0.7f * std::sin(2.0f * static_cast<float>(M_PI) * 220.0f * t)
+                                           + 0.3f * std::sin(2.0f * static_cast<float>(M_PI) * 1800.0f * t));
+        }
+        return x;
+    }
+
+    void configure(dsp::DSPChain& chain) {
+        static const float kCurve[10] = {-6, -4, -2, 0, 2, 4, 5, 3, 0, -3};
+        for (int band = 0; band < 10; ++band) chain.setParameter(dsp::eqBandParam(band), kCurve[band]);
+        chain.setVoiceGainDb(6.0f);
+        chain.setParameter(Param::CompressorThreshold, -24.0f);
+        chain.setParameter(Param::LimiterThreshold, -3.0f);
+    }
+
+    void process(dsp::DSPChain& chain, std::vector<float>& buffer, utils::StageProfiler* profiler = nullptr) {
+        dsp::BlockContext ctx;
+        ctx.profiler = profiler;
+        for (size_t offset = 0; offset < buffer.size(); offset += kBlock) {
+            const auto n = static_cast<int32_t>(std::min<size_t>(kBlock, buffer.size() - offset));
+            chain.processBlock(buffer.data() + offset, n, ctx);
+        }
+    }
+
+    float maxDifference(const std::vector<float>& a, const std::vector<float>& b) {
+        float d = 0.0f;
+        for (size_t i = 0; i < a.size(); ++i) d = std::max(d, std::fabs(a[i] - b[i]));
+        return d;
+    }
+
+    std::unique_ptr<utils::StageProfiler> makeProfiler() {
+        auto profiler = std::make_unique<utils::StageProfiler>();
+        profiler->reset();
+        return profiler;
+    }
+
+} // anonymous namespace
+
+TEST_CASE(fused_chain_matches_the_multi_pass_chain) {
+    const std::vector<float> input = voice(kBlock * 250, 0.5f);
+
+    dsp::DSPChain multiPass(kRate);
+    multiPass.setFusedProcessing(false);
+    configure(multiPass);
+    std::vector<float> expected = input;
+    process(multiPass, expected);
+
+    dsp::DSPChain fused(kRate);
+    configure(fused);
+    std::vector<float> actual = input;
+    process(fused, actual);
+
+    EXPECT_NEAR(maxDifference(actual, expected), 0.0f, kTolerance);
+    const dsp::ModuleMeters a = fused.moduleMeters();
+    const dsp::ModuleMeters b = multiPass.moduleMeters();
+    EXPECT_NEAR(a.agcGainDb, b.agcGainDb, 0.01f);
+    EXPECT_NEAR(a.compressorGainReductionDb, b.compressorGainReductionDb, 0.01f);
+    EXPECT_NEAR(a.limiterGainReductionDb, b.limiterGainReductionDb, 0.01f);
+}
+
+TEST_CASE(chain_template_runs_module_kernels) {
+    // No biquad in the list: same instructions as processBlock(), sample for sample.
+    // 100 frames: shorter than a tile.
+    constexpr int32_t kFrames = 100;
+    const std::vector<float> input = voice(kFrames * 50, 0.9f);
+    const dsp::DSPMath& dspMath = dsp::getDSPMath();
+
+    dsp::Compressor compressor(kRate);
+    dsp::Limiter limiter(kRate);
+    limiter.setLookahead(2.0f);
+    std::vector<float> expected = input;
+    std::vector<float> peaks;
+    for (size_t offset = 0; offset < expected.size(); offset += kFrames) {
+        float* block = expected.data() + offset;
+        compressor.processBlock(block, block, kFrames);
+        limiter.processBlock(block, block, kFrames);
+        float peak = 0.0f;
+        for (int32_t i = 0; i < kFrames; ++i) peak = std::max(peak, std::fabs(block[i]));
+        peaks.push_back(peak);
+    }
+
+    dsp::Compressor fusedCompressor(kRate);
+    dsp::Limiter fusedLimiter(kRate);
+    fusedLimiter.setLookahead(2.0f);
+    dsp::BlockLevels levels;
+    dsp::Chain<dsp::Compressor, dsp::Limiter, dsp::Meter> chain(
+            dsp::FusedStage<dsp::Compressor>{&fusedCompressor, &dspMath},
+            dsp::FusedStage<dsp::Limiter>{&fusedLimiter, &dspMath},
+            dsp::FusedStage<dsp::Meter>{&levels});
+    EXPECT_TRUE(chain.fusable());
+
+    std::vector<float> actual = input;
+    bool peaksMatch = true;
+    for (size_t offset = 0, block = 0; offset < actual.size(); offset += kFrames, ++block) {
+        chain.process(actual.data() + offset, kFrames);
+        peaksMatch = peaksMatch && levels.samples == kFrames && std::fabs(levels.peak - peaks[block]) < 1e-6f;
+    }
+    EXPECT_NEAR(maxDifference(actual, expected), 0.0f, 1e-6f);
+    EXPECT_TRUE(peaksMatch);
+
+    // A ramp in flight: not fusable until it lands
+    fusedLimiter.setThreshold(-6.0f, kFrames);
+    EXPECT_TRUE(!chain.fusable());
+}
+
+TEST_CASE(ramps_and_other_routings_fall_back) {
+    std::vector<float> buffer = voice(kBlock * 10, 0.5f);
+    auto profiler = makeProfiler();
+    dsp::DSPChain chain(kRate);
+
+    process(chain, buffer, profiler.get());
+    EXPECT_EQ(profiler->summary(Stage::FusedChain).count, 10u);
+    EXPECT_EQ(profiler->summary(Stage::Compressor).count, 0u);
+
+    // 20 ms threshold glide = 5 blocks stage by stage, then fused again
+    chain.setParameter(Param::CompressorThreshold, -30.0f);
+    process(chain, buffer, profiler.get());
+    EXPECT_EQ(profiler->summary(Stage::Compressor).count, 5u);
+    EXPECT_EQ(profiler->summary(Stage::FusedChain).count, 15u);
+
+    // A stage switched off, another routing, fusion off: no fused block
+    profiler->reset();
+    chain.setAGCEnabled(false);
+    process(chain, buffer, profiler.get());
+    chain.setAGCEnabled(true);
+    dsp::GraphSpec reordered;
+    reordered.add(dsp::StageKind::Equalizer, dsp::GraphSpec::kGraphInput);
+    reordered.add(dsp::StageKind::AGC);
+    reordered.add(dsp::StageKind::Compressor);
+    reordered.add(dsp::StageKind::Limiter);
+    EXPECT_TRUE(chain.setGraph(reordered) == dsp::GraphError::None);
+    process(chain, buffer, profiler.get());
+    EXPECT_TRUE(chain.setGraph(dsp::GraphSpec::defaultChain()) == dsp::GraphError::None);
+    chain.setFusedProcessing(false);
+    process(chain, buffer, profiler.get());
+    EXPECT_EQ(profiler->summary(Stage::FusedChain).count, 0u);
+    EXPECT_EQ(profiler->summary(Stage::Limiter).count, 30u);
+
+    // Safe Mode: limiter only, never fused
+    chain.setFusedProcessing(true);
+    dsp::BlockContext safe;
+    safe.safeMode = true;
+    safe.profiler = profiler.get();
+    chain.processBlock(buffer.data(), kBlock, safe);
+    EXPECT_EQ(profiler->summary(Stage::FusedChain).count, 0u);
+}
+
+TEST_CASE(block_levels_from_both_paths) {
+    const std::vector<float> input = voice(kBlock, 0.5f);
+    for (bool fused : {true, false}) {
+        dsp::DSPChain chain(kRate);
+        chain.setFusedProcessing(fused);
+        std::vector<float> buffer = input;
+        dsp::BlockLevels levels;
+        dsp::BlockContext ctx;
+        ctx.levels = &levels;
+        chain.processBlock(buffer.data(), kBlock, ctx);
+
+        float peak = 0.0f;
+        float sumSquares = 0.0f;
+        for (float x : buffer) {
+            peak = std::max(peak, std::fabs(x));
+            sumSquares += x * x;
+        }
+        EXPECT_EQ(levels.samples, kBlock);
+        EXPECT_NEAR(levels.peak, peak, 0.0f);
+        EXPECT_NEAR(levels.sumSquares, sumSquares, 1e-6f * sumSquares);   // Summation order (-ffast-math)
+    }
+}
+
+TEST_CASE(live_stream_meters_inside_the_fused_pass) {
+    auto backend = std::make_unique<SimulatedBackend>(SimulatedDeviceConfig{});
+    SimulatedBackend* device = backend.get();
+    auto engine = std::make_unique<OboeEngine>(std::move(backend));
+    EngineContext context(kRate, std::move(engine));
+
+    EXPECT_TRUE(context.start());
+    EXPECT_TRUE(device->advance(2.0));
+    context.stop();
+
+    // Blocks with captured audio run fused; the meter is read from the pass
+    const utils::StageProfiler& profiler = context.engine()->profiler();
+    const uint64_t fused = profiler.summary(Stage::FusedChain).count;
+    EXPECT_TRUE(fused > 0);
+    EXPECT_EQ(profiler.summary(Stage::Limiter).count, 0u);
+    EXPECT_EQ(profiler.summary(Stage::Metering).count, profiler.summary(Stage::Callback).count);
+    EXPECT_TRUE(context.engine()->getPeakDb() > -40.0f);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,268 @@
+// ==============================================================================
+// Module hot swap - epoch reclamation, swaps between blocks, no stream restart
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "EngineContext.h"
+#include "SimulatedBackend.h"
+#include "dsp/DSPChain.h"
+#include "utils/EpochReclaimer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace soundarch;
+using audio::SimulatedBackend;
+using audio::SimulatedDeviceConfig;
+using dsp::Param;
+
+namespace {
+
+    constexpr int32_t kBlock = 192;
+
+    std::vector<float> sine(size_t n, float amplitude, float sampleRate, float freq = 1000.0f) {
+        std::vector<float> x(n);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = amplitude * std::sin(2.0f * static_cast<float>(M_PI) * freq * static_cast<float>(i) / sampleRate);
+        }
+        return x;
+    }
+
+    // change() runs between blocks, like a control thread racing the callback
+    template<typename Change>
+    void process(dsp::DSPChain& chain, std::vector<float>& buffer, size_t changeAtBlock, Change&& change) {
+        dsp::BlockContext ctx;
+        ctx.sampleRate = static_cast<int>(chain.getSampleRate());
+        for (size_t offset = 0, block = 0; offset < buffer.size(); offset += kBlock, ++block) {
+            if (block == changeAtBlock) change();
+            const auto n = static_cast<int32_t>(std::min<size_t>(kBlock, buffer.size() - offset));
+            chain.processBlock(buffer.data() + offset, n, ctx);
+        }
+    }
+
+    void process(dsp::DSPChain& chain, std::vector<float>& buffer) {
+        process(chain, buffer, SIZE_MAX, [] {});
+    }
+
+    bool bitExact(const std::vector<float>& a, const std::vector<float>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+
+    float peak(const float* x, size_t n) {
+        float p = 0.0f;
+        for (size_t i = 0; i < n; ++i) p = std::max(p, std::fabs(x[i]));
+        return p;
+    }
+
+    struct Tracked {
+        explicit Tracked(std::atomic<int>& deleted) : deleted_(deleted) {}
+        ~Tracked() { deleted_.fetch_add(1); }
+        std::atomic<int>& deleted_;
+    };
+
+} // anonymous namespace
+
+TEST_CASE(reclaimer_frees_at_once_between_blocks) {
+    std::atomic<int> deleted{0};
+    utils::EpochReclaimer reclaimer;
+
+    reclaimer.enter();
+    reclaimer.exit();
+    reclaimer.retire(std::make_unique<Tracked>(deleted));
+    EXPECT_EQ(deleted.load(), 1);
+    EXPECT_EQ(reclaimer.reclaim(), 0u);
+}
+
+TEST_CASE(reclaimer_waits_for_the_block_in_progress) {
+    std::atomic<int> deleted{0};
+    utils::EpochReclaimer reclaimer;
+
+    reclaimer.enter();                                   // Block may hold the old object
+    reclaimer.retire(std::make_unique<Tracked>(deleted));
+    EXPECT_EQ(deleted.load(), 0);
+    EXPECT_EQ(reclaimer.reclaim(), 1u);
+    EXPECT_EQ(deleted.load(), 0);
+
+    reclaimer.exit();                                    // Quiescent point
+    EXPECT_EQ(reclaimer.reclaim(), 0u);
+    EXPECT_EQ(deleted.load(), 1);
+
+    // Still pending at destruction: freed with the reclaimer
+    {
+        utils::EpochReclaimer scoped;
+        scoped.enter();
+        scoped.retire(std::make_unique<Tracked>(deleted));
+        scoped.exit();
+    }
+    EXPECT_EQ(deleted.load(), 2);
+}
+
+TEST_CASE(replaced_module_matches_a_configured_chain) {
+    constexpr float kRate = 48000.0f;
+    const std::vector<float> input = sine(kBlock * 100, 0.9f, kRate);
+
+    dsp::DSPChain reference(kRate);
+    reference.setParameter(Param::LimiterThreshold, -9.0f);
+    std::vector<float> expected = input;
+    process(reference, expected);
+
+    // Same ceiling, built on the "control thread" and swapped in before any block
+    dsp::DSPChain chain(kRate);
+    auto limiter = std::make_unique<dsp::Limiter>(kRate);
+    limiter->setThreshold(-9.0f);
+    limiter->setRelease(50.0f);
+    dsp::Limiter* const built = limiter.get();
+    chain.replaceLimiter(std::move(limiter));
+    EXPECT_TRUE(&chain.limiter() == built);
+    chain.replaceLimiter(nullptr);                       // Ignored
+    EXPECT_TRUE(&chain.limiter() == built);
+
+    std::vector<float> actual = input;
+    process(chain, actual);
+    EXPECT_TRUE(bitExact(actual, expected));
+}
+
+TEST_CASE(swap_takes_effect_at_the_next_block) {
+    constexpr float kRate = 48000.0f;
+    constexpr size_t kSwapBlock = 50;
+    dsp::DSPChain chain(kRate);
+    chain.setAGCEnabled(false);
+    chain.setCompressorEnabled(false);
+
+    std::vector<float> buffer = sine(kBlock * 100, 0.9f, kRate);
+    process(chain, buffer, kSwapBlock, [&chain, kRate] {
+        auto limiter = std::make_unique<dsp::Limiter>(kRate);
+        limiter->setThreshold(-12.0f);
+        chain.replaceLimiter(std::move(limiter));
+    });
+
+    // Same chain with the -12 dBFS limiter from the start: the level it settles to
+    dsp::DSPChain reference(kRate);
+    reference.setAGCEnabled(false);
+    reference.setCompressorEnabled(false);
+    reference.setParameter(Param::LimiterThreshold, -12.0f);
+    std::vector<float> settled = sine(kBlock * 100, 0.9f, kRate);
+    process(reference, settled);
+    const float target = peak(settled.data() + 60 * kBlock, 40 * kBlock);
+
+    // Before: -1 dBFS ceiling. From the swap block on: the new limiter (fresh module, no ramp)
+    const float before = peak(buffer.data() + (kSwapBlock - 10) * kBlock, 10 * kBlock);
+    const float after = peak(buffer.data() + (kSwapBlock + 10) * kBlock, 40 * kBlock);
+    EXPECT_TRUE(before > 0.8f);
+    EXPECT_NEAR(after, target, 0.01f);
+    EXPECT_EQ(chain.reclaimRetired(), 0u);
+}
+
+TEST_CASE(sample_rate_rebuild_keeps_posted_parameters) {
+    constexpr float kRate = 44100.0f;
+    auto configure = [](dsp::DSPChain& chain) {
+        chain.setParameter(Param::CompressorThreshold, -32.0f);
+        chain.setParameter(Param::CompressorRatio, 6.0f);
+        chain.setParameter(Param::LimiterThreshold, -4.0f);
+        chain.setParameter(dsp::eqBandParam(2), 5.0f);
+        chain.setParameter(Param::AGCTargetLevel, -24.0f);
+    };
+    const std::vector<float> input = sine(kBlock * 200, 0.5f, kRate, 440.0f);
+
+    dsp::DSPChain reference(kRate);
+    configure(reference);
+    std::vector<float> expected = input;
+    process(reference, expected);
+
+    // Configured (queued values applied by one silent block) at 48 kHz, then
+    // rebuilt for the stream rate: fresh modules, same settings
+    dsp::DSPChain chain(48000.0f);
+    configure(chain);
+    std::vector<float> warmup(kBlock, 0.0f);
+    process(chain, warmup);
+    chain.setSampleRate(kRate);
+    EXPECT_NEAR(chain.getSampleRate(), kRate, 0.0f);
+
+    std::vector<float> actual = input;
+    process(chain, actual);
+    EXPECT_TRUE(bitExact(actual, expected));
+}
+
+TEST_CASE(concurrent_swaps_while_processing) {
+    constexpr float kRate = 48000.0f;
+    dsp::DSPChain chain(kRate);
+    std::atomic<bool> done{false};
+    std::atomic<int> swaps{0};
+
+    std::thread control([&] {
+        for (int i = 0; i < 200; ++i) {
+            if (i % 10 == 9) {
+                chain.setSampleRate(i % 20 == 19 ? 48000.0f : 44100.0f);
+            } else {
+                auto compressor = std::make_unique<dsp::Compressor>(chain.getSampleRate());
+                compressor->setThreshold(-10.0f - static_cast<float>(i % 20));
+                chain.replaceCompressor(std::move(compressor));
+            }
+            chain.setParameter(Param::LimiterThreshold, -1.0f - static_cast<float>(i % 6));
+            swaps.fetch_add(1);
+            std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    std::vector<float> block(kBlock);
+    dsp::BlockContext ctx;
+    uint64_t blocks = 0;
+    bool finite = true;
+    while (!done.load() || blocks < 100) {
+        const std::vector<float> input = sine(kBlock, 0.7f, kRate);
+        std::copy(input.begin(), input.end(), block.begin());
+        chain.processBlock(block.data(), kBlock, ctx);
+        for (float x : block) {
+            uint32_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            finite = finite && (bits & 0x7F800000u) != 0x7F800000u;
+        }
+        ++blocks;
+        std::this_thread::yield();                       // Single-core hosts
+    }
+    control.join();
+
+    EXPECT_EQ(swaps.load(), 200);
+    EXPECT_TRUE(finite);
+    EXPECT_EQ(chain.reclaimRetired(), 0u);               // Reader idle: nothing left behind
+}
+
+TEST_CASE(live_swap_without_stream_restart) {
+    SimulatedDeviceConfig config;
+    config.sampleRate = 44100;                           // Not the context's initial rate
+    auto backend = std::make_unique<SimulatedBackend>(config);
+    SimulatedBackend* device = backend.get();
+    auto engine = std::make_unique<OboeEngine>(std::move(backend));
+    engine->setTelemetryThreadEnabled(false);
+    EngineContext context(48000.0f, std::move(engine));
+
+    // start() adopts the stream rate by hot swap
+    EXPECT_TRUE(context.start());
+    EXPECT_NEAR(context.chain().getSampleRate(), 44100.0f, 0.0f);
+    EXPECT_TRUE(device->advance(1.0));
+    const uint32_t startupXRuns = context.engine()->getXRunCount();
+    const uint64_t callbacks = device->stats().callbacks;
+
+    for (int i = 0; i < 20; ++i) {
+        auto limiter = std::make_unique<dsp::Limiter>(44100.0f);
+        limiter->setThreshold(-3.0f - static_cast<float>(i % 3));
+        context.chain().replaceLimiter(std::move(limiter));
+        EXPECT_TRUE(device->advance(0.1));
+    }
+
+    EXPECT_EQ(context.engine()->getXRunCount(), startupXRuns);
+    EXPECT_TRUE(device->stats().callbacks > callbacks);   // Same stream kept running
+    EXPECT_EQ(device->stats().outputUnderruns, 0u);
+    context.stop();
+    EXPECT_EQ(context.chain().reclaimRetired(), 0u);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,234 @@
+// ==============================================================================
+// Offline renderer tests - WAV/RF64 I/O and bit-exact chain reproduction
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "OfflineRenderer.h"
+#include "WavFile.h"
+#include "bench/BenchmarkHarness.h"
+#include "utils/Denormals.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace soundarch;
+
+namespace {
+
+    constexpr int kSampleRate = 48000;
+
+    // Interleaved test signal, channel c offset by c samples so channels differ
+    std::vector<float> makeSignal(size_t frames, int channels, float rmsDb) {
+        const std::vector<float> mono = bench::makeTestSignal(frames + channels, kSampleRate, rmsDb);
+        std::vector<float> out(frames * channels);
+        for (size_t i = 0; i < frames; ++i) {
+            for (int c = 0; c < channels; ++c) out[i * channels + c] = mono[i + c];
+        }
+        return out;
+    }
+
+    bool writeWav(const char* path, const std::vector<float>& data, int channels,
+                  tools::SampleFormat format, bool rf64 = false) {
+        tools::WavWriter writer;
+        if (!writer.open(path, kSampleRate, channels, format, rf64)) return false;
+        // Several write() calls: exercises streaming, not a single buffer
+        const size_t frames = data.size() / channels;
+        for (size_t offset = 0; offset < frames; offset += 1000) {
+            const size_t n = std::min<size_t>(1000, frames - offset);
+            if (!writer.write(&data[offset * channels], n)) return false;
+        }
+        return writer.close();
+    }
+
+    std::vector<float> readWav(const char* path, tools::WavInfo* infoOut = nullptr) {
+        tools::WavReader reader;
+        if (!reader.open(path)) return {};
+        if (infoOut) *infoOut = reader.info();
+        std::vector<float> data(reader.info().numFrames * reader.info().channels);
+        size_t frames = 0;
+        size_t got;
+        while ((got = reader.read(&data[frames * reader.info().channels], 777)) > 0) frames += got;
+        data.resize(frames * reader.info().channels);
+        return data;
+    }
+
+    double maxAbsDiff(const std::vector<float>& a, const std::vector<float>& b) {
+        if (a.size() != b.size()) return 1e9;
+        double diff = 0.0;
+        for (size_t i = 0; i < a.size(); ++i) diff = std::max(diff, std::fabs(static_cast<double>(a[i]) - b[i]));
+        return diff;
+    }
+
+    bool bitIdentical(const std::vector<float>& a, const std::vector<float>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+
+} // anonymous namespace
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// 💾 WAV / RF64 I/O
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+TEST_CASE(wav_roundtrip_all_formats) {
+    const std::vector<float> signal = makeSignal(4801, 2, -12.0f);  // Odd length: pad byte for s24
+
+    struct Case { tools::SampleFormat format; double tolerance; };
+    const Case cases[] = {
+            { tools::SampleFormat::Int16,   0.5 / 32768.0 + 1e-9 },
+            { tools::SampleFormat::Int24,   0.5 / 8388608.0 + 1e-9 },
+            { tools::SampleFormat::Int32,   1e-7 },
+            { tools::SampleFormat::Float32, 0.0 },
+            { tools::SampleFormat::Float64, 0.0 },
+    };
+
+    for (const Case& c : cases) {
+        const std::string path = std::string("roundtrip_") + tools::toString(c.format) + ".wav";
+        EXPECT_TRUE(writeWav(path.c_str(), signal, 2, c.format));
+
+        tools::WavInfo info;
+        const std::vector<float> back = readWav(path.c_str(), &info);
+        EXPECT_EQ(info.channels, 2);
+        EXPECT_EQ(info.sampleRate, kSampleRate);
+        EXPECT_EQ(info.numFrames, 4801u);
+        EXPECT_TRUE(info.format == c.format);
+        EXPECT_TRUE(!info.rf64);
+        EXPECT_TRUE(maxAbsDiff(signal, back) <= c.tolerance);
+    }
+}
+
+TEST_CASE(wav_forced_rf64_header) {
+    const std::vector<float> signal = makeSignal(3000, 1, -20.0f);
+    EXPECT_TRUE(writeWav("forced.rf64.wav", signal, 1, tools::SampleFormat::Float32, true));
+
+    tools::WavInfo info;
+    const std::vector<float> back = readWav("forced.rf64.wav", &info);
+    EXPECT_TRUE(info.rf64);
+    EXPECT_EQ(info.numFrames, 3000u);
+    EXPECT_TRUE(bitIdentical(signal, back));
+}
+
+TEST_CASE(wav_rejects_garbage) {
+    FILE* f = std::fopen("garbage.wav", "wb");
+    std::fputs("this is not a wave file at all", f);
+    std::fclose(f);
+
+    tools::WavReader reader;
+    std::string error;
+    EXPECT_TRUE(!reader.open("garbage.wav", &error));
+    EXPECT_TRUE(!error.empty());
+    EXPECT_TRUE(!reader.open("does_not_exist.wav"));
+}
+
+// fmt chunk with blockAlign = 0 ahead of a data chunk: rejected, not divided by
+TEST_CASE(wav_rejects_zero_block_align) {
+    const uint8_t header[] = {
+        'R', 'I', 'F', 'F', 44, 0, 0, 0, 'W', 'A', 'V', 'E',
+        'f', 'm', 't', ' ', 16, 0, 0, 0,
+        1, 0, 1, 0,                 // PCM, mono
+        0x80, 0xBB, 0, 0,           // 48000 Hz
+        0, 0, 0, 0,                 // byte rate
+        0, 0, 16, 0,                // blockAlign 0, 16 bits
+        'd', 'a', 't', 'a', 8, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+    };
+    FILE* f = std::fopen("zero_align.wav", "wb");
+    std::fwrite(header, 1, sizeof(header), f);
+    std::fclose(f);
+
+    tools::WavReader reader;
+    std::string error;
+    EXPECT_TRUE(!reader.open("zero_align.wav", &error));
+    EXPECT_TRUE(error == "inconsistent fmt chunk");
+}
+
+TEST_CASE(wav_pcm_clips_out_of_range) {
+    const std::vector<float> hot = { 1.5f, -1.5f, 1.0f, -1.0f };
+    EXPECT_TRUE(writeWav("clip_s16.wav", hot, 1, tools::SampleFormat::Int16));
+    const std::vector<float> back = readWav("clip_s16.wav");
+    EXPECT_EQ(back.size(), 4u);
+    EXPECT_NEAR(back[0], 32767.0 / 32768.0, 1e-9);
+    EXPECT_NEAR(back[1], -1.0, 1e-9);
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// 🎞️ RENDERER
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+TEST_CASE(render_matches_live_chain_bit_for_bit) {
+    const size_t frames = kSampleRate * 2 + 100;  // Final short block
+    const std::vector<float> input = makeSignal(frames, 1, -30.0f);
+    EXPECT_TRUE(writeWav("render_in.wav", input, 1, tools::SampleFormat::Float32));
+
+    tools::RenderConfig config;
+    config.dspBlockFrames = 192;
+    config.ioFrames = 4096;
+    tools::RenderStats stats;
+    std::string error;
+    EXPECT_TRUE(tools::renderFile("render_in.wav", "render_out.wav", config, stats, &error));
+    EXPECT_EQ(stats.frames, frames);
+    EXPECT_TRUE(stats.realtimeFactor > 0.0);
+
+    // Reference: what audioCallback() does, 192 frames per callback
+    utils::enableFlushToZero();
+    dsp::DSPChain chain(static_cast<float>(kSampleRate));
+    std::vector<float> expected = input;
+    for (size_t offset = 0; offset < frames; offset += 192) {
+        const size_t n = std::min<size_t>(192, frames - offset);
+        chain.processBlock(&expected[offset], static_cast<int32_t>(n), dsp::BlockContext{false, kSampleRate});
+    }
+
+    EXPECT_TRUE(bitIdentical(readWav("render_out.wav"), expected));
+}
+
+TEST_CASE(render_output_independent_of_io_chunk) {
+    const std::vector<float> input = makeSignal(30000, 2, -25.0f);
+    EXPECT_TRUE(writeWav("chunk_in.wav", input, 2, tools::SampleFormat::Int24));
+
+    tools::RenderConfig small;
+    small.dspBlockFrames = 256;
+    small.ioFrames = 1000;        // Rounded down to 768 (whole DSP blocks)
+    tools::RenderConfig large = small;
+    large.ioFrames = 1 << 20;
+
+    tools::RenderStats stats;
+    EXPECT_TRUE(tools::renderFile("chunk_in.wav", "chunk_small.wav", small, stats));
+    EXPECT_TRUE(tools::renderFile("chunk_in.wav", "chunk_large.wav", large, stats));
+    EXPECT_EQ(stats.channels, 2);
+
+    const std::vector<float> a = readWav("chunk_small.wav");
+    EXPECT_EQ(a.size(), input.size());
+    EXPECT_TRUE(bitIdentical(a, readWav("chunk_large.wav")));
+
+    // Rendering twice in one process gives the same result (no hidden global state)
+    EXPECT_TRUE(tools::renderFile("chunk_in.wav", "chunk_small_again.wav", small, stats));
+    EXPECT_TRUE(bitIdentical(a, readWav("chunk_small_again.wav")));
+}
+
+TEST_CASE(render_applies_parameters) {
+    const std::vector<float> input = makeSignal(20000, 1, -10.0f);
+    EXPECT_TRUE(writeWav("params_in.wav", input, 1, tools::SampleFormat::Float32));
+
+    EXPECT_TRUE(tools::findParameter("comp.ratio") != nullptr);
+    EXPECT_TRUE(tools::findParameter("no.such_param") == nullptr);
+
+    // Everything off + flat EQ + safe mode without limiter → near pass-through
+    tools::RenderConfig bypass;
+    bypass.safeMode = true;
+    bypass.parameters.emplace_back(tools::findParameter("limiter.enabled"), 0.0f);
+    tools::RenderStats stats;
+    EXPECT_TRUE(tools::renderFile("params_in.wav", "params_bypass.wav", bypass, stats));
+    EXPECT_TRUE(bitIdentical(readWav("params_bypass.wav"), input));
+
+    // Voice gain is clamped like the JNI setter (+12 dB max)
+    tools::RenderConfig loud;
+    loud.parameters.emplace_back(tools::findParameter("agc.enabled"), 0.0f);
+    loud.parameters.emplace_back(tools::findParameter("comp.enabled"), 0.0f);
+    loud.parameters.emplace_back(tools::findParameter("limiter.enabled"), 0.0f);
+    loud.parameters.emplace_back(tools::findParameter("voice.gain"), 100.0f);
+    EXPECT_TRUE(tools::renderFile("params_in.wav", "params_loud.wav", loud, stats));
+    EXPECT_NEAR(20.0 * std::log10(stats.peakOut / stats.peakIn), 12.0, 1.0);
+}
+
+SOUNDARCH_TEST_MAIN()
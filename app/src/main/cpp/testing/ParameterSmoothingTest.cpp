@@ -0,0 +1,332 @@
+// ==============================================================================
+// Live parameters - coalescing queue, linear ramps, no steps on live changes
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "dsp/DSPChain.h"
+#include "dsp/ParameterQueue.h"
+#include "dsp/SmoothedValue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace soundarch;
+using dsp::Param;
+
+namespace {
+
+    constexpr float kSampleRate = 48000.0f;
+    constexpr int kBlock = 192;
+
+    // change() runs between blocks, like a JNI setter racing the callback
+    template<typename Change>
+    void process(dsp::DSPChain& chain, std::vector<float>& buffer, size_t changeAtBlock, Change&& change) {
+        dsp::BlockContext ctx;
+        for (size_t offset = 0, block = 0; offset < buffer.size(); offset += kBlock, ++block) {
+            if (block == changeAtBlock) change();
+            const auto n = static_cast<int32_t>(std::min<size_t>(kBlock, buffer.size() - offset));
+            chain.processBlock(buffer.data() + offset, n, ctx);
+        }
+    }
+
+    void process(dsp::DSPChain& chain, std::vector<float>& buffer) {
+        process(chain, buffer, SIZE_MAX, [] {});
+    }
+
+    std::vector<float> sine(size_t n, float amplitude, float freq = 1000.0f) {
+        std::vector<float> x(n);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = amplitude * std::sin(2.0f * static_cast<float>(M_PI) * freq * static_cast<float>(i) / kSampleRate);
+        }
+        return x;
+    }
+
+    // Largest change of out/in between neighbouring samples (|in| large enough to divide)
+    float maxGainStep(const std::vector<float>& in, const std::vector<float>& out) {
+        float previous = -1.0f;
+        float worst = 0.0f;
+        for (size_t i = 0; i < in.size(); ++i) {
+            if (std::fabs(in[i]) < 0.05f) continue;
+            const float gain = out[i] / in[i];
+            if (previous >= 0.0f) worst = std::max(worst, std::fabs(gain - previous));
+            previous = gain;
+        }
+        return worst;
+    }
+
+    // Chain reduced to the stage under test
+    void isolate(dsp::DSPChain& chain, bool compressor, bool limiter) {
+        chain.setAGCEnabled(false);
+        chain.setCompressorEnabled(compressor);
+        chain.setLimiterEnabled(limiter);
+    }
+
+} // anonymous namespace
+
+TEST_CASE(smoothed_value_ramps_linearly_and_lands_on_target) {
+    dsp::SmoothedValue v(1.0f);
+    v.setTarget(3.0f, 4);
+    EXPECT_TRUE(v.isRamping());
+    EXPECT_NEAR(v.next(), 1.5f, 1e-6);
+    EXPECT_NEAR(v.next(), 2.0f, 1e-6);
+    EXPECT_NEAR(v.next(), 2.5f, 1e-6);
+    EXPECT_EQ(v.next(), 3.0f);
+    EXPECT_TRUE(!v.isRamping());
+
+    // Retarget mid-ramp: continues from where it is
+    v.setTarget(1.0f, 10);
+    EXPECT_NEAR(v.skip(5), 2.0f, 1e-6);
+    v.setTarget(4.0f, 2);
+    EXPECT_NEAR(v.next(), 3.0f, 1e-6);
+    EXPECT_EQ(v.skip(100), 4.0f);
+
+    v.setTarget(-1.0f, 0);
+    EXPECT_EQ(v.current(), -1.0f);
+    EXPECT_TRUE(!v.isRamping());
+}
+
+TEST_CASE(queue_coalesces_to_latest_value) {
+    dsp::ParameterQueue queue;
+    EXPECT_TRUE(!queue.pending());
+
+    for (int i = 0; i < 1000; ++i) queue.post(Param::CompressorRatio, static_cast<float>(i));
+    queue.post(Param::VoiceGain, -3.0f);
+    EXPECT_TRUE(queue.pending());
+
+    int calls = 0;
+    float ratio = 0.0f;
+    float voice = 0.0f;
+    queue.drain([&](Param id, float value) {
+        ++calls;
+        if (id == Param::CompressorRatio) ratio = value;
+        if (id == Param::VoiceGain) voice = value;
+    });
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(ratio, 999.0f);
+    EXPECT_EQ(voice, -3.0f);
+    EXPECT_TRUE(!queue.pending());
+}
+
+TEST_CASE(concurrent_posts_always_deliver_the_final_value) {
+    dsp::ParameterQueue queue;
+    constexpr int kPosts = 20000;
+    float applied[dsp::kParamCount] = {};
+
+    std::atomic<int> running{2};
+    auto producer = [&](Param a, Param b) {
+        for (int i = 1; i <= kPosts; ++i) {
+            queue.post(a, static_cast<float>(i));
+            queue.post(b, static_cast<float>(-i));
+            if ((i & 255) == 0) std::this_thread::yield();
+        }
+        running.fetch_sub(1);
+    };
+    std::thread p1(producer, Param::LimiterThreshold, dsp::eqBandParam(3));
+    std::thread p2(producer, Param::AGCTargetLevel, dsp::eqBandParam(9));
+
+    bool monotonic = true;
+    auto apply = [&](Param id, float value) {
+        float& slot = applied[static_cast<size_t>(id)];
+        if (std::fabs(value) < std::fabs(slot)) monotonic = false;   // Never an older value after a newer one
+        slot = value;
+    };
+    while (running.load() > 0) {
+        queue.drain(apply);
+        std::this_thread::yield();
+    }
+    p1.join();
+    p2.join();
+    queue.drain(apply);
+
+    EXPECT_TRUE(monotonic);
+    EXPECT_EQ(applied[static_cast<size_t>(Param::LimiterThreshold)], static_cast<float>(kPosts));
+    EXPECT_EQ(applied[static_cast<size_t>(dsp::eqBandParam(3))], static_cast<float>(-kPosts));
+    EXPECT_EQ(applied[static_cast<size_t>(Param::AGCTargetLevel)], static_cast<float>(kPosts));
+    EXPECT_EQ(applied[static_cast<size_t>(dsp::eqBandParam(9))], static_cast<float>(-kPosts));
+}
+
+TEST_CASE(updates_before_the_first_block_apply_exactly) {
+    // Queued configuration must render exactly like direct setters (offline renderer contract)
+    dsp::DSPChain queued(kSampleRate);
+    queued.setParameter(Param::CompressorThreshold, -30.0f);
+    queued.setParameter(Param::CompressorRatio, 6.0f);
+    queued.setParameter(Param::CompressorMakeupGain, 6.0f);
+    queued.setParameter(Param::LimiterThreshold, -3.0f);
+    queued.setParameter(Param::AGCTargetLevel, -18.0f);
+    queued.setParameter(dsp::eqBandParam(5), 6.0f);
+    queued.setVoiceGainDb(4.0f);
+
+    dsp::DSPChain direct(kSampleRate);
+    direct.compressor().setThreshold(-30.0f);
+    direct.compressor().setRatio(6.0f);
+    direct.compressor().setMakeupGain(6.0f);
+    direct.limiter().setThreshold(-3.0f);
+    direct.agc().setTargetLevel(-18.0f);
+    direct.equalizer().setBandGain(5, 6.0f);
+    direct.setVoiceGainDb(4.0f);
+
+    std::vector<float> a = sine(48000, 0.3f);
+    std::vector<float> b = a;
+    process(queued, a);
+    process(direct, b);
+    EXPECT_TRUE(std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0);
+}
+
+TEST_CASE(live_voice_gain_glides_over_the_smoothing_time) {
+    dsp::DSPChain chain(kSampleRate);
+    isolate(chain, false, false);
+    chain.setParameterSmoothingMs(10.0f);   // 480 samples
+
+    // DC through a flat EQ: the output is the voice gain curve itself
+    std::vector<float> out(kBlock * 14, 0.1f);
+    process(chain, out, 4, [&] { chain.setVoiceGainDb(12.0f); });
+
+    const size_t start = kBlock * 4;
+    const float before = out[start - 1];
+    const float target = before * std::pow(10.0f, 12.0f / 20.0f);
+    const float perSample = (target - before) / 480.0f;
+    float worstStep = 0.0f;
+    for (size_t i = start - kBlock; i < out.size(); ++i) worstStep = std::max(worstStep, std::fabs(out[i] - out[i - 1]));
+    EXPECT_TRUE(worstStep < perSample * 1.5f);
+    EXPECT_TRUE(out[start + 240] > before * 1.5f && out[start + 240] < target * 0.9f);   // Halfway up
+    EXPECT_NEAR(out[start + 479], target, target * 2e-3);
+    EXPECT_NEAR(out.back(), target, target * 2e-3);
+
+    // Smoothing off: the same change back is a single step
+    chain.setParameterSmoothingMs(0.0f);
+    std::vector<float> jump(kBlock * 2, 0.1f);
+    process(chain, jump, 1, [&] { chain.setVoiceGainDb(0.0f); });
+    EXPECT_TRUE(jump[kBlock - 1] > 0.35f);
+    EXPECT_TRUE(jump[kBlock] < 0.11f);
+}
+
+TEST_CASE(live_compressor_change_has_no_gain_step) {
+    auto run = [](float smoothingMs) {
+        dsp::DSPChain chain(kSampleRate);
+        isolate(chain, true, false);
+        chain.setParameterSmoothingMs(smoothingMs);
+
+        // Every level-type compressor parameter at once, after 50 blocks
+        const std::vector<float> in = sine(kBlock * 70, 0.5f);
+        std::vector<float> out = in;
+        process(chain, out, 50, [&] {
+            chain.setParameter(Param::CompressorThreshold, -40.0f);
+            chain.setParameter(Param::CompressorRatio, 10.0f);
+            chain.setParameter(Param::CompressorMakeupGain, 12.0f);
+        });
+        EXPECT_TRUE(!chain.compressor().isRamping());
+        return maxGainStep(in, out);
+    };
+
+    const float stepped = run(0.0f);
+    const float smoothed = run(20.0f);
+    EXPECT_TRUE(stepped > 0.15f);   // ≈ -9 dB → -16 dB in one sample
+    EXPECT_TRUE(smoothed < stepped * 0.1f);
+}
+
+TEST_CASE(live_limiter_ceiling_glides) {
+    auto run = [](float smoothingMs) {
+        dsp::DSPChain chain(kSampleRate);
+        isolate(chain, false, true);
+        chain.setParameterSmoothingMs(smoothingMs);
+
+        std::vector<float> out(kBlock * 20, 0.9f);
+        process(chain, out, 10, [&] { chain.setParameter(Param::LimiterThreshold, -12.0f); });
+        EXPECT_TRUE(!chain.limiter().isRamping());
+
+        float worst = 0.0f;
+        for (size_t i = 1; i < out.size(); ++i) worst = std::max(worst, std::fabs(out[i] - out[i - 1]));
+        return worst;
+    };
+
+    const float stepped = run(0.0f);
+    const float smoothed = run(20.0f);
+    EXPECT_TRUE(stepped > 0.3f);
+    EXPECT_TRUE(smoothed < stepped * 0.02f);
+}
+
+TEST_CASE(live_eq_band_glides_block_by_block) {
+    dsp::DSPChain chain(kSampleRate);
+    isolate(chain, false, false);
+    chain.setParameterSmoothingMs(40.0f);   // 1920 samples = 10 blocks
+
+    std::vector<float> out = sine(kBlock * 90, 0.1f);
+    process(chain, out, 50, [&] { chain.setParameter(dsp::eqBandParam(5), 12.0f); });   // 1 kHz band, +12 dB
+
+    EXPECT_TRUE(!chain.equalizer().isRamping());
+    EXPECT_EQ(chain.equalizer().getBandGain(5), 12.0f);
+
+    // Block peaks rise step by step: no block more than ~3 dB above the previous one
+    float previous = 0.0f;
+    bool gradual = true;
+    for (size_t b = 49; b < 90; ++b) {
+        float peak = 0.0f;
+        for (size_t i = 0; i < kBlock; ++i) peak = std::max(peak, std::fabs(out[b * kBlock + i]));
+        if (previous > 0.0f && peak > previous * 1.45f) gradual = false;
+        previous = peak;
+    }
+    EXPECT_TRUE(gradual);
+    EXPECT_TRUE(previous > 0.3f);   // ≈ 0.1 × 3.98 once settled (the neighbours add a little)
+}
+
+// A ramped band then an unramped one: the second publish keeps the first gain
+TEST_CASE(unramped_eq_update_keeps_ramped_bands) {
+    dsp::DSPChain chain(kSampleRate);
+    isolate(chain, false, false);
+    chain.setParameterSmoothingMs(20.0f);
+
+    auto settledPeak = [](const std::vector<float>& out) {
+        float peak = 0.0f;
+        for (size_t i = out.size() - kBlock * 10; i < out.size(); ++i) peak = std::max(peak, std::fabs(out[i]));
+        return peak;
+    };
+
+    std::vector<float> ramped = sine(kBlock * 60, 0.1f);
+    process(chain, ramped, 10, [&] { chain.setParameter(dsp::eqBandParam(5), 12.0f); });   // 1 kHz, ramped
+    const float boosted = settledPeak(ramped);
+
+    std::vector<float> after = sine(kBlock * 60, 0.1f);
+    process(chain, after, 10, [&] {
+        chain.setParameterSmoothingMs(0.0f);
+        chain.setParameter(dsp::eqBandParam(0), 3.0f);   // 31 Hz, unramped: republishes every band
+    });
+
+    EXPECT_EQ(chain.equalizer().getBandGain(5), 12.0f);
+    EXPECT_TRUE(boosted > 0.3f);
+    EXPECT_TRUE(std::fabs(20.0f * std::log10(settledPeak(after) / boosted)) < 0.5f);
+}
+
+// A ramp in flight, then an unramped update of the same band: the jump wins
+TEST_CASE(unramped_eq_update_ends_the_band_ramp) {
+    dsp::DSPChain chain(kSampleRate);
+    isolate(chain, false, false);
+
+    std::vector<float> flat = sine(kBlock * 60, 0.1f);
+    process(chain, flat);
+    float flatPeak = 0.0f;
+    for (size_t i = flat.size() - kBlock * 10; i < flat.size(); ++i) flatPeak = std::max(flatPeak, std::fabs(flat[i]));
+
+    chain.setParameterSmoothingMs(dsp::DSPChain::kMaxSmoothingMs);   // 1 kHz band towards +12 dB, slowly
+    std::vector<float> out = sine(kBlock * 120, 0.1f);
+    process(chain, out, 5, [&] { chain.setParameter(dsp::eqBandParam(5), 12.0f); });
+    // ... then back to 0 dB at once, mid-ramp
+    std::vector<float> after = sine(kBlock * 60, 0.1f);
+    process(chain, after, 2, [&] {
+        chain.setParameterSmoothingMs(0.0f);
+        chain.setParameter(dsp::eqBandParam(5), 0.0f);
+    });
+
+    float peak = 0.0f;
+    for (size_t i = after.size() - kBlock * 10; i < after.size(); ++i) peak = std::max(peak, std::fabs(after[i]));
+    EXPECT_EQ(chain.equalizer().getBandGain(5), 0.0f);
+    EXPECT_TRUE(!chain.equalizer().isRamping());
+    EXPECT_TRUE(std::fabs(20.0f * std::log10(peak / flatPeak)) < 0.1f);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,299 @@
+// ==============================================================================
+// Processing graph - compiled schedule, buffer assignment, live re-routing
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "dsp/DSPChain.h"
+#include "dsp/ProcessingGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace soundarch;
+using dsp::GraphError;
+using dsp::GraphSpec;
+using dsp::Param;
+using dsp::StageKind;
+
+namespace {
+
+    constexpr float kRate = 48000.0f;
+    constexpr int32_t kBlock = 192;
+    constexpr int32_t kLongBlock = 480;   // > DSPChain scratch: chunked parallel path
+
+    std::vector<float> sine(size_t n, float amplitude, float freq = 1000.0f) {
+        std::vector<float> x(n);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = amplitude * std::sin(2.0f * static_cast<float>(M_PI) * freq * static_cast<float>(i) / kRate);
+        }
+        return x;
+    }
+
+    void process(dsp::DSPChain& chain, std::vector<float>& buffer, int32_t block = kBlock) {
+        dsp::BlockContext ctx;
+        ctx.sampleRate = static_cast<int>(kRate);
+        for (size_t offset = 0; offset < buffer.size(); offset += static_cast<size_t>(block)) {
+            const auto n = static_cast<int32_t>(std::min<size_t>(static_cast<size_t>(block), buffer.size() - offset));
+            chain.processBlock(buffer.data() + offset, n, ctx);
+        }
+    }
+
+    // Runs stage(in, out, n) block by block, like the fixed chain did
+    template<typename Stage>
+    void apply(std::vector<float>& buffer, Stage&& stage, int32_t block = kBlock) {
+        for (size_t offset = 0; offset < buffer.size(); offset += static_cast<size_t>(block)) {
+            const auto n = static_cast<int>(std::min<size_t>(static_cast<size_t>(block), buffer.size() - offset));
+            stage(buffer.data() + offset, n);
+        }
+    }
+
+    bool bitExact(const std::vector<float>& a, const std::vector<float>& b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+
+    // Production limiter settings (DSPChain::makeLimiter) with another ceiling
+    void configure(dsp::Limiter& limiter, float thresholdDb) {
+        limiter.setThreshold(thresholdDb);
+        limiter.setRelease(50.0f);
+    }
+
+    bool allInPlace(const dsp::CompiledGraph& compiled) {
+        return std::all_of(compiled.ops.begin(), compiled.ops.end(),
+                           [](const dsp::GraphOp& op) { return op.in == 0 && op.out == 0; });
+    }
+
+} // anonymous namespace
+
+TEST_CASE(default_chain_compiles_to_an_in_place_schedule) {
+    dsp::CompiledGraph compiled;
+    EXPECT_TRUE(dsp::compileGraph(GraphSpec::defaultChain(), true, compiled) == GraphError::None);
+    EXPECT_EQ(compiled.ops.size(), 6u);
+    EXPECT_EQ(compiled.scratchBuffers, 0);
+    EXPECT_TRUE(allInPlace(compiled));
+
+    // Without a noise canceller its node is a bypass: nothing scheduled
+    EXPECT_TRUE(dsp::compileGraph(GraphSpec::defaultChain(), false, compiled) == GraphError::None);
+    EXPECT_EQ(compiled.ops.size(), 5u);
+    EXPECT_EQ(compiled.instances[static_cast<int>(StageKind::NoiseCanceller)], 0);
+    for (const dsp::GraphOp& op : compiled.ops) EXPECT_TRUE(op.kind != StageKind::NoiseCanceller);
+}
+
+TEST_CASE(parallel_branches_get_scratch_buffers) {
+    // Parallel compression: dry and compressed signal summed
+    GraphSpec parallel;
+    const int eq = parallel.add(StageKind::Equalizer, GraphSpec::kGraphInput);
+    const int wet = parallel.add(StageKind::Compressor, eq);
+    parallel.mix(eq, 0.5f, wet, 0.5f);
+
+    dsp::CompiledGraph compiled;
+    EXPECT_TRUE(dsp::compileGraph(parallel, false, compiled) == GraphError::None);
+    EXPECT_EQ(compiled.scratchBuffers, 1);
+    EXPECT_EQ(compiled.ops.size(), 3u);
+    EXPECT_EQ(compiled.ops[0].out, 0);                   // EQ in place
+    EXPECT_EQ(compiled.ops[1].in, 0);                    // Compressor keeps the dry signal intact
+    EXPECT_EQ(compiled.ops[1].out, 1);
+    EXPECT_TRUE(compiled.ops[2].kind == StageKind::Mix);
+    EXPECT_EQ(compiled.ops[2].out, 0);                   // Result already in the caller's block
+
+    // Output taken from a branch that is not the last node: one closing copy
+    GraphSpec tap;
+    const int limited = tap.add(StageKind::Limiter, GraphSpec::kGraphInput);
+    tap.add(StageKind::Compressor, GraphSpec::kGraphInput);
+    tap.setOutput(limited);
+    EXPECT_TRUE(dsp::compileGraph(tap, false, compiled) == GraphError::None);
+    EXPECT_EQ(compiled.ops.size(), 1u);                  // Compressor never reaches the output
+    EXPECT_TRUE(allInPlace(compiled));
+}
+
+TEST_CASE(invalid_graphs_are_rejected) {
+    dsp::CompiledGraph compiled;
+
+    GraphSpec forward;
+    forward.add(StageKind::AGC, 1);                      // Reads a later node
+    forward.add(StageKind::Limiter, GraphSpec::kGraphInput);
+    EXPECT_TRUE(dsp::compileGraph(forward, false, compiled) == GraphError::BadInput);
+
+    GraphSpec twice;
+    twice.add(StageKind::VoiceGain, GraphSpec::kGraphInput);
+    twice.add(StageKind::VoiceGain);
+    EXPECT_TRUE(dsp::compileGraph(twice, false, compiled) == GraphError::DuplicateVoiceGain);
+    twice.setBypassed(1, true);                          // A bypassed one does not count
+    EXPECT_TRUE(dsp::compileGraph(twice, false, compiled) == GraphError::None);
+
+    GraphSpec copy;
+    copy.add(StageKind::Copy, GraphSpec::kGraphInput);
+    EXPECT_TRUE(dsp::compileGraph(copy, false, compiled) == GraphError::Unsupported);
+
+    // The chain keeps its current routing
+    dsp::DSPChain chain(kRate);
+    const size_t stages = chain.scheduledStageCount();
+    EXPECT_TRUE(chain.setGraph(forward) == GraphError::BadInput);
+    EXPECT_EQ(chain.scheduledStageCount(), stages);
+    EXPECT_EQ(chain.graph().nodes().size(), GraphSpec::defaultChain().nodes().size());
+}
+
+TEST_CASE(default_graph_matches_the_fixed_chain) {
+    const std::vector<float> input = sine(kBlock * 100, 0.6f, 440.0f);
+
+    // The stages as the fixed chain wired them, production defaults
+    dsp::AGC agc(kRate);
+    agc.setTargetLevel(-20.0f);
+    agc.setMaxGain(25.0f);
+    agc.setMinGain(-10.0f);
+    agc.setAttackTime(0.1f);
+    agc.setReleaseTime(0.5f);
+    agc.setNoiseThreshold(-55.0f);
+    agc.setWindowSize(0.1f);
+    dsp::Equalizer equalizer(kRate);
+    dsp::Compressor compressor(kRate);
+    compressor.setThreshold(-20.0f);
+    compressor.setRatio(4.0f);
+    compressor.setAttack(5.0f);
+    compressor.setRelease(50.0f);
+    compressor.setMakeupGain(0.0f);
+    dsp::Limiter limiter(kRate);
+    configure(limiter, -1.0f);
+
+    std::vector<float> expected = input;
+    apply(expected, [&](float* x, int n) {
+        agc.processBlock(x, x, n);
+        equalizer.processBlock(x, x, n);
+        compressor.processBlock(x, x, n);
+        limiter.processBlock(x, x, n);
+    });
+
+    // Stage by stage, like the reference (the fused pass is fused_chain_test's)
+    dsp::DSPChain chain(kRate);
+    chain.setFusedProcessing(false);
+    std::vector<float> actual = input;
+    process(chain, actual);
+    EXPECT_TRUE(bitExact(actual, expected));
+}
+
+TEST_CASE(reordered_repeated_and_bypassed_stages) {
+    const std::vector<float> input = sine(kBlock * 80, 0.9f);
+
+    // Limiter → EQ → EQ (bypassed AGC in front): two EQ instances, both boosted
+    GraphSpec spec;
+    const int agc = spec.add(StageKind::AGC, GraphSpec::kGraphInput);
+    spec.add(StageKind::Limiter);
+    spec.add(StageKind::Equalizer);
+    spec.add(StageKind::Equalizer);
+    spec.setBypassed(agc, true);
+
+    dsp::DSPChain chain(kRate);
+    EXPECT_TRUE(chain.setGraph(spec) == GraphError::None);
+    EXPECT_EQ(chain.scheduledStageCount(), 3u);
+    chain.setParameter(dsp::eqBandParam(5), 4.0f);       // Fans out to every EQ instance
+
+    dsp::Limiter limiter(kRate);
+    configure(limiter, -1.0f);
+    dsp::Equalizer first(kRate);
+    dsp::Equalizer second(kRate);
+    first.setBandGain(5, 4.0f);
+    second.setBandGain(5, 4.0f);
+    std::vector<float> expected = input;
+    apply(expected, [&](float* x, int n) {
+        limiter.processBlock(x, x, n);
+        first.processBlock(x, x, n);
+        second.processBlock(x, x, n);
+    });
+
+    std::vector<float> actual = input;
+    process(chain, actual);
+    EXPECT_TRUE(bitExact(actual, expected));
+
+    // Everything bypassed: the block comes out untouched
+    GraphSpec bypass = GraphSpec::defaultChain();
+    for (int i = 0; i < static_cast<int>(bypass.nodes().size()); ++i) bypass.setBypassed(i, true);
+    EXPECT_TRUE(chain.setGraph(bypass) == GraphError::None);
+    EXPECT_EQ(chain.scheduledStageCount(), 0u);
+    std::vector<float> untouched = input;
+    process(chain, untouched);
+    EXPECT_TRUE(bitExact(untouched, input));
+}
+
+TEST_CASE(parallel_mix_matches_separate_branches) {
+    // Dry/wet: 0.5 × input + 0.5 × limited, blocks longer than the scratch
+    const std::vector<float> input = sine(kLongBlock * 40, 0.9f, 220.0f);
+    GraphSpec spec;
+    const int wet = spec.add(StageKind::Limiter, GraphSpec::kGraphInput);
+    spec.mix(GraphSpec::kGraphInput, 0.5f, wet, 0.5f);
+
+    dsp::DSPChain chain(kRate);
+    chain.setParameter(Param::LimiterThreshold, -12.0f);
+    EXPECT_TRUE(chain.setGraph(spec) == GraphError::None);
+
+    dsp::Limiter limiter(kRate);
+    configure(limiter, -12.0f);
+    std::vector<float> limited = input;
+    apply(limited, [&](float* x, int n) {
+        // The chain limits in scratch-sized chunks: same split here
+        for (int offset = 0; offset < n; offset += 256) {
+            const int chunk = std::min(256, n - offset);
+            limiter.processBlock(x + offset, x + offset, chunk);
+        }
+    }, kLongBlock);
+
+    std::vector<float> actual = input;
+    process(chain, actual, kLongBlock);
+    float maxError = 0.0f;
+    for (size_t i = 0; i < input.size(); ++i) {
+        maxError = std::max(maxError, std::fabs(actual[i] - (0.5f * input[i] + 0.5f * limited[i])));
+    }
+    EXPECT_NEAR(maxError, 0.0f, 1e-6f);
+}
+
+TEST_CASE(set_graph_while_processing) {
+    dsp::DSPChain chain(kRate);
+    std::atomic<bool> done{false};
+    std::atomic<int> swaps{0};
+
+    GraphSpec parallel;
+    const int wet = parallel.add(StageKind::Compressor, GraphSpec::kGraphInput);
+    parallel.mix(GraphSpec::kGraphInput, 0.7f, wet, 0.3f);
+    parallel.add(StageKind::Limiter);
+    GraphSpec doubled = GraphSpec::defaultChain();
+    doubled.add(StageKind::Compressor);
+    doubled.add(StageKind::Limiter);
+
+    std::thread control([&] {
+        for (int i = 0; i < 150; ++i) {
+            const GraphSpec& spec = i % 3 == 0 ? parallel : i % 3 == 1 ? doubled : GraphSpec::defaultChain();
+            if (chain.setGraph(spec) == GraphError::None) swaps.fetch_add(1);
+            chain.setParameter(Param::CompressorThreshold, -10.0f - static_cast<float>(i % 20));
+            std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    std::vector<float> block(kLongBlock);
+    dsp::BlockContext ctx;
+    uint64_t blocks = 0;
+    bool finite = true;
+    while (!done.load() || blocks < 100) {
+        const std::vector<float> input = sine(kLongBlock, 0.7f);
+        std::copy(input.begin(), input.end(), block.begin());
+        chain.processBlock(block.data(), kLongBlock, ctx);
+        for (float x : block) {
+            uint32_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            finite = finite && (bits & 0x7F800000u) != 0x7F800000u;
+        }
+        ++blocks;
+        std::this_thread::yield();                       // Single-core hosts
+    }
+    control.join();
+
+    EXPECT_EQ(swaps.load(), 150);
+    EXPECT_TRUE(finite);
+    EXPECT_EQ(chain.reclaimRetired(), 0u);
+}
+
+SOUNDARCH_TEST_MAIN()
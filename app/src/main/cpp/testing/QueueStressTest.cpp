@@ -0,0 +1,246 @@
+// ==============================================================================
+// Lock-free queue family - frame ring, MPSC, broadcast (built with TSan)
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // ━━━ Frame ring: 3 channels (not a power of two) carrying n, -n, n/2 ━━━
+    using Frames = FrameRingBuffer<float, 3, 256>;
+
+    void writeFrame(float* f, uint32_t n) {
+        f[0] = static_cast<float>(n);
+        f[1] = -static_cast<float>(n);
+        f[2] = static_cast<float>(n) * 0.5f;
+    }
+
+    bool frameIs(const float* f, uint32_t n) {
+        return f[0] == static_cast<float>(n) && f[1] == -static_cast<float>(n)
+               && f[2] == static_cast<float>(n) * 0.5f;
+    }
+
+    // ━━━ MPSC: which producer, its own running count ━━━
+    struct Command {
+        uint32_t producer;
+        uint32_t sequence;
+    };
+
+    // ━━━ Broadcast: 48-byte payload, every word derived from n ━━━
+    struct Meter {
+        uint64_t n;
+        double peak;
+        double rms;
+        uint64_t check[3];
+
+        static Meter of(uint64_t n) {
+            Meter m{};
+            m.n = n;
+            m.peak = static_cast<double>(n);
+            m.rms = static_cast<double>(n) * 0.5;
+            for (auto& c : m.check) c = ~n;
+            return m;
+        }
+
+        bool consistent() const {
+            return peak == static_cast<double>(n) && rms == static_cast<double>(n) * 0.5
+                   && check[0] == ~n && check[1] == ~n && check[2] == ~n;
+        }
+    };
+
+} // anonymous namespace
+
+TEST_CASE(frame_ring_counts_and_wraps_in_frames) {
+    auto ring = std::make_unique<Frames>();
+    EXPECT_EQ(ring->capacity(), 256u);
+    EXPECT_EQ(Frames::channels(), 3u);
+
+    float block[3 * 200];
+    for (uint32_t i = 0; i < 200; ++i) writeFrame(block + 3 * i, i);
+    EXPECT_TRUE(ring->push(block, 200));
+    EXPECT_TRUE(ring->pop(block, 200));
+
+    // 100 frames from frame 200: 56 before the wrap, 44 after
+    const Frames::Spans w = ring->prepareWrite(100);
+    EXPECT_EQ(w.first.size, 56u);
+    EXPECT_EQ(w.second.size, 44u);
+    for (uint32_t i = 0; i < w.first.size; ++i) writeFrame(Frames::samples(w.first) + 3 * i, i);
+    for (uint32_t i = 0; i < w.second.size; ++i) writeFrame(Frames::samples(w.second) + 3 * i, 56 + i);
+    ring->commitWrite(100);
+
+    EXPECT_TRUE(ring->pop(block, 100));
+    bool intact = true;
+    for (uint32_t i = 0; i < 100; ++i) intact = intact && frameIs(block + 3 * i, i);
+    EXPECT_TRUE(intact);
+}
+
+TEST_CASE(frame_ring_spsc_stress) {
+    auto ring = std::make_unique<Frames>();
+    constexpr uint32_t kTotal = 200000;
+
+    std::thread producer([&] {
+        std::vector<float> block(3 * 97);
+        uint32_t next = 0;
+        size_t chunk = 1;
+        while (next < kTotal) {
+            const size_t n = std::min<size_t>(chunk, kTotal - next);
+            for (size_t i = 0; i < n; ++i) writeFrame(block.data() + 3 * i, next + static_cast<uint32_t>(i));
+            if (ring->push(block.data(), n)) {
+                next += static_cast<uint32_t>(n);
+                chunk = chunk % 97 + 1;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t errors = 0;
+    while (expected < kTotal) {
+        const Frames::Spans r = ring->prepareRead(64);
+        if (r.size() == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (const auto& span : {r.first, r.second}) {
+            const float* f = Frames::samples(span);
+            for (size_t i = 0; i < span.size; ++i) errors += !frameIs(f + 3 * i, expected++);
+        }
+        ring->commitRead(r.size());
+    }
+    producer.join();
+    EXPECT_EQ(errors, 0u);
+}
+
+TEST_CASE(mpsc_rejects_when_full) {
+    auto queue = std::make_unique<MpscQueue<Command, 8>>();
+    for (uint32_t i = 0; i < 8; ++i) EXPECT_TRUE(queue->tryPush({0, i}));
+    EXPECT_TRUE(!queue->tryPush({0, 8}));
+
+    Command out[8];
+    EXPECT_EQ(queue->popBulk(out, 3), 3u);
+    EXPECT_EQ(out[2].sequence, 2u);
+    EXPECT_TRUE(queue->tryPush({0, 8}));
+    EXPECT_EQ(queue->popBulk(out, 8), 6u);
+    EXPECT_EQ(out[5].sequence, 8u);
+    EXPECT_TRUE(!queue->tryPop(out[0]));
+}
+
+TEST_CASE(mpsc_producers_stress) {
+    constexpr uint32_t kProducers = 4;
+    constexpr uint32_t kPerProducer = 50000;
+    auto queue = std::make_unique<MpscQueue<Command, 256>>();
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (uint32_t i = 0; i < kPerProducer;) {
+                if (queue->tryPush({p, i})) ++i;
+                else std::this_thread::yield();
+            }
+        });
+    }
+
+    // Per producer, commands arrive complete and in order
+    uint32_t next[kProducers] = {};
+    uint32_t errors = 0;
+    uint32_t received = 0;
+    Command batch[32];
+    while (received < kProducers * kPerProducer) {
+        const size_t n = queue->popBulk(batch, 32);
+        if (n == 0) std::this_thread::yield();
+        for (size_t i = 0; i < n; ++i) {
+            const Command& c = batch[i];
+            if (c.producer >= kProducers || c.sequence != next[c.producer]) ++errors;
+            else ++next[c.producer];
+        }
+        received += static_cast<uint32_t>(n);
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_EQ(errors, 0u);
+    for (uint32_t p = 0; p < kProducers; ++p) EXPECT_EQ(next[p], kPerProducer);
+}
+
+TEST_CASE(broadcast_reader_starts_at_now_and_skips_when_lapped) {
+    auto queue = std::make_unique<BroadcastQueue<Meter, 16>>();
+    for (uint64_t n = 0; n < 5; ++n) queue->publish(Meter::of(n));
+
+    auto early = queue->reader();                  // Sees items from 5 on
+    Meter m{};
+    EXPECT_TRUE(!early.tryPop(m));
+
+    for (uint64_t n = 5; n < 5 + 3 * 16; ++n) queue->publish(Meter::of(n));
+    auto late = queue->reader();
+    EXPECT_TRUE(!late.tryPop(m));
+
+    // 48 published since early: it resumes at head - N + 1 and counts the gap
+    EXPECT_TRUE(early.tryPop(m));
+    EXPECT_EQ(m.n, 5u + 3 * 16 - 16 + 1);
+    EXPECT_EQ(early.lostCount(), 3u * 16 - 16 + 1);
+    EXPECT_TRUE(m.consistent());
+
+    uint64_t delivered = 1;
+    while (early.tryPop(m)) ++delivered;
+    EXPECT_EQ(delivered, 15u);
+}
+
+TEST_CASE(broadcast_readers_stress) {
+    constexpr uint64_t kTotal = 300000;
+    constexpr int kReaders = 3;
+    auto queue = std::make_unique<BroadcastQueue<Meter, 64>>();
+
+    std::vector<BroadcastQueue<Meter, 64>::Reader> readers;
+    for (int r = 0; r < kReaders; ++r) readers.push_back(queue->reader());
+
+    std::atomic<bool> done{false};
+    uint64_t delivered[kReaders] = {};
+    uint64_t errors[kReaders] = {};
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < kReaders; ++r) {
+        threads.emplace_back([&, r] {
+            auto& reader = readers[static_cast<size_t>(r)];
+            uint64_t last = 0;
+            bool first = true;
+            Meter m{};
+            for (;;) {
+                const bool finished = done.load(std::memory_order_acquire);
+                if (!reader.tryPop(m)) {
+                    if (finished) break;   // Producer done and caught up
+                    std::this_thread::yield();
+                    continue;
+                }
+                // No torn payloads, strictly increasing (gaps only when lapped)
+                if (!m.consistent() || (!first && m.n <= last)) ++errors[r];
+                last = m.n;
+                first = false;
+                ++delivered[r];
+            }
+        });
+    }
+
+    for (uint64_t n = 0; n < kTotal; ++n) {
+        queue->publish(Meter::of(n));
+        if ((n & 255) == 0) std::this_thread::yield();   // Give readers a chance on small hosts
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+
+    for (int r = 0; r < kReaders; ++r) {
+        EXPECT_EQ(errors[r], 0u);
+        EXPECT_EQ(delivered[r] + readers[static_cast<size_t>(r)].lostCount(), kTotal);
+    }
+    EXPECT_EQ(queue->publishedCount(), kTotal);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,141 @@
+// ==============================================================================
+// RingBuffer - reservation spans, wrap-around, partial commits, SPSC stress
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Ring = RingBuffer<float, 64>;
+
+    void fill(const Ring::Span& span, float& next) {
+        for (size_t i = 0; i < span.size; ++i) span.data[i] = next++;
+    }
+
+} // anonymous namespace
+
+TEST_CASE(indices_live_on_separate_cache_lines) {
+    EXPECT_TRUE(alignof(Ring) >= 64);
+    EXPECT_TRUE(sizeof(Ring) >= 64 * sizeof(float) + 2 * 64);
+}
+
+TEST_CASE(reservation_wraps_into_two_spans) {
+    auto ring = std::make_unique<Ring>();
+    std::vector<float> scratch(64);
+
+    // Move both indices to 50: the next 30 elements wrap after 14
+    EXPECT_TRUE(ring->push(scratch.data(), 50));
+    EXPECT_TRUE(ring->pop(scratch.data(), 50));
+
+    const Ring::Spans w = ring->prepareWrite(30);
+    EXPECT_EQ(w.first.size, 14u);
+    EXPECT_EQ(w.second.size, 16u);
+    EXPECT_EQ(w.size(), 30u);
+
+    float next = 0.0f;
+    fill(w.first, next);
+    fill(w.second, next);
+    ring->commitWrite(w.size());
+    EXPECT_EQ(ring->availableToRead(), 30u);
+
+    const Ring::Spans r = ring->prepareRead(100);   // Capped to what is queued
+    EXPECT_EQ(r.first.size, 14u);
+    EXPECT_EQ(r.second.size, 16u);
+    EXPECT_EQ(r.first.data[0], 0.0f);
+    EXPECT_EQ(r.second.data[0], 14.0f);
+    EXPECT_EQ(r.second.data[15], 29.0f);
+    ring->commitRead(r.size());
+    EXPECT_EQ(ring->availableToRead(), 0u);
+}
+
+TEST_CASE(reservation_is_capped_by_free_space) {
+    auto ring = std::make_unique<Ring>();
+    std::vector<float> scratch(64);
+    EXPECT_TRUE(ring->push(scratch.data(), 40));
+
+    EXPECT_EQ(ring->prepareWrite(100).size(), 24u);
+    EXPECT_TRUE(!ring->push(scratch.data(), 25));
+    EXPECT_TRUE(ring->push(scratch.data(), 24));
+    EXPECT_EQ(ring->prepareWrite(1).size(), 0u);
+
+    // Freed space becomes visible to the producer's cached tail
+    EXPECT_TRUE(ring->pop(scratch.data(), 10));
+    EXPECT_EQ(ring->prepareWrite(100).size(), 10u);
+}
+
+TEST_CASE(partial_commits_keep_order) {
+    auto ring = std::make_unique<Ring>();
+    float next = 0.0f;
+    for (int round = 0; round < 20; ++round) {
+        const Ring::Spans w = ring->prepareWrite(24);
+        fill(w.first, next);
+        fill(w.second, next);
+        ring->commitWrite(17);                // Only part of the reservation
+        next -= static_cast<float>(w.size() - 17);
+
+        float out[17];
+        EXPECT_TRUE(ring->pop(out, 17));
+        for (int i = 0; i < 17; ++i) EXPECT_EQ(out[i], static_cast<float>(round * 17 + i));
+    }
+}
+
+TEST_CASE(pop_fails_without_consuming_when_short) {
+    auto ring = std::make_unique<Ring>();
+    const float in[3] = {1.0f, 2.0f, 3.0f};
+    float out[4] = {};
+    EXPECT_TRUE(ring->push(in, 3));
+    EXPECT_TRUE(!ring->pop(out, 4));
+    EXPECT_TRUE(ring->pop(out, 3));
+    EXPECT_EQ(out[2], 3.0f);
+}
+
+TEST_CASE(spsc_threads_see_every_sample_in_order) {
+    using BigRing = RingBuffer<float, 1024>;
+    auto ring = std::make_unique<BigRing>();
+    constexpr uint32_t kTotal = 1u << 20;
+
+    // Producer: odd-sized reservations; consumer: odd-sized pops and reads in place
+    std::thread producer([&] {
+        uint32_t next = 0;
+        size_t chunk = 1;
+        while (next < kTotal) {
+            const BigRing::Spans w = ring->prepareWrite(std::min<size_t>(chunk, kTotal - next));
+            for (size_t i = 0; i < w.first.size; ++i) w.first.data[i] = static_cast<float>(next++ & 0xFFFFF);
+            for (size_t i = 0; i < w.second.size; ++i) w.second.data[i] = static_cast<float>(next++ & 0xFFFFF);
+            ring->commitWrite(w.size());
+            chunk = chunk % 300 + 7;
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t errors = 0;
+    size_t chunk = 3;
+    std::vector<float> out(512);
+    while (expected < kTotal) {
+        if (chunk % 2 == 0) {
+            const size_t n = std::min<size_t>(chunk, kTotal - expected);
+            if (!ring->pop(out.data(), n)) continue;
+            for (size_t i = 0; i < n; ++i) errors += out[i] != static_cast<float>(expected++ & 0xFFFFF);
+        } else {
+            const BigRing::Spans r = ring->prepareRead(chunk);
+            for (size_t i = 0; i < r.first.size; ++i) errors += r.first.data[i] != static_cast<float>(expected++ & 0xFFFFF);
+            for (size_t i = 0; i < r.second.size; ++i) errors += r.second.data[i] != static_cast<float>(expected++ & 0xFFFFF);
+            ring->commitRead(r.size());
+        }
+        chunk = chunk % 500 + 11;
+    }
+    producer.join();
+
+    EXPECT_EQ(errors, 0u);
+    EXPECT_EQ(ring->availableToRead(), 0u);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,258 @@
+// ==============================================================================
+// RT safety - violation detector, and the audio path running clean under it
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "DSPChain.h"
+#include "Limiter.h"
+#include "OboeEngine.h"
+#include "RtGuard.h"
+#include "SimulatedBackend.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+#include <vector>
+
+using namespace soundarch;
+
+namespace {
+
+    std::vector<float>* volatile gEscape = nullptr;
+
+    // Fails the calling test with a symbolized report if the RT path misbehaved
+    void expectNoViolations(const char* what) {
+#if SOUNDARCH_RT_GUARD
+        const size_t count = utils::rtguard::violationCount();
+        if (count != 0) {
+            std::fprintf(stderr, "RT violations in %s:\n", what);
+            utils::rtguard::printViolations(stderr);
+        }
+        EXPECT_EQ(count, 0u);
+        utils::rtguard::clearViolations();
+#else
+        (void)what;
+#endif
+    }
+
+} // anonymous namespace
+
+#if SOUNDARCH_RT_GUARD
+
+TEST_CASE(guard_is_linked) {
+    EXPECT_TRUE(utils::rtguard::isActive());
+    EXPECT_TRUE(!utils::rtguard::inRtSection());
+}
+
+TEST_CASE(allocation_inside_rt_scope_is_recorded) {
+    utils::rtguard::clearViolations();
+
+    void* outside = std::malloc(64);   // Not RT: ignored
+    std::free(outside);
+    EXPECT_EQ(utils::rtguard::violationCount(), 0u);
+
+    {
+        SOUNDARCH_RT_SCOPE();
+        EXPECT_TRUE(utils::rtguard::inRtSection());
+        gEscape = new std::vector<float>(256);   // Escapes: the optimizer can't elide it
+        delete gEscape;
+    }
+    EXPECT_TRUE(!utils::rtguard::inRtSection());
+
+    // Vector + its storage allocated, then both freed
+    EXPECT_EQ(utils::rtguard::violationCount(), 4u);
+    utils::rtguard::Violation v;
+    EXPECT_TRUE(utils::rtguard::violation(0, v));
+    EXPECT_TRUE(v.kind == utils::rtguard::ViolationKind::Allocation);
+    EXPECT_TRUE(std::strcmp(v.function, "malloc") == 0);
+    EXPECT_TRUE(v.frameCount > 2);
+    EXPECT_TRUE(utils::rtguard::violation(3, v));
+    EXPECT_TRUE(v.kind == utils::rtguard::ViolationKind::Deallocation);
+    utils::rtguard::clearViolations();
+}
+
+TEST_CASE(locks_and_syscalls_inside_rt_scope_are_recorded) {
+    utils::rtguard::clearViolations();
+    std::mutex mutex;
+
+    {
+        SOUNDARCH_RT_SCOPE();
+        mutex.lock();
+        mutex.unlock();
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+        if (FILE* f = std::fopen("/proc/self/stat", "r")) std::fclose(f);   // fclose also frees
+    }
+
+    bool sawLock = false;
+    bool sawSleep = false;
+    bool sawOpen = false;
+    for (size_t i = 0; i < utils::rtguard::violationCount(); ++i) {
+        utils::rtguard::Violation v;
+        if (!utils::rtguard::violation(i, v)) continue;
+        sawLock |= v.kind == utils::rtguard::ViolationKind::Lock;
+        sawSleep |= std::strcmp(v.function, "nanosleep") == 0 || std::strcmp(v.function, "clock_nanosleep") == 0;
+        sawOpen |= std::strncmp(v.function, "fopen", 5) == 0;
+    }
+    EXPECT_TRUE(sawLock);
+    EXPECT_TRUE(sawSleep);
+    EXPECT_TRUE(sawOpen);
+    utils::rtguard::clearViolations();
+}
+
+TEST_CASE(condition_waits_inside_rt_scope_are_recorded) {
+    utils::rtguard::clearViolations();
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+    std::mutex stdMutex;
+    std::condition_variable stdCond;
+
+    {
+        SOUNDARCH_RT_SCOPE();
+        const timespec past = {0, 0};   // Already expired: returns ETIMEDOUT at once
+        pthread_mutex_lock(&mutex);
+        EXPECT_EQ(pthread_cond_timedwait(&cond, &mutex, &past), ETIMEDOUT);
+        pthread_mutex_unlock(&mutex);
+
+        std::unique_lock<std::mutex> lock(stdMutex);
+        stdCond.wait_for(lock, std::chrono::microseconds(1));
+    }
+
+    // Timed wait, then wait_for (pthread_cond_clockwait or timedwait depending on glibc)
+    bool sawTimedwait = false;
+    int condWaits = 0;
+    for (size_t i = 0; i < utils::rtguard::violationCount(); ++i) {
+        utils::rtguard::Violation v;
+        if (!utils::rtguard::violation(i, v) || v.kind != utils::rtguard::ViolationKind::Lock) continue;
+        sawTimedwait |= std::strcmp(v.function, "pthread_cond_timedwait") == 0;
+        condWaits += std::strncmp(v.function, "pthread_cond_", 13) == 0;
+    }
+    EXPECT_TRUE(sawTimedwait);
+    EXPECT_EQ(condWaits, 2);
+
+    // Forwarded to the real condvar: a waiter is woken by a signal
+    std::atomic<bool> woken{false};
+    std::thread waiter([&] {
+        std::unique_lock<std::mutex> lock(stdMutex);
+        stdCond.wait(lock, [&] { return woken.load(); });
+    });
+    {
+        std::lock_guard<std::mutex> lock(stdMutex);
+        woken = true;
+    }
+    stdCond.notify_one();
+    waiter.join();
+    utils::rtguard::clearViolations();
+}
+
+TEST_CASE(violations_on_other_threads_are_ignored) {
+    utils::rtguard::clearViolations();
+    std::atomic<bool> stop{false};
+    std::thread worker([&] {
+        while (!stop.load()) {
+            std::vector<int> v(32);
+            std::this_thread::yield();
+        }
+    });
+
+    {
+        SOUNDARCH_RT_SCOPE();
+        for (volatile int i = 0; i < 100000; i = i + 1) {
+        }
+    }
+    stop = true;
+    worker.join();
+    EXPECT_EQ(utils::rtguard::violationCount(), 0u);
+}
+
+#endif // SOUNDARCH_RT_GUARD
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// The real audio path: OboeEngine + DSPChain, as wired in native-lib.cpp
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+TEST_CASE(engine_callback_with_dsp_chain_is_rt_safe) {
+    audio::SimulatedDeviceConfig config;
+    config.callbackJitterFrames = 32;          // Exercise XRun logging paths too
+    config.stalls.push_back({1.0, 30.0});
+
+    auto backend = std::make_unique<audio::SimulatedBackend>(config);
+    audio::SimulatedBackend* device = backend.get();
+    OboeEngine engine(std::move(backend));
+    engine.setTelemetryThreadEnabled(false);
+
+    dsp::DSPChain chain(48000.0f);
+    chain.setVoiceGainDb(3.0f);
+    chain.limiter().setLookahead(5.0f);
+    engine.setAudioCallback([&](float* in, float* out, int32_t n) {
+        if (in != out) std::memcpy(out, in, static_cast<size_t>(n) * sizeof(float));
+        dsp::BlockContext ctx;
+        ctx.sampleRate = 48000;
+        ctx.profiler = &engine.profiler();
+        chain.processBlock(out, n, ctx);
+    });
+
+    EXPECT_TRUE(engine.start());
+    EXPECT_TRUE(engine.trace().start(10.0, false));   // Trace producers are on the RT path too
+    EXPECT_TRUE(device->advance(0.5));
+    expectNoViolations("startup");
+
+    // Control-thread parameter changes between callbacks (as the JNI setters do)
+    for (int i = 0; i < 20; ++i) {
+        chain.limiter().setLookahead(static_cast<float>(i % 11));
+        chain.compressor().setRatio(2.0f + static_cast<float>(i % 4));
+        chain.equalizer().setBandGain(i % dsp::Equalizer::kNumBands, static_cast<float>(i % 7) - 3.0f);
+        chain.setAGCEnabled(i % 3 != 0);
+        EXPECT_TRUE(device->advance(0.1));
+        engine.pollTelemetry();
+        engine.trace().drain();
+    }
+    expectNoViolations("steady state with parameter changes");
+    EXPECT_TRUE(engine.getXRunCount() > 0);   // The stall and the jitter did happen
+    EXPECT_TRUE(engine.trace().windowEventCount() > 0);
+
+    engine.trace().stop();
+    engine.stop();
+}
+
+TEST_CASE(limiter_lookahead_changes_while_processing) {
+    // setLookahead() used to resize the delay line under the audio thread
+    dsp::Limiter limiter(48000.0f);
+    std::atomic<bool> stop{false};
+    std::thread control([&] {
+        for (int i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+            limiter.setLookahead(static_cast<float>(i % 12));
+        }
+    });
+
+    std::vector<float> block(192, 0.5f);
+    for (int b = 0; b < 2000; ++b) {
+        SOUNDARCH_RT_SCOPE();
+        limiter.processBlock(block.data(), block.data(), static_cast<int>(block.size()));
+    }
+    stop = true;
+    control.join();
+    expectNoViolations("Limiter::processBlock");
+
+    for (float s : block) EXPECT_TRUE(std::isfinite(s) && std::fabs(s) <= 1.0f);
+
+    // Lookahead still delays by the configured length once settled
+    limiter.setLookahead(1.0f);   // 48 samples
+    limiter.reset();
+    std::vector<float> impulse(128, 0.0f);
+    impulse[0] = 0.1f;
+    limiter.processBlock(impulse.data(), impulse.data(), static_cast<int>(impulse.size()));
+    EXPECT_NEAR(impulse[0], 0.0f, 1e-9);
+    EXPECT_TRUE(std::fabs(impulse[47]) > 0.05f);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,154 @@
+// ==============================================================================
+// RT-safe async logger - record encoding, drops, compile-time level, threads
+// ==============================================================================
+
+#include "TestHarness.h"
+
+// Info and Debug call sites compiled out for this translation unit
+#undef SOUNDARCH_RT_LOG_LEVEL
+#define SOUNDARCH_RT_LOG_LEVEL 5
+#include "RtLog.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace soundarch::log;
+
+namespace {
+
+    constexpr const char* kTag = "RtLogTest";
+
+    struct Captured {
+        int priority;
+        std::string tag;
+        std::string message;
+    };
+
+    std::vector<Captured> gCaptured;
+    void captureSink(int priority, const char* tag, const char* message) {
+        gCaptured.push_back({ priority, tag, message });
+    }
+
+    std::atomic<uint64_t> gCounted{0};
+    std::atomic<bool> gMalformed{false};
+    void countingSink(int, const char* tag, const char* message) {
+        if (std::strcmp(tag, kTag) != 0) return;   // Drop reports
+        if (std::strncmp(message, "producer ", 9) != 0) gMalformed = true;
+        gCounted.fetch_add(1);
+    }
+
+    void resetCapture() {
+        rt::logger().drain();
+        gCaptured.clear();
+        rt::logger().setSink(captureSink);
+    }
+
+    int gEvaluations = 0;
+    int sideEffect() { return ++gEvaluations; }
+
+} // anonymous namespace
+
+TEST_CASE(formats_every_argument_type_on_drain) {
+    resetCapture();
+
+    int marker = 0;
+    const int64_t big = -1234567890123ll;
+    EXPECT_TRUE(rt::logger().log(Warn, kTag, "i=%d u=%u ll=%lld zu=%zu", -7, 42u,
+                                 static_cast<long long>(big), static_cast<size_t>(99)));
+    EXPECT_TRUE(rt::logger().log(Error, kTag, "f=%.2f d=%.3f s=%s c=%c", 1.5f, 2.25, "literal", 'x'));
+    EXPECT_TRUE(rt::logger().log(Warn, kTag, "p=%p", static_cast<void*>(&marker)));
+    EXPECT_TRUE(rt::logger().log(Warn, kTag, "no arguments"));
+
+    // Nothing is formatted on the producer side
+    EXPECT_EQ(gCaptured.size(), 0u);
+    EXPECT_EQ(rt::logger().drain(), 4u);
+    EXPECT_EQ(gCaptured.size(), 4u);
+
+    char pointer[32];
+    std::snprintf(pointer, sizeof(pointer), "p=%p", static_cast<void*>(&marker));
+    EXPECT_TRUE(gCaptured[0].message == "i=-7 u=42 ll=-1234567890123 zu=99");
+    EXPECT_TRUE(gCaptured[1].message == "f=1.50 d=2.250 s=literal c=x");
+    EXPECT_TRUE(gCaptured[2].message == pointer);
+    EXPECT_TRUE(gCaptured[3].message == "no arguments");
+    EXPECT_EQ(gCaptured[1].priority, static_cast<int>(Error));
+    EXPECT_TRUE(gCaptured[0].tag == kTag);
+}
+
+TEST_CASE(full_ring_drops_and_reports) {
+    resetCapture();
+    const uint64_t droppedBefore = rt::logger().droppedCount();
+
+    int accepted = 0;
+    for (size_t i = 0; i < rt::kCapacity + 10; ++i) {
+        if (rt::logger().log(Warn, kTag, "record %zu", i)) ++accepted;
+    }
+    EXPECT_EQ(static_cast<size_t>(accepted), rt::kCapacity);
+    EXPECT_EQ(rt::logger().droppedCount() - droppedBefore, 10u);
+
+    EXPECT_EQ(rt::logger().drain(), rt::kCapacity);
+    EXPECT_EQ(gCaptured.size(), rt::kCapacity + 1);
+    EXPECT_TRUE(gCaptured.front().message == "record 0");
+    EXPECT_TRUE(gCaptured.back().message.find("10 RT log records dropped") != std::string::npos);
+
+    // Space is reusable after the drain
+    EXPECT_TRUE(rt::logger().log(Warn, kTag, "after"));
+    EXPECT_EQ(rt::logger().drain(), 1u);
+}
+
+TEST_CASE(compiled_out_levels_do_not_evaluate_arguments) {
+    resetCapture();
+    gEvaluations = 0;
+
+    SA_RT_LOGD(kTag, "debug %d", sideEffect());
+    SA_RT_LOGI(kTag, "info %d", sideEffect());
+    EXPECT_EQ(gEvaluations, 0);
+
+    SA_RT_LOGW(kTag, "warn %d", sideEffect());
+    SA_RT_LOGE(kTag, "error %d", sideEffect());
+    EXPECT_EQ(gEvaluations, 2);
+
+    rt::logger().drain();
+    EXPECT_EQ(gCaptured.size(), 2u);
+    EXPECT_TRUE(gCaptured[0].message == "warn 1");
+    EXPECT_TRUE(gCaptured[1].message == "error 2");
+}
+
+TEST_CASE(concurrent_producers_with_drain_thread) {
+    rt::logger().drain();
+    rt::logger().setSink(countingSink);
+    gCounted = 0;
+    gMalformed = false;
+
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+    const uint64_t droppedBefore = rt::logger().droppedCount();
+
+    rt::logger().startThread();
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                rt::logger().log(Warn, kTag, "producer %d record %d", p, i);
+                // Callback-like bursts, so records are drained while others are pushed
+                if (i % 64 == 63) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+    rt::logger().stopThread();   // Final drain
+
+    const uint64_t dropped = rt::logger().droppedCount() - droppedBefore;
+    std::fprintf(stderr, "  %d records: %llu emitted, %llu dropped\n", kProducers * kPerProducer,
+                 static_cast<unsigned long long>(gCounted.load()), static_cast<unsigned long long>(dropped));
+    EXPECT_EQ(gCounted.load() + dropped, static_cast<uint64_t>(kProducers * kPerProducer));
+    EXPECT_TRUE(!gMalformed.load());
+
+    rt::logger().setSink(nullptr);
+}
+
+SOUNDARCH_TEST_MAIN()
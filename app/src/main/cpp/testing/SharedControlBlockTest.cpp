@@ -0,0 +1,194 @@
+// ==============================================================================
+// Shared control block - Kotlin-side byte layout, generation pickup, meters
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "dsp/DSPChain.h"
+#include "dsp/SharedControlBlock.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace soundarch;
+using dsp::Param;
+using dsp::SharedControlBlock;
+
+namespace {
+
+    constexpr float kSampleRate = 48000.0f;
+    constexpr int kBlock = 192;
+
+    // What com.soundarch.engine.SharedControlBlock does: plain byte offsets, no C++ types
+    struct KotlinView {
+        uint8_t* bytes;
+
+        explicit KotlinView(SharedControlBlock& block) : bytes(static_cast<uint8_t*>(block.data())) {}
+
+        uint32_t getInt(size_t offset) const {
+            uint32_t v;
+            std::memcpy(&v, bytes + offset, sizeof(v));
+            return v;
+        }
+        float getFloat(size_t offset) const {
+            float v;
+            std::memcpy(&v, bytes + offset, sizeof(v));
+            return v;
+        }
+        void putInt(size_t offset, uint32_t v) { std::memcpy(bytes + offset, &v, sizeof(v)); }
+        void putFloat(size_t offset, float v) { std::memcpy(bytes + offset, &v, sizeof(v)); }
+
+        size_t control() const { return getInt(16); }
+        size_t telemetry() const { return getInt(20); }
+
+        void setParam(Param id, float value) { putFloat(control() + 20 + 4 * static_cast<size_t>(id), value); }
+        void setSwitch(dsp::ModuleSwitch s, bool on) { putInt(control() + 4 + 4 * static_cast<size_t>(s), on ? 1 : 0); }
+        void bump() { putInt(control(), getInt(control()) + 1); }
+    };
+
+    // One live callback: pump, then process
+    void callback(SharedControlBlock& block, dsp::DSPChain& chain, std::vector<float>& buffer) {
+        block.pump(chain);
+        dsp::BlockContext ctx;
+        chain.processBlock(buffer.data(), kBlock, ctx);
+    }
+
+} // anonymous namespace
+
+TEST_CASE(header_describes_the_layout) {
+    SharedControlBlock block;
+    KotlinView kotlin(block);
+    EXPECT_EQ(kotlin.getInt(0), SharedControlBlock::kMagic);
+    EXPECT_TRUE(std::memcmp(kotlin.bytes, "SACB", 4) == 0);
+    EXPECT_EQ(kotlin.getInt(4), SharedControlBlock::kLayoutVersion);
+    EXPECT_EQ(kotlin.getInt(8), 320u);
+    EXPECT_EQ(kotlin.getInt(12), static_cast<uint32_t>(dsp::kParamCount));
+    EXPECT_EQ(kotlin.control(), 64u);
+    EXPECT_EQ(kotlin.telemetry(), 256u);
+
+    // Untouched until the UI writes: NaN params, -1 switches
+    EXPECT_EQ(kotlin.getInt(64 + 20), 0x7FC00000u);   // Float.NaN
+    EXPECT_EQ(static_cast<int32_t>(kotlin.getInt(64 + 4)), SharedControlBlock::kSwitchUntouched);
+}
+
+TEST_CASE(untouched_block_changes_nothing) {
+    SharedControlBlock block;
+    dsp::DSPChain chain(kSampleRate);
+    size_t applied = 0;
+    for (uint32_t i = 0; i < SharedControlBlock::kBackstopPumps * 3; ++i) applied += block.pump(chain);
+    EXPECT_EQ(applied, 0u);
+    EXPECT_EQ(chain.getVoiceGainDb(), 0.0f);
+    EXPECT_TRUE(chain.isAGCEnabled());
+}
+
+TEST_CASE(generation_bump_applies_changed_values_once) {
+    SharedControlBlock block;
+    KotlinView kotlin(block);
+    dsp::DSPChain chain(kSampleRate);
+    std::vector<float> buffer(kBlock, 0.1f);
+
+    kotlin.setParam(Param::CompressorThreshold, -32.0f);
+    kotlin.setParam(dsp::eqBandParam(7), -5.0f);
+    kotlin.setParam(Param::VoiceGain, 40.0f);   // Out of range: clamped like the JNI setter
+    kotlin.setSwitch(dsp::ModuleSwitch::AGC, false);
+    kotlin.bump();
+
+    EXPECT_EQ(block.pump(chain), 4u);
+    dsp::BlockContext ctx;
+    chain.processBlock(buffer.data(), kBlock, ctx);
+    EXPECT_TRUE(!chain.isAGCEnabled());
+    EXPECT_EQ(chain.equalizer().getBandGain(7), -5.0f);
+    EXPECT_EQ(chain.getVoiceGainDb(), SharedControlBlock::kVoiceGainMaxDb);
+
+    // Confirmation scan finds nothing new; the same values are never re-posted
+    EXPECT_EQ(block.pump(chain), 0u);
+    kotlin.bump();
+    EXPECT_EQ(block.pump(chain), 0u);
+}
+
+TEST_CASE(values_landing_after_the_bump_are_still_picked_up) {
+    // No release store on the JVM side: the bump may be seen before the value
+    SharedControlBlock block;
+    KotlinView kotlin(block);
+    dsp::DSPChain chain(kSampleRate);
+
+    kotlin.bump();
+    EXPECT_EQ(block.pump(chain), 0u);
+    kotlin.setParam(dsp::eqBandParam(4), 6.0f);
+    EXPECT_EQ(block.pump(chain), 1u);          // Confirmation scan
+
+    // Write without any bump at all: the backstop scan catches it
+    kotlin.setParam(Param::CompressorRatio, 8.0f);
+    kotlin.setParam(Param::CompressorKnee, INFINITY);   // Ignored
+    size_t applied = 0;
+    for (uint32_t i = 0; i < SharedControlBlock::kBackstopPumps; ++i) applied += block.pump(chain);
+    EXPECT_EQ(applied, 1u);
+}
+
+TEST_CASE(shared_block_matches_jni_setters_bit_for_bit) {
+    SharedControlBlock block;
+    KotlinView kotlin(block);
+    dsp::DSPChain shared(kSampleRate);
+    dsp::DSPChain direct(kSampleRate);
+
+    kotlin.setParam(Param::CompressorThreshold, -30.0f);
+    kotlin.setParam(Param::CompressorRatio, 6.0f);
+    kotlin.setParam(dsp::eqBandParam(2), -4.0f);
+    kotlin.setParam(Param::VoiceGain, 3.0f);
+    kotlin.bump();
+    direct.setParameter(Param::CompressorThreshold, -30.0f);
+    direct.setParameter(Param::CompressorRatio, 6.0f);
+    direct.setParameter(dsp::eqBandParam(2), -4.0f);
+    direct.setVoiceGainDb(3.0f);
+
+    std::vector<float> a(kBlock);
+    std::vector<float> b(kBlock);
+    bool identical = true;
+    for (int n = 0; n < 200; ++n) {
+        for (int i = 0; i < kBlock; ++i) {
+            a[i] = b[i] = 0.4f * std::sin(0.05f * static_cast<float>(n * kBlock + i));
+        }
+        callback(block, shared, a);
+        dsp::BlockContext ctx;
+        direct.processBlock(b.data(), kBlock, ctx);
+        identical = identical && std::memcmp(a.data(), b.data(), sizeof(float) * kBlock) == 0;
+    }
+    EXPECT_TRUE(identical);
+}
+
+TEST_CASE(published_meters_are_readable_at_fixed_offsets) {
+    SharedControlBlock block;
+    KotlinView kotlin(block);
+    const size_t t = kotlin.telemetry();
+    EXPECT_EQ(kotlin.getInt(t), 0u);
+
+    dsp::EngineMeters meters;
+    meters.peakDb = -6.5f;
+    meters.rmsDb = -18.25f;
+    meters.agcGainDb = 4.0f;
+    meters.agcLevelDb = -24.0f;
+    meters.compressorReductionDb = 3.5f;
+    meters.limiterReductionDb = 1.25f;
+    meters.xRunCount = 7;
+    meters.callbackFrames = 192;
+    meters.safeModeActive = true;
+    block.publish(meters);
+
+    EXPECT_EQ(kotlin.getInt(t), 1u);
+    EXPECT_EQ(kotlin.getFloat(t + 4), -6.5f);
+    EXPECT_EQ(kotlin.getFloat(t + 8), -18.25f);
+    EXPECT_EQ(kotlin.getFloat(t + 12), 4.0f);
+    EXPECT_EQ(kotlin.getFloat(t + 16), -24.0f);
+    EXPECT_EQ(kotlin.getFloat(t + 20), 3.5f);
+    EXPECT_EQ(kotlin.getFloat(t + 24), 1.25f);
+    EXPECT_EQ(kotlin.getInt(t + 28), 7u);
+    EXPECT_EQ(kotlin.getInt(t + 32), 192u);
+    EXPECT_EQ(kotlin.getInt(t + 36), 1u);
+
+    block.publish(meters);
+    EXPECT_EQ(kotlin.getInt(t), 2u);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,297 @@
+// ==============================================================================
+// OboeEngine on the simulated device - scheduling, XRuns, drift, stalls
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "OboeEngine.h"
+#include "SimulatedBackend.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+using namespace soundarch;
+using audio::SimulatedBackend;
+using audio::SimulatedDeviceConfig;
+
+namespace {
+
+    struct Rig {
+        SimulatedBackend* device = nullptr;    // Owned by engine
+        std::unique_ptr<OboeEngine> engine;
+        uint64_t outputHash = 1469598103934665603ull;   // FNV-1a over output samples
+        double sumSquares = 0.0;
+        uint64_t samples = 0;
+
+        explicit Rig(const SimulatedDeviceConfig& config) {
+            auto backend = std::make_unique<SimulatedBackend>(config);
+            device = backend.get();
+            device->setOutputSink([this](const float* src, int32_t frames) {
+                for (int32_t i = 0; i < frames; ++i) {
+                    uint32_t bits;
+                    std::memcpy(&bits, &src[i], sizeof(bits));
+                    outputHash = (outputHash ^ bits) * 1099511628211ull;
+                    sumSquares += static_cast<double>(src[i]) * src[i];
+                }
+                samples += static_cast<uint64_t>(frames);
+            });
+            engine = std::make_unique<OboeEngine>(std::move(backend));
+        }
+
+        void resetLevel() {
+            sumSquares = 0.0;
+            samples = 0;
+        }
+
+        double rms() const { return samples ? std::sqrt(sumSquares / static_cast<double>(samples)) : 0.0; }
+    };
+
+    int gLatencyUpdates = 0;
+    void countLatencyUpdate(double) { ++gLatencyUpdates; }
+
+    std::atomic<int> gThreadedUpdates{0};
+    std::atomic<bool> gListenerOnCallbackThread{false};
+    std::thread::id gCallbackThread;
+    void recordListenerThread(double) {
+        if (std::this_thread::get_id() == gCallbackThread) gListenerOnCallbackThread = true;
+        gThreadedUpdates.fetch_add(1);
+    }
+
+} // anonymous namespace
+
+TEST_CASE(steady_state_runs_without_xruns) {
+    Rig rig(SimulatedDeviceConfig{});
+    EXPECT_TRUE(rig.engine->start());
+
+    // Startup: the first callbacks run before the capture has produced anything
+    EXPECT_TRUE(rig.device->advance(1.0));
+    const uint32_t startupXRuns = rig.engine->getXRunCount();
+
+    rig.resetLevel();
+    EXPECT_TRUE(rig.device->advance(60.0));
+    EXPECT_EQ(rig.engine->getXRunCount(), startupXRuns);
+    EXPECT_EQ(rig.device->stats().outputUnderruns, 0u);
+    EXPECT_EQ(rig.device->stats().inputOverruns, 0u);
+    EXPECT_EQ(rig.engine->getLastCallbackSize(), 192);
+
+    // Pass-through of the default -20 dBFS sine (0.1 peak)
+    EXPECT_NEAR(rig.rms(), 0.1 / std::sqrt(2.0), 1e-3);
+
+    // ~61 s of 192-frame periods, one callback each
+    const uint64_t expected = static_cast<uint64_t>(61.0 * 48000 / 192);
+    EXPECT_NEAR(static_cast<double>(rig.device->stats().callbacks), static_cast<double>(expected), 3.0);
+}
+
+TEST_CASE(runs_far_faster_than_real_time) {
+    Rig rig(SimulatedDeviceConfig{});
+    EXPECT_TRUE(rig.engine->start());
+
+    const auto t0 = std::chrono::steady_clock::now();
+    EXPECT_TRUE(rig.device->advance(600.0));
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::fprintf(stderr, "  600 s of device time in %.3f s (%.0fx real time)\n", wall, 600.0 / wall);
+    EXPECT_TRUE(wall < 60.0);
+}
+
+TEST_CASE(identical_config_reproduces_bit_for_bit) {
+    SimulatedDeviceConfig config;
+    config.callbackJitterFrames = 48;
+    config.inputDriftPpm = -300.0;
+    config.outputDriftPpm = 150.0;
+    config.stalls = { { 3.0, 15.0 }, { 7.5, 40.0 } };
+
+    Rig a(config);
+    Rig b(config);
+    EXPECT_TRUE(a.engine->start());
+    EXPECT_TRUE(b.engine->start());
+    a.device->advance(10.0);
+    b.device->advance(10.0);
+
+    EXPECT_EQ(a.outputHash, b.outputHash);
+    EXPECT_EQ(a.engine->getXRunCount(), b.engine->getXRunCount());
+    EXPECT_EQ(a.device->stats().callbacks, b.device->stats().callbacks);
+    EXPECT_EQ(a.device->stats().outputUnderruns, b.device->stats().outputUnderruns);
+
+    // A different jitter seed changes the schedule
+    config.seed = 42;
+    Rig c(config);
+    EXPECT_TRUE(c.engine->start());
+    c.device->advance(10.0);
+    EXPECT_TRUE(c.outputHash != a.outputHash);
+}
+
+TEST_CASE(slow_capture_clock_starves_ring_buffer) {
+    SimulatedDeviceConfig config;
+    config.inputDriftPpm = -500.0;   // Mic runs 24 frames/s slow at 48 kHz
+
+    Rig rig(config);
+    EXPECT_TRUE(rig.engine->start());
+    rig.device->advance(1.0);
+    const uint32_t startupUnderflows = rig.engine->getUnderflowCount();
+
+    rig.device->advance(60.0);
+    // ~1440 frames missing after 60 s → one underflow per 192 missing frames, at least
+    EXPECT_TRUE(rig.engine->getUnderflowCount() >= startupUnderflows + 7);
+    EXPECT_EQ(rig.engine->getOverflowCount(), 0u);
+}
+
+TEST_CASE(fast_capture_clock_overruns_device_fifo) {
+    SimulatedDeviceConfig config;
+    config.inputDriftPpm = 2000.0;   // +96 frames/s: backlog beyond the 8-burst capture FIFO in ~16 s
+
+    Rig rig(config);
+    EXPECT_TRUE(rig.engine->start());
+    rig.device->advance(60.0);
+    EXPECT_TRUE(rig.device->stats().inputOverruns > 0);
+    EXPECT_TRUE(rig.device->stats().inputFramesWritten > rig.device->stats().inputFramesRead);
+}
+
+TEST_CASE(stall_underruns_device_then_recovers) {
+    SimulatedDeviceConfig config;
+    config.stalls = { { 2.0, 20.0 } };   // Callback thread preempted for 20 ms
+
+    Rig rig(config);
+    EXPECT_TRUE(rig.engine->start());
+    rig.device->advance(3.0);
+
+    const auto& stats = rig.device->stats();
+    EXPECT_TRUE(stats.stalledPeriods >= 4);
+    // 2-burst buffer (8 ms) cannot cover 20 ms: the device plays silence
+    EXPECT_TRUE(stats.outputUnderruns >= 2);
+    const uint64_t underrunsAfterStall = stats.outputUnderruns;
+    const uint32_t xrunsAfterStall = rig.engine->getXRunCount();
+
+    rig.device->advance(30.0);
+    EXPECT_EQ(rig.device->stats().outputUnderruns, underrunsAfterStall);
+    EXPECT_EQ(rig.engine->getXRunCount(), xrunsAfterStall);
+
+    // Deeper output buffer rides through the same stall
+    config.bufferSizeBursts = 8;
+    Rig deep(config);
+    EXPECT_TRUE(deep.engine->start());
+    deep.device->advance(3.0);
+    EXPECT_EQ(deep.device->stats().outputUnderruns, 0u);
+}
+
+TEST_CASE(callback_jitter_stays_in_bounds) {
+    SimulatedDeviceConfig config;
+    config.bufferSizeBursts = 4;
+    config.callbackJitterFrames = 64;
+
+    Rig rig(config);
+    EXPECT_TRUE(rig.engine->start());
+    rig.device->advance(5.0);
+
+    const auto& stats = rig.device->stats();
+    EXPECT_TRUE(stats.minCallbackFrames >= 128 && stats.minCallbackFrames < 192);
+    EXPECT_TRUE(stats.maxCallbackFrames <= 256 && stats.maxCallbackFrames > 192);
+    EXPECT_TRUE(rig.engine->getLastCallbackSize() >= 128 && rig.engine->getLastCallbackSize() <= 256);
+
+    // Variable callback sizes with no ring headroom: the engine XRuns
+    EXPECT_TRUE(rig.engine->getUnderflowCount() > 2);
+}
+
+TEST_CASE(latency_listener_and_stats_follow_virtual_clock) {
+    gLatencyUpdates = 0;
+    Rig rig(SimulatedDeviceConfig{});
+    rig.engine->setLatencyListener(countLatencyUpdate);
+    rig.engine->setTelemetryThreadEnabled(false);   // Pumped below, on the virtual clock
+    EXPECT_TRUE(rig.engine->start());
+
+    // Nothing is derived on the callback side: only raw counters are published
+    rig.device->advance(1.0);
+    EXPECT_EQ(gLatencyUpdates, 0);
+    EXPECT_TRUE(rig.engine->pollTelemetry());
+    EXPECT_TRUE(!rig.engine->pollTelemetry());      // Latest snapshot already consumed
+    EXPECT_EQ(gLatencyUpdates, 1);
+
+    // 10 Hz
+    gLatencyUpdates = 0;
+    for (int i = 0; i < 100; ++i) {
+        rig.device->advance(0.1);
+        rig.engine->pollTelemetry();
+    }
+    EXPECT_NEAR(gLatencyUpdates, 100, 2);
+
+    const LatencyStats stats = rig.engine->getLatencyStats();
+    // Burst latency: (192 + 192) / 48000 = 8 ms, ring buffer empty in steady state
+    EXPECT_NEAR(stats.totalMs, 8.0, 0.5);
+    EXPECT_TRUE(stats.minMs <= stats.totalMs && stats.totalMs <= stats.maxMs);
+
+    const PerformanceMetrics metrics = rig.engine->getPerformanceMetrics();
+    EXPECT_EQ(metrics.lastCallbackSize, 192);
+    EXPECT_NEAR(metrics.burstLatencyMs, 8.0, 1e-9);
+
+    // Bulk snapshot: same telemetry update as the individual getters
+    const EngineMetricsSnapshot snapshot = rig.engine->getMetricsSnapshot();
+    EXPECT_NEAR(snapshot.latency.emaMs, stats.emaMs, 1e-12);
+    EXPECT_NEAR(snapshot.performance.perceivedLatencyMs, metrics.perceivedLatencyMs, 1e-12);
+    EXPECT_EQ(snapshot.lastCallbackSize, 192);
+    EXPECT_EQ(snapshot.xRunCount, rig.engine->getXRunCount());
+    EXPECT_TRUE(snapshot.telemetryVersion >= 100);
+}
+
+TEST_CASE(telemetry_thread_notifies_off_the_callback_thread) {
+    gThreadedUpdates = 0;
+    gListenerOnCallbackThread = false;
+    gCallbackThread = std::this_thread::get_id();   // advance() runs callbacks here
+
+    Rig rig(SimulatedDeviceConfig{});
+    rig.engine->setLatencyListener(recordListenerThread);
+    EXPECT_TRUE(rig.engine->start());
+
+    // Device paced at ~real time so the 50 ms telemetry poll sees every snapshot
+    for (int i = 0; i < 40 && gThreadedUpdates.load() < 3; ++i) {
+        rig.device->advance(0.1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    rig.engine->stop();
+
+    EXPECT_TRUE(gThreadedUpdates.load() >= 3);
+    EXPECT_TRUE(!gListenerOnCallbackThread.load());
+}
+
+TEST_CASE(stage_profiler_times_every_callback) {
+    Rig rig(SimulatedDeviceConfig{});
+    EXPECT_TRUE(rig.engine->start());
+    EXPECT_TRUE(rig.device->advance(2.0));
+
+    using soundarch::utils::Stage;
+    const auto& profiler = rig.engine->profiler();
+    const uint64_t callbacks = rig.device->stats().callbacks;
+    EXPECT_EQ(profiler.summary(Stage::Callback).count, callbacks);
+    EXPECT_EQ(profiler.summary(Stage::Input).count, callbacks);
+    EXPECT_EQ(profiler.summary(Stage::Dsp).count, callbacks);
+    EXPECT_EQ(profiler.summary(Stage::Metering).count, callbacks);
+    EXPECT_EQ(profiler.summary(Stage::AGC).count, 0u);   // No DSPChain attached
+    EXPECT_EQ(profiler.budget().count, callbacks);
+
+    const auto total = profiler.summary(Stage::Callback);
+    EXPECT_TRUE(total.p50Ns > 0.0 && total.p50Ns <= total.p99Ns && total.p99Ns <= total.maxNs);
+
+    // start() clears the histograms
+    rig.engine->stop();
+    EXPECT_TRUE(rig.engine->start());
+    EXPECT_EQ(profiler.summary(Stage::Callback).count, 0u);
+}
+
+TEST_CASE(stop_ends_the_stream) {
+    Rig rig(SimulatedDeviceConfig{});
+    EXPECT_TRUE(rig.engine->start());
+    EXPECT_TRUE(rig.device->advance(0.5));
+    rig.engine->stop();
+    const uint64_t callbacks = rig.device->stats().callbacks;
+    EXPECT_TRUE(!rig.device->advance(0.5));
+    EXPECT_EQ(rig.device->stats().callbacks, callbacks);
+
+    // Restart: counters reset, stream runs again
+    EXPECT_TRUE(rig.engine->start());
+    EXPECT_TRUE(rig.device->advance(0.5));
+    EXPECT_TRUE(rig.device->stats().callbacks > 0);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,111 @@
+// ==============================================================================
+// Stage timing - LatencyHistogram buckets/percentiles, StageProfiler budget
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "CycleCounter.h"
+#include "LatencyHistogram.h"
+#include "StageProfiler.h"
+
+#include <cstdint>
+#include <memory>
+
+using soundarch::utils::LatencyHistogram;
+using soundarch::utils::Stage;
+using soundarch::utils::StageProfiler;
+
+TEST_CASE(bucket_bounds_stay_within_relative_error) {
+    // Every value maps to a bucket whose upper bound is ≥ value and ≤ value + 1/32
+    for (uint64_t v = 0; v < (1ull << 20); v += 1 + v / 97) {
+        const size_t index = LatencyHistogram::bucketIndex(v);
+        const uint64_t bound = LatencyHistogram::bucketUpperBound(index);
+        EXPECT_TRUE(bound >= v);
+        EXPECT_TRUE(static_cast<double>(bound - v) <= static_cast<double>(v) / 32.0);
+        if (index > 0) EXPECT_TRUE(LatencyHistogram::bucketUpperBound(index - 1) < v);
+    }
+
+    // Exact below 32, saturating at the top
+    EXPECT_EQ(LatencyHistogram::bucketIndex(31), 31u);
+    EXPECT_EQ(LatencyHistogram::bucketUpperBound(31), 31u);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(~0ull), LatencyHistogram::kBucketCount - 1);
+    EXPECT_EQ(LatencyHistogram::bucketIndex((1ull << 40) - 1), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST_CASE(percentiles_of_uniform_distribution) {
+    auto h = std::make_unique<LatencyHistogram>();
+    EXPECT_EQ(h->percentile(0.5), 0u);
+
+    for (uint64_t v = 1; v <= 10000; ++v) h->record(v);
+    EXPECT_EQ(h->count(), 10000u);
+    EXPECT_EQ(h->max(), 10000u);
+
+    // Bucket upper bound: never below the true quantile, at most 1/32 above
+    const uint64_t p50 = h->percentile(0.50);
+    const uint64_t p99 = h->percentile(0.99);
+    const uint64_t p999 = h->percentile(0.999);
+    EXPECT_TRUE(p50 >= 5000 && p50 <= 5000 + 5000 / 32);
+    EXPECT_TRUE(p99 >= 9900 && p99 <= 9900 + 9900 / 32);
+    EXPECT_TRUE(p999 >= 9990 && p999 <= 10000);
+    EXPECT_EQ(h->percentile(1.0), 10000u);
+    EXPECT_EQ(h->percentile(0.0), 1u);
+
+    h->reset();
+    EXPECT_EQ(h->count(), 0u);
+    EXPECT_EQ(h->max(), 0u);
+}
+
+TEST_CASE(rare_outlier_shows_only_in_the_tail) {
+    auto h = std::make_unique<LatencyHistogram>();
+    for (int i = 0; i < 9999; ++i) h->record(1000);
+    h->record(1000000);
+
+    EXPECT_TRUE(h->percentile(0.50) <= 1000 + 1000 / 32);
+    EXPECT_TRUE(h->percentile(0.999) <= 1000 + 1000 / 32);
+    EXPECT_EQ(h->percentile(1.0), 1000000u);
+    EXPECT_EQ(h->max(), 1000000u);   // Exact, not a bucket bound
+}
+
+TEST_CASE(budget_is_a_fraction_of_the_buffer_period) {
+    auto profiler = std::make_unique<StageProfiler>();
+    profiler->reset();
+
+    // 480 frames at 48 kHz = 10 ms period
+    const double ticksPerMs = soundarch::utils::cycleCounterFrequency() / 1000.0;
+    for (int i = 0; i < 98; ++i) profiler->recordCallback(static_cast<uint64_t>(2.0 * ticksPerMs), 480, 48000);
+    profiler->recordCallback(static_cast<uint64_t>(12.0 * ticksPerMs), 480, 48000);
+    profiler->recordCallback(static_cast<uint64_t>(15.0 * ticksPerMs), 480, 48000);
+
+    const auto budget = profiler->budget();
+    EXPECT_EQ(budget.count, 100u);
+    EXPECT_EQ(budget.deadlineMisses, 2u);
+    EXPECT_NEAR(budget.p50, 0.2, 0.2 / 32.0 + 1e-3);
+    EXPECT_NEAR(budget.max, 1.5, 1e-3);
+
+    const auto callback = profiler->summary(Stage::Callback);
+    EXPECT_EQ(callback.count, 100u);
+    EXPECT_NEAR(callback.p50Ns, 2.0e6, 2.0e6 / 32.0 + 1e3);
+    EXPECT_NEAR(callback.maxNs, 15.0e6, 1e3);
+
+    // Period follows the callback size (same 2 ms against a 4 ms period)
+    profiler->reset();
+    profiler->recordCallback(static_cast<uint64_t>(2.0 * ticksPerMs), 192, 48000);
+    EXPECT_NEAR(profiler->budget().max, 0.5, 1e-3);
+    EXPECT_EQ(profiler->budget().deadlineMisses, 0u);
+}
+
+TEST_CASE(lap_chains_stage_boundaries) {
+    auto profiler = std::make_unique<StageProfiler>();
+    profiler->reset();
+
+    const uint64_t start = StageProfiler::now();
+    uint64_t t = profiler->lap(Stage::Input, start);
+    t = profiler->lap(Stage::Dsp, t);
+    EXPECT_TRUE(t >= start);
+    EXPECT_EQ(profiler->summary(Stage::Input).count, 1u);
+    EXPECT_EQ(profiler->summary(Stage::Dsp).count, 1u);
+    EXPECT_EQ(profiler->summary(Stage::AGC).count, 0u);
+    EXPECT_EQ(profiler->summary(Stage::AGC).maxNs, 0.0);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// ==============================================================================
+// 🧪 HOST TEST HARNESS - Minimal, dependency-free (one executable per suite)
+// ==============================================================================
+//
+//   TEST_CASE(wav_roundtrip) {
+//       EXPECT_TRUE(reader.open(path));
+//       EXPECT_NEAR(a, b, 1e-6);
+//   }
+//   SOUNDARCH_TEST_MAIN()
+//
+// Exit code is non-zero if any expectation failed, so ctest picks it up.
+//
+// ==============================================================================
+
+namespace soundarch::testing {
+
+    struct TestCase {
+        const char* name;
+        std::function<void()> body;
+    };
+
+    inline std::vector<TestCase>& registry() {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    inline int& failureCount() {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar {
+        Registrar(const char* name, std::function<void()> body) {
+            registry().push_back({name, std::move(body)});
+        }
+    };
+
+    inline void reportFailure(const char* file, int line, const char* expr) {
+        std::fprintf(stderr, "  ❌ %s:%d: %s\n", file, line, expr);
+        ++failureCount();
+    }
+
+    inline int runAll() {
+        int failedTests = 0;
+        for (const auto& t : registry()) {
+            const int before = failureCount();
+            t.body();
+            const bool passed = failureCount() == before;
+            std::fprintf(stderr, "%s %s\n", passed ? "✅" : "❌", t.name);
+            if (!passed) ++failedTests;
+        }
+        std::fprintf(stderr, "%zu tests, %d failed\n", registry().size(), failedTests);
+        return failedTests == 0 ? 0 : 1;
+    }
+
+} // namespace soundarch::testing
+
+#define TEST_CASE(name)                                                              \
+    static void name();                                                              \
+    static ::soundarch::testing::Registrar registrar_##name(#name, name);           \
+    static void name()
+
+#define EXPECT_TRUE(cond)                                                            \
+    do {                                                                             \
+        if (!(cond)) ::soundarch::testing::reportFailure(__FILE__, __LINE__, #cond); \
+    } while (0)
+
+#define EXPECT_EQ(a, b) EXPECT_TRUE((a) == (b))
+
+#define EXPECT_NEAR(a, b, tol) EXPECT_TRUE(std::fabs(static_cast<double>(a) - static_cast<double>(b)) <= (tol))
+
+#define SOUNDARCH_TEST_MAIN() \
+    int main() { return ::soundarch::testing::runAll(); }
@@ -0,0 +1,182 @@
+// ==============================================================================
+// Trace recorder - per-track rings, rolling window, Chrome JSON, engine events
+// ==============================================================================
+
+#include "TestHarness.h"
+
+#include "CycleCounter.h"
+#include "OboeEngine.h"
+#include "SimulatedBackend.h"
+#include "TraceRecorder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+
+using soundarch::utils::TraceRecorder;
+using soundarch::utils::TraceTrack;
+
+namespace {
+
+    std::string toJson(TraceRecorder& recorder) {
+        char* buffer = nullptr;
+        size_t size = 0;
+        FILE* f = open_memstream(&buffer, &size);
+        recorder.writeChromeTrace(f);
+        std::fclose(f);
+        std::string json(buffer, size);
+        std::free(buffer);
+        return json;
+    }
+
+    size_t occurrences(const std::string& haystack, const std::string& needle) {
+        size_t count = 0;
+        for (size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1)) {
+            ++count;
+        }
+        return count;
+    }
+
+    // Structure check: brackets balance outside strings, document closes
+    bool balanced(const std::string& json) {
+        int depth = 0;
+        bool inString = false;
+        for (char c : json) {
+            if (c == '"') inString = !inString;
+            if (inString) continue;
+            if (c == '{' || c == '[') ++depth;
+            if (c == '}' || c == ']') --depth;
+            if (depth < 0) return false;
+        }
+        return depth == 0 && !inString;
+    }
+
+} // anonymous namespace
+
+TEST_CASE(nothing_is_recorded_until_started) {
+    TraceRecorder recorder;
+    TraceTrack* track = recorder.addTrack("audio");
+    EXPECT_TRUE(track != nullptr);
+    EXPECT_TRUE(!track->enabled());
+
+    track->instant("ignored");
+    EXPECT_TRUE(recorder.start(10.0, false));
+    EXPECT_EQ(recorder.windowEventCount(), 0u);
+
+    track->instant("kept", "value", 7);
+    recorder.stop();
+    track->instant("ignored_again");
+    EXPECT_EQ(recorder.windowEventCount(), 1u);
+}
+
+TEST_CASE(events_serialize_as_chrome_trace) {
+    TraceRecorder recorder;
+    TraceTrack* audio = recorder.addTrack("audio");
+    TraceTrack* telemetry = recorder.addTrack("telemetry");
+    EXPECT_TRUE(recorder.start(10.0, false));
+
+    const uint64_t t0 = soundarch::utils::readCycles();
+    audio->complete("callback", t0, t0 + 1000, "frames", 192, "ring_fill", 384);
+    audio->counter("ring_fill", "samples", 384);
+    audio->instant("xrun_underflow", "count", 1);
+    telemetry->instant("safe_mode_on");
+
+    const std::string json = toJson(recorder);
+    EXPECT_TRUE(balanced(json));
+    EXPECT_EQ(occurrences(json, "\"thread_name\""), 2u);
+    EXPECT_TRUE(json.find("\"name\":\"audio\"") != std::string::npos);
+    EXPECT_TRUE(json.find("\"name\":\"callback\",\"ph\":\"X\",\"pid\":1,\"tid\":1") != std::string::npos);
+    EXPECT_TRUE(json.find("\"args\":{\"frames\":192,\"ring_fill\":384}") != std::string::npos);
+    EXPECT_TRUE(json.find("\"ph\":\"C\"") != std::string::npos);
+    EXPECT_TRUE(json.find("\"name\":\"safe_mode_on\",\"ph\":\"i\",\"pid\":1,\"tid\":2") != std::string::npos);
+    EXPECT_TRUE(json.find("\"dropped_events\":0") != std::string::npos);
+}
+
+TEST_CASE(full_ring_drops_and_counts) {
+    TraceRecorder recorder;
+    TraceTrack* track = recorder.addTrack("audio");
+    EXPECT_TRUE(recorder.start(10.0, false));
+
+    for (size_t i = 0; i < TraceTrack::kCapacity + 100; ++i) track->instant("e");
+    EXPECT_EQ(track->droppedCount(), 100u);
+    EXPECT_EQ(recorder.windowEventCount(), TraceTrack::kCapacity);
+
+    // Drained: room again
+    track->instant("e");
+    EXPECT_EQ(recorder.windowEventCount(), TraceTrack::kCapacity + 1);
+}
+
+TEST_CASE(window_keeps_only_the_last_seconds) {
+    TraceRecorder recorder;
+    TraceTrack* track = recorder.addTrack("audio");
+    EXPECT_TRUE(recorder.start(0.05, false));
+
+    track->instant("old");
+    recorder.drain();
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    track->instant("new");
+
+    EXPECT_EQ(recorder.windowEventCount(), 1u);
+    const std::string json = toJson(recorder);
+    EXPECT_TRUE(json.find("\"old\"") == std::string::npos);
+    EXPECT_TRUE(json.find("\"new\"") != std::string::npos);
+}
+
+TEST_CASE(drain_thread_writes_requested_dump) {
+    TraceRecorder recorder;
+    TraceTrack* track = recorder.addTrack("audio");
+    EXPECT_TRUE(recorder.start(10.0));
+
+    track->instant("marker", "n", 42);
+    const std::string path = "trace_recorder_test_dump.json";
+    recorder.requestDump(path);
+    for (int i = 0; i < 200 && recorder.dumpCount() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(recorder.dumpCount(), 1u);
+    recorder.stop();
+
+    std::string contents;
+    if (FILE* f = std::fopen(path.c_str(), "r")) {
+        char buffer[4096];
+        size_t n;
+        while ((n = std::fread(buffer, 1, sizeof(buffer), f)) > 0) contents.append(buffer, n);
+        std::fclose(f);
+    }
+    std::remove(path.c_str());
+    EXPECT_TRUE(balanced(contents));
+    EXPECT_TRUE(contents.find("\"args\":{\"n\":42}") != std::string::npos);
+}
+
+TEST_CASE(engine_emits_callbacks_stages_and_xruns) {
+    soundarch::audio::SimulatedDeviceConfig config;
+    config.stalls.push_back({0.3, 20.0});
+    auto backend = std::make_unique<soundarch::audio::SimulatedBackend>(config);
+    auto* device = backend.get();
+    OboeEngine engine(std::move(backend));
+    engine.setTelemetryThreadEnabled(false);
+
+    EXPECT_TRUE(engine.start());
+    EXPECT_TRUE(engine.trace().start(3600.0, false));
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(device->advance(0.1));
+        engine.pollTelemetry();
+        engine.trace().drain();
+    }
+    engine.trace().stop();
+
+    const uint64_t callbacks = device->stats().callbacks;
+    const std::string json = toJson(engine.trace());
+    EXPECT_TRUE(balanced(json));
+    EXPECT_EQ(occurrences(json, "\"name\":\"callback\""), callbacks);
+    EXPECT_EQ(occurrences(json, "\"name\":\"input\""), callbacks);
+    EXPECT_EQ(occurrences(json, "\"name\":\"dsp\""), callbacks);
+    EXPECT_TRUE(occurrences(json, "\"name\":\"ring_fill\"") == callbacks);
+    EXPECT_TRUE(occurrences(json, "\"name\":\"xrun_") > 0);            // The stall
+    EXPECT_TRUE(occurrences(json, "\"name\":\"telemetry_poll\"") > 0);
+    EXPECT_EQ(engine.trace().droppedCount(), 0u);
+}
+
+SOUNDARCH_TEST_MAIN()
@@ -0,0 +1,203 @@
+#include "OfflineRenderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#include "utils/Denormals.h"
+
+namespace soundarch::tools {
+
+    namespace {
+
+        using dsp::DSPChain;
+
+        // Same range as setVoiceGain() in native-lib.cpp
+        constexpr float VOICE_GAIN_MIN_DB = -12.0f;
+        constexpr float VOICE_GAIN_MAX_DB = 12.0f;
+
+        template <int Band>
+        void setEqBand(DSPChain& c, float v) { c.setParameter(dsp::eqBandParam(Band), v); }
+
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+        void applyNcPreset(DSPChain& c, float v) {
+            using Preset = dsp::noisecancel::NoiseCancellerParams::Preset;
+            static const Preset presets[] = { Preset::Default, Preset::Voice, Preset::Outdoor, Preset::Office };
+            const int index = std::clamp(static_cast<int>(v), 0, 3);
+            c.applyNoiseCancellerPreset(presets[index]);
+        }
+#endif
+
+        const ParameterSpec kParameters[] = {
+                // AGC
+                { "agc.enabled",         "0/1",                        [](DSPChain& c, float v) { c.setAGCEnabled(v != 0.0f); } },
+                { "agc.target",          "target level (dB)",          [](DSPChain& c, float v) { c.setParameter(dsp::Param::AGCTargetLevel, v); } },
+                { "agc.max_gain",        "max gain (dB)",              [](DSPChain& c, float v) { c.setParameter(dsp::Param::AGCMaxGain, v); } },
+                { "agc.min_gain",        "min gain (dB)",              [](DSPChain& c, float v) { c.setParameter(dsp::Param::AGCMinGain, v); } },
+                { "agc.attack",          "attack (s)",                 [](DSPChain& c, float v) { c.setParameter(dsp::Param::AGCAttackTime, v); } },
+                { "agc.release",         "release (s)",                [](DSPChain& c, float v) { c.setParameter(dsp::Param::AGCReleaseTime, v); } },
+                { "agc.noise_threshold", "noise gate (dB)",            [](DSPChain& c, float v) { c.setParameter(dsp::Param::AGCNoiseThreshold, v); } },
+                { "agc.window",          "RMS window (s)",             [](DSPChain& c, float v) { c.setParameter(dsp::Param::AGCWindowSize, v); } },
+
+                // Equalizer (10 bands, 31.25 Hz → 16 kHz)
+                { "eq.band0", "31.25 Hz gain (dB)", setEqBand<0> },
+                { "eq.band1", "62.5 Hz gain (dB)",  setEqBand<1> },
+                { "eq.band2", "125 Hz gain (dB)",   setEqBand<2> },
+                { "eq.band3", "250 Hz gain (dB)",   setEqBand<3> },
+                { "eq.band4", "500 Hz gain (dB)",   setEqBand<4> },
+                { "eq.band5", "1 kHz gain (dB)",    setEqBand<5> },
+                { "eq.band6", "2 kHz gain (dB)",    setEqBand<6> },
+                { "eq.band7", "4 kHz gain (dB)",    setEqBand<7> },
+                { "eq.band8", "8 kHz gain (dB)",    setEqBand<8> },
+                { "eq.band9", "16 kHz gain (dB)",   setEqBand<9> },
+
+                // Voice Gain
+                { "voice.gain", "post-EQ gain (dB, clamped to ±12)", [](DSPChain& c, float v) {
+                    c.setVoiceGainDb(std::max(VOICE_GAIN_MIN_DB, std::min(VOICE_GAIN_MAX_DB, v)));
+                } },
+
+#if SOUNDARCH_HAS_NOISE_CANCELLER
+                // Noise Canceller
+                { "nc.enabled", "0/1",                                    [](DSPChain& c, float v) { c.setNoiseCancellerEnabled(v != 0.0f); } },
+                { "nc.preset",  "0=Default 1=Voice 2=Outdoor 3=Office",   applyNcPreset },
+#endif
+
+                // Compressor
+                { "comp.enabled",    "0/1",               [](DSPChain& c, float v) { c.setCompressorEnabled(v != 0.0f); } },
+                { "comp.threshold",  "threshold (dB)",    [](DSPChain& c, float v) { c.setParameter(dsp::Param::CompressorThreshold, v); } },
+                { "comp.ratio",      "ratio (x:1)",       [](DSPChain& c, float v) { c.setParameter(dsp::Param::CompressorRatio, v); } },
+                { "comp.attack",     "attack (ms)",       [](DSPChain& c, float v) { c.setParameter(dsp::Param::CompressorAttack, v); } },
+                { "comp.release",    "release (ms)",      [](DSPChain& c, float v) { c.setParameter(dsp::Param::CompressorRelease, v); } },
+                { "comp.knee",       "knee width (dB)",   [](DSPChain& c, float v) { c.setParameter(dsp::Param::CompressorKnee, v); } },
+                { "comp.makeup",     "makeup gain (dB)",  [](DSPChain& c, float v) { c.setParameter(dsp::Param::CompressorMakeupGain, v); } },
+                { "comp.rms",        "0=PEAK 1=RMS detection", [](DSPChain& c, float v) {
+                    c.compressor().setDetectionMode(v != 0.0f ? dsp::DetectionMode::RMS : dsp::DetectionMode::PEAK);
+                } },
+                { "comp.rms_window", "RMS window (ms)",   [](DSPChain& c, float v) { c.compressor().setRMSWindowSize(v); } },
+
+                // Limiter
+                { "limiter.enabled",   "0/1",             [](DSPChain& c, float v) { c.setLimiterEnabled(v != 0.0f); } },
+                { "limiter.threshold", "ceiling (dBFS)",  [](DSPChain& c, float v) { c.setParameter(dsp::Param::LimiterThreshold, v); } },
+                { "limiter.release",   "release (ms)",    [](DSPChain& c, float v) { c.setParameter(dsp::Param::LimiterRelease, v); } },
+                { "limiter.lookahead", "lookahead (ms)",  [](DSPChain& c, float v) { c.setParameter(dsp::Param::LimiterLookahead, v); } },
+        };
+
+        inline float blockPeak(const float* data, size_t n) noexcept {
+            float peak = 0.0f;
+            for (size_t i = 0; i < n; ++i) peak = std::max(peak, std::fabs(data[i]));
+            return peak;
+        }
+
+    } // namespace
+
+    const ParameterSpec* parameterTable(size_t& count) noexcept {
+        count = sizeof(kParameters) / sizeof(kParameters[0]);
+        return kParameters;
+    }
+
+    const ParameterSpec* findParameter(const char* name) noexcept {
+        for (const ParameterSpec& p : kParameters) {
+            if (std::strcmp(p.name, name) == 0) return &p;
+        }
+        return nullptr;
+    }
+
+    bool renderFile(const char* inputPath, const char* outputPath, const RenderConfig& config,
+                    RenderStats& stats, std::string* error) {
+        using Clock = std::chrono::steady_clock;
+        const auto wallStart = Clock::now();
+
+        stats = RenderStats{};
+        if (config.dspBlockFrames <= 0 || config.ioFrames <= 0) {
+            if (error) *error = "block sizes must be positive";
+            return false;
+        }
+
+        WavReader reader;
+        if (!reader.open(inputPath, error)) return false;
+        const WavInfo& info = reader.info();
+
+        WavWriter writer;
+        if (!writer.open(outputPath, info.sampleRate, info.channels, config.outputFormat,
+                         config.forceRF64, error)) {
+            return false;
+        }
+
+        // Same denormal behaviour as the Oboe audio thread
+        soundarch::utils::enableFlushToZero();
+
+        // One chain per channel (the live chain is mono)
+        const float dspRate = config.dspSampleRate > 0.0f ? config.dspSampleRate
+                                                          : static_cast<float>(info.sampleRate);
+        std::vector<std::unique_ptr<DSPChain>> chains;
+        chains.reserve(static_cast<size_t>(info.channels));
+        for (int ch = 0; ch < info.channels; ++ch) {
+            auto chain = std::make_unique<DSPChain>(dspRate);
+            for (const auto& [spec, value] : config.parameters) {
+                spec->apply(*chain, value);
+            }
+            chains.push_back(std::move(chain));
+        }
+
+        dsp::BlockContext ctx;
+        ctx.safeMode = config.safeMode;
+        ctx.sampleRate = info.sampleRate;
+
+        // Bounded working set: one I/O chunk, interleaved + one planar channel.
+        // The chunk is a whole number of DSP blocks, so block boundaries (and
+        // therefore the output) never depend on the I/O size; only the last
+        // block of the file can be short.
+        const size_t dspBlock = static_cast<size_t>(config.dspBlockFrames);
+        const size_t ioFrames = std::max<size_t>(1, static_cast<size_t>(config.ioFrames) / dspBlock) * dspBlock;
+        const size_t channels = static_cast<size_t>(info.channels);
+        std::vector<float> interleaved(ioFrames * channels);
+        std::vector<float> planar(dspBlock);
+
+        Clock::duration dspTime{};
+        bool ok = true;
+        size_t got;
+
+        while ((got = reader.read(interleaved.data(), ioFrames)) > 0) {
+            stats.peakIn = std::max(stats.peakIn, blockPeak(interleaved.data(), got * channels));
+
+            const auto dspStart = Clock::now();
+            for (size_t offset = 0; offset < got; offset += dspBlock) {
+                const size_t n = std::min(dspBlock, got - offset);
+                float* frames = &interleaved[offset * channels];
+
+                for (size_t ch = 0; ch < channels; ++ch) {
+                    float* mono = planar.data();
+                    for (size_t i = 0; i < n; ++i) mono[i] = frames[i * channels + ch];
+                    chains[ch]->processBlock(mono, static_cast<int32_t>(n), ctx);
+                    for (size_t i = 0; i < n; ++i) frames[i * channels + ch] = mono[i];
+                }
+            }
+            dspTime += Clock::now() - dspStart;
+
+            stats.peakOut = std::max(stats.peakOut, blockPeak(interleaved.data(), got * channels));
+            if (!writer.write(interleaved.data(), got)) {
+                ok = false;
+                break;
+            }
+            stats.frames += got;
+        }
+
+        if (!writer.close()) ok = false;
+        if (!ok && error) *error = "write failed (disk full?)";
+        if (ok && stats.frames != info.numFrames && error) {
+            *error = "input truncated: rendered available frames only";
+        }
+
+        stats.channels = info.channels;
+        stats.sampleRate = info.sampleRate;
+        stats.audioSeconds = static_cast<double>(stats.frames) / info.sampleRate;
+        stats.wallSeconds = std::chrono::duration<double>(Clock::now() - wallStart).count();
+        stats.dspSeconds = std::chrono::duration<double>(dspTime).count();
+        stats.realtimeFactor = stats.wallSeconds > 0.0 ? stats.audioSeconds / stats.wallSeconds : 0.0;
+        stats.dspRealtimeFactor = stats.dspSeconds > 0.0 ? stats.audioSeconds / stats.dspSeconds : 0.0;
+        return ok;
+    }
+
+} // namespace soundarch::tools
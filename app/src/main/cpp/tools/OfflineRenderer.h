@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "WavFile.h"
+#include "dsp/DSPChain.h"
+
+namespace soundarch::tools {
+
+// ==============================================================================
+// 🎞️ OFFLINE RENDERER - Full DSP chain over files, faster than real time
+// ==============================================================================
+//
+// Streams a WAV/RF64 file through dsp::DSPChain (the same object the Oboe
+// callback uses) and writes the result, with memory bounded by ioFrames
+// regardless of file length.
+//
+// Bit-exact device reproduction:
+//   - Same chain, same production defaults, same parameter setters as JNI
+//   - dspBlockFrames = device callback size (Oboe framesPerBurst), so that
+//     per-block work (parameter snapshots, the EQ filter-set swap) lands on
+//     the same sample boundaries as on the phone
+//   - dspSampleRate = rate the live chain was built with (48000 in
+//     native-lib.cpp), independent of the file rate
+//   - FTZ/DAZ enabled on the rendering thread, like the audio thread
+//   - Mono per chain: multichannel files get one independent chain per channel
+//
+// ==============================================================================
+
+    /**
+     * Named parameter → DSPChain setter (same setters as the JNI entry points).
+     * Names are "<module>.<param>", e.g. "agc.target", "comp.ratio", "eq.band3".
+     */
+    struct ParameterSpec {
+        const char* name;
+        const char* help;
+        void (*apply)(dsp::DSPChain& chain, float value);
+    };
+
+    const ParameterSpec* parameterTable(size_t& count) noexcept;
+    const ParameterSpec* findParameter(const char* name) noexcept;
+
+    struct RenderConfig {
+        int dspBlockFrames = 192;        // Frames per DSPChain::processBlock() call
+        int ioFrames = 65536;            // Frames per file read/write (bounds memory)
+        float dspSampleRate = 0.0f;      // 0 = use the input file rate
+        bool safeMode = false;           // Bluetooth Safe Mode (limiter only)
+        SampleFormat outputFormat = SampleFormat::Float32;
+        bool forceRF64 = false;
+
+        // Applied in order after the production defaults
+        std::vector<std::pair<const ParameterSpec*, float>> parameters;
+    };
+
+    struct RenderStats {
+        uint64_t frames = 0;
+        int channels = 0;
+        int sampleRate = 0;
+        double audioSeconds = 0.0;
+        double wallSeconds = 0.0;       // Everything (I/O + DSP)
+        double dspSeconds = 0.0;        // Inside DSPChain::processBlock() only
+        double realtimeFactor = 0.0;    // audioSeconds / wallSeconds
+        double dspRealtimeFactor = 0.0; // audioSeconds / dspSeconds
+        float peakIn = 0.0f;
+        float peakOut = 0.0f;
+    };
+
+    bool renderFile(const char* inputPath, const char* outputPath, const RenderConfig& config,
+                    RenderStats& stats, std::string* error = nullptr);
+
+} // namespace soundarch::tools
@@ -0,0 +1,200 @@
+// ==============================================================================
+// SoundArch Offline Renderer - run the live DSP chain over WAV/RF64 files
+// ==============================================================================
+//
+// Processes a file through dsp::DSPChain as fast as the CPU allows and
+// reports throughput. With --block set to the device callback size and
+// --dsp-rate 48000 the output matches what the phone produced for the same
+// input and settings, sample for sample.
+//
+//   soundarch_render in.wav out.wav --block 192 --set comp.ratio=6 --json report.json
+//
+// Report (stderr, or JSON with --json):
+//   {
+//     "schema": "soundarch-render/1",
+//     "frames": 4320000, "channels": 1, "sample_rate": 48000,
+//     "audio_seconds": 90.0, "wall_seconds": 0.41, "dsp_seconds": 0.33,
+//     "realtime_factor": 219.5, "dsp_realtime_factor": 272.7, ...
+//   }
+//
+// Usage:
+//   soundarch_render INPUT OUTPUT [--block N] [--io-frames N] [--dsp-rate HZ]
+//                    [--safe-mode] [--format s16|s24|s32|f32|f64] [--rf64]
+//                    [--set NAME=VALUE]... [--eq G0,G1,...,G9]
+//                    [--json FILE] [--verbose] [--list-params]
+//
+// ==============================================================================
+
+#include "OfflineRenderer.h"
+
+#include "bench/BenchmarkHarness.h"
+#include "utils/Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace soundarch;
+
+namespace {
+
+    struct Options {
+        const char* input = nullptr;
+        const char* output = nullptr;
+        const char* json = nullptr;
+        bool listParams = false;
+        bool verbose = false;
+        tools::RenderConfig config;
+    };
+
+    void printUsage(const char* argv0) {
+        std::fprintf(stderr,
+                     "Usage: %s INPUT OUTPUT [--block N] [--io-frames N] [--dsp-rate HZ]\n"
+                     "          [--safe-mode] [--format s16|s24|s32|f32|f64] [--rf64]\n"
+                     "          [--set NAME=VALUE]... [--eq G0,G1,...,G9]\n"
+                     "          [--json FILE] [--verbose] [--list-params]\n", argv0);
+    }
+
+    bool addParameter(Options& opt, const char* name, float value) {
+        const tools::ParameterSpec* spec = tools::findParameter(name);
+        if (!spec) {
+            std::fprintf(stderr, "Unknown parameter '%s' (see --list-params)\n", name);
+            return false;
+        }
+        opt.config.parameters.emplace_back(spec, value);
+        return true;
+    }
+
+    bool parseSet(Options& opt, const char* arg) {
+        const char* eq = std::strchr(arg, '=');
+        if (!eq || eq == arg) return false;
+        const std::string name(arg, static_cast<size_t>(eq - arg));
+        char* end = nullptr;
+        const float value = std::strtof(eq + 1, &end);
+        if (end == eq + 1 || *end != '\0') return false;
+        return addParameter(opt, name.c_str(), value);
+    }
+
+    bool parseEq(Options& opt, const char* arg) {
+        const char* p = arg;
+        for (int band = 0; band < dsp::Equalizer::kNumBands; ++band) {
+            char* end = nullptr;
+            const float gain = std::strtof(p, &end);
+            if (end == p) return false;
+            char name[16];
+            std::snprintf(name, sizeof(name), "eq.band%d", band);
+            if (!addParameter(opt, name, gain)) return false;
+            if (band + 1 < dsp::Equalizer::kNumBands) {
+                if (*end != ',') return false;
+                p = end + 1;
+            } else if (*end != '\0') {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            const char* a = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (!std::strcmp(a, "--block") && hasValue) opt.config.dspBlockFrames = std::atoi(argv[++i]);
+            else if (!std::strcmp(a, "--io-frames") && hasValue) opt.config.ioFrames = std::atoi(argv[++i]);
+            else if (!std::strcmp(a, "--dsp-rate") && hasValue) opt.config.dspSampleRate = static_cast<float>(std::atof(argv[++i]));
+            else if (!std::strcmp(a, "--json") && hasValue) opt.json = argv[++i];
+            else if (!std::strcmp(a, "--safe-mode")) opt.config.safeMode = true;
+            else if (!std::strcmp(a, "--rf64")) opt.config.forceRF64 = true;
+            else if (!std::strcmp(a, "--verbose")) opt.verbose = true;
+            else if (!std::strcmp(a, "--list-params")) opt.listParams = true;
+            else if (!std::strcmp(a, "--format") && hasValue) {
+                if (!tools::parseSampleFormat(argv[++i], opt.config.outputFormat)) return false;
+            } else if (!std::strcmp(a, "--set") && hasValue) {
+                if (!parseSet(opt, argv[++i])) return false;
+            } else if (!std::strcmp(a, "--eq") && hasValue) {
+                if (!parseEq(opt, argv[++i])) return false;
+            } else if (a[0] != '-' && !opt.input) {
+                opt.input = a;
+            } else if (a[0] != '-' && !opt.output) {
+                opt.output = a;
+            } else {
+                return false;
+            }
+        }
+        if (opt.listParams) return true;
+        return opt.input && opt.output && opt.config.dspBlockFrames > 0 && opt.config.ioFrames > 0;
+    }
+
+    void writeReport(FILE* out, const Options& opt, const tools::RenderStats& s) {
+        bench::JsonWriter json(out);
+        json.beginObject();
+        json.field("schema", "soundarch-render/1");
+        json.beginObject("host");
+        json.field("arch", bench::hostArchitecture());
+        json.field("compiler", bench::compilerId());
+        json.endObject();
+        json.field("input", opt.input);
+        json.field("output", opt.output);
+        json.field("format", tools::toString(opt.config.outputFormat));
+        json.field("block_frames", opt.config.dspBlockFrames);
+        json.field("io_frames", opt.config.ioFrames);
+        json.field("safe_mode", opt.config.safeMode);
+        json.field("noise_canceller_available", dsp::DSPChain::hasNoiseCanceller());
+        json.field("frames", static_cast<uint64_t>(s.frames));
+        json.field("channels", s.channels);
+        json.field("sample_rate", s.sampleRate);
+        json.field("audio_seconds", s.audioSeconds);
+        json.field("wall_seconds", s.wallSeconds);
+        json.field("dsp_seconds", s.dspSeconds);
+        json.field("realtime_factor", s.realtimeFactor);
+        json.field("dsp_realtime_factor", s.dspRealtimeFactor);
+        json.field("peak_in_dbfs", 20.0 * std::log10(std::max(1e-10, static_cast<double>(s.peakIn))));
+        json.field("peak_out_dbfs", 20.0 * std::log10(std::max(1e-10, static_cast<double>(s.peakOut))));
+        json.endObject();
+        json.finish();
+    }
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (opt.listParams) {
+        size_t count = 0;
+        const tools::ParameterSpec* params = tools::parameterTable(count);
+        for (size_t i = 0; i < count; ++i) std::printf("%-20s %s\n", params[i].name, params[i].help);
+        return 0;
+    }
+
+    if (opt.verbose) log::setHostLogLevel(log::Info);
+
+    tools::RenderStats stats;
+    std::string error;
+    const bool ok = tools::renderFile(opt.input, opt.output, opt.config, stats, &error);
+    if (!ok) {
+        std::fprintf(stderr, "❌ %s: %s\n", opt.input, error.c_str());
+        return 1;
+    }
+    if (!error.empty()) std::fprintf(stderr, "⚠️ %s\n", error.c_str());
+
+    std::fprintf(stderr, "✅ %llu frames x %d ch @ %d Hz (%.1fs audio) in %.3fs → %.1fx realtime (DSP only: %.1fx)\n",
+                 static_cast<unsigned long long>(stats.frames), stats.channels, stats.sampleRate,
+                 stats.audioSeconds, stats.wallSeconds, stats.realtimeFactor, stats.dspRealtimeFactor);
+
+    if (opt.json) {
+        FILE* out = std::strcmp(opt.json, "-") == 0 ? stdout : std::fopen(opt.json, "w");
+        if (!out) {
+            std::fprintf(stderr, "Cannot open %s\n", opt.json);
+            return 1;
+        }
+        writeReport(out, opt, stats);
+        if (out != stdout) std::fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,444 @@
+#include "WavFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace soundarch::tools {
+
+    namespace {
+
+        constexpr uint16_t WAVE_FORMAT_PCM = 0x0001;
+        constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+        constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+        constexpr uint32_t RIFF_SIZE_MAX = 0xFFFFFFFFu;
+        constexpr uint32_t DS64_PAYLOAD = 28;   // riffSize(8) + dataSize(8) + sampleCount(8) + tableLength(4)
+
+        // Stream buffer for the FILE* (I/O is chunked by the caller anyway)
+        constexpr size_t STDIO_BUFFER_BYTES = 1 << 20;
+
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+        // Little-endian helpers (WAV is LE regardless of host)
+        // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+        inline uint16_t readLE16(const uint8_t* p) noexcept {
+            return static_cast<uint16_t>(p[0] | (p[1] << 8));
+        }
+
+        inline uint32_t readLE32(const uint8_t* p) noexcept {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        inline uint64_t readLE64(const uint8_t* p) noexcept {
+            return static_cast<uint64_t>(readLE32(p)) | (static_cast<uint64_t>(readLE32(p + 4)) << 32);
+        }
+
+        inline void putLE16(uint8_t* p, uint16_t v) noexcept {
+            p[0] = static_cast<uint8_t>(v);
+            p[1] = static_cast<uint8_t>(v >> 8);
+        }
+
+        inline void putLE32(uint8_t* p, uint32_t v) noexcept {
+            for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+        }
+
+        inline void putLE64(uint8_t* p, uint64_t v) noexcept {
+            for (int i = 0; i < 8; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+        }
+
+        bool writeBytes(FILE* f, const void* data, size_t size) {
+            return std::fwrite(data, 1, size, f) == size;
+        }
+
+        bool writeU32(FILE* f, uint32_t v) {
+            uint8_t b[4];
+            putLE32(b, v);
+            return writeBytes(f, b, 4);
+        }
+
+        bool writeU64(FILE* f, uint64_t v) {
+            uint8_t b[8];
+            putLE64(b, v);
+            return writeBytes(f, b, 8);
+        }
+
+        bool seekTo(FILE* f, int64_t offset) {
+            return fseeko(f, static_cast<off_t>(offset), SEEK_SET) == 0;
+        }
+
+        inline int32_t toFixed(float x, float scale, int32_t lo, int32_t hi) noexcept {
+            const double v = std::nearbyint(static_cast<double>(x) * scale);
+            return static_cast<int32_t>(std::clamp(v, static_cast<double>(lo), static_cast<double>(hi)));
+        }
+
+    } // namespace
+
+    const char* toString(SampleFormat format) noexcept {
+        switch (format) {
+            case SampleFormat::Int16:   return "s16";
+            case SampleFormat::Int24:   return "s24";
+            case SampleFormat::Int32:   return "s32";
+            case SampleFormat::Float32: return "f32";
+            case SampleFormat::Float64: return "f64";
+        }
+        return "?";
+    }
+
+    bool parseSampleFormat(const char* text, SampleFormat& format) noexcept {
+        static const SampleFormat all[] = {
+                SampleFormat::Int16, SampleFormat::Int24, SampleFormat::Int32,
+                SampleFormat::Float32, SampleFormat::Float64
+        };
+        for (SampleFormat f : all) {
+            if (std::strcmp(text, toString(f)) == 0) {
+                format = f;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int bytesPerSample(SampleFormat format) noexcept {
+        switch (format) {
+            case SampleFormat::Int16:   return 2;
+            case SampleFormat::Int24:   return 3;
+            case SampleFormat::Int32:   return 4;
+            case SampleFormat::Float32: return 4;
+            case SampleFormat::Float64: return 8;
+        }
+        return 0;
+    }
+
+    // ==============================================================================
+    // 📖 READER
+    // ==============================================================================
+
+    WavReader::~WavReader() {
+        close();
+    }
+
+    void WavReader::close() noexcept {
+        if (file_) {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+        framesRemaining_ = 0;
+    }
+
+    bool WavReader::fail(std::string* error, const char* message) {
+        if (error) *error = message;
+        close();
+        return false;
+    }
+
+    bool WavReader::open(const char* path, std::string* error) {
+        close();
+        info_ = WavInfo{};
+
+        file_ = std::fopen(path, "rb");
+        if (!file_) return fail(error, "cannot open input file");
+        std::setvbuf(file_, nullptr, _IOFBF, STDIO_BUFFER_BYTES);
+
+        uint8_t header[12];
+        if (std::fread(header, 1, 12, file_) != 12) return fail(error, "truncated header");
+
+        const bool isRiff = std::memcmp(header, "RIFF", 4) == 0;
+        const bool isRf64 = std::memcmp(header, "RF64", 4) == 0 || std::memcmp(header, "BW64", 4) == 0;
+        if ((!isRiff && !isRf64) || std::memcmp(header + 8, "WAVE", 4) != 0) {
+            return fail(error, "not a RIFF/RF64 WAVE file");
+        }
+        info_.rf64 = isRf64;
+
+        uint64_t ds64DataSize = 0;
+        bool haveFmt = false;
+        uint16_t formatTag = 0;
+        uint16_t bitsPerSample = 0;
+        uint16_t blockAlign = 0;
+        uint64_t dataSize = 0;
+
+        // Walk chunks until "data" (streamed: never seek past the payload)
+        for (;;) {
+            uint8_t chunk[8];
+            if (std::fread(chunk, 1, 8, file_) != 8) return fail(error, "no data chunk");
+            const uint32_t size = readLE32(chunk + 4);
+
+            if (std::memcmp(chunk, "data", 4) == 0) {
+                if (!haveFmt) return fail(error, "data chunk before fmt chunk");
+                dataSize = size;
+                if (info_.rf64 && size == RIFF_SIZE_MAX) dataSize = ds64DataSize;
+                break;
+            }
+
+            if (std::memcmp(chunk, "ds64", 4) == 0 || std::memcmp(chunk, "fmt ", 4) == 0) {
+                if (size < 16 || size > 256) return fail(error, "malformed ds64/fmt chunk");
+                uint8_t body[256];
+                if (std::fread(body, 1, size, file_) != size) return fail(error, "truncated chunk");
+                if (size & 1u) std::fgetc(file_);
+
+                if (chunk[0] == 'd') {
+                    ds64DataSize = readLE64(body + 8);
+                    continue;
+                }
+
+                formatTag = readLE16(body);
+                info_.channels = readLE16(body + 2);
+                info_.sampleRate = static_cast<int>(readLE32(body + 4));
+                blockAlign = readLE16(body + 12);
+                bitsPerSample = readLE16(body + 14);
+                if (formatTag == WAVE_FORMAT_EXTENSIBLE) {
+                    if (size < 40) return fail(error, "malformed WAVE_FORMAT_EXTENSIBLE");
+                    formatTag = readLE16(body + 24);  // SubFormat GUID, first two bytes
+                }
+                haveFmt = true;
+                continue;
+            }
+
+            // Skip unknown chunk (LIST, JUNK, fact, bext, ...) with pad byte
+            const int64_t skip = static_cast<int64_t>(size) + (size & 1u);
+            if (fseeko(file_, static_cast<off_t>(skip), SEEK_CUR) != 0) return fail(error, "seek failed");
+        }
+
+        if (formatTag == WAVE_FORMAT_PCM && bitsPerSample == 16) info_.format = SampleFormat::Int16;
+        else if (formatTag == WAVE_FORMAT_PCM && bitsPerSample == 24) info_.format = SampleFormat::Int24;
+        else if (formatTag == WAVE_FORMAT_PCM && bitsPerSample == 32) info_.format = SampleFormat::Int32;
+        else if (formatTag == WAVE_FORMAT_IEEE_FLOAT && bitsPerSample == 32) info_.format = SampleFormat::Float32;
+        else if (formatTag == WAVE_FORMAT_IEEE_FLOAT && bitsPerSample == 64) info_.format = SampleFormat::Float64;
+        else return fail(error, "unsupported sample format (PCM 16/24/32 or float 32/64 only)");
+
+        if (info_.channels <= 0 || info_.sampleRate <= 0 ||
+            blockAlign != info_.channels * bytesPerSample(info_.format)) {
+            return fail(error, "inconsistent fmt chunk");
+        }
+
+        // blockAlign vérifié non nul ci-dessus
+        info_.numFrames = dataSize / blockAlign;
+        framesRemaining_ = info_.numFrames;
+        return true;
+    }
+
+    size_t WavReader::read(float* interleaved, size_t maxFrames) {
+        if (!file_ || framesRemaining_ == 0) return 0;
+
+        const size_t frames = static_cast<size_t>(std::min<uint64_t>(maxFrames, framesRemaining_));
+        const size_t bps = static_cast<size_t>(bytesPerSample(info_.format));
+        const size_t samples = frames * static_cast<size_t>(info_.channels);
+        raw_.resize(samples * bps);
+
+        const size_t got = std::fread(raw_.data(), 1, raw_.size(), file_);
+        const size_t gotFrames = got / (bps * static_cast<size_t>(info_.channels));
+        const size_t n = gotFrames * static_cast<size_t>(info_.channels);
+        const uint8_t* p = raw_.data();
+
+        switch (info_.format) {
+            case SampleFormat::Int16:
+                for (size_t i = 0; i < n; ++i, p += 2) {
+                    interleaved[i] = static_cast<float>(static_cast<int16_t>(readLE16(p))) * (1.0f / 32768.0f);
+                }
+                break;
+            case SampleFormat::Int24:
+                for (size_t i = 0; i < n; ++i, p += 3) {
+                    const int32_t v = static_cast<int32_t>(
+                            (static_cast<uint32_t>(p[0]) << 8) | (static_cast<uint32_t>(p[1]) << 16) |
+                            (static_cast<uint32_t>(p[2]) << 24)) >> 8;
+                    interleaved[i] = static_cast<float>(v) * (1.0f / 8388608.0f);
+                }
+                break;
+            case SampleFormat::Int32:
+                for (size_t i = 0; i < n; ++i, p += 4) {
+                    interleaved[i] = static_cast<float>(
+                            static_cast<double>(static_cast<int32_t>(readLE32(p))) * (1.0 / 2147483648.0));
+                }
+                break;
+            case SampleFormat::Float32:
+                for (size_t i = 0; i < n; ++i, p += 4) {
+                    const uint32_t bits = readLE32(p);
+                    std::memcpy(&interleaved[i], &bits, sizeof(float));
+                }
+                break;
+            case SampleFormat::Float64:
+                for (size_t i = 0; i < n; ++i, p += 8) {
+                    const uint64_t bits = readLE64(p);
+                    double d;
+                    std::memcpy(&d, &bits, sizeof(double));
+                    interleaved[i] = static_cast<float>(d);
+                }
+                break;
+        }
+
+        // Short read = truncated file: stop cleanly at the last whole frame
+        framesRemaining_ = (gotFrames == frames) ? framesRemaining_ - frames : 0;
+        return gotFrames;
+    }
+
+    // ==============================================================================
+    // ✍️ WRITER
+    // ==============================================================================
+    //
+    // Layout (offsets fixed at open()):
+    //   RIFF|RF64 <size32> WAVE
+    //   JUNK|ds64 <28>     riffSize64 dataSize64 sampleCount64 tableLength32
+    //   fmt        <16|18> ...
+    //   fact       <4>     sampleFrames32          (float formats only)
+    //   data       <size32> samples...
+    //
+    // ==============================================================================
+
+    WavWriter::~WavWriter() {
+        close();
+    }
+
+    bool WavWriter::open(const char* path, int sampleRate, int channels, SampleFormat format,
+                         bool forceRF64, std::string* error) {
+        close();
+
+        if (channels <= 0 || sampleRate <= 0) {
+            if (error) *error = "invalid channel count or sample rate";
+            return false;
+        }
+
+        file_ = std::fopen(path, "wb");
+        if (!file_) {
+            if (error) *error = "cannot open output file";
+            return false;
+        }
+        std::setvbuf(file_, nullptr, _IOFBF, STDIO_BUFFER_BYTES);
+
+        channels_ = channels;
+        format_ = format;
+        forceRF64_ = forceRF64;
+        ioError_ = false;
+        framesWritten_ = 0;
+
+        const bool isFloat = format == SampleFormat::Float32 || format == SampleFormat::Float64;
+        const uint16_t bits = static_cast<uint16_t>(bytesPerSample(format) * 8);
+        const uint16_t blockAlign = static_cast<uint16_t>(channels * bytesPerSample(format));
+
+        bool ok = writeBytes(file_, "RIFF", 4) && writeU32(file_, 0) && writeBytes(file_, "WAVE", 4);
+
+        // Placeholder for ds64 (becomes RF64 on close() if needed)
+        uint8_t junk[DS64_PAYLOAD] = {};
+        ok = ok && writeBytes(file_, "JUNK", 4) && writeU32(file_, DS64_PAYLOAD) && writeBytes(file_, junk, DS64_PAYLOAD);
+
+        uint8_t fmt[18] = {};
+        putLE16(fmt, isFloat ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM);
+        putLE16(fmt + 2, static_cast<uint16_t>(channels));
+        putLE32(fmt + 4, static_cast<uint32_t>(sampleRate));
+        putLE32(fmt + 8, static_cast<uint32_t>(sampleRate) * blockAlign);
+        putLE16(fmt + 12, blockAlign);
+        putLE16(fmt + 14, bits);
+        const uint32_t fmtSize = isFloat ? 18 : 16;  // cbSize = 0 for non-PCM
+        ok = ok && writeBytes(file_, "fmt ", 4) && writeU32(file_, fmtSize) && writeBytes(file_, fmt, fmtSize);
+
+        factSizeOffset_ = -1;
+        if (isFloat) {
+            ok = ok && writeBytes(file_, "fact", 4) && writeU32(file_, 4);
+            factSizeOffset_ = ok ? static_cast<int64_t>(ftello(file_)) : -1;
+            ok = ok && writeU32(file_, 0);
+        }
+
+        ok = ok && writeBytes(file_, "data", 4);
+        dataSizeOffset_ = ok ? static_cast<int64_t>(ftello(file_)) : 0;
+        ok = ok && writeU32(file_, 0);
+        dataStart_ = ok ? static_cast<int64_t>(ftello(file_)) : 0;
+
+        if (!ok) {
+            if (error) *error = "failed to write WAV header";
+            std::fclose(file_);
+            file_ = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    bool WavWriter::write(const float* interleaved, size_t frames) {
+        if (!file_ || ioError_) return false;
+
+        const size_t bps = static_cast<size_t>(bytesPerSample(format_));
+        const size_t n = frames * static_cast<size_t>(channels_);
+        raw_.resize(n * bps);
+        uint8_t* p = raw_.data();
+
+        switch (format_) {
+            case SampleFormat::Int16:
+                for (size_t i = 0; i < n; ++i, p += 2) {
+                    putLE16(p, static_cast<uint16_t>(toFixed(interleaved[i], 32768.0f, -32768, 32767)));
+                }
+                break;
+            case SampleFormat::Int24:
+                for (size_t i = 0; i < n; ++i, p += 3) {
+                    const uint32_t v = static_cast<uint32_t>(toFixed(interleaved[i], 8388608.0f, -8388608, 8388607));
+                    p[0] = static_cast<uint8_t>(v);
+                    p[1] = static_cast<uint8_t>(v >> 8);
+                    p[2] = static_cast<uint8_t>(v >> 16);
+                }
+                break;
+            case SampleFormat::Int32:
+                for (size_t i = 0; i < n; ++i, p += 4) {
+                    const double v = std::nearbyint(static_cast<double>(interleaved[i]) * 2147483648.0);
+                    putLE32(p, static_cast<uint32_t>(static_cast<int32_t>(
+                            std::clamp(v, -2147483648.0, 2147483647.0))));
+                }
+                break;
+            case SampleFormat::Float32:
+                for (size_t i = 0; i < n; ++i, p += 4) {
+                    uint32_t bits;
+                    std::memcpy(&bits, &interleaved[i], sizeof(float));
+                    putLE32(p, bits);
+                }
+                break;
+            case SampleFormat::Float64:
+                for (size_t i = 0; i < n; ++i, p += 8) {
+                    const double d = interleaved[i];
+                    uint64_t bits;
+                    std::memcpy(&bits, &d, sizeof(double));
+                    putLE64(p, bits);
+                }
+                break;
+        }
+
+        if (!writeBytes(file_, raw_.data(), raw_.size())) {
+            ioError_ = true;
+            return false;
+        }
+        framesWritten_ += frames;
+        return true;
+    }
+
+    bool WavWriter::close() {
+        if (!file_) return !ioError_;
+
+        const uint64_t dataBytes = framesWritten_ * static_cast<uint64_t>(channels_ * bytesPerSample(format_));
+        bool ok = !ioError_;
+
+        // Pad byte keeps the chunk list word-aligned (not counted in data size)
+        if (dataBytes & 1u) ok = ok && std::fputc(0, file_) != EOF;
+
+        const uint64_t riffSize = static_cast<uint64_t>(dataStart_) + dataBytes + (dataBytes & 1u) - 8;
+        const bool rf64 = forceRF64_ || riffSize > RIFF_SIZE_MAX;
+
+        if (rf64) {
+            ok = ok && seekTo(file_, 0) && writeBytes(file_, "RF64", 4) && writeU32(file_, RIFF_SIZE_MAX);
+            ok = ok && seekTo(file_, 12) && writeBytes(file_, "ds64", 4) && writeU32(file_, DS64_PAYLOAD);
+            ok = ok && writeU64(file_, riffSize) && writeU64(file_, dataBytes) &&
+                 writeU64(file_, framesWritten_) && writeU32(file_, 0);
+            ok = ok && seekTo(file_, dataSizeOffset_) && writeU32(file_, RIFF_SIZE_MAX);
+        } else {
+            ok = ok && seekTo(file_, 4) && writeU32(file_, static_cast<uint32_t>(riffSize));
+            ok = ok && seekTo(file_, dataSizeOffset_) && writeU32(file_, static_cast<uint32_t>(dataBytes));
+        }
+
+        if (factSizeOffset_ >= 0) {
+            const uint32_t fact = framesWritten_ > RIFF_SIZE_MAX ? RIFF_SIZE_MAX
+                                                                 : static_cast<uint32_t>(framesWritten_);
+            ok = ok && seekTo(file_, factSizeOffset_) && writeU32(file_, fact);
+        }
+
+        ok = (std::fclose(file_) == 0) && ok;
+        file_ = nullptr;
+        ioError_ = !ok;
+        return ok;
+    }
+
+} // namespace soundarch::tools
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace soundarch::tools {
+
+// ==============================================================================
+// 💾 STREAMING WAV / RF64 I/O - bounded buffers, files of any length
+// ==============================================================================
+//
+// Reader:
+//   - RIFF/WAVE, RF64 and BW64 (ds64 chunk for >4 GB payloads)
+//   - PCM 16/24/32-bit, IEEE float 32/64-bit, WAVE_FORMAT_EXTENSIBLE
+//   - read() converts to interleaved float in caller-sized chunks; memory
+//     use is bounded by the chunk size, never by the file length
+//
+// Writer:
+//   - Reserves a JUNK chunk the size of ds64 up front, so a file that grows
+//     past 4 GB is promoted to RF64 in place on close() (EBU Tech 3306)
+//   - float32 (bit-exact DSP output) or PCM 16/24/32 with rounding + clipping
+//
+// Host tools only (offline renderer, tests): allocates freely.
+//
+// ==============================================================================
+
+    enum class SampleFormat {
+        Int16,
+        Int24,
+        Int32,
+        Float32,
+        Float64
+    };
+
+    const char* toString(SampleFormat format) noexcept;
+    bool parseSampleFormat(const char* text, SampleFormat& format) noexcept;
+    int bytesPerSample(SampleFormat format) noexcept;
+
+    struct WavInfo {
+        int sampleRate = 0;
+        int channels = 0;
+        SampleFormat format = SampleFormat::Float32;
+        uint64_t numFrames = 0;
+        bool rf64 = false;
+    };
+
+    class WavReader {
+    public:
+        WavReader() = default;
+        ~WavReader();
+
+        WavReader(const WavReader&) = delete;
+        WavReader& operator=(const WavReader&) = delete;
+
+        bool open(const char* path, std::string* error = nullptr);
+        void close() noexcept;
+
+        const WavInfo& info() const noexcept { return info_; }
+        uint64_t framesRemaining() const noexcept { return framesRemaining_; }
+
+        /**
+         * Reads up to maxFrames interleaved frames, converted to float.
+         * @return Frames read (0 at end of data or on I/O error)
+         */
+        size_t read(float* interleaved, size_t maxFrames);
+
+    private:
+        bool fail(std::string* error, const char* message);
+
+        FILE* file_ = nullptr;
+        WavInfo info_{};
+        uint64_t framesRemaining_ = 0;
+        std::vector<uint8_t> raw_;
+    };
+
+    class WavWriter {
+    public:
+        WavWriter() = default;
+        ~WavWriter();
+
+        WavWriter(const WavWriter&) = delete;
+        WavWriter& operator=(const WavWriter&) = delete;
+
+        /**
+         * @param forceRF64 Always write an RF64 header (default: only when > 4 GB)
+         */
+        bool open(const char* path, int sampleRate, int channels, SampleFormat format,
+                  bool forceRF64 = false, std::string* error = nullptr);
+
+        bool write(const float* interleaved, size_t frames);
+
+        // Finalizes chunk sizes (RIFF or RF64). Returns false on I/O error.
+        bool close();
+
+        uint64_t framesWritten() const noexcept { return framesWritten_; }
+
+    private:
+        FILE* file_ = nullptr;
+        int channels_ = 0;
+        SampleFormat format_ = SampleFormat::Float32;
+        bool forceRF64_ = false;
+        bool ioError_ = false;
+        uint64_t framesWritten_ = 0;
+        int64_t factSizeOffset_ = -1;
+        int64_t dataSizeOffset_ = 0;
+        int64_t dataStart_ = 0;
+        std::vector<uint8_t> raw_;
+    };
+
+} // namespace soundarch::tools
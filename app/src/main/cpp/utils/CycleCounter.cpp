@@ -0,0 +1,42 @@
+#include "CycleCounter.h"
+#include <atomic>
+#include <chrono>
+
+namespace soundarch::utils {
+
+    namespace {
+
+        // Measured once per process (0 = not yet)
+        std::atomic<double> gFrequency{0.0};
+
+        double measureFrequency() noexcept {
+#if defined(__aarch64__)
+            uint64_t frequency;
+            __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+            return static_cast<double>(frequency);
+#elif defined(__x86_64__) || defined(__i386__)
+            using Clock = std::chrono::steady_clock;
+            const auto t0 = Clock::now();
+            const uint64_t c0 = readCycles();
+            while (Clock::now() - t0 < std::chrono::milliseconds(10)) {
+            }
+            const uint64_t c1 = readCycles();
+            const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+            return static_cast<double>(c1 - c0) / seconds;
+#else
+            return 1e9;   // CLOCK_MONOTONIC nanoseconds
+#endif
+        }
+
+    } // anonymous namespace
+
+    double cycleCounterFrequency() noexcept {
+        double frequency = gFrequency.load(std::memory_order_relaxed);
+        if (frequency <= 0.0) {
+            frequency = measureFrequency();
+            gFrequency.store(frequency, std::memory_order_relaxed);
+        }
+        return frequency;
+    }
+
+} // namespace soundarch::utils
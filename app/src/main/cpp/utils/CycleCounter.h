@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <ctime>
+#endif
+
+// ==============================================================================
+// ⏱️ CYCLE COUNTER - Cheapest monotonic timestamp on the audio thread
+// ==============================================================================
+//
+//   - ARM64:  CNTVCT_EL0 (generic timer, fixed frequency from CNTFRQ_EL0,
+//             readable from user space on every Android device)
+//   - x86-64: RDTSC (invariant TSC on any CPU that runs Android emulators or CI)
+//   - Other:  CLOCK_MONOTONIC in nanoseconds
+//
+// readCycles() is a single instruction (or a vDSO call), no syscall, RT-safe.
+// Ticks are converted to time on the reader side with cycleCounterFrequency().
+//
+// ==============================================================================
+
+namespace soundarch::utils {
+
+    inline uint64_t readCycles() noexcept {
+#if defined(__aarch64__)
+        uint64_t ticks;
+        __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r"(ticks) : : "memory");
+        return ticks;
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+    }
+
+    /**
+     * Ticks per second of readCycles(). The first call on x86 calibrates the
+     * TSC against CLOCK_MONOTONIC (~10 ms): call it from a control thread
+     * (OboeEngine::start()) before the audio thread needs it.
+     */
+    double cycleCounterFrequency() noexcept;
+
+    inline double cyclesToNanos(uint64_t ticks) noexcept {
+        return static_cast<double>(ticks) * 1e9 / cycleCounterFrequency();
+    }
+
+} // namespace soundarch::utils
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+// FTZ/DAZ support for denormal handling
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #include <xmmintrin.h>  // SSE intrinsics for FTZ
+    #include <pmmintrin.h>  // SSE3 intrinsics for DAZ
+    #define HAS_FTZ_DAZ 1
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(__aarch64__)
+    // ARM NEON: Flush-to-zero is controlled by FPCR register
+    // On Android ARM64, FTZ is typically enabled by default
+    #define HAS_FTZ_DAZ 1
+    #define HAS_ARM_NEON 1
+#else
+    #define HAS_FTZ_DAZ 0
+#endif
+
+namespace soundarch::utils {
+
+    /**
+     * Enables FTZ (Flush-To-Zero) and DAZ (Denormals-Are-Zero) on the CALLING thread.
+     *
+     * Prevents CPU slowdown when processing very small floating-point values (<10^-38).
+     * Must be called from every thread that runs the DSP chain (Oboe callback,
+     * offline renderer) so that they all produce identical output.
+     *
+     * @return Human-readable description of what was enabled (for logging)
+     */
+    inline const char* enableFlushToZero() noexcept {
+#if HAS_FTZ_DAZ
+    #ifdef HAS_ARM_NEON
+        // NOTE: FPCR register only available on ARM64 (aarch64), not on 32-bit ARM
+        #ifdef __aarch64__
+            uint64_t fpcr;
+            __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+            fpcr |= (1 << 24);  // Set FZ bit (Flush-to-Zero)
+            __asm__ __volatile__("msr fpcr, %0" :: "r"(fpcr));
+            return "✅ FTZ enabled (ARM64 NEON)";
+        #else
+            // 32-bit ARM: FTZ controlled by FPSCR register, but typically enabled by default
+            // We don't set it manually to avoid platform-specific assembly issues
+            return "⚠️ FTZ (ARM32 NEON, using default)";
+        #endif
+    #else
+        // x86/x64: Enable FTZ and DAZ via SSE control registers
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);          // FTZ: Underflows flushed to zero
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);  // DAZ: Denormals treated as zero
+        return "✅ FTZ/DAZ enabled (x86/SSE)";
+    #endif
+#else
+        return "⚠️ FTZ/DAZ not supported on this architecture";
+#endif
+    }
+
+} // namespace soundarch::utils
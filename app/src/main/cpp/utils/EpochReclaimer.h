@@ -0,0 +1,103 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// ==============================================================================
+// ♻️ EPOCH RECLAIMER - Free what the audio thread may still be reading, later
+// ==============================================================================
+//
+// One reader (the audio thread) brackets every block with enter()/exit():
+// the epoch counter is odd inside a block, even between blocks (the
+// quiescent point). Control threads publish a replacement with one atomic
+// exchange, then retire() the previous object:
+//   - epoch even when retired: no block can still hold it → freed at once
+//   - epoch odd (= e): the block in progress may → freed once epoch > e
+//
+// The reader never waits, never frees, never allocates: enter()/exit() are
+// one atomic increment each. Deletion always happens on a control thread,
+// in retire() or reclaim(), so destructors (vector frees, FFT plans) stay
+// off the audio thread.
+//
+// Ordering: the publishing exchange, the epoch read in retire(), the
+// reader's increment in enter() and its pointer loads are all seq_cst, so
+// a block that starts after the epoch was read sees the new pointer.
+//
+// Usage (DSPChain module hot swap):
+//   Audio:   reclaimer.enter(); Modules* m = current.load(); ...; reclaimer.exit();
+//   Control: old = current.exchange(next); reclaimer.retire(std::unique_ptr<Modules>(old));
+//
+// ==============================================================================
+
+namespace soundarch::utils {
+
+    class EpochReclaimer {
+    public:
+        EpochReclaimer() = default;
+        ~EpochReclaimer() { freeAll(); }   // The reader must be gone
+
+        EpochReclaimer(const EpochReclaimer&) = delete;
+        EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+        // ⚡ Reader (audio thread, wait-free): bracket every access to published objects
+        void enter() noexcept { epoch_.fetch_add(1, std::memory_order_seq_cst); }
+        void exit() noexcept { epoch_.fetch_add(1, std::memory_order_release); }
+
+        // Control threads: call AFTER the object was unpublished
+        template<typename T>
+        void retire(std::unique_ptr<T> object) {
+            if (!object) return;
+            const uint64_t observed = epoch_.load(std::memory_order_seq_cst);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                retired_.push_back({observed, object.release(), [](void* p) { delete static_cast<T*>(p); }});
+            }
+            reclaim();
+        }
+
+        // Control threads: frees every object the reader has moved past.
+        // Returns how many are still waiting for the current block to end.
+        size_t reclaim() noexcept {
+            const uint64_t now = epoch_.load(std::memory_order_acquire);
+            std::lock_guard<std::mutex> lock(mutex_);
+            size_t kept = 0;
+            for (const Retired& r : retired_) {
+                if (isQuiescent(r.epoch, now)) {
+                    r.destroy(r.object);
+                } else {
+                    retired_[kept++] = r;
+                }
+            }
+            retired_.resize(kept);
+            return kept;
+        }
+
+        // Blocks (reader side) started or finished since construction, x2
+        uint64_t epoch() const noexcept { return epoch_.load(std::memory_order_relaxed); }
+
+    private:
+        struct Retired {
+            uint64_t epoch;             // Reader epoch seen after unpublishing
+            void* object;
+            void (*destroy)(void*);
+        };
+
+        // Even: reader was between blocks. Odd: wait for that block to end.
+        static bool isQuiescent(uint64_t retiredAt, uint64_t now) noexcept {
+            return (retiredAt & 1u) == 0 || now > retiredAt;
+        }
+
+        void freeAll() noexcept {
+            for (const Retired& r : retired_) r.destroy(r.object);
+            retired_.clear();
+        }
+
+        alignas(64) std::atomic<uint64_t> epoch_{0};   // Written by the reader only
+        std::mutex mutex_;                             // Control threads only
+        std::vector<Retired> retired_;
+    };
+
+} // namespace soundarch::utils
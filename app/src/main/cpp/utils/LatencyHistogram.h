@@ -0,0 +1,103 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// ==============================================================================
+// 📊 LATENCY HISTOGRAM - HDR-style log-linear buckets, wait-free recording
+// ==============================================================================
+//
+// Bucketing (same idea as HdrHistogram, fixed 5 significant bits):
+//   - Values 0..31 → one bucket each (exact)
+//   - Above: 32 linear sub-buckets per power of two → ≤ 3.1% relative error
+//   - Values ≥ 2^40 land in the top bucket (2^40 ticks ≈ 6 min at 3 GHz)
+//
+// Recording: one writer thread (the audio callback). Counts are relaxed
+// atomics updated with load + store (no RMW, no lock prefix), so record() is
+// a handful of instructions and readers on other threads never tear a count.
+//
+// Percentiles report the upper bound of the bucket that contains them
+// (conservative for deadline analysis); max() is exact.
+//
+// ==============================================================================
+
+namespace soundarch::utils {
+
+    class LatencyHistogram {
+    public:
+        static constexpr int kSubBucketBits = 5;
+        static constexpr uint64_t kSubBuckets = 1ull << kSubBucketBits;   // 32
+        static constexpr int kMaxValueBits = 40;
+        static constexpr size_t kBucketCount =
+                kSubBuckets + static_cast<size_t>(kMaxValueBits - kSubBucketBits) * kSubBuckets;
+
+        static constexpr size_t bucketIndex(uint64_t value) noexcept {
+            if (value < kSubBuckets) return static_cast<size_t>(value);
+            if (value >= (1ull << kMaxValueBits)) return kBucketCount - 1;
+            const int exponent = 63 - __builtin_clzll(value);         // ≥ kSubBucketBits
+            const int shift = exponent - kSubBucketBits;
+            const uint64_t sub = (value >> shift) & (kSubBuckets - 1);
+            return static_cast<size_t>(kSubBuckets + static_cast<uint64_t>(shift) * kSubBuckets + sub);
+        }
+
+        // Largest value that maps to bucket index
+        static constexpr uint64_t bucketUpperBound(size_t index) noexcept {
+            if (index < kSubBuckets) return index;
+            const uint64_t shift = (index - kSubBuckets) / kSubBuckets;
+            const uint64_t sub = (index - kSubBuckets) % kSubBuckets;
+            return ((kSubBuckets + sub + 1) << shift) - 1;
+        }
+
+        // 🎙️ Writer (single thread, wait-free)
+        void record(uint64_t value) noexcept {
+            auto& bucket = counts_[bucketIndex(value)];
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            total_.store(total_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (value > max_.load(std::memory_order_relaxed)) max_.store(value, std::memory_order_relaxed);
+        }
+
+        // 📖 Readers (any thread). Values recorded concurrently may or may not be included.
+        uint64_t count() const noexcept { return total_.load(std::memory_order_relaxed); }
+        uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+        // q in [0, 1]. 0 when empty.
+        uint64_t percentile(double q) const noexcept {
+            uint64_t snapshot[kBucketCount];
+            uint64_t total = 0;
+            for (size_t i = 0; i < kBucketCount; ++i) {
+                snapshot[i] = counts_[i].load(std::memory_order_relaxed);
+                total += snapshot[i];
+            }
+            if (total == 0) return 0;
+
+            // Rank of the q-quantile (1-based), at least the first sample
+            auto rank = static_cast<uint64_t>(q * static_cast<double>(total) + 0.999999);
+            if (rank < 1) rank = 1;
+            if (rank > total) rank = total;
+
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < kBucketCount; ++i) {
+                cumulative += snapshot[i];
+                if (cumulative >= rank) {
+                    const uint64_t bound = bucketUpperBound(i);
+                    const uint64_t observedMax = max();
+                    return bound < observedMax ? bound : observedMax;
+                }
+            }
+            return max();
+        }
+
+        // Only while the writer is not running
+        void reset() noexcept {
+            for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+            total_.store(0, std::memory_order_relaxed);
+            max_.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint32_t> counts_[kBucketCount] = {};
+        std::atomic<uint64_t> total_{0};
+        std::atomic<uint64_t> max_{0};
+    };
+
+} // namespace soundarch::utils
@@ -0,0 +1,80 @@
+#pragma once
+
+// ==============================================================================
+// 📝 PORTABLE LOGGING - logcat on Android, stderr on host builds
+// ==============================================================================
+//
+// DSP modules must build without the NDK (soundarch_dsp host library,
+// benchmarks, offline tools), so they log through SA_LOG* instead of calling
+// __android_log_print directly.
+//
+// Usage (per translation unit, same pattern as the existing LOGI macros):
+//   #define TAG "AGC"
+//   #define LOGI(...) SA_LOGI(TAG, __VA_ARGS__)
+//
+// Host builds only print Warn and above by default so benchmark and renderer
+// output stays clean. Call soundarch::log::setHostLogLevel() to change it.
+//
+// ==============================================================================
+
+namespace soundarch::log {
+
+    // Values match android_LogPriority so they can be passed straight through
+    enum Priority : int {
+        Verbose = 2,
+        Debug = 3,
+        Info = 4,
+        Warn = 5,
+        Error = 6
+    };
+
+} // namespace soundarch::log
+
+#if defined(__ANDROID__)
+
+#include <android/log.h>
+
+#define SA_LOG_PRINT(prio, tag, ...) __android_log_print(prio, tag, __VA_ARGS__)
+
+#else
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+
+namespace soundarch::log {
+
+    inline std::atomic<int>& hostLogLevel() noexcept {
+        static std::atomic<int> level{Warn};
+        return level;
+    }
+
+    inline void setHostLogLevel(int priority) noexcept {
+        hostLogLevel().store(priority, std::memory_order_relaxed);
+    }
+
+    __attribute__((format(printf, 3, 4)))
+    inline void hostPrint(int priority, const char* tag, const char* fmt, ...) noexcept {
+        if (priority < hostLogLevel().load(std::memory_order_relaxed)) return;
+
+        static constexpr char kLevels[] = "??VDIWE";
+        const char level = (priority >= Verbose && priority <= Error) ? kLevels[priority] : '?';
+
+        std::fprintf(stderr, "%c/%s: ", level, tag);
+        va_list args;
+        va_start(args, fmt);
+        std::vfprintf(stderr, fmt, args);
+        va_end(args);
+        std::fputc('\n', stderr);
+    }
+
+} // namespace soundarch::log
+
+#define SA_LOG_PRINT(prio, tag, ...) ::soundarch::log::hostPrint(prio, tag, __VA_ARGS__)
+
+#endif
+
+#define SA_LOGD(tag, ...) SA_LOG_PRINT(::soundarch::log::Debug, tag, __VA_ARGS__)
+#define SA_LOGI(tag, ...) SA_LOG_PRINT(::soundarch::log::Info, tag, __VA_ARGS__)
+#define SA_LOGW(tag, ...) SA_LOG_PRINT(::soundarch::log::Warn, tag, __VA_ARGS__)
+#define SA_LOGE(tag, ...) SA_LOG_PRINT(::soundarch::log::Error, tag, __VA_ARGS__)
@@ -2,7 +2,23 @@
 #include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <type_traits>
 
+// ==============================================================================
+// 🔒 LOCK-FREE BOUNDED QUEUES - fixed capacity, no allocation after construction
+// ==============================================================================
+//
+//   RingBuffer<T, N>                 SPSC, scalar elements (audio input → output)
+//   FrameRingBuffer<T, Channels, N>  SPSC, interleaved multichannel frames
+//   MpscQueue<T, N>                  Many producers (UI, BT bridge, ML) → one
+//                                    consumer (audio thread)
+//   BroadcastQueue<T, N>             One producer (audio thread) → any number of
+//                                    readers (meters, recorder, analyzer), each
+//                                    seeing every item; the producer never waits,
+//                                    a reader that falls N behind skips ahead
+//
+// Capacities are powers of two; elements are trivially copyable.
+//
 // ==============================================================================
 // 🔒 LOCK-FREE SINGLE-PRODUCER SINGLE-CONSUMER (SPSC) RING BUFFER
 // ==============================================================================
@@ -18,29 +34,58 @@
 //   - head.store(memory_order_release): Publishes new data to consumer
 //   - tail.store(memory_order_release): Publishes freed space to producer
 //
+// Zero-copy API (reservation):
+//   - prepareWrite(max) / prepareRead(max) return up to TWO contiguous spans
+//     (second one non-empty only when the region wraps past the end)
+//   - The caller fills / consumes them in place, then commitWrite(n) /
+//     commitRead(n) with n ≤ reserved size (partial commits are fine)
+//   - push()/pop() are the copying wrappers: one memcpy per span
+//
 // Usage Pattern (OboeEngine):
-//   - Producer: inputStream→read() → ringBuffer.push()  (onAudioReady thread)
-//   - Consumer: ringBuffer.pop() → DSP chain → output   (onAudioReady thread)
+//   - Producer: inputStream→read() straight into prepareWrite() spans  (onAudioReady thread)
+//   - Consumer: ringBuffer.pop() → DSP chain in place on output         (onAudioReady thread)
 //   - Both operations run on same thread, but logically producer/consumer
 //
 // Performance:
 //   - Power-of-two size enables fast modulo via bitwise AND: (index & (N-1))
-//   - No divisions, no mutexes, minimal cache line ping-pong
-//   - Typical latency: <1μs for 4096-sample buffer
+//   - head and tail live on separate cache lines (no false sharing)
+//   - Each side caches the other side's index and only reloads it (one
+//     acquire load of a remote line) when the cached view looks too full/empty
+//   - No divisions, no mutexes, no per-sample masking
 //
 // ==============================================================================
 
 template<typename T, size_t N>
 class RingBuffer {
     static_assert((N & (N - 1)) == 0, "Size must be power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "Bulk copies use memcpy");
 
-    T buffer[N];
-    std::atomic<size_t> head{0};
-    std::atomic<size_t> tail{0};
+    static constexpr size_t kCacheLine = 64;
 
 public:
+    struct Span {
+        T* data = nullptr;
+        size_t size = 0;
+    };
+
+    // Up to two contiguous regions, in ring order
+    struct Spans {
+        Span first;
+        Span second;
+        size_t size() const noexcept { return first.size + second.size; }
+    };
+
     size_t capacity() const { return N; }
 
+    // Drops all content. Only while neither side is running (stream stopped).
+    void reset() noexcept {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        cachedTail = 0;
+        cachedHead = 0;
+    }
+
+    // Exact, any thread (telemetry): loads both indices
     size_t availableToWrite() const {
         return N - (head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire));
     }
@@ -49,23 +94,352 @@ public:
         return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
     }
 
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // ✍️ PRODUCER
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    // Reserves min(max, free space) elements for writing in place
+    Spans prepareWrite(size_t max) noexcept {
+        const size_t localHead = head.load(std::memory_order_relaxed);
+        const size_t free = writable(localHead, max);
+        return spansAt(localHead, free < max ? free : max);
+    }
+
+    // Publishes the first count reserved elements
+    void commitWrite(size_t count) noexcept {
+        head.store(head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
     bool push(const T* data, size_t count) noexcept {
-        if (availableToWrite() < count) return false;
-        size_t localHead = head.load(std::memory_order_relaxed);
-        for (size_t i = 0; i < count; ++i) {
-            buffer[(localHead + i) & (N - 1)] = data[i];
-        }
+        const size_t localHead = head.load(std::memory_order_relaxed);
+        if (writable(localHead, count) < count) return false;
+        const Spans s = spansAt(localHead, count);
+        std::memcpy(s.first.data, data, s.first.size * sizeof(T));
+        if (s.second.size) std::memcpy(s.second.data, data + s.first.size, s.second.size * sizeof(T));
         head.store(localHead + count, std::memory_order_release);
         return true;
     }
 
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 📖 CONSUMER
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    // Reserves min(max, queued) elements for reading (or processing) in place
+    Spans prepareRead(size_t max) noexcept {
+        const size_t localTail = tail.load(std::memory_order_relaxed);
+        const size_t queued = readable(localTail, max);
+        return spansAt(localTail, queued < max ? queued : max);
+    }
+
+    // Releases the first count reserved elements to the producer
+    void commitRead(size_t count) noexcept {
+        tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
     bool pop(T* out, size_t count) noexcept {
-        if (availableToRead() < count) return false;
-        size_t localTail = tail.load(std::memory_order_relaxed);
-        for (size_t i = 0; i < count; ++i) {
-            out[i] = buffer[(localTail + i) & (N - 1)];
-        }
+        const size_t localTail = tail.load(std::memory_order_relaxed);
+        if (readable(localTail, count) < count) return false;
+        const Spans s = spansAt(localTail, count);
+        std::memcpy(out, s.first.data, s.first.size * sizeof(T));
+        if (s.second.size) std::memcpy(out + s.first.size, s.second.data, s.second.size * sizeof(T));
         tail.store(localTail + count, std::memory_order_release);
         return true;
     }
+
+private:
+    // Free space seen by the producer; refreshes cachedTail only when short
+    size_t writable(size_t localHead, size_t wanted) noexcept {
+        size_t free = N - (localHead - cachedTail);
+        if (free < wanted) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            free = N - (localHead - cachedTail);
+        }
+        return free;
+    }
+
+    // Queued data seen by the consumer; refreshes cachedHead only when short
+    size_t readable(size_t localTail, size_t wanted) noexcept {
+        size_t queued = cachedHead - localTail;
+        if (queued < wanted) {
+            cachedHead = head.load(std::memory_order_acquire);
+            queued = cachedHead - localTail;
+        }
+        return queued;
+    }
+
+    Spans spansAt(size_t index, size_t count) noexcept {
+        const size_t offset = index & (N - 1);
+        const size_t firstSize = count < N - offset ? count : N - offset;
+        Spans s;
+        s.first = {buffer + offset, firstSize};
+        if (count > firstSize) s.second = {buffer, count - firstSize};
+        return s;
+    }
+
+    // Producer line: its own index + its view of the consumer
+    alignas(kCacheLine) std::atomic<size_t> head{0};
+    size_t cachedTail = 0;
+
+    // Consumer line
+    alignas(kCacheLine) std::atomic<size_t> tail{0};
+    size_t cachedHead = 0;
+
+    alignas(kCacheLine) T buffer[N];
+};
+
+// ==============================================================================
+// 🎚️ FRAME RING BUFFER - SPSC over interleaved multichannel frames
+// ==============================================================================
+//
+// RingBuffer of Frame { T channel[Channels] }: indices, spans and capacity
+// count frames, so a reservation never splits a frame across the wrap. The
+// storage is plain interleaved T (samples(span) gives the T* of a span).
+//
+// ==============================================================================
+
+template<typename T, size_t Channels, size_t N>
+class FrameRingBuffer {
+public:
+    struct Frame {
+        T channel[Channels];
+    };
+    static_assert(Channels > 0, "At least one channel");
+    static_assert(sizeof(Frame) == Channels * sizeof(T), "Frames must be tightly interleaved");
+
+    using Ring = RingBuffer<Frame, N>;
+    using Span = typename Ring::Span;
+    using Spans = typename Ring::Spans;
+
+    static constexpr size_t channels() noexcept { return Channels; }
+    size_t capacity() const { return N; }   // Frames
+
+    void reset() noexcept { ring_.reset(); }
+    size_t availableToWrite() const { return ring_.availableToWrite(); }
+    size_t availableToRead() const { return ring_.availableToRead(); }
+
+    // Interleaved samples of a span (span.size * Channels of them)
+    static T* samples(const Span& span) noexcept { return span.data ? span.data->channel : nullptr; }
+
+    // ━━━ Producer ━━━
+    Spans prepareWrite(size_t maxFrames) noexcept { return ring_.prepareWrite(maxFrames); }
+    void commitWrite(size_t frames) noexcept { ring_.commitWrite(frames); }
+
+    bool push(const T* interleaved, size_t frames) noexcept {
+        const Spans s = ring_.prepareWrite(frames);
+        if (s.size() < frames) return false;
+        std::memcpy(s.first.data, interleaved, s.first.size * sizeof(Frame));
+        if (s.second.size) {
+            std::memcpy(s.second.data, interleaved + s.first.size * Channels, s.second.size * sizeof(Frame));
+        }
+        ring_.commitWrite(frames);
+        return true;
+    }
+
+    // ━━━ Consumer ━━━
+    Spans prepareRead(size_t maxFrames) noexcept { return ring_.prepareRead(maxFrames); }
+    void commitRead(size_t frames) noexcept { ring_.commitRead(frames); }
+
+    bool pop(T* interleaved, size_t frames) noexcept {
+        const Spans s = ring_.prepareRead(frames);
+        if (s.size() < frames) return false;
+        std::memcpy(interleaved, s.first.data, s.first.size * sizeof(Frame));
+        if (s.second.size) {
+            std::memcpy(interleaved + s.first.size * Channels, s.second.data, s.second.size * sizeof(Frame));
+        }
+        ring_.commitRead(frames);
+        return true;
+    }
+
+private:
+    Ring ring_;
+};
+
+// ==============================================================================
+// 📮 MPSC QUEUE - many producers, one consumer (bounded, Vyukov cell sequences)
+// ==============================================================================
+//
+// Same scheme as the RT logger (utils/RtLog.h):
+//   - Cell i is free for position p when its sequence == p
+//   - Producer: CAS enqueuePos p → p+1, write the value, sequence = p+1
+//   - Consumer: reads position p when sequence == p+1, then hands the cell
+//     back for the next lap with sequence = p+N
+//
+// Producers are lock-free (a CAS retry only when another producer won the
+// same position); the consumer is wait-free. Full → tryPush returns false.
+//
+// ==============================================================================
+
+template<typename T, size_t N>
+class MpscQueue {
+    static_assert((N & (N - 1)) == 0, "Size must be power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "Values are copied in and out");
+
+public:
+    MpscQueue() noexcept {
+        for (size_t i = 0; i < N; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    size_t capacity() const { return N; }
+
+    // Any thread
+    bool tryPush(const T& value) noexcept {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & (N - 1)];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // Full: the consumer has not released this cell yet
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only
+    bool tryPop(T& out) noexcept {
+        Cell& cell = cells_[dequeuePos_ & (N - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) return false;
+        out = cell.value;
+        cell.sequence.store(dequeuePos_ + N, std::memory_order_release);
+        ++dequeuePos_;
+        return true;
+    }
+
+    // Consumer thread only: up to max values, in order
+    size_t popBulk(T* out, size_t max) noexcept {
+        size_t n = 0;
+        while (n < max && tryPop(out[n])) ++n;
+        return n;
+    }
+
+    // Consumer thread only: nothing ready to pop (one acquire load)
+    bool empty() const noexcept {
+        return cells_[dequeuePos_ & (N - 1)].sequence.load(std::memory_order_acquire) != dequeuePos_ + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value;
+    };
+
+    Cell cells_[N];
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) size_t dequeuePos_ = 0;
+};
+
+// ==============================================================================
+// 📡 BROADCAST QUEUE - one producer, any number of lossy readers
+// ==============================================================================
+//
+// Producer (never waits, never fails):
+//   slot.sequence → 2i+1, copy payload, slot.sequence → 2i+2, head → i+1
+// Reader (own cursor c, no registration, nothing shared between readers):
+//   sequence <  2c+2 → nothing new
+//   sequence == 2c+2 → copy, re-check the sequence (seqlock), advance
+//   sequence >  2c+2 → lapped: jump to the oldest intact item, count the gap
+//
+// Payload words are relaxed atomics, as in SeqLock: the concurrent copy is
+// race-free (TSan clean) and compiles to plain loads/stores.
+//
+// ==============================================================================
+
+template<typename T, size_t N>
+class BroadcastQueue {
+    static_assert((N & (N - 1)) == 0, "Size must be power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "Payload is copied word by word");
+
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+    class Reader {
+    public:
+        Reader() = default;
+
+        // Next item in order; false when caught up
+        bool tryPop(T& out) noexcept {
+            if (!queue_) return false;
+            uint64_t words[kWords];
+            for (;;) {
+                const Slot& slot = queue_->slots_[cursor_ & (N - 1)];
+                const uint64_t expected = 2 * cursor_ + 2;
+                const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+                if (before < expected) return false;
+
+                if (before == expected) {
+                    for (size_t i = 0; i < kWords; ++i) words[i] = slot.words[i].load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                        std::memcpy(&out, words, sizeof(T));
+                        ++cursor_;
+                        return true;
+                    }
+                }
+
+                // Lapped by the producer: resume at the oldest slot it cannot be rewriting
+                const uint64_t head = queue_->head_.load(std::memory_order_acquire);
+                const uint64_t oldest = head >= N ? head - N + 1 : 0;
+                if (oldest > cursor_) {
+                    lost_ += oldest - cursor_;
+                    cursor_ = oldest;
+                }
+            }
+        }
+
+        uint64_t lostCount() const noexcept { return lost_; }
+
+    private:
+        friend class BroadcastQueue;
+        explicit Reader(const BroadcastQueue* queue, uint64_t cursor) noexcept
+                : queue_(queue), cursor_(cursor) {}
+
+        const BroadcastQueue* queue_ = nullptr;
+        uint64_t cursor_ = 0;
+        uint64_t lost_ = 0;
+    };
+
+    BroadcastQueue() = default;
+    BroadcastQueue(const BroadcastQueue&) = delete;
+    BroadcastQueue& operator=(const BroadcastQueue&) = delete;
+
+    size_t capacity() const { return N; }
+
+    // Producer thread only (wait-free)
+    void publish(const T& value) noexcept {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const uint64_t index = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[index & (N - 1)];
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) slot.words[i].store(words[i], std::memory_order_relaxed);
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        head_.store(index + 1, std::memory_order_release);
+    }
+
+    // Any thread: a reader that sees items published from now on
+    Reader reader() const noexcept { return Reader(this, head_.load(std::memory_order_acquire)); }
+
+    uint64_t publishedCount() const noexcept { return head_.load(std::memory_order_acquire); }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> words[kWords] = {};
+    };
+
+    Slot slots_[N];
+    alignas(64) std::atomic<uint64_t> head_{0};
 };
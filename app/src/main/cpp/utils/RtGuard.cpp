@@ -0,0 +1,82 @@
+#include "RtGuard.h"
+#include <atomic>
+#include <execinfo.h>
+
+// Compiled only when SOUNDARCH_RT_GUARD=1 (see CMakeLists.txt)
+
+namespace soundarch::utils::rtguard {
+
+    namespace {
+
+        // initial-exec: plain TLS offset, no lazy TLS allocation from inside malloc()
+        __attribute__((tls_model("initial-exec"))) thread_local int tDepth = 0;
+        __attribute__((tls_model("initial-exec"))) thread_local bool tRecording = false;
+
+        std::atomic<bool> gInterposed{false};
+        std::atomic<size_t> gCount{0};
+        Violation gViolations[kMaxRecorded];
+        std::atomic<bool> gRecorded[kMaxRecorded] = {};
+
+    } // anonymous namespace
+
+    void enter() noexcept { ++tDepth; }
+    void leave() noexcept { --tDepth; }
+    bool inRtSection() noexcept { return tDepth > 0; }
+
+    void check(ViolationKind kind, const char* function) noexcept {
+        if (tDepth == 0 || tRecording) return;
+        tRecording = true;   // backtrace() must not record itself
+
+        const size_t index = gCount.fetch_add(1, std::memory_order_relaxed);
+        if (index < kMaxRecorded) {
+            Violation& v = gViolations[index];
+            v.kind = kind;
+            v.function = function;
+            v.frameCount = backtrace(v.frames, kMaxFrames);
+            gRecorded[index].store(true, std::memory_order_release);
+        }
+
+        tRecording = false;
+    }
+
+    void markInterposed() noexcept {
+        // The first backtrace() loads the unwinder (dlopen + malloc): do it now,
+        // not inside the first violation
+        void* frame[1];
+        backtrace(frame, 1);
+        gInterposed.store(true, std::memory_order_release);
+    }
+
+    bool isActive() noexcept { return gInterposed.load(std::memory_order_acquire); }
+
+    size_t violationCount() noexcept { return gCount.load(std::memory_order_relaxed); }
+
+    bool violation(size_t index, Violation& out) noexcept {
+        if (index >= kMaxRecorded || !gRecorded[index].load(std::memory_order_acquire)) return false;
+        out = gViolations[index];
+        return true;
+    }
+
+    void clearViolations() noexcept {
+        for (auto& recorded : gRecorded) recorded.store(false, std::memory_order_relaxed);
+        gCount.store(0, std::memory_order_release);
+    }
+
+    void printViolations(FILE* out) noexcept {
+        const size_t count = violationCount();
+        std::fprintf(out, "🚨 %zu RT violation(s)\n", count);
+
+        for (size_t i = 0; i < count && i < kMaxRecorded; ++i) {
+            Violation v;
+            if (!violation(i, v)) continue;
+            std::fprintf(out, "#%zu %s: %s()\n", i, violationKindName(v.kind), v.function);
+            std::fflush(out);
+            backtrace_symbols_fd(v.frames, v.frameCount, fileno(out));
+        }
+        if (count > kMaxRecorded) {
+            std::fprintf(out, "... %zu more not recorded\n", count - kMaxRecorded);
+        }
+        std::fflush(out);
+    }
+
+} // namespace soundarch::utils::rtguard
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdio>
+
+// ==============================================================================
+// 🚨 RT GUARD - Catches allocations, locks and syscalls on the audio thread
+// ==============================================================================
+//
+// Debug/test builds only (SOUNDARCH_RT_GUARD=1, host default when no
+// sanitizer is enabled). Release and Android builds compile every marker to
+// nothing.
+//
+//   bool OboeEngine::onAudioReady(...) noexcept {
+//       SOUNDARCH_RT_SCOPE();     // Everything below, and what it calls, is RT
+//       ...
+//   }
+//
+// Detection needs the interposers (utils/RtGuardInterpose.cpp, CMake object
+// library soundarch_rt_guard) linked into the executable. They replace:
+//   - malloc / calloc / realloc / free / posix_memalign / aligned_alloc / memalign
+//     (operator new/delete included: they end in malloc/free)
+//   - pthread_mutex_lock / trylock, pthread_cond_wait / timedwait / clockwait
+//   - open / openat / fopen / read / write / close / nanosleep / usleep / sched_yield
+// Outside an RT scope they forward at once. Inside one, each call is recorded
+// with its backtrace in a fixed table (no allocation), then forwarded: the
+// program keeps running, the test fails on violationCount() != 0.
+//
+// ==============================================================================
+
+#ifndef SOUNDARCH_RT_GUARD
+#define SOUNDARCH_RT_GUARD 0
+#endif
+
+namespace soundarch::utils::rtguard {
+
+    enum class ViolationKind : int {
+        Allocation,
+        Deallocation,
+        Lock,
+        Syscall
+    };
+
+    inline const char* violationKindName(ViolationKind kind) noexcept {
+        switch (kind) {
+            case ViolationKind::Allocation: return "allocation";
+            case ViolationKind::Deallocation: return "deallocation";
+            case ViolationKind::Lock: return "lock";
+            case ViolationKind::Syscall: return "syscall";
+            default: return "?";
+        }
+    }
+
+    constexpr int kMaxFrames = 24;
+    constexpr size_t kMaxRecorded = 64;   // Further violations are counted only
+
+    struct Violation {
+        ViolationKind kind = ViolationKind::Allocation;
+        const char* function = nullptr;   // Interposed symbol ("malloc", "open", ...)
+        int frameCount = 0;
+        void* frames[kMaxFrames] = {};
+    };
+
+#if SOUNDARCH_RT_GUARD
+
+    // ━━━ RT section marker (audio thread) ━━━
+    void enter() noexcept;
+    void leave() noexcept;
+    bool inRtSection() noexcept;
+
+    class Scope {
+    public:
+        Scope() noexcept { enter(); }
+        ~Scope() { leave(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // ━━━ Interposers ━━━
+    // Records one violation if the calling thread is inside an RT section
+    void check(ViolationKind kind, const char* function) noexcept;
+    void markInterposed() noexcept;
+
+    // ━━━ Reporting (control thread / tests) ━━━
+    // True when the interposers are linked in (otherwise nothing is detected)
+    bool isActive() noexcept;
+    size_t violationCount() noexcept;
+    bool violation(size_t index, Violation& out) noexcept;   // index < kMaxRecorded
+    void clearViolations() noexcept;                           // Only while no RT section runs
+    void printViolations(FILE* out) noexcept;                  // Kind, function, symbolized backtrace
+
+#define SOUNDARCH_RT_SCOPE_CAT2(a, b) a##b
+#define SOUNDARCH_RT_SCOPE_CAT(a, b) SOUNDARCH_RT_SCOPE_CAT2(a, b)
+#define SOUNDARCH_RT_SCOPE() ::soundarch::utils::rtguard::Scope SOUNDARCH_RT_SCOPE_CAT(rtScope_, __LINE__)
+
+#else
+
+#define SOUNDARCH_RT_SCOPE() ((void)0)
+
+#endif
+
+} // namespace soundarch::utils::rtguard
@@ -0,0 +1,279 @@
+// ==============================================================================
+// 🚨 RT GUARD INTERPOSERS - Linked only into test executables (glibc hosts)
+// ==============================================================================
+//
+// Definitions in the executable win over libc's at dynamic link time, for the
+// program itself and for every shared library it loads (libstdc++ operator
+// new included). Each interposer asks rtguard::check() whether the calling
+// thread is in an RT section, then forwards to the real implementation:
+//   - malloc family → glibc's __libc_* entry points (no dlsym recursion)
+//   - everything else → dlsym(RTLD_NEXT), resolved before main()
+//   - pthread_cond_* → the GLIBC_2.3.2 version where there is one: a plain
+//     dlsym() hands back the pre-NPTL compat condvar on x86-64
+//
+// See utils/RtGuard.h.
+//
+// ==============================================================================
+
+// Fortified inline wrappers (open, read, ...) would clash with the definitions
+#ifdef _FORTIFY_SOURCE
+#undef _FORTIFY_SOURCE
+#endif
+
+#include "RtGuard.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#if !defined(__GLIBC__)
+#error "RT guard interposers rely on glibc (__libc_malloc); disable SOUNDARCH_RT_GUARD"
+#endif
+
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* ptr);
+}
+
+#define SA_INTERPOSE extern "C" __attribute__((visibility("default")))
+
+namespace {
+
+    using soundarch::utils::rtguard::ViolationKind;
+    using soundarch::utils::rtguard::check;
+
+    enum Real : int {
+        kPthreadMutexLock,
+        kPthreadMutexTrylock,
+        kPthreadCondWait,
+        kPthreadCondTimedwait,
+        kPthreadCondClockwait,
+        kOpen,
+        kOpen64,
+        kOpenat,
+        kFopen,
+        kFopen64,
+        kRead,
+        kWrite,
+        kClose,
+        kNanosleep,
+        kClockNanosleep,
+        kUsleep,
+        kSchedYield,
+        kRealCount
+    };
+
+    const char* const kRealNames[kRealCount] = {
+            "pthread_mutex_lock", "pthread_mutex_trylock",
+            "pthread_cond_wait", "pthread_cond_timedwait", "pthread_cond_clockwait",
+            "open", "open64", "openat", "fopen", "fopen64",
+            "read", "write", "close",
+            "nanosleep", "clock_nanosleep", "usleep", "sched_yield",
+    };
+
+    // No function-local statics here: their guard would lock inside the interposer
+    std::atomic<void*> gReal[kRealCount] = {};
+
+    void* resolve(int id) noexcept {
+        if (id == kPthreadCondWait || id == kPthreadCondTimedwait) {
+            if (void* fn = dlvsym(RTLD_NEXT, kRealNames[id], "GLIBC_2.3.2")) return fn;
+        }
+        return dlsym(RTLD_NEXT, kRealNames[id]);
+    }
+
+    template<typename Fn>
+    Fn real(Real id) noexcept {
+        void* fn = gReal[id].load(std::memory_order_relaxed);
+        if (!fn) {
+            fn = resolve(id);
+            gReal[id].store(fn, std::memory_order_relaxed);
+        }
+        return reinterpret_cast<Fn>(fn);
+    }
+
+    __attribute__((constructor)) void resolveRealFunctions() {
+        for (int i = 0; i < kRealCount; ++i) {
+            gReal[i].store(resolve(i), std::memory_order_relaxed);
+        }
+        soundarch::utils::rtguard::markInterposed();
+    }
+
+    mode_t variadicMode(int flags, va_list args) noexcept {
+        const bool hasMode = (flags & O_CREAT) != 0
+#ifdef O_TMPFILE
+                             || (flags & O_TMPFILE) == O_TMPFILE
+#endif
+                ;
+        return hasMode ? static_cast<mode_t>(va_arg(args, int)) : 0;
+    }
+
+} // anonymous namespace
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// 🧠 ALLOCATOR
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+SA_INTERPOSE void* malloc(size_t size) __THROW {
+    check(ViolationKind::Allocation, "malloc");
+    return __libc_malloc(size);
+}
+
+SA_INTERPOSE void* calloc(size_t count, size_t size) __THROW {
+    check(ViolationKind::Allocation, "calloc");
+    return __libc_calloc(count, size);
+}
+
+SA_INTERPOSE void* realloc(void* ptr, size_t size) __THROW {
+    check(ViolationKind::Allocation, "realloc");
+    return __libc_realloc(ptr, size);
+}
+
+SA_INTERPOSE void* memalign(size_t alignment, size_t size) __THROW {
+    check(ViolationKind::Allocation, "memalign");
+    return __libc_memalign(alignment, size);
+}
+
+SA_INTERPOSE void* aligned_alloc(size_t alignment, size_t size) __THROW {
+    check(ViolationKind::Allocation, "aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+SA_INTERPOSE int posix_memalign(void** out, size_t alignment, size_t size) __THROW {
+    check(ViolationKind::Allocation, "posix_memalign");
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) return EINVAL;
+    void* p = __libc_memalign(alignment, size);
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+
+SA_INTERPOSE void free(void* ptr) __THROW {
+    if (ptr) check(ViolationKind::Deallocation, "free");
+    __libc_free(ptr);
+}
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// 🔒 LOCKS (std::mutex → pthread_mutex_lock, std::condition_variable → pthread_cond_*)
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+SA_INTERPOSE int pthread_mutex_lock(pthread_mutex_t* mutex) __THROWNL {
+    check(ViolationKind::Lock, "pthread_mutex_lock");
+    return real<int (*)(pthread_mutex_t*)>(kPthreadMutexLock)(mutex);
+}
+
+SA_INTERPOSE int pthread_mutex_trylock(pthread_mutex_t* mutex) __THROWNL {
+    check(ViolationKind::Lock, "pthread_mutex_trylock");
+    return real<int (*)(pthread_mutex_t*)>(kPthreadMutexTrylock)(mutex);
+}
+
+SA_INTERPOSE int pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex) {
+    check(ViolationKind::Lock, "pthread_cond_wait");
+    return real<int (*)(pthread_cond_t*, pthread_mutex_t*)>(kPthreadCondWait)(cond, mutex);
+}
+
+SA_INTERPOSE int pthread_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex,
+                                        const struct timespec* deadline) {
+    check(ViolationKind::Lock, "pthread_cond_timedwait");
+    return real<int (*)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*)>(kPthreadCondTimedwait)(
+            cond, mutex, deadline);
+}
+
+#if __GLIBC_PREREQ(2, 30)
+// libstdc++'s condition_variable::wait_for/wait_until on glibc >= 2.30
+SA_INTERPOSE int pthread_cond_clockwait(pthread_cond_t* cond, pthread_mutex_t* mutex, clockid_t clock,
+                                        const struct timespec* deadline) {
+    check(ViolationKind::Lock, "pthread_cond_clockwait");
+    return real<int (*)(pthread_cond_t*, pthread_mutex_t*, clockid_t, const struct timespec*)>(
+            kPthreadCondClockwait)(cond, mutex, clock, deadline);
+}
+#endif
+
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+// 📁 FILES / 💤 SLEEPS
+// ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+SA_INTERPOSE int open(const char* path, int flags, ...) {
+    check(ViolationKind::Syscall, "open");
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = variadicMode(flags, args);
+    va_end(args);
+    return real<int (*)(const char*, int, ...)>(kOpen)(path, flags, mode);
+}
+
+SA_INTERPOSE int open64(const char* path, int flags, ...) {
+    check(ViolationKind::Syscall, "open64");
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = variadicMode(flags, args);
+    va_end(args);
+    return real<int (*)(const char*, int, ...)>(kOpen64)(path, flags, mode);
+}
+
+SA_INTERPOSE int openat(int dirFd, const char* path, int flags, ...) {
+    check(ViolationKind::Syscall, "openat");
+    va_list args;
+    va_start(args, flags);
+    const mode_t mode = variadicMode(flags, args);
+    va_end(args);
+    return real<int (*)(int, const char*, int, ...)>(kOpenat)(dirFd, path, flags, mode);
+}
+
+SA_INTERPOSE FILE* fopen(const char* path, const char* mode) {
+    check(ViolationKind::Syscall, "fopen");
+    return real<FILE* (*)(const char*, const char*)>(kFopen)(path, mode);
+}
+
+SA_INTERPOSE FILE* fopen64(const char* path, const char* mode) {
+    check(ViolationKind::Syscall, "fopen64");
+    return real<FILE* (*)(const char*, const char*)>(kFopen64)(path, mode);
+}
+
+SA_INTERPOSE ssize_t read(int fd, void* buffer, size_t size) {
+    check(ViolationKind::Syscall, "read");
+    return real<ssize_t (*)(int, void*, size_t)>(kRead)(fd, buffer, size);
+}
+
+SA_INTERPOSE ssize_t write(int fd, const void* buffer, size_t size) {
+    check(ViolationKind::Syscall, "write");
+    return real<ssize_t (*)(int, const void*, size_t)>(kWrite)(fd, buffer, size);
+}
+
+SA_INTERPOSE int close(int fd) {
+    check(ViolationKind::Syscall, "close");
+    return real<int (*)(int)>(kClose)(fd);
+}
+
+SA_INTERPOSE int nanosleep(const struct timespec* request, struct timespec* remaining) {
+    check(ViolationKind::Syscall, "nanosleep");
+    return real<int (*)(const struct timespec*, struct timespec*)>(kNanosleep)(request, remaining);
+}
+
+SA_INTERPOSE int clock_nanosleep(clockid_t clock, int flags, const struct timespec* request,
+                                 struct timespec* remaining) {
+    check(ViolationKind::Syscall, "clock_nanosleep");
+    return real<int (*)(clockid_t, int, const struct timespec*, struct timespec*)>(kClockNanosleep)(
+            clock, flags, request, remaining);
+}
+
+SA_INTERPOSE int usleep(useconds_t usec) {
+    check(ViolationKind::Syscall, "usleep");
+    return real<int (*)(useconds_t)>(kUsleep)(usec);
+}
+
+SA_INTERPOSE int sched_yield() __THROW {
+    check(ViolationKind::Syscall, "sched_yield");
+    return real<int (*)()>(kSchedYield)();
+}
@@ -0,0 +1,143 @@
+#include "RtLog.h"
+#include <chrono>
+
+namespace soundarch::log::rt {
+
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+    namespace {
+
+        constexpr size_t kMask = kCapacity - 1;
+        constexpr std::chrono::milliseconds kDrainInterval{20};
+
+        void defaultSink(int priority, const char* tag, const char* message) {
+            SA_LOG_PRINT(priority, tag, "%s", message);
+        }
+
+        // Process-wide instance (cells live in static storage, nothing is allocated)
+        AsyncLogger gLogger;
+
+    } // anonymous namespace
+
+    AsyncLogger& logger() noexcept {
+        return gLogger;
+    }
+
+    AsyncLogger::AsyncLogger() noexcept {
+        for (size_t i = 0; i < kCapacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    AsyncLogger::~AsyncLogger() {
+        std::lock_guard<std::mutex> lifecycle(lifecycleMutex_);
+        {
+            std::lock_guard<std::mutex> lock(threadMutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        if (thread_.joinable()) thread_.join();
+        threadUsers_ = 0;
+    }
+
+    // Bounded MPSC claim: a cell is free for position p when its sequence == p
+    AsyncLogger::Cell* AsyncLogger::claim(size_t& position) noexcept {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & kMask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    position = pos;
+                    return &cell;
+                }
+            } else if (diff < 0) {
+                return nullptr;   // Full: the consumer has not released this cell yet
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void AsyncLogger::publish(Cell* cell, size_t position) noexcept {
+        cell->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    size_t AsyncLogger::drain() noexcept {
+        std::lock_guard<std::mutex> lock(drainMutex_);
+        const Sink sink = sink_.load(std::memory_order_acquire);
+        const Sink emit = sink ? sink : &defaultSink;
+
+        char message[kMaxMessageLength];
+        size_t drained = 0;
+
+        for (;;) {
+            Cell& cell = cells_[dequeuePos_ & kMask];
+            if (cell.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) break;
+
+            // Copy out and hand the cell back before the (slow) formatting
+            const Record record = cell.record;
+            cell.sequence.store(dequeuePos_ + kCapacity, std::memory_order_release);
+            ++dequeuePos_;
+
+            if (record.formatter(record, message, sizeof(message)) < 0) {
+                std::snprintf(message, sizeof(message), "<bad RT log format: %s>", record.format);
+            }
+            emit(record.priority, record.tag, message);
+            ++drained;
+        }
+
+        const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != reportedDrops_) {
+            std::snprintf(message, sizeof(message), "⚠️ %llu RT log records dropped (ring full)",
+                          static_cast<unsigned long long>(dropped - reportedDrops_));
+            emit(Warn, "RtLog", message);
+            reportedDrops_ = dropped;
+        }
+
+        emitted_.fetch_add(drained, std::memory_order_relaxed);
+        return drained;
+    }
+
+    void AsyncLogger::setSink(Sink sink) noexcept {
+        sink_.store(sink, std::memory_order_release);
+    }
+
+    void AsyncLogger::startThread() {
+        std::lock_guard<std::mutex> lifecycle(lifecycleMutex_);
+        if (threadUsers_++ > 0) return;
+
+        {
+            std::lock_guard<std::mutex> lock(threadMutex_);
+            stop_ = false;
+        }
+        thread_ = std::thread(&AsyncLogger::drainLoop, this);
+    }
+
+    void AsyncLogger::stopThread() {
+        std::lock_guard<std::mutex> lifecycle(lifecycleMutex_);
+        if (threadUsers_ == 0 || --threadUsers_ > 0) return;
+
+        {
+            std::lock_guard<std::mutex> lock(threadMutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        if (thread_.joinable()) thread_.join();
+        drain();
+    }
+
+    void AsyncLogger::drainLoop() {
+        std::unique_lock<std::mutex> lock(threadMutex_);
+        while (!stop_) {
+            wake_.wait_for(lock, kDrainInterval, [this] { return stop_; });
+
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
+
+} // namespace soundarch::log::rt
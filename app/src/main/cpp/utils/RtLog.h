@@ -0,0 +1,215 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "Log.h"
+
+// ==============================================================================
+// 📝 RT-SAFE ASYNC LOGGER - Binary records from the audio thread
+// ==============================================================================
+//
+// SA_LOG* ends in __android_log_print / fprintf: a syscall that can block for
+// milliseconds. From the audio callback, log through SA_RT_LOG* instead:
+//
+//   #define RT_LOGE(...) SA_RT_LOGE(TAG, __VA_ARGS__)
+//   RT_LOGE("⚠️ RingBuffer OVERFLOW x%u", count);
+//
+// Producer (any thread, typically the audio callback):
+//   - Copies format pointer + raw arguments into a fixed-size record of a
+//     preallocated ring (bounded MPSC, one CAS, no allocation, no formatting)
+//   - Ring full → record dropped, dropped counter incremented, never blocks
+//
+// Consumer (background drain thread, or drain() by hand):
+//   - snprintf()s each record with its original argument types and emits it
+//     through SA_LOG_PRINT (logcat / stderr), then reports drops
+//
+// Argument rules: up to kMaxArgs arithmetic, enum or pointer values. "%s"
+// arguments must be string literals or otherwise outlive the drain (the
+// pointer is stored, not the characters).
+//
+// Compile-time level: SOUNDARCH_RT_LOG_LEVEL (soundarch::log::Priority
+// value, default Info). Call sites below it compile to nothing and their
+// arguments are not evaluated.
+//
+// ==============================================================================
+
+#ifndef SOUNDARCH_RT_LOG_LEVEL
+#define SOUNDARCH_RT_LOG_LEVEL 4   // soundarch::log::Info
+#endif
+
+namespace soundarch::log::rt {
+
+    constexpr size_t kMaxArgs = 6;
+    constexpr size_t kCapacity = 512;          // Records (power of two)
+    constexpr size_t kMaxMessageLength = 256;  // Formatted, including '\0'
+
+    struct Record;
+    using FormatFn = int (*)(const Record& record, char* out, size_t size);
+
+    struct Record {
+        const char* tag = nullptr;
+        const char* format = nullptr;           // Format id: the literal itself
+        FormatFn formatter = nullptr;           // Knows the argument types
+        int priority = 0;
+        uint64_t args[kMaxArgs] = {};           // Raw argument bytes
+    };
+
+    // Receives each formatted message (default: SA_LOG_PRINT)
+    using Sink = void (*)(int priority, const char* tag, const char* message);
+
+    namespace detail {
+
+        template<typename T>
+        constexpr bool kLoggable = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+        template<typename T>
+        inline uint64_t pack(T value) noexcept {
+            static_assert(kLoggable<T>, "RT log arguments must be arithmetic, enum or pointer values");
+            static_assert(sizeof(T) <= sizeof(uint64_t), "RT log argument too large");
+            uint64_t raw = 0;
+            std::memcpy(&raw, &value, sizeof(T));
+            return raw;
+        }
+
+        template<typename T>
+        inline T unpack(uint64_t raw) noexcept {
+            T value;
+            std::memcpy(&value, &raw, sizeof(T));
+            return value;
+        }
+
+        template<typename... Args, size_t... I>
+        int formatWith(const Record& record, char* out, size_t size, std::index_sequence<I...>) noexcept {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+            return std::snprintf(out, size, record.format, unpack<Args>(record.args[I])...);
+#pragma GCC diagnostic pop
+        }
+
+        template<typename... Args>
+        int format(const Record& record, char* out, size_t size) noexcept {
+            return formatWith<Args...>(record, out, size, std::index_sequence_for<Args...>{});
+        }
+
+        // Never called: lets the compiler check format strings at RT call sites
+        __attribute__((format(printf, 1, 2)))
+        inline void checkFormat(const char*, ...) noexcept {}
+
+    } // namespace detail
+
+    class AsyncLogger {
+    public:
+        AsyncLogger() noexcept;
+        ~AsyncLogger();
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        // 🎙️ Producer side - lock-free, allocation-free, never blocks
+        template<typename... Args>
+        bool log(int priority, const char* tag, const char* format, Args... args) noexcept {
+            static_assert(sizeof...(Args) <= kMaxArgs, "Too many RT log arguments");
+
+            size_t position = 0;
+            Cell* cell = claim(position);
+            if (!cell) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            Record& record = cell->record;
+            record.tag = tag;
+            record.format = format;
+            record.formatter = &detail::format<std::decay_t<Args>...>;
+            record.priority = priority;
+            size_t i = 0;
+            ((record.args[i++] = detail::pack(args)), ...);
+            (void)i;
+
+            publish(cell, position);
+            return true;
+        }
+
+        // 🖨️ Consumer side - formats and emits everything pending
+        size_t drain() noexcept;
+
+        // Background drain thread, reference counted (one per engine start())
+        void startThread();
+        void stopThread();   // Last stop drains what is left
+
+        void setSink(Sink sink) noexcept;
+        uint64_t droppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+        uint64_t emittedCount() const noexcept { return emitted_.load(std::memory_order_relaxed); }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence{0};
+            Record record;
+        };
+
+        Cell* claim(size_t& position) noexcept;
+        static void publish(Cell* cell, size_t position) noexcept;
+        void drainLoop();
+
+        Cell cells_[kCapacity];
+        alignas(64) std::atomic<size_t> enqueuePos_{0};
+        alignas(64) std::atomic<uint64_t> dropped_{0};
+
+        // Consumer state (guarded by drainMutex_)
+        alignas(64) std::mutex drainMutex_;
+        size_t dequeuePos_ = 0;
+        uint64_t reportedDrops_ = 0;
+        std::atomic<Sink> sink_{nullptr};
+        std::atomic<uint64_t> emitted_{0};
+
+        // Drain thread
+        std::mutex lifecycleMutex_;          // start/stop
+        std::mutex threadMutex_;             // stop_ + wake_
+        std::condition_variable wake_;
+        std::thread thread_;
+        int threadUsers_ = 0;                // Guarded by lifecycleMutex_
+        bool stop_ = false;
+    };
+
+    // Process-wide logger used by the SA_RT_LOG* macros
+    AsyncLogger& logger() noexcept;
+
+} // namespace soundarch::log::rt
+
+#define SA_RT_LOG_PUSH(prio, tag, ...)                                             \
+    do {                                                                           \
+        if (false) ::soundarch::log::rt::detail::checkFormat(__VA_ARGS__);         \
+        ::soundarch::log::rt::logger().log(prio, tag, __VA_ARGS__);                \
+    } while (0)
+
+#if SOUNDARCH_RT_LOG_LEVEL <= 3
+#define SA_RT_LOGD(tag, ...) SA_RT_LOG_PUSH(::soundarch::log::Debug, tag, __VA_ARGS__)
+#else
+#define SA_RT_LOGD(tag, ...) do {} while (0)
+#endif
+
+#if SOUNDARCH_RT_LOG_LEVEL <= 4
+#define SA_RT_LOGI(tag, ...) SA_RT_LOG_PUSH(::soundarch::log::Info, tag, __VA_ARGS__)
+#else
+#define SA_RT_LOGI(tag, ...) do {} while (0)
+#endif
+
+#if SOUNDARCH_RT_LOG_LEVEL <= 5
+#define SA_RT_LOGW(tag, ...) SA_RT_LOG_PUSH(::soundarch::log::Warn, tag, __VA_ARGS__)
+#else
+#define SA_RT_LOGW(tag, ...) do {} while (0)
+#endif
+
+#if SOUNDARCH_RT_LOG_LEVEL <= 6
+#define SA_RT_LOGE(tag, ...) SA_RT_LOG_PUSH(::soundarch::log::Error, tag, __VA_ARGS__)
+#else
+#define SA_RT_LOGE(tag, ...) do {} while (0)
+#endif
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// ==============================================================================
+// 🔐 SEQLOCK SNAPSHOT - One writer, any number of readers, no tearing
+// ==============================================================================
+//
+// Writer (never waits):
+//   sequence → odd, copy payload, sequence → even
+// Reader (retries only while a write overlaps its copy):
+//   read sequence (even), copy payload, re-read sequence, retry if it moved
+//
+// The payload is stored as relaxed atomic 64-bit words, so the concurrent
+// copy is race-free under the C++ memory model (and clean under TSan), and
+// compiles to plain loads/stores on ARM64 and x86-64.
+//
+// Used where a latest value must be read by several threads at once (JNI
+// getters, UI polling, BluetoothBridge). For a single reader, TripleBuffer
+// avoids the retry entirely.
+//
+// ==============================================================================
+
+namespace soundarch::utils {
+
+    template<typename T>
+    class SeqLock {
+        static_assert(std::is_trivially_copyable_v<T>, "SeqLock payload is copied word by word");
+
+        static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    public:
+        SeqLock() noexcept { write(T{}); }
+
+        // Single writer thread at a time (wait-free)
+        void write(const T& value) noexcept {
+            uint64_t words[kWords] = {};
+            std::memcpy(words, &value, sizeof(T));
+
+            const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+            sequence_.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (size_t i = 0; i < kWords; ++i) {
+                words_[i].store(words[i], std::memory_order_relaxed);
+            }
+
+            sequence_.store(sequence + 2, std::memory_order_release);
+        }
+
+        // Any thread: consistent copy of the last complete write
+        T read() const noexcept {
+            uint64_t words[kWords];
+            for (;;) {
+                const uint32_t before = sequence_.load(std::memory_order_acquire);
+                if (before & 1u) continue;   // Write in progress
+
+                for (size_t i = 0; i < kWords; ++i) {
+                    words[i] = words_[i].load(std::memory_order_relaxed);
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == before) break;
+            }
+
+            T value;
+            std::memcpy(&value, words, sizeof(T));
+            return value;
+        }
+
+        // Number of completed writes (even values only)
+        uint32_t version() const noexcept { return sequence_.load(std::memory_order_acquire) / 2; }
+
+    private:
+        alignas(64) std::atomic<uint32_t> sequence_{0};
+        std::atomic<uint64_t> words_[kWords];
+    };
+
+} // namespace soundarch::utils
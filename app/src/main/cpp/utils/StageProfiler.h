@@ -0,0 +1,180 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "CycleCounter.h"
+#include "LatencyHistogram.h"
+#include "TraceRecorder.h"
+
+// ==============================================================================
+// ⏱️ STAGE PROFILER - Always-on per-stage timing of the audio callback
+// ==============================================================================
+//
+// The callback timestamps each stage boundary with readCycles() and records
+// the delta into that stage's LatencyHistogram. Cost per stage: one counter
+// read + three relaxed load/store pairs. Nothing is converted, sorted or
+// formatted on the audio thread.
+//
+//   OboeEngine::onAudioReady()
+//     ├─ Input           mic read + ring buffer push
+//     ├─ Dsp             ring buffer pop + whole audioCallback()
+//     │    ├─ AGC, Equalizer, VoiceGain, NoiseCanceller, Compressor, Limiter
+//     │    │  (DSPChain::processBlock, only when the stage actually ran)
+//     ├─ Metering        peak/RMS loop
+//     └─ Callback        total, plus budget = total / buffer period
+//
+// Readers (telemetry, JNI, benchmarks) query percentiles in nanoseconds at any
+// time; reset() only while the stream is stopped.
+//
+// With a TraceTrack attached, every lap() is also emitted as a span on the
+// trace timeline while the recorder runs (same timestamps, no extra reads).
+//
+// ==============================================================================
+
+namespace soundarch::utils {
+
+    enum class Stage : int {
+        Input = 0,
+        Dsp,
+        AGC,
+        Equalizer,
+        VoiceGain,
+        NoiseCanceller,
+        Compressor,
+        Limiter,
+        FusedChain,     // AGC → Limiter in one pass (DSPChain fused path)
+        Metering,
+        Callback,
+        Count
+    };
+
+    constexpr int kStageCount = static_cast<int>(Stage::Count);
+
+    inline const char* stageName(Stage stage) noexcept {
+        switch (stage) {
+            case Stage::Input: return "input";
+            case Stage::Dsp: return "dsp";
+            case Stage::AGC: return "agc";
+            case Stage::Equalizer: return "equalizer";
+            case Stage::VoiceGain: return "voice_gain";
+            case Stage::NoiseCanceller: return "noise_canceller";
+            case Stage::Compressor: return "compressor";
+            case Stage::Limiter: return "limiter";
+            case Stage::FusedChain: return "fused_chain";
+            case Stage::Metering: return "metering";
+            case Stage::Callback: return "callback";
+            default: return "?";
+        }
+    }
+
+    struct StageSummary {
+        uint64_t count = 0;
+        double p50Ns = 0.0;
+        double p99Ns = 0.0;
+        double p999Ns = 0.0;
+        double maxNs = 0.0;
+    };
+
+    // Callback duration as a fraction of the buffer period (1.0 = deadline)
+    struct BudgetSummary {
+        uint64_t count = 0;
+        double p50 = 0.0;
+        double p99 = 0.0;
+        double p999 = 0.0;
+        double max = 0.0;
+        uint64_t deadlineMisses = 0;   // Callbacks longer than their buffer period
+    };
+
+    class StageProfiler {
+    public:
+        // Budget histogram resolution: 1/10000 of the buffer period
+        static constexpr uint64_t kBudgetScale = 10000;
+
+        // ━━━ Audio thread ━━━
+        static uint64_t now() noexcept { return readCycles(); }
+
+        void record(Stage stage, uint64_t ticks) noexcept {
+            histograms_[static_cast<int>(stage)].record(ticks);
+        }
+
+        // Records [since, now) for stage and returns now (chains stage boundaries)
+        uint64_t lap(Stage stage, uint64_t since) noexcept {
+            const uint64_t t = readCycles();
+            record(stage, t - since);
+            if (trace_) trace_->complete(stageName(stage), since, t);
+            return t;
+        }
+
+        // Total callback time against the period of numFrames at sampleRate
+        void recordCallback(uint64_t ticks, int32_t numFrames, int32_t sampleRate) noexcept {
+            record(Stage::Callback, ticks);
+            if (numFrames <= 0 || sampleRate <= 0) return;
+
+            if (numFrames != periodFrames_ || sampleRate != periodRate_) {
+                periodFrames_ = numFrames;
+                periodRate_ = sampleRate;
+                periodTicks_ = static_cast<uint64_t>(ticksPerSecond_ * numFrames / sampleRate);
+                if (periodTicks_ == 0) periodTicks_ = 1;
+            }
+
+            budget_.record(ticks * kBudgetScale / periodTicks_);
+            if (ticks > periodTicks_) {
+                deadlineMisses_.store(deadlineMisses_.load(std::memory_order_relaxed) + 1,
+                                      std::memory_order_relaxed);
+            }
+        }
+
+        // ━━━ Control thread ━━━
+        // Track the audio thread emits stage spans into (set before the stream starts)
+        void setTrace(TraceTrack* track) noexcept { trace_ = track; }
+
+        // Clears everything and caches the counter frequency (calibrates on x86)
+        void reset() noexcept {
+            for (auto& h : histograms_) h.reset();
+            budget_.reset();
+            deadlineMisses_.store(0, std::memory_order_relaxed);
+            ticksPerSecond_ = cycleCounterFrequency();
+            periodFrames_ = 0;
+            periodRate_ = 0;
+            periodTicks_ = 1;
+        }
+
+        // ━━━ Any thread ━━━
+        StageSummary summary(Stage stage) const noexcept {
+            const LatencyHistogram& h = histograms_[static_cast<int>(stage)];
+            StageSummary s;
+            s.count = h.count();
+            if (s.count == 0) return s;
+            s.p50Ns = cyclesToNanos(h.percentile(0.50));
+            s.p99Ns = cyclesToNanos(h.percentile(0.99));
+            s.p999Ns = cyclesToNanos(h.percentile(0.999));
+            s.maxNs = cyclesToNanos(h.max());
+            return s;
+        }
+
+        BudgetSummary budget() const noexcept {
+            BudgetSummary s;
+            s.count = budget_.count();
+            s.deadlineMisses = deadlineMisses_.load(std::memory_order_relaxed);
+            if (s.count == 0) return s;
+            constexpr double kScale = static_cast<double>(kBudgetScale);
+            s.p50 = static_cast<double>(budget_.percentile(0.50)) / kScale;
+            s.p99 = static_cast<double>(budget_.percentile(0.99)) / kScale;
+            s.p999 = static_cast<double>(budget_.percentile(0.999)) / kScale;
+            s.max = static_cast<double>(budget_.max()) / kScale;
+            return s;
+        }
+
+    private:
+        LatencyHistogram histograms_[kStageCount];
+        LatencyHistogram budget_;
+        std::atomic<uint64_t> deadlineMisses_{0};
+        TraceTrack* trace_ = nullptr;
+
+        // Audio thread cache of the current buffer period
+        double ticksPerSecond_ = 1e9;
+        int32_t periodFrames_ = 0;
+        int32_t periodRate_ = 0;
+        uint64_t periodTicks_ = 1;
+    };
+
+} // namespace soundarch::utils
@@ -0,0 +1,66 @@
+#include "SystemStats.h"
+#include <cinttypes>
+#include <cstdio>
+
+namespace soundarch::utils {
+
+    bool readMemoryInfo(MemoryInfo& out) noexcept {
+        FILE* meminfoFile = fopen("/proc/meminfo", "r");
+        if (!meminfoFile) return false;
+
+        uint64_t memTotal = 0;
+        uint64_t memAvailable = 0;
+        char line[256];
+
+        while (fgets(line, sizeof(line), meminfoFile)) {
+            if (sscanf(line, "MemTotal: %" SCNu64 " kB", &memTotal) == 1) {
+                memTotal *= 1024;  // Convert to bytes
+            } else if (sscanf(line, "MemAvailable: %" SCNu64 " kB", &memAvailable) == 1) {
+                memAvailable *= 1024;  // Convert to bytes
+                break;  // Got both values
+            }
+        }
+        fclose(meminfoFile);
+
+        if (memTotal == 0 || memAvailable == 0) return false;
+
+        out.totalBytes = memTotal;
+        out.availableBytes = memAvailable;
+        out.usedBytes = memTotal - memAvailable;
+        out.usagePercent = 100.0f * static_cast<float>(out.usedBytes) / static_cast<float>(memTotal);
+        return true;
+    }
+
+    bool CpuUsageSampler::sample(float& usagePercent) noexcept {
+        FILE* statFile = fopen("/proc/stat", "r");
+        if (!statFile) return false;
+
+        char cpuLabel[16];
+        uint64_t user, nice, system, idle, iowait, irq, softirq, steal;
+        const int fields = fscanf(statFile,
+                                  "%15s %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64
+                                  " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64,
+                                  cpuLabel, &user, &nice, &system, &idle, &iowait, &irq, &softirq, &steal);
+        fclose(statFile);
+        if (fields != 9) return false;
+
+        const uint64_t totalCpuTime = user + nice + system + idle + iowait + irq + softirq + steal;
+        const uint64_t idleCpuTime = idle + iowait;
+
+        bool valid = false;
+        if (prevTotalCpuTime_ > 0) {
+            const uint64_t totalDelta = totalCpuTime - prevTotalCpuTime_;
+            const uint64_t idleDelta = idleCpuTime - prevIdleCpuTime_;
+
+            if (totalDelta > 0) {
+                usagePercent = 100.0f * (1.0f - static_cast<float>(idleDelta) / static_cast<float>(totalDelta));
+                valid = true;
+            }
+        }
+
+        prevTotalCpuTime_ = totalCpuTime;
+        prevIdleCpuTime_ = idleCpuTime;
+        return valid;
+    }
+
+} // namespace soundarch::utils
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+
+// ==============================================================================
+// 💻 SYSTEM STATS - CPU / RAM sampling from /proc (NOT real-time safe)
+// ==============================================================================
+//
+// fopen/fscanf on procfs can block on kernel locks and page faults: call these
+// from the telemetry thread or the UI thread, never from an audio callback.
+//
+// ==============================================================================
+
+namespace soundarch::utils {
+
+    struct MemoryInfo {
+        uint64_t totalBytes = 0;
+        uint64_t availableBytes = 0;
+        uint64_t usedBytes = 0;
+        float usagePercent = 0.0f;
+    };
+
+    // /proc/meminfo → MemTotal / MemAvailable. False if unreadable.
+    bool readMemoryInfo(MemoryInfo& out) noexcept;
+
+    // System-wide CPU usage from successive /proc/stat samples
+    class CpuUsageSampler {
+    public:
+        // Usage since the previous call, in percent. False on the first call
+        // (no baseline yet) or if /proc/stat cannot be read.
+        bool sample(float& usagePercent) noexcept;
+
+    private:
+        uint64_t prevTotalCpuTime_ = 0;
+        uint64_t prevIdleCpuTime_ = 0;
+    };
+
+} // namespace soundarch::utils
@@ -0,0 +1,257 @@
+#include "TraceRecorder.h"
+#include <chrono>
+#include "CycleCounter.h"
+
+namespace soundarch::utils {
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🎙️ PRODUCER SIDE (RT-safe)
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    void TraceTrack::push(const TraceEvent& event) noexcept {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= kCapacity) {
+            dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        events_[head & (kCapacity - 1)] = event;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    void TraceTrack::complete(const char* name, uint64_t start, uint64_t end,
+                              const char* argName0, int64_t arg0,
+                              const char* argName1, int64_t arg1) noexcept {
+        if (!enabled()) return;
+        TraceEvent e;
+        e.timestamp = start;
+        e.duration = end - start;
+        e.name = name;
+        e.argName[0] = argName0;
+        e.arg[0] = arg0;
+        e.argName[1] = argName1;
+        e.arg[1] = arg1;
+        e.phase = 'X';
+        push(e);
+    }
+
+    void TraceTrack::counter(const char* name, const char* series, int64_t value) noexcept {
+        if (!enabled()) return;
+        TraceEvent e;
+        e.timestamp = readCycles();
+        e.name = name;
+        e.argName[0] = series;
+        e.arg[0] = value;
+        e.phase = 'C';
+        push(e);
+    }
+
+    void TraceTrack::instant(const char* name, const char* argName, int64_t arg) noexcept {
+        if (!enabled()) return;
+        TraceEvent e;
+        e.timestamp = readCycles();
+        e.name = name;
+        e.argName[0] = argName;
+        e.arg[0] = arg;
+        e.phase = 'i';
+        push(e);
+    }
+
+    size_t TraceTrack::pop(TraceEvent* out, size_t max) noexcept {
+        if (!events_) return 0;
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t available = head_.load(std::memory_order_acquire) - tail;
+        const size_t n = available < max ? available : max;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = events_[(tail + i) & (kCapacity - 1)];
+        }
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🎞️ RECORDER (control + drain thread)
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    TraceRecorder::~TraceRecorder() {
+        stop();
+    }
+
+    TraceTrack* TraceRecorder::addTrack(const char* name) noexcept {
+        if (trackCount_ >= kMaxTracks) return nullptr;
+        TraceTrack& track = tracks_[trackCount_++];
+        track.name_ = name;
+        return &track;
+    }
+
+    bool TraceRecorder::start(double windowSeconds, bool drainThread) {
+        if (windowSeconds <= 0.0) return false;
+        stop();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            TraceEvent discard[256];
+            for (int i = 0; i < trackCount_; ++i) {
+                TraceTrack& track = tracks_[i];
+                if (!track.events_) track.events_.reset(new TraceEvent[TraceTrack::kCapacity]);
+                while (track.pop(discard, 256) > 0) {
+                    // Leftovers of a previous session
+                }
+                track.dropped_.store(0, std::memory_order_relaxed);
+            }
+
+            window_.clear();
+            dumpPath_.clear();
+            stopRequested_ = false;
+            origin_ = readCycles();
+            newest_ = origin_;
+            windowTicks_ = static_cast<uint64_t>(windowSeconds * cycleCounterFrequency());
+        }
+
+        for (int i = 0; i < trackCount_; ++i) tracks_[i].enabled_.store(true, std::memory_order_release);
+        recording_.store(true, std::memory_order_relaxed);
+
+        if (drainThread) thread_ = std::thread(&TraceRecorder::threadLoop, this);
+        return true;
+    }
+
+    void TraceRecorder::stop() {
+        for (int i = 0; i < trackCount_; ++i) tracks_[i].enabled_.store(false, std::memory_order_release);
+        recording_.store(false, std::memory_order_relaxed);
+
+        if (thread_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopRequested_ = true;
+            }
+            wake_.notify_all();
+            thread_.join();
+        }
+
+        // Keep what was recorded up to now: the window can still be dumped
+        std::lock_guard<std::mutex> lock(mutex_);
+        drainLocked();
+    }
+
+    void TraceRecorder::drain() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        drainLocked();
+    }
+
+    void TraceRecorder::drainLocked() {
+        TraceEvent batch[256];
+        for (int i = 0; i < trackCount_; ++i) {
+            size_t n;
+            while ((n = tracks_[i].pop(batch, 256)) > 0) {
+                for (size_t k = 0; k < n; ++k) {
+                    if (batch[k].timestamp < origin_) continue;   // Straggler from a previous session
+                    const uint64_t end = batch[k].timestamp + batch[k].duration;
+                    if (end > newest_) newest_ = end;
+                    window_.push_back({batch[k], i});
+                }
+            }
+        }
+
+        // Rolling window: drop what ended before newest - window
+        const uint64_t cutoff = newest_ > origin_ + windowTicks_ ? newest_ - windowTicks_ : origin_;
+        while (!window_.empty()) {
+            const TraceEvent& e = window_.front().event;
+            if (e.timestamp + e.duration >= cutoff) break;
+            window_.pop_front();
+        }
+    }
+
+    bool TraceRecorder::writeChromeTrace(FILE* out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        drainLocked();
+        return writeLocked(out);
+    }
+
+    bool TraceRecorder::writeLocked(FILE* out) {
+        if (!out) return false;
+        const double usPerTick = 1e6 / cycleCounterFrequency();
+        const uint64_t cutoff = newest_ > origin_ + windowTicks_ ? newest_ - windowTicks_ : origin_;
+
+        std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", out);
+        std::fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"SoundArch\"}}", out);
+        for (int i = 0; i < trackCount_; ++i) {
+            std::fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                         i + 1, tracks_[i].name_);
+        }
+
+        for (const Entry& entry : window_) {
+            const TraceEvent& e = entry.event;
+            if (e.timestamp + e.duration < cutoff) continue;   // Other tracks may interleave older events
+
+            const double ts = static_cast<double>(e.timestamp - origin_) * usPerTick;
+            std::fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f",
+                         e.name, e.phase, entry.track + 1, ts);
+            if (e.phase == 'X') std::fprintf(out, ",\"dur\":%.3f", static_cast<double>(e.duration) * usPerTick);
+            if (e.phase == 'i') std::fputs(",\"s\":\"t\"", out);
+
+            if (e.argName[0]) {
+                std::fprintf(out, ",\"args\":{\"%s\":%lld", e.argName[0], static_cast<long long>(e.arg[0]));
+                if (e.argName[1]) std::fprintf(out, ",\"%s\":%lld", e.argName[1], static_cast<long long>(e.arg[1]));
+                std::fputc('}', out);
+            }
+            std::fputc('}', out);
+        }
+
+        uint64_t dropped = 0;
+        for (int i = 0; i < trackCount_; ++i) dropped += tracks_[i].droppedCount();
+        std::fprintf(out, "\n],\"otherData\":{\"window_seconds\":%.3f,\"dropped_events\":%llu}}\n",
+                     static_cast<double>(windowTicks_) * usPerTick * 1e-6, static_cast<unsigned long long>(dropped));
+        return std::ferror(out) == 0;
+    }
+
+    void TraceRecorder::requestDump(const std::string& path) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            dumpPath_ = path;
+        }
+        if (thread_.joinable()) {
+            wake_.notify_all();
+            return;
+        }
+
+        // No drain thread (stopped or manual mode): write right away
+        std::lock_guard<std::mutex> lock(mutex_);
+        drainLocked();
+        if (FILE* f = std::fopen(dumpPath_.c_str(), "w")) {
+            writeLocked(f);
+            std::fclose(f);
+        }
+        dumpPath_.clear();
+        dumpCount_.fetch_add(1, std::memory_order_release);
+    }
+
+    size_t TraceRecorder::windowEventCount() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        drainLocked();
+        return window_.size();
+    }
+
+    uint64_t TraceRecorder::droppedCount() const noexcept {
+        uint64_t dropped = 0;
+        for (int i = 0; i < trackCount_; ++i) dropped += tracks_[i].droppedCount();
+        return dropped;
+    }
+
+    void TraceRecorder::threadLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopRequested_) {
+            wake_.wait_for(lock, std::chrono::milliseconds(50),
+                           [this] { return stopRequested_ || !dumpPath_.empty(); });
+            drainLocked();
+
+            if (!dumpPath_.empty()) {
+                if (FILE* f = std::fopen(dumpPath_.c_str(), "w")) {
+                    writeLocked(f);
+                    std::fclose(f);
+                }
+                dumpPath_.clear();
+                dumpCount_.fetch_add(1, std::memory_order_release);
+            }
+        }
+    }
+
+} // namespace soundarch::utils
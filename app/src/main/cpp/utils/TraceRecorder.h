@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// ==============================================================================
+// 🎞️ TRACE RECORDER - Callback timeline → Chrome trace-event JSON
+// ==============================================================================
+//
+// Flight recorder for field sessions: the last N seconds of callbacks, stage
+// spans, ring buffer fill, XRuns and Safe Mode transitions, viewable in
+// chrome://tracing or ui.perfetto.dev.
+//
+//   Producer thread (audio callback, telemetry thread) - one TraceTrack each:
+//     - Fixed-size event: timestamp (readCycles()), duration, literal name,
+//       up to two integer args
+//     - Pushed into the track's preallocated SPSC ring: no allocation, no
+//       lock, no formatting; ring full → event dropped and counted
+//     - Not recording → one relaxed load and return
+//
+//   Drain thread (TraceRecorder, while recording):
+//     - Every 50 ms moves events into the rolling window (older events than
+//       windowSeconds are discarded)
+//     - Serializes the window to JSON on requestDump(path)
+//
+// Tracks are added before start(); rings are allocated on the first start()
+// and kept until destruction (a late producer can never hit freed memory).
+//
+// ==============================================================================
+
+namespace soundarch::utils {
+
+    struct TraceEvent {
+        uint64_t timestamp = 0;            // readCycles()
+        uint64_t duration = 0;             // Complete events, ticks
+        const char* name = nullptr;        // String literal
+        const char* argName[2] = {nullptr, nullptr};
+        int64_t arg[2] = {0, 0};
+        char phase = 0;                    // 'X' complete, 'C' counter, 'i' instant
+    };
+
+    class TraceTrack {
+    public:
+        static constexpr size_t kCapacity = 8192;   // Events (power of two), ~3 s of audio callbacks
+
+        // ━━━ Producer (the track's own thread) ━━━
+        bool enabled() const noexcept { return enabled_.load(std::memory_order_acquire); }
+
+        // Span [start, end) in readCycles() ticks
+        void complete(const char* name, uint64_t start, uint64_t end,
+                      const char* argName0 = nullptr, int64_t arg0 = 0,
+                      const char* argName1 = nullptr, int64_t arg1 = 0) noexcept;
+
+        // Counter track value (drawn as a graph)
+        void counter(const char* name, const char* series, int64_t value) noexcept;
+
+        // Point event (XRun, mode switch)
+        void instant(const char* name, const char* argName = nullptr, int64_t arg = 0) noexcept;
+
+        // ━━━ Any thread ━━━
+        const char* name() const noexcept { return name_; }
+        uint64_t droppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        friend class TraceRecorder;
+
+        void push(const TraceEvent& event) noexcept;
+        size_t pop(TraceEvent* out, size_t max) noexcept;   // Drain thread
+
+        const char* name_ = nullptr;
+        std::atomic<bool> enabled_{false};
+        std::unique_ptr<TraceEvent[]> events_;
+        alignas(64) std::atomic<size_t> head_{0};   // Next write (producer)
+        alignas(64) std::atomic<size_t> tail_{0};   // Next read (drain)
+        std::atomic<uint64_t> dropped_{0};
+    };
+
+    class TraceRecorder {
+    public:
+        static constexpr int kMaxTracks = 4;
+
+        TraceRecorder() = default;
+        ~TraceRecorder();
+
+        TraceRecorder(const TraceRecorder&) = delete;
+        TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+        // Control thread, before the first start(). nullptr once kMaxTracks are in use.
+        TraceTrack* addTrack(const char* name) noexcept;
+
+        /**
+         * Starts recording a rolling window of the last windowSeconds.
+         * @param drainThread false = the caller pumps drain() itself (tests, simulated devices)
+         */
+        bool start(double windowSeconds, bool drainThread = true);
+        void stop();
+        bool isRecording() const noexcept { return recording_.load(std::memory_order_relaxed); }
+
+        // Moves pending events into the window (no-op while the drain thread owns it)
+        void drain();
+
+        // Writes the current window as Chrome trace-event JSON (any non-RT thread)
+        bool writeChromeTrace(FILE* out);
+
+        // Asks the drain thread to write the window to path; dumpCount() increments when done
+        void requestDump(const std::string& path);
+        uint32_t dumpCount() const noexcept { return dumpCount_.load(std::memory_order_acquire); }
+
+        size_t windowEventCount();
+        uint64_t droppedCount() const noexcept;
+
+    private:
+        struct Entry {
+            TraceEvent event;
+            int track;
+        };
+
+        void drainLocked();
+        bool writeLocked(FILE* out);
+        void threadLoop();
+
+        TraceTrack tracks_[kMaxTracks];
+        int trackCount_ = 0;
+
+        std::atomic<bool> recording_{false};
+        uint64_t origin_ = 0;               // Session start (ticks)
+        uint64_t windowTicks_ = 0;
+        uint64_t newest_ = 0;
+
+        std::mutex mutex_;                  // window_, dumpPath_, stop flag
+        std::condition_variable wake_;
+        std::deque<Entry> window_;
+        std::string dumpPath_;
+        bool stopRequested_ = false;
+        std::thread thread_;
+        std::atomic<uint32_t> dumpCount_{0};
+    };
+
+} // namespace soundarch::utils
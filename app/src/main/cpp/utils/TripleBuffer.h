@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// ==============================================================================
+// 🔁 WAIT-FREE TRIPLE BUFFER - Latest-value handoff, one writer / one reader
+// ==============================================================================
+//
+// The writer always has a private slot to fill, the reader always has a
+// private slot to read, and the third slot is exchanged between them with a
+// single atomic swap. Neither side ever waits or retries:
+//   - write(): copy into back slot, swap it with the middle slot (marked fresh)
+//   - read():  if the middle slot is fresh, swap it with the front slot
+//
+// Intermediate values are overwritten when the reader is slower than the
+// writer - this is a "latest snapshot" channel, not a queue.
+//
+// Usage (OboeEngine):
+//   - Writer: audio callback publishes raw counters at 10Hz
+//   - Reader: telemetry thread turns them into LatencyStats / PerformanceMetrics
+//
+// ==============================================================================
+
+namespace soundarch::utils {
+
+    template<typename T>
+    class TripleBuffer {
+        static_assert(std::is_trivially_copyable_v<T>, "TripleBuffer slots are copied with plain stores");
+
+        static constexpr uint8_t kIndexMask = 0x3;
+        static constexpr uint8_t kFresh = 0x4;
+
+    public:
+        // Writer side (wait-free)
+        void write(const T& value) noexcept {
+            slots_[back_].value = value;
+            back_ = middle_.exchange(static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel) & kIndexMask;
+        }
+
+        // Reader side (wait-free). Returns false if nothing new since the last read.
+        bool read(T& out) noexcept {
+            if (!(middle_.load(std::memory_order_relaxed) & kFresh)) return false;
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+            out = slots_[front_].value;
+            return true;
+        }
+
+        // Drops any unread value. Only while neither side is running.
+        void reset() noexcept {
+            back_ = 0;
+            middle_.store(1, std::memory_order_relaxed);
+            front_ = 2;
+        }
+
+    private:
+        struct alignas(64) Slot {
+            T value{};
+        };
+
+        Slot slots_[3];
+        alignas(64) std::atomic<uint8_t> middle_{1};
+        alignas(64) uint8_t back_ = 0;     // Writer only
+        alignas(64) uint8_t front_ = 2;    // Reader only
+    };
+
+} // namespace soundarch::utils
@@ -13,6 +13,8 @@ import androidx.core.content.ContextCompat
 import androidx.lifecycle.viewmodel.compose.viewModel
 import androidx.navigation.compose.rememberNavController
 import com.soundarch.data.FeatureTogglesDataStore
+import com.soundarch.engine.MetricsSnapshot
+import com.soundarch.engine.SharedControlBlock
 import com.soundarch.ui.navigation.NavGraph
 import com.soundarch.theme.SoundArchTheme
 import com.soundarch.viewmodel.BluetoothViewModel
@@ -26,6 +28,7 @@ import dagger.hilt.android.AndroidEntryPoint
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.delay
 import kotlinx.coroutines.launch
+import java.nio.ByteBuffer
 
 @AndroidEntryPoint
 class MainActivity : ComponentActivity() {
@@ -182,6 +185,29 @@ class MainActivity : ComponentActivity() {
     external fun getXRunCount(): Int
     external fun getCallbackSize(): Int
 
+    /**
+     * Whole metrics snapshot in one JNI call (consistent, no tearing between fields).
+     * @param out DoubleArray of at least MetricsSnapshot.FIELD_COUNT, reused across calls
+     * @return Number of fields written (0 if out is too small)
+     */
+    external fun getMetricsSnapshot(out: DoubleArray): Int
+
+    /**
+     * Per-stage callback timing histograms (p50/p99/p99.9/max) and CPU budget.
+     * @param out DoubleArray of at least StageTimings.FIELD_COUNT, reused across calls
+     * @return Number of fields written (0 if out is too small)
+     */
+    external fun getStageTimings(out: DoubleArray): Int
+
+    /**
+     * Callback timeline recorder (flight recorder of the last windowSeconds).
+     * dumpTrace() writes Chrome trace-event JSON from a native background thread;
+     * open it in chrome://tracing or ui.perfetto.dev.
+     */
+    external fun startTrace(windowSeconds: Float): Boolean
+    external fun stopTrace()
+    external fun dumpTrace(path: String): Boolean
+
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // AUDIO LEVELS MONITORING (Peak/RMS Meter)
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -189,6 +215,65 @@ class MainActivity : ComponentActivity() {
     external fun getPeakDb(): Float
     external fun getRmsDb(): Float
 
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // SHARED CONTROL BLOCK (parameters in, meters out, no JNI per field)
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    external fun getSharedControlBlock(): ByteBuffer?
+
+    /** Null if the native layout differs: the push* helpers then use the JNI setters */
+    private val sharedControl: SharedControlBlock? by lazy {
+        SharedControlBlock.wrap(getSharedControlBlock()).also {
+            Log.i(TAG, if (it != null) "🧩 Shared control block mapped" else "⚠️ Shared control block unavailable - JNI setters")
+        }
+    }
+
+    // UI writes go through ONE path per parameter (block or JNI, never both)
+    private fun pushEqBands(gains: FloatArray) =
+        sharedControl?.setEqBands(gains) ?: setEqBands(gains)
+
+    private fun pushCompressor(threshold: Float, ratio: Float, attack: Float, release: Float, makeupGain: Float) =
+        sharedControl?.setCompressor(threshold, ratio, attack, release, makeupGain)
+            ?: setCompressor(threshold, ratio, attack, release, makeupGain)
+
+    private fun pushLimiter(threshold: Float, release: Float, lookahead: Float) =
+        sharedControl?.setLimiter(threshold, release, lookahead) ?: setLimiter(threshold, release, lookahead)
+
+    private fun pushAGC(
+        targetLevel: Float, maxGain: Float, minGain: Float, attackTime: Float,
+        releaseTime: Float, noiseThreshold: Float, windowSize: Float
+    ) {
+        val block = sharedControl
+        if (block != null) {
+            block.setAGC(targetLevel, maxGain, minGain, attackTime, releaseTime, noiseThreshold, windowSize)
+            return
+        }
+        setAGCTargetLevel(targetLevel)
+        setAGCMaxGain(maxGain)
+        setAGCMinGain(minGain)
+        setAGCAttackTime(attackTime)
+        setAGCReleaseTime(releaseTime)
+        setAGCNoiseThreshold(noiseThreshold)
+        setAGCWindowSize(windowSize)
+    }
+
+    private fun pushVoiceGain(gainDb: Float) =
+        sharedControl?.setParam(SharedControlBlock.Param.VOICE_GAIN, gainDb) ?: setVoiceGain(gainDb)
+
+    private fun pushEnabled(module: SharedControlBlock.Module, enabled: Boolean) {
+        val block = sharedControl
+        if (block != null) {
+            block.setEnabled(module, enabled)
+            return
+        }
+        when (module) {
+            SharedControlBlock.Module.AGC -> setAGCEnabled(enabled)
+            SharedControlBlock.Module.NOISE_CANCELLER -> setNoiseCancellerEnabled(enabled)
+            SharedControlBlock.Module.COMPRESSOR -> setCompressorEnabled(enabled)
+            SharedControlBlock.Module.LIMITER -> setLimiterEnabled(enabled)
+        }
+    }
+
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // VOICE GAIN CONTROL (Post-EQ, Pre-Dynamics)
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -461,9 +546,9 @@ class MainActivity : ComponentActivity() {
                     Log.i(TAG, "🎚️ EQ Master ${if (eqMasterEnabled) "ENABLED" else "DISABLED"}")
                     // When EQ master is OFF, set all bands to 0 (bypass entire EQ)
                     if (!eqMasterEnabled) {
-                        setEqBands(FloatArray(gains.size) { 0f })
+                        pushEqBands(FloatArray(gains.size) { 0f })
                     } else {
-                        setEqBands(gains.toFloatArray())
+                        pushEqBands(gains.toFloatArray())
                     }
                 }
 
@@ -476,14 +561,14 @@ class MainActivity : ComponentActivity() {
                 // Sync Dynamics toggle (Compressor + Limiter)
                 LaunchedEffect(dynamicsEnabled) {
                     Log.i(TAG, "⚡ Dynamics ${if (dynamicsEnabled) "ENABLED" else "DISABLED"}")
-                    setCompressorEnabled(dynamicsEnabled)
-                    setLimiterEnabled(dynamicsEnabled && limiterEnabled)
+                    pushEnabled(SharedControlBlock.Module.COMPRESSOR, dynamicsEnabled)
+                    pushEnabled(SharedControlBlock.Module.LIMITER, dynamicsEnabled && limiterEnabled)
                 }
 
                 // Sync Noise Cancelling toggle
                 LaunchedEffect(noiseCancellingEnabled) {
                     Log.i(TAG, "🔇 Noise Cancellation ${if (noiseCancellingEnabled) "ENABLED" else "DISABLED"}")
-                    setNoiseCancellerEnabled(noiseCancellingEnabled)
+                    pushEnabled(SharedControlBlock.Module.NOISE_CANCELLER, noiseCancellingEnabled)
                 }
 
                 // Sync Noise Cancelling parameters to native layer
@@ -516,14 +601,28 @@ class MainActivity : ComponentActivity() {
                 }
 
                 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-                // 📊 MONITORING - Throttled by UI Mode
+                // 📊 MONITORING
                 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
-                // Friendly mode: 200ms (5 FPS) for audio meters
-                // Advanced mode: 100ms (10 FPS) for audio meters
+                // Audio meters: display rate from the shared control block
+                // (plain memory reads, no JNI). Without it, polled over JNI:
+                // Friendly mode 200ms (5 FPS), Advanced mode 100ms (10 FPS)
                 // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 
-                // Update audio levels (Peak/RMS) - throttled by UI mode
+                // Update audio levels (Peak/RMS)
                 LaunchedEffect(uiMode) {
+                    val block = sharedControl
+                    if (block != null) {
+                        val meters = SharedControlBlock.Meters()
+                        while (true) {
+                            withFrameNanos { }
+                            // False while the engine is stopped: no state write, no recomposition
+                            if (block.readMeters(meters)) {
+                                peakDb = meters.peakDb
+                                rmsDb = meters.rmsDb
+                            }
+                        }
+                    }
+
                     val meterUpdateRate = if (uiMode == com.soundarch.ui.model.UiMode.FRIENDLY) 200L else 100L
                     while (true) {
                         delay(meterUpdateRate)
@@ -558,16 +657,20 @@ class MainActivity : ComponentActivity() {
 
                 // Update latency breakdown - 500ms (2 FPS) sufficient for monitoring
                 LaunchedEffect(Unit) {
+                    val metricsBuffer = DoubleArray(MetricsSnapshot.FIELD_COUNT)
                     while (true) {
                         delay(500) // 2 FPS for latency metrics
                         try {
-                            latencyInputMs = getLatencyInputMs()
-                            latencyOutputMs = getLatencyOutputMs()
-                            latencyTotalMs = getLatencyTotalMs()
-                            latencyMinMs = getLatencyMinMs()
-                            latencyMaxMs = getLatencyMaxMs()
-                            xRunCount = getXRunCount()
-                            callbackSize = getCallbackSize()
+                            // One JNI crossing, all fields from the same snapshot
+                            if (getMetricsSnapshot(metricsBuffer) == 0) continue
+                            val metrics = MetricsSnapshot.from(metricsBuffer)
+                            latencyInputMs = metrics.latencyInputMs
+                            latencyOutputMs = metrics.latencyOutputMs
+                            latencyTotalMs = metrics.latencyTotalMs
+                            latencyMinMs = metrics.latencyMinMs
+                            latencyMaxMs = metrics.latencyMaxMs
+                            xRunCount = metrics.xRunCount
+                            callbackSize = metrics.callbackSize
                             Log.i("LatencyMonitor", "🎯 IN=%.2fms OUT=%.2fms Total=%.2fms [%.2f-%.2f] XRuns=%d CB=%d".format(
                                 latencyInputMs, latencyOutputMs, latencyTotalMs, latencyMinMs, latencyMaxMs, xRunCount, callbackSize
                             ))
@@ -604,7 +707,7 @@ class MainActivity : ComponentActivity() {
                         debounceJob = scope.launch {
                             delay(10)
                             Log.i(TAG, "EQ update: Band$index=${String.format("%.1f", value)}dB")
-                            setEqBands(gains.toFloatArray())
+                            pushEqBands(gains.toFloatArray())
                         }
                     },
 
@@ -622,7 +725,7 @@ class MainActivity : ComponentActivity() {
                         Log.i(TAG, "Reset all bands to 0dB")
                         eqViewModel.setAllBandGains(List(bands.size) { 0f })
                         debounceJob?.cancel()
-                        setEqBands(FloatArray(bands.size) { 0f })
+                        pushEqBands(FloatArray(bands.size) { 0f })
                     },
 
                     onCompressorChange = { threshold, ratio, attack, release, makeupGain ->
@@ -635,7 +738,7 @@ class MainActivity : ComponentActivity() {
                         debounceJob?.cancel()
                         debounceJob = scope.launch {
                             delay(10)
-                            setCompressor(threshold, ratio, attack, release, makeupGain)
+                            pushCompressor(threshold, ratio, attack, release, makeupGain)
                         }
                     },
 
@@ -646,14 +749,14 @@ class MainActivity : ComponentActivity() {
                         debounceJob?.cancel()
                         debounceJob = scope.launch {
                             delay(10)
-                            setLimiter(threshold, release, 0.0f)
+                            pushLimiter(threshold, release, 0.0f)
                         }
                     },
 
                     onLimiterToggle = { enabled ->
                         Log.i(TAG, if (enabled) "Limiter ENABLED" else "Limiter DISABLED")
                         dynamicsViewModel.setLimiterEnabled(enabled)
-                        setLimiterEnabled(enabled)
+                        pushEnabled(SharedControlBlock.Module.LIMITER, enabled)
                     },
 
                     onAGCChange = { targetLevel, maxGain, minGain, attackTime, releaseTime, noiseThreshold, windowSize ->
@@ -668,20 +771,14 @@ class MainActivity : ComponentActivity() {
                         debounceJob?.cancel()
                         debounceJob = scope.launch {
                             delay(10)
-                            setAGCTargetLevel(targetLevel)
-                            setAGCMaxGain(maxGain)
-                            setAGCMinGain(minGain)
-                            setAGCAttackTime(attackTime)
-                            setAGCReleaseTime(releaseTime)
-                            setAGCNoiseThreshold(noiseThreshold)
-                            setAGCWindowSize(windowSize)
+                            pushAGC(targetLevel, maxGain, minGain, attackTime, releaseTime, noiseThreshold, windowSize)
                         }
                     },
 
                     onAGCToggle = { enabled ->
                         Log.i(TAG, if (enabled) "AGC ENABLED" else "AGC DISABLED")
                         dynamicsViewModel.setAgcEnabled(enabled)
-                        setAGCEnabled(enabled)
+                        pushEnabled(SharedControlBlock.Module.AGC, enabled)
                     },
 
                     onVoiceGainChange = { gainDb ->
@@ -690,7 +787,7 @@ class MainActivity : ComponentActivity() {
                         debounceJob?.cancel()
                         debounceJob = scope.launch {
                             delay(10)
-                            setVoiceGain(gainDb)
+                            pushVoiceGain(gainDb)
                         }
                     },
 
@@ -698,7 +795,7 @@ class MainActivity : ComponentActivity() {
                         Log.i(TAG, "Voice Gain: RESET to 0dB")
                         voiceGainViewModel.resetVoiceGain()
                         debounceJob?.cancel()
-                        resetVoiceGain()
+                        pushVoiceGain(0f)
                     },
 
                     onStart = {
@@ -707,8 +804,8 @@ class MainActivity : ComponentActivity() {
                             startAudio()
                             engineSettingsViewModel.setEngineRunning(true)
 
-                            setEqBands(gains.toFloatArray())
-                            setCompressor(
+                            pushEqBands(gains.toFloatArray())
+                            pushCompressor(
                                 compressorThreshold,
                                 compressorRatio,
                                 compressorAttack,
@@ -717,19 +814,13 @@ class MainActivity : ComponentActivity() {
                             )
 
                             if (limiterEnabled) {
-                                setLimiter(limiterThreshold, limiterRelease, 0.0f)
-                                setLimiterEnabled(true)
+                                pushLimiter(limiterThreshold, limiterRelease, 0.0f)
+                                pushEnabled(SharedControlBlock.Module.LIMITER, true)
                             }
 
                             if (agcEnabled) {
-                                setAGCTargetLevel(agcTargetLevel)
-                                setAGCMaxGain(agcMaxGain)
-                                setAGCMinGain(agcMinGain)
-                                setAGCAttackTime(agcAttackTime)
-                                setAGCReleaseTime(agcReleaseTime)
-                                setAGCNoiseThreshold(agcNoiseThreshold)
-                                setAGCWindowSize(agcWindowSize)
-                                setAGCEnabled(true)
+                                pushAGC(agcTargetLevel, agcMaxGain, agcMinGain, agcAttackTime, agcReleaseTime, agcNoiseThreshold, agcWindowSize)
+                                pushEnabled(SharedControlBlock.Module.AGC, true)
                             }
 
                             Toast.makeText(
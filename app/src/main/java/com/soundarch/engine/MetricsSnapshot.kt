@@ -0,0 +1,70 @@
+package com.soundarch.engine
+
+/**
+ * Engine metrics from one consistent native snapshot (single JNI crossing).
+ *
+ * Filled by `MainActivity.getMetricsSnapshot(DoubleArray)`; the field order
+ * mirrors `MetricsSnapshotField` in native-lib.cpp.
+ */
+data class MetricsSnapshot(
+    val latencyInputMs: Double = 0.0,
+    val latencyOutputMs: Double = 0.0,
+    val latencyTotalMs: Double = 0.0,
+    val latencyEmaMs: Double = 0.0,
+    val latencyMinMs: Double = 0.0,
+    val latencyMaxMs: Double = 0.0,
+    val burstLatencyMs: Double = 0.0,
+    val bufferLatencyMs: Double = 0.0,
+    val ringBufferLatencyMs: Double = 0.0,
+    val perceivedLatencyMs: Double = 0.0,
+    val bluetoothCodecMs: Double = 0.0,
+    val inputFramesPending: Long = 0,
+    val outputFramesPending: Long = 0,
+    val cpuUsagePercent: Float = 0f,
+    val ramUsedBytes: Long = 0,
+    val ramAvailableBytes: Long = 0,
+    val ramUsagePercent: Float = 0f,
+    val xRunCount: Int = 0,
+    val callbackSize: Int = 0,
+    val bufferFillRatio: Float = 0f,
+    val safeModeActive: Boolean = false,
+    val peakDb: Float = -60f,
+    val rmsDb: Float = -60f,
+    val telemetryVersion: Long = 0
+) {
+    companion object {
+        /** Size of the DoubleArray to pass to getMetricsSnapshot() */
+        const val FIELD_COUNT = 24
+
+        /** Decodes a buffer filled by getMetricsSnapshot() */
+        fun from(values: DoubleArray): MetricsSnapshot {
+            require(values.size >= FIELD_COUNT) { "Metrics buffer too small: ${values.size} < $FIELD_COUNT" }
+            return MetricsSnapshot(
+                latencyInputMs = values[0],
+                latencyOutputMs = values[1],
+                latencyTotalMs = values[2],
+                latencyEmaMs = values[3],
+                latencyMinMs = values[4],
+                latencyMaxMs = values[5],
+                burstLatencyMs = values[6],
+                bufferLatencyMs = values[7],
+                ringBufferLatencyMs = values[8],
+                perceivedLatencyMs = values[9],
+                bluetoothCodecMs = values[10],
+                inputFramesPending = values[11].toLong(),
+                outputFramesPending = values[12].toLong(),
+                cpuUsagePercent = values[13].toFloat(),
+                ramUsedBytes = values[14].toLong(),
+                ramAvailableBytes = values[15].toLong(),
+                ramUsagePercent = values[16].toFloat(),
+                xRunCount = values[17].toInt(),
+                callbackSize = values[18].toInt(),
+                bufferFillRatio = values[19].toFloat(),
+                safeModeActive = values[20] != 0.0,
+                peakDb = values[21].toFloat(),
+                rmsDb = values[22].toFloat(),
+                telemetryVersion = values[23].toLong()
+            )
+        }
+    }
+}
@@ -1,20 +1,69 @@
 package com.soundarch.engine
 
+import java.nio.ByteBuffer
+
 /**
- * Native Audio Engine - JNI bridge to C++ audio processing
+ * Native Audio Engine - JNI bridge to one native EngineContext
+ *
+ * Each instance owns a complete DSP chain and shares nothing with the others:
+ * a live instance drives the audio device, offline instances render caller
+ * buffers on whatever thread calls process() (background renders).
+ *
+ * @param live true to open the audio device, false for an offline renderer
  */
-class NativeAudioEngine {
+class NativeAudioEngine(private val live: Boolean = true) : AutoCloseable {
+
+    // EngineContext* on the native side, 0 when not initialized / released
+    private var handle = 0L
 
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // 🎛️ AUDIO ENGINE
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 
-    external fun initialize(sampleRate: Int): Boolean
-    external fun start(): Boolean
-    external fun stop()
-    external fun release()
-    external fun getCurrentLatency(): Double
-    external fun setEqBands(gains: FloatArray)
+    fun initialize(sampleRate: Int): Boolean {
+        if (handle == 0L) handle = nativeCreate(sampleRate, live)
+        return handle != 0L
+    }
+
+    fun start(): Boolean = handle != 0L && nativeStart(handle)
+
+    fun stop() {
+        if (handle != 0L) nativeStop(handle)
+    }
+
+    fun release() {
+        if (handle != 0L) {
+            nativeDestroy(handle)
+            handle = 0L
+        }
+    }
+
+    override fun close() = release()
+
+    fun getCurrentLatency(): Double = if (handle != 0L) nativeGetCurrentLatency(handle) else 0.0
+
+    fun setEqBands(gains: FloatArray) {
+        if (handle != 0L) nativeSetEqBands(handle, gains)
+    }
+
+    fun setParameter(param: SharedControlBlock.Param, value: Float): Boolean =
+        handle != 0L && nativeSetParameter(handle, param.ordinal, value)
+
+    fun setModuleEnabled(module: SharedControlBlock.Module, enabled: Boolean) {
+        if (handle != 0L) nativeSetModuleEnabled(handle, module.ordinal, enabled)
+    }
+
+    /**
+     * Offline instances only: processes the first numFrames samples in place
+     *
+     * @return false for live instances or invalid arguments
+     */
+    fun process(buffer: FloatArray, numFrames: Int = buffer.size): Boolean =
+        handle != 0L && nativeProcess(handle, buffer, numFrames)
+
+    /** Shared control block of this instance (parameters in, meters out) */
+    fun getSharedControlBlock(): SharedControlBlock? =
+        if (handle != 0L) SharedControlBlock.wrap(nativeGetSharedControlBlock(handle)) else null
 
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // 🔇 NOISE CANCELLER
@@ -25,7 +74,8 @@ class NativeAudioEngine {
      *
      * @param enabled true to enable, false to disable (zero CPU cost when disabled)
      */
-    external fun setNoiseCancellerEnabled(enabled: Boolean)
+    fun setNoiseCancellerEnabled(enabled: Boolean) =
+        setModuleEnabled(SharedControlBlock.Module.NOISE_CANCELLER, enabled)
 
     /**
      * Apply a noise cancellation preset
@@ -36,7 +86,9 @@ class NativeAudioEngine {
      *   - 2: Outdoor (high strength, fast attack, long release)
      *   - 3: Office (medium strength, low artifacts)
      */
-    external fun applyNoiseCancellerPreset(presetIndex: Int)
+    fun applyNoiseCancellerPreset(presetIndex: Int) {
+        if (handle != 0L) nativeApplyNoiseCancellerPreset(handle, presetIndex)
+    }
 
     /**
      * Set noise canceller parameters
@@ -49,7 +101,7 @@ class NativeAudioEngine {
      * @param residualBoostDb   Residual boost [-6, +6] dB
      * @param artifactSuppress  Artifact suppression [0.0, 1.0]
      */
-    external fun setNoiseCancellerParams(
+    fun setNoiseCancellerParams(
         strength: Float,
         spectralFloor: Float,
         smoothing: Float,
@@ -57,14 +109,21 @@ class NativeAudioEngine {
         noiseReleaseMs: Float,
         residualBoostDb: Float,
         artifactSuppress: Float
-    )
+    ) {
+        if (handle == 0L) return
+        nativeSetNoiseCancellerParams(
+            handle, strength, spectralFloor, smoothing,
+            noiseAttackMs, noiseReleaseMs, residualBoostDb, artifactSuppress
+        )
+    }
 
     /**
      * Get current noise floor estimate
      *
      * @return Noise floor in dB (e.g., -42.3)
      */
-    external fun getNoiseCancellerNoiseFloor(): Float
+    fun getNoiseCancellerNoiseFloor(): Float =
+        if (handle != 0L) nativeGetNoiseCancellerNoiseFloor(handle) else -100f
 
     /**
      * Get average CPU time per block (requires NC_BENCHMARK build flag)
@@ -72,20 +131,56 @@ class NativeAudioEngine {
      * @return Average CPU time in milliseconds (e.g., 0.015)
      * @note Only available when compiled with -DNC_BENCHMARK flag
      */
-    external fun getNoiseCancellerCpuMs(): Float
+    fun getNoiseCancellerCpuMs(): Float =
+        if (handle != 0L) nativeGetNoiseCancellerCpuMs(handle) else 0f
 
     /**
      * Reset CPU statistics (requires NC_BENCHMARK build flag)
      *
      * @note Only available when compiled with -DNC_BENCHMARK flag
      */
-    external fun resetNoiseCancellerCpuStats()
+    fun resetNoiseCancellerCpuStats() {
+        if (handle != 0L) nativeResetNoiseCancellerCpuStats(handle)
+    }
+
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // 🔌 NATIVE (audio/NativeAudioEngine.cpp)
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+
+    private external fun nativeCreate(sampleRate: Int, live: Boolean): Long
+    private external fun nativeDestroy(handle: Long)
+    private external fun nativeStart(handle: Long): Boolean
+    private external fun nativeStop(handle: Long)
+    private external fun nativeGetCurrentLatency(handle: Long): Double
+    private external fun nativeSetEqBands(handle: Long, gains: FloatArray)
+    private external fun nativeSetParameter(handle: Long, param: Int, value: Float): Boolean
+    private external fun nativeSetModuleEnabled(handle: Long, module: Int, enabled: Boolean)
+    private external fun nativeProcess(handle: Long, buffer: FloatArray, numFrames: Int): Boolean
+    private external fun nativeGetSharedControlBlock(handle: Long): ByteBuffer?
+    private external fun nativeApplyNoiseCancellerPreset(handle: Long, presetIndex: Int)
+    private external fun nativeSetNoiseCancellerParams(
+        handle: Long,
+        strength: Float,
+        spectralFloor: Float,
+        smoothing: Float,
+        noiseAttackMs: Float,
+        noiseReleaseMs: Float,
+        residualBoostDb: Float,
+        artifactSuppress: Float
+    )
+    private external fun nativeGetNoiseCancellerNoiseFloor(handle: Long): Float
+    private external fun nativeGetNoiseCancellerCpuMs(handle: Long): Float
+    private external fun nativeResetNoiseCancellerCpuStats(handle: Long)
 
     companion object {
         init {
             System.loadLibrary("soundarch")
         }
 
+        /** Offline renderer: process() on any background thread, no device */
+        fun offline(sampleRate: Int): NativeAudioEngine? =
+            NativeAudioEngine(live = false).takeIf { it.initialize(sampleRate) }
+
         /**
          * Noise cancellation presets
          */
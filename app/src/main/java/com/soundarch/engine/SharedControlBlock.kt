@@ -0,0 +1,156 @@
+package com.soundarch.engine
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Parameters in, meters out, through native memory instead of one JNI call per field.
+ *
+ * Wraps the DirectByteBuffer from `MainActivity.getSharedControlBlock()`; the
+ * byte layout mirrors `dsp::SharedControlBlock` (SharedControlBlock.h).
+ *
+ * - Setters write the values, then bump the control generation: the audio
+ *   callback picks them up before its next block, through the same parameter
+ *   queue (and smoothing) as the JNI setters.
+ * - [readMeters] copies the meters published after every callback and returns
+ *   false when nothing was published since the last read.
+ *
+ * Once a block is in use, route every write of a parameter through it: a JNI
+ * setter racing a block write of the same parameter can be overtaken by it.
+ *
+ * Not thread-safe: one writer (the UI thread), one meter reader.
+ */
+class SharedControlBlock private constructor(buffer: ByteBuffer) {
+
+    /** Same order as dsp::Param (ParameterQueue.h): ordinal = slot */
+    enum class Param {
+        AGC_TARGET_LEVEL, AGC_MAX_GAIN, AGC_MIN_GAIN, AGC_ATTACK_TIME, AGC_RELEASE_TIME,
+        AGC_NOISE_THRESHOLD, AGC_WINDOW_SIZE,
+        COMPRESSOR_THRESHOLD, COMPRESSOR_RATIO, COMPRESSOR_ATTACK, COMPRESSOR_RELEASE,
+        COMPRESSOR_KNEE, COMPRESSOR_MAKEUP_GAIN,
+        LIMITER_THRESHOLD, LIMITER_RELEASE, LIMITER_LOOKAHEAD,
+        VOICE_GAIN,
+        EQ_BAND_0, EQ_BAND_1, EQ_BAND_2, EQ_BAND_3, EQ_BAND_4,
+        EQ_BAND_5, EQ_BAND_6, EQ_BAND_7, EQ_BAND_8, EQ_BAND_9,
+        DYNAMICS_CONTROL_INTERVAL
+    }
+
+    /** Same order as dsp::ModuleSwitch */
+    enum class Module { AGC, NOISE_CANCELLER, COMPRESSOR, LIMITER }
+
+    /** Latest published meters (reused between reads: no allocation per frame) */
+    class Meters {
+        var peakDb = -60f
+        var rmsDb = -60f
+        var agcGainDb = 0f
+        var agcLevelDb = -60f
+        var compressorReductionDb = 0f
+        var limiterReductionDb = 0f
+        var xRunCount = 0
+        var callbackFrames = 0
+        var safeModeActive = false
+    }
+
+    private val bytes = buffer.order(ByteOrder.nativeOrder())
+    private val control = bytes.getInt(HEADER_CONTROL_OFFSET)
+    private val telemetry = bytes.getInt(HEADER_TELEMETRY_OFFSET)
+    private var lastTelemetryGeneration = -1
+
+    fun setParam(param: Param, value: Float) {
+        put(param, value)
+        bump()
+    }
+
+    fun setEqBands(gains: FloatArray) {
+        for (band in 0 until minOf(gains.size, EQ_BANDS)) {
+            bytes.putFloat(paramOffset(Param.EQ_BAND_0.ordinal + band), gains[band])
+        }
+        bump()
+    }
+
+    fun setCompressor(threshold: Float, ratio: Float, attack: Float, release: Float, makeupGain: Float) {
+        put(Param.COMPRESSOR_THRESHOLD, threshold)
+        put(Param.COMPRESSOR_RATIO, ratio)
+        put(Param.COMPRESSOR_ATTACK, attack)
+        put(Param.COMPRESSOR_RELEASE, release)
+        put(Param.COMPRESSOR_MAKEUP_GAIN, makeupGain)
+        bump()
+    }
+
+    fun setLimiter(threshold: Float, release: Float, lookahead: Float) {
+        put(Param.LIMITER_THRESHOLD, threshold)
+        put(Param.LIMITER_RELEASE, release)
+        put(Param.LIMITER_LOOKAHEAD, lookahead)
+        bump()
+    }
+
+    fun setAGC(
+        targetLevel: Float, maxGain: Float, minGain: Float, attackTime: Float,
+        releaseTime: Float, noiseThreshold: Float, windowSize: Float
+    ) {
+        put(Param.AGC_TARGET_LEVEL, targetLevel)
+        put(Param.AGC_MAX_GAIN, maxGain)
+        put(Param.AGC_MIN_GAIN, minGain)
+        put(Param.AGC_ATTACK_TIME, attackTime)
+        put(Param.AGC_RELEASE_TIME, releaseTime)
+        put(Param.AGC_NOISE_THRESHOLD, noiseThreshold)
+        put(Param.AGC_WINDOW_SIZE, windowSize)
+        bump()
+    }
+
+    fun setEnabled(module: Module, enabled: Boolean) {
+        bytes.putInt(control + CONTROL_SWITCHES + module.ordinal * 4, if (enabled) 1 else 0)
+        bump()
+    }
+
+    /** Copies the meters into [into]; false if no callback ran since the last call */
+    fun readMeters(into: Meters): Boolean {
+        val generation = bytes.getInt(telemetry)
+        if (generation == lastTelemetryGeneration) return false
+        lastTelemetryGeneration = generation
+        into.peakDb = bytes.getFloat(telemetry + 4)
+        into.rmsDb = bytes.getFloat(telemetry + 8)
+        into.agcGainDb = bytes.getFloat(telemetry + 12)
+        into.agcLevelDb = bytes.getFloat(telemetry + 16)
+        into.compressorReductionDb = bytes.getFloat(telemetry + 20)
+        into.limiterReductionDb = bytes.getFloat(telemetry + 24)
+        into.xRunCount = bytes.getInt(telemetry + 28)
+        into.callbackFrames = bytes.getInt(telemetry + 32)
+        into.safeModeActive = bytes.getInt(telemetry + 36) != 0
+        return true
+    }
+
+    private fun paramOffset(slot: Int) = control + CONTROL_PARAMS + slot * 4
+
+    private fun put(param: Param, value: Float) = bytes.putFloat(paramOffset(param.ordinal), value)
+
+    // Plain store: the native side rescans after every bump (no release store below API 33)
+    private fun bump() = bytes.putInt(control, bytes.getInt(control) + 1)
+
+    companion object {
+        private const val MAGIC = 0x42434153          // "SACB"
+        private const val LAYOUT_VERSION = 2
+        private const val EQ_BANDS = 10
+
+        private const val HEADER_MAGIC = 0
+        private const val HEADER_VERSION = 4
+        private const val HEADER_SIZE = 8
+        private const val HEADER_PARAM_COUNT = 12
+        private const val HEADER_CONTROL_OFFSET = 16
+        private const val HEADER_TELEMETRY_OFFSET = 20
+
+        private const val CONTROL_SWITCHES = 4
+        private const val CONTROL_PARAMS = 20
+
+        /** Null when the native layout is not the one this class was written for */
+        fun wrap(buffer: ByteBuffer?): SharedControlBlock? {
+            if (buffer == null || !buffer.isDirect || buffer.capacity() < 24) return null
+            val bytes = buffer.duplicate().order(ByteOrder.nativeOrder())
+            val compatible = bytes.getInt(HEADER_MAGIC) == MAGIC &&
+                bytes.getInt(HEADER_VERSION) == LAYOUT_VERSION &&
+                bytes.getInt(HEADER_SIZE) <= buffer.capacity() &&
+                bytes.getInt(HEADER_PARAM_COUNT) == Param.entries.size
+            return if (compatible) SharedControlBlock(bytes) else null
+        }
+    }
+}
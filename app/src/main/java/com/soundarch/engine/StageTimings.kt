@@ -0,0 +1,68 @@
+package com.soundarch.engine
+
+/**
+ * Audio callback timing per processing stage, from the always-on native
+ * histograms (reset each time the engine starts).
+ *
+ * Filled by `MainActivity.getStageTimings(DoubleArray)`; the layout mirrors
+ * `utils::Stage` and the STAGE TIMINGS section of native-lib.cpp.
+ */
+data class StageTimings(
+    val stages: Map<Stage, StageTiming> = emptyMap(),
+    val budget: CallbackBudget = CallbackBudget()
+) {
+    /** Same order as soundarch::utils::Stage */
+    enum class Stage {
+        INPUT, DSP, AGC, EQUALIZER, VOICE_GAIN, NOISE_CANCELLER, COMPRESSOR, LIMITER, FUSED_CHAIN, METERING, CALLBACK
+    }
+
+    data class StageTiming(
+        val count: Long = 0,
+        val p50Us: Double = 0.0,
+        val p99Us: Double = 0.0,
+        val p999Us: Double = 0.0,
+        val maxUs: Double = 0.0
+    )
+
+    /** Callback duration as a percentage of the buffer period (100% = deadline) */
+    data class CallbackBudget(
+        val p50Percent: Double = 0.0,
+        val p99Percent: Double = 0.0,
+        val p999Percent: Double = 0.0,
+        val maxPercent: Double = 0.0,
+        val deadlineMisses: Long = 0
+    )
+
+    companion object {
+        private const val COLUMNS = 5
+
+        /** Size of the DoubleArray to pass to getStageTimings() */
+        val FIELD_COUNT = (Stage.entries.size + 1) * COLUMNS
+
+        /** Decodes a buffer filled by getStageTimings() */
+        fun from(values: DoubleArray): StageTimings {
+            require(values.size >= FIELD_COUNT) { "Stage timing buffer too small: ${values.size} < $FIELD_COUNT" }
+            val stages = Stage.entries.associateWith { stage ->
+                val row = stage.ordinal * COLUMNS
+                StageTiming(
+                    count = values[row].toLong(),
+                    p50Us = values[row + 1],
+                    p99Us = values[row + 2],
+                    p999Us = values[row + 3],
+                    maxUs = values[row + 4]
+                )
+            }
+            val row = Stage.entries.size * COLUMNS
+            return StageTimings(
+                stages = stages,
+                budget = CallbackBudget(
+                    p50Percent = values[row],
+                    p99Percent = values[row + 1],
+                    p999Percent = values[row + 2],
+                    maxPercent = values[row + 3],
+                    deadlineMisses = values[row + 4].toLong()
+                )
+            )
+        }
+    }
+}